@@ -20,11 +20,13 @@
 #ifndef RIPPLED_COMPRESSIONALGORITHMS_H_INCLUDED
 #define RIPPLED_COMPRESSIONALGORITHMS_H_INCLUDED
 
+#include <xrpl/basics/Slice.h>
 #include <xrpl/basics/contract.h>
 
 #include <lz4.h>
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
 #include <stdexcept>
 #include <vector>
@@ -65,11 +67,60 @@ lz4Compress(void const* in, std::size_t inSize, BufferFactory&& bf)
     return compressedSize;
 }
 
+/** LZ4 block compression with a dictionary.
+
+    The block may refer back into the dictionary, so it can only be
+    decompressed with the same dictionary.
+
+ * @tparam BufferFactory Callable object or lambda.
+ *     Takes the requested buffer size and returns allocated buffer pointer.
+ * @param in Data to compress
+ * @param inSize Size of the data
+ * @param bf Compressed buffer allocator
+ * @param dictionary The dictionary, at most 64KB are used
+ * @return Size of compressed data, or zero if failed to compress
+ */
+template <typename BufferFactory>
+std::size_t
+lz4Compress(
+    void const* in,
+    std::size_t inSize,
+    BufferFactory&& bf,
+    Slice dictionary)
+{
+    if (inSize > UINT32_MAX || dictionary.size() > INT_MAX)
+        Throw<std::runtime_error>("lz4 compress: invalid size");
+
+    auto const outCapacity = LZ4_compressBound(inSize);
+
+    auto compressed = bf(outCapacity);
+
+    LZ4_stream_t stream;
+    LZ4_initStream(&stream, sizeof(stream));
+    LZ4_loadDict(
+        &stream,
+        reinterpret_cast<char const*>(dictionary.data()),
+        static_cast<int>(dictionary.size()));
+
+    auto compressedSize = LZ4_compress_fast_continue(
+        &stream,
+        reinterpret_cast<char const*>(in),
+        reinterpret_cast<char*>(compressed),
+        inSize,
+        outCapacity,
+        1);
+    if (compressedSize == 0)
+        Throw<std::runtime_error>("lz4 compress: failed");
+
+    return compressedSize;
+}
+
 /**
  * @param in Compressed data
  * @param inSizeUnchecked Size of compressed data
  * @param decompressed Buffer to hold decompressed data
  * @param decompressedSizeUnchecked Size of the decompressed buffer
+ * @param dictionary The dictionary the data was compressed with, if any
  * @return size of the decompressed data
  */
 inline std::size_t
@@ -77,7 +128,8 @@ lz4Decompress(
     std::uint8_t const* in,
     std::size_t inSizeUnchecked,
     std::uint8_t* decompressed,
-    std::size_t decompressedSizeUnchecked)
+    std::size_t decompressedSizeUnchecked,
+    Slice dictionary = {})
 {
     int const inSize = static_cast<int>(inSizeUnchecked);
     int const decompressedSize = static_cast<int>(decompressedSizeUnchecked);
@@ -88,11 +140,23 @@ lz4Decompress(
     if (decompressedSize <= 0)
         Throw<std::runtime_error>("lz4Decompress: integer overflow (output)");
 
-    if (LZ4_decompress_safe(
-            reinterpret_cast<char const*>(in),
-            reinterpret_cast<char*>(decompressed),
-            inSize,
-            decompressedSize) != decompressedSize)
+    if (dictionary.size() > INT_MAX)
+        Throw<std::runtime_error>("lz4Decompress: integer overflow (dict)");
+
+    int const result = dictionary.empty()
+        ? LZ4_decompress_safe(
+              reinterpret_cast<char const*>(in),
+              reinterpret_cast<char*>(decompressed),
+              inSize,
+              decompressedSize)
+        : LZ4_decompress_safe_usingDict(
+              reinterpret_cast<char const*>(in),
+              reinterpret_cast<char*>(decompressed),
+              inSize,
+              decompressedSize,
+              reinterpret_cast<char const*>(dictionary.data()),
+              static_cast<int>(dictionary.size()));
+    if (result != decompressedSize)
         Throw<std::runtime_error>("lz4Decompress: failed");
 
     return decompressedSize;
@@ -104,6 +168,7 @@ lz4Decompress(
  * @param inSize Size of compressed data
  * @param decompressed Buffer to hold decompressed data
  * @param decompressedSize Size of the decompressed buffer
+ * @param dictionary The dictionary the data was compressed with, if any
  * @return size of the decompressed data
  */
 template <typename InputStream>
@@ -112,7 +177,8 @@ lz4Decompress(
     InputStream& in,
     std::size_t inSize,
     std::uint8_t* decompressed,
-    std::size_t decompressedSize)
+    std::size_t decompressedSize,
+    Slice dictionary = {})
 {
     std::vector<std::uint8_t> compressed;
     std::uint8_t const* chunk = nullptr;
@@ -158,7 +224,8 @@ lz4Decompress(
         (copiedInSize > 0 && copiedInSize != inSize))
         Throw<std::runtime_error>("lz4 decompress: insufficient input size");
 
-    return lz4Decompress(chunk, inSize, decompressed, decompressedSize);
+    return lz4Decompress(
+        chunk, inSize, decompressed, decompressedSize, dictionary);
 }
 
 }  // namespace compression_algorithms
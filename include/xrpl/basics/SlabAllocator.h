@@ -170,6 +170,10 @@ private:
     // The size of each individual slab:
     std::size_t const slabSize_;
 
+    // The number of slabs and of items handed out, for reporting only:
+    std::atomic<std::size_t> slabCount_ = 0;
+    std::atomic<std::size_t> inUse_ = 0;
+
 public:
     /** Constructs a slab allocator able to allocate objects of a fixed size
 
@@ -215,6 +219,20 @@ public:
         return itemSize_;
     }
 
+    /** Returns the number of memory blocks currently handed out. */
+    std::size_t
+    inUse() const noexcept
+    {
+        return inUse_.load(std::memory_order_relaxed);
+    }
+
+    /** Returns the number of bytes obtained from the system for slabs. */
+    std::size_t
+    reserved() const noexcept
+    {
+        return slabCount_.load(std::memory_order_relaxed) * slabSize_;
+    }
+
     /** Returns a suitably aligned pointer, if one is available.
 
         @return a pointer to a block of memory from the allocator, or
@@ -228,7 +246,10 @@ public:
         while (slab != nullptr)
         {
             if (auto ret = slab->allocate())
+            {
+                inUse_.fetch_add(1, std::memory_order_relaxed);
                 return ret;
+            }
 
             slab = slab->next_;
         }
@@ -287,7 +308,12 @@ public:
             ;  // Nothing to do
         }
 
-        return slab->allocate();
+        slabCount_.fetch_add(1, std::memory_order_relaxed);
+
+        auto ret = slab->allocate();
+        if (ret)
+            inUse_.fetch_add(1, std::memory_order_relaxed);
+        return ret;
     }
 
     /** Returns the memory block to the allocator.
@@ -310,6 +336,7 @@ public:
             if (slab->own(ptr))
             {
                 slab->deallocate(ptr);
+                inUse_.fetch_sub(1, std::memory_order_relaxed);
                 return true;
             }
         }
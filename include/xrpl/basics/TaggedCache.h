@@ -31,6 +31,7 @@
 #include <atomic>
 #include <functional>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -46,6 +47,12 @@ namespace ripple {
     If it stays in memory even after it is ejected from the cache,
     the map will track it.
 
+    The map is split into partitions, each guarded by its own reader/writer
+    lock. A lookup that finds a strongly cached object only takes its
+    partition's lock in shared mode, so concurrent hits never block each
+    other. Sweeps visit one partition at a time and never hold more than
+    one partition lock.
+
     @note Callers must not modify data objects that are stored in the cache
           unless they hold their own lock over all cache operations.
 */
@@ -170,6 +177,12 @@ public:
     bool
     retrieve(key_type const& key, T& data);
 
+    /** Return a mutex callers may hold to make a sequence of cache operations
+        atomic with respect to each other.
+
+        The cache does not take this mutex itself; its own state is protected
+        by the partition locks.
+    */
     mutex_type&
     peekMutex();
 
@@ -192,8 +205,27 @@ public:
     // End CachedSLEs functions.
 
 private:
+    using partition_lock_type = std::shared_mutex;
+
+    // Padded so that the locks of neighbouring partitions do not share a
+    // cache line.
+    struct alignas(64) PartitionLock
+    {
+        partition_lock_type mutable mutex;
+    };
+
+    SharedPointerType
+    cachedFetch(
+        key_type const& key,
+        std::shared_lock<partition_lock_type> const&);
+
     SharedPointerType
-    initialFetch(key_type const& key, std::lock_guard<mutex_type> const& l);
+    initialFetch(
+        key_type const& key,
+        std::unique_lock<partition_lock_type> const&);
+
+    std::vector<std::unique_lock<partition_lock_type>>
+    lockAll() const;
 
     void
     collect_metrics();
@@ -218,14 +250,47 @@ private:
         beast::insight::Gauge size;
         beast::insight::Gauge hit_rate;
 
-        std::size_t hits;
-        std::size_t misses;
+        std::atomic<std::size_t> hits;
+        std::atomic<std::size_t> misses;
+    };
+
+    // Hits refresh the access time while holding only a shared lock on the
+    // partition, so it is stored atomically.
+    class AccessTime
+    {
+    public:
+        explicit AccessTime(clock_type::time_point const& when)
+            : rep_(when.time_since_epoch().count())
+        {
+        }
+
+        AccessTime(AccessTime const& other)
+            : rep_(other.rep_.load(std::memory_order_relaxed))
+        {
+        }
+
+        clock_type::time_point
+        load() const
+        {
+            return clock_type::time_point(
+                clock_type::duration(rep_.load(std::memory_order_relaxed)));
+        }
+
+        void
+        store(clock_type::time_point const& when)
+        {
+            rep_.store(
+                when.time_since_epoch().count(), std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<clock_type::rep> rep_;
     };
 
     class KeyOnlyEntry
     {
     public:
-        clock_type::time_point last_access;
+        AccessTime last_access;
 
         explicit KeyOnlyEntry(clock_type::time_point const& last_access_)
             : last_access(last_access_)
@@ -235,7 +300,7 @@ private:
         void
         touch(clock_type::time_point const& now)
         {
-            last_access = now;
+            last_access.store(now);
         }
     };
 
@@ -243,7 +308,7 @@ private:
     {
     public:
         shared_weak_combo_pointer_type ptr;
-        clock_type::time_point last_access;
+        AccessTime last_access;
 
         ValueEntry(
             clock_type::time_point const& last_access_,
@@ -277,7 +342,7 @@ private:
         void
         touch(clock_type::time_point const& now)
         {
-            last_access = now;
+            last_access.store(now);
         }
     };
 
@@ -294,23 +359,23 @@ private:
     using cache_type =
         hardened_partitioned_hash_map<key_type, Entry, Hash, KeyEqual>;
 
-    [[nodiscard]] std::thread
-    sweepHelper(
+    // Sweep one partition and return the number of entries that left the
+    // cache.
+    int
+    sweepPartition(
         clock_type::time_point const& when_expire,
         [[maybe_unused]] clock_type::time_point const& now,
         typename KeyValueCacheType::map_type& partition,
         SweptPointersVector& stuffToSweep,
-        std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&);
+        std::unique_lock<partition_lock_type> const&);
 
-    [[nodiscard]] std::thread
-    sweepHelper(
+    int
+    sweepPartition(
         clock_type::time_point const& when_expire,
         clock_type::time_point const& now,
         typename KeyOnlyCacheType::map_type& partition,
         SweptPointersVector&,
-        std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&);
+        std::unique_lock<partition_lock_type> const&);
 
     beast::Journal m_journal;
     clock_type& m_clock;
@@ -328,10 +393,11 @@ private:
     clock_type::duration const m_target_age;
 
     // Number of items cached
-    int m_cache_count;
+    std::atomic<int> m_cache_count;
     cache_type m_cache;  // Hold strong reference to recent objects
-    std::uint64_t m_hits;
-    std::uint64_t m_misses;
+    std::vector<PartitionLock> m_locks;  // One per partition of m_cache
+    std::atomic<std::uint64_t> m_hits;
+    std::atomic<std::uint64_t> m_misses;
 };
 
 }  // namespace ripple
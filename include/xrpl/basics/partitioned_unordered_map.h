@@ -277,6 +277,19 @@ public:
         return map_;
     }
 
+    partition_map_type const&
+    map() const
+    {
+        return map_;
+    }
+
+    /** Return the index of the partition that holds `key`. */
+    std::size_t
+    partition_index(key_type const& key) const
+    {
+        return partitioner(key);
+    }
+
     iterator
     begin()
     {
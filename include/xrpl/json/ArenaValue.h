@@ -0,0 +1,467 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_ARENAVALUE_H_INCLUDED
+#define RIPPLE_JSON_ARENAVALUE_H_INCLUDED
+
+#include <xrpl/json/json_value.h>
+#include <xrpl/json/json_writer.h>
+
+#include <boost/container/pmr/memory_resource.hpp>
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Json {
+
+/** Memory for the values of one JSON document.
+
+    Memory is taken from large blocks and is only returned, all at once,
+    when the Arena is destroyed. Nothing allocated from it is ever freed
+    individually.
+*/
+class Arena : public boost::container::pmr::memory_resource
+{
+public:
+    explicit Arena(std::size_t initialBytes = 16 * 1024);
+
+    Arena(Arena const&) = delete;
+    Arena&
+    operator=(Arena const&) = delete;
+
+    /** The number of blocks obtained from the heap. */
+    std::size_t
+    blocks() const
+    {
+        return upstream_.blocks;
+    }
+
+    /** The number of bytes handed out to values. */
+    std::size_t
+    bytes() const
+    {
+        return bytes_;
+    }
+
+    /** Copy a string into the arena, terminated with a NUL. */
+    std::string_view
+    copy(std::string_view s);
+
+private:
+    struct Upstream : boost::container::pmr::memory_resource
+    {
+        std::size_t blocks = 0;
+
+        void*
+        do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void
+        do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+            override;
+
+        bool
+        do_is_equal(memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    void*
+    do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void
+    do_deallocate(void*, std::size_t, std::size_t) override
+    {
+    }
+
+    bool
+    do_is_equal(memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    Upstream upstream_;
+    boost::container::pmr::monotonic_buffer_resource buffer_;
+    std::size_t bytes_ = 0;
+};
+
+/** A JSON value whose storage lives in an Arena.
+
+    This is an alternative to Json::Value for building large responses.
+    Its interface follows Json::Value closely so code can move from one to
+    the other with few changes, but:
+
+    - Values are created by a Document, or as members and elements of
+      other values, and can't be copied or moved. Assignment copies the
+      contents into this value's arena.
+    - Member names given as StaticString, such as the jss:: keys, are
+      stored by pointer. Other names and all strings are copied into the
+      arena once.
+    - Objects are vectors of members kept sorted by name, so members are
+      visited in the same order as Json::Value and lookups are a binary
+      search. Members and elements are allocated individually, so a
+      reference to one stays valid while others are added.
+
+    Replacing the contents of a value does not reclaim the memory of what
+    was there before until the whole document is destroyed.
+*/
+class ArenaValue
+{
+public:
+    using UInt = Json::UInt;
+    using Int = Json::Int;
+
+    struct Member
+    {
+        std::string_view name;
+        bool isStatic;
+        ArenaValue* value;
+    };
+
+    using Members = boost::container::pmr::vector<Member>;
+    using Elements = boost::container::pmr::vector<ArenaValue*>;
+
+    static ArenaValue const null;
+
+    explicit ArenaValue(Arena& arena, ValueType type = nullValue);
+
+    ArenaValue(ArenaValue const&) = delete;
+
+    ArenaValue&
+    operator=(ArenaValue const& other);
+    ArenaValue&
+    operator=(Value const& other);
+    ArenaValue&
+    operator=(ValueType type);
+    ArenaValue&
+    operator=(Int value);
+    ArenaValue&
+    operator=(UInt value);
+    ArenaValue&
+    operator=(double value);
+    ArenaValue&
+    operator=(bool value);
+    ArenaValue&
+    operator=(char const* value);
+    ArenaValue&
+    operator=(std::string const& value);
+    ArenaValue&
+    operator=(StaticString const& value);
+
+    ValueType
+    type() const
+    {
+        return type_;
+    }
+
+    bool
+    isNull() const
+    {
+        return type_ == nullValue;
+    }
+
+    bool
+    isBool() const
+    {
+        return type_ == booleanValue;
+    }
+
+    bool
+    isString() const
+    {
+        return type_ == stringValue;
+    }
+
+    bool
+    isArray() const
+    {
+        return type_ == arrayValue;
+    }
+
+    bool
+    isObject() const
+    {
+        return type_ == objectValue;
+    }
+
+    bool
+    isIntegral() const
+    {
+        return type_ == intValue || type_ == uintValue;
+    }
+
+    bool
+    isNumeric() const
+    {
+        return isIntegral() || type_ == realValue;
+    }
+
+    char const*
+    asCString() const;
+    std::string
+    asString() const;
+    Int
+    asInt() const;
+    UInt
+    asUInt() const;
+    double
+    asDouble() const;
+    bool
+    asBool() const;
+
+    /// Number of values in array or object
+    UInt
+    size() const;
+
+    /// Access an array element, growing the array with nulls if needed.
+    ArenaValue&
+    operator[](UInt index);
+    ArenaValue const&
+    operator[](UInt index) const;
+
+    /// Append a new null element to the array and return it.
+    ArenaValue&
+    append();
+
+    template <class T>
+    ArenaValue&
+    append(T const& value)
+    {
+        auto& element = append();
+        element = value;
+        return element;
+    }
+
+    /// Access an object member, creating a null member if there is none.
+    ArenaValue&
+    operator[](StaticString const& key);
+    ArenaValue&
+    operator[](std::string const& key);
+    ArenaValue&
+    operator[](char const* key);
+
+    /// Access an object member, returning null if there is none.
+    ArenaValue const&
+    operator[](StaticString const& key) const;
+    ArenaValue const&
+    operator[](std::string const& key) const;
+    ArenaValue const&
+    operator[](char const* key) const;
+
+    bool
+    isMember(std::string_view key) const;
+
+    /// Remove the named member. Return true if it existed.
+    bool
+    removeMember(std::string_view key);
+
+    /// The members of an object, sorted by name.
+    Members const&
+    members() const;
+
+    /// The elements of an array.
+    Elements const&
+    elements() const;
+
+    /// Copy this value into a Json::Value.
+    Value
+    toValue() const;
+
+private:
+    ArenaValue() = default;
+
+    void
+    reset(ValueType type);
+
+    ArenaValue&
+    resolve(std::string_view key, bool isStatic);
+
+    ArenaValue const*
+    find(std::string_view key) const;
+
+    ArenaValue&
+    make();
+
+    Arena* arena_ = nullptr;
+    union
+    {
+        Int int_;
+        UInt uint_;
+        double real_;
+        bool bool_;
+        char const* string_;
+        Members* members_;
+        Elements* elements_;
+    } value_{};
+    ValueType type_ = nullValue;
+};
+
+/** A JSON document: an Arena and the value at its root. */
+class Document
+{
+public:
+    explicit Document(
+        ValueType type = objectValue,
+        std::size_t initialBytes = 16 * 1024)
+        : arena_(initialBytes), root_(arena_, type)
+    {
+    }
+
+    Document(Document const&) = delete;
+    Document&
+    operator=(Document const&) = delete;
+
+    ArenaValue&
+    root()
+    {
+        return root_;
+    }
+
+    ArenaValue const&
+    root() const
+    {
+        return root_;
+    }
+
+    Arena const&
+    arena() const
+    {
+        return arena_;
+    }
+
+private:
+    Arena arena_;
+    ArenaValue root_;
+};
+
+bool
+operator==(ArenaValue const& x, Value const& y);
+
+inline bool
+operator==(Value const& x, ArenaValue const& y)
+{
+    return y == x;
+}
+
+namespace detail {
+
+// Most strings need no escaping and are written without a copy.
+template <class Write>
+void
+write_quoted(Write const& write, std::string_view s)
+{
+    bool const plain = std::none_of(s.begin(), s.end(), [](char c) {
+        return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+    });
+    if (!plain)
+        return write_string(write, valueToQuotedString(s.data()));
+
+    write("\"", 1);
+    write(s.data(), s.size());
+    write("\"", 1);
+}
+
+template <class Write>
+void
+write_value(Write const& write, ArenaValue const& value)
+{
+    switch (value.type())
+    {
+        case arrayValue: {
+            write("[", 1);
+            bool first = true;
+            for (auto const element : value.elements())
+            {
+                if (!first)
+                    write(",", 1);
+                first = false;
+                write_value(write, *element);
+            }
+            write("]", 1);
+            break;
+        }
+
+        case objectValue: {
+            write("{", 1);
+            bool first = true;
+            for (auto const& member : value.members())
+            {
+                if (!first)
+                    write(",", 1);
+                first = false;
+                write_quoted(write, member.name);
+                write(":", 1);
+                write_value(write, *member.value);
+            }
+            write("}", 1);
+            break;
+        }
+
+        case stringValue:
+            write_quoted(write, value.asCString());
+            break;
+
+        case nullValue:
+            write("null", 4);
+            break;
+
+        case intValue:
+            write_string(write, valueToString(value.asInt()));
+            break;
+
+        case uintValue:
+            write_string(write, valueToString(value.asUInt()));
+            break;
+
+        case realValue:
+            write_string(write, valueToString(value.asDouble()));
+            break;
+
+        case booleanValue:
+            write_string(write, valueToString(value.asBool()));
+            break;
+    }
+}
+
+}  // namespace detail
+
+/** Stream compact JSON to the specified function.
+
+    The output is the same as Json::stream gives for the equivalent
+    Json::Value.
+*/
+template <class Write>
+void
+stream(ArenaValue const& value, Write const& write)
+{
+    detail::write_value(write, value);
+    write("\n", 1);
+}
+
+/** Writes an ArenaValue to an std::string, like Json::to_string. */
+std::string
+to_string(ArenaValue const& value);
+
+}  // namespace Json
+
+#endif
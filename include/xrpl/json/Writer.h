@@ -26,6 +26,7 @@
 #include <xrpl/json/json_value.h>
 
 #include <memory>
+#include <string_view>
 
 namespace Json {
 
@@ -144,7 +145,7 @@ public:
 
     /** Start a new collection inside an object. */
     void
-    startSet(CollectionType, std::string const& key);
+    startSet(CollectionType, std::string_view key);
 
     /** Finish the collection most recently started. */
     void
@@ -195,7 +196,13 @@ public:
     /** Emit just "tag": as part of an object.  Useful if you are writing the
         actual value data yourself. */
     void
-    rawSet(std::string const& key);
+    rawSet(std::string_view key);
+
+    void
+    rawSet(Json::StaticString const& key)
+    {
+        rawSet(std::string_view(key.c_str()));
+    }
 
     // You won't need to call anything below here until you are writing single
     // items (numbers, strings, bools, null) to a JSON stream.
@@ -270,17 +270,19 @@ write_value(Write const& write, Value const& value)
         }
 
         case objectValue: {
-            Value::Members const members = value.getMemberNames();
+            // Members are visited in place, in name order, rather than
+            // copying out their names and looking each one up again.
             write("{", 1);
-            for (auto it = members.begin(); it != members.end(); ++it)
+            bool first = true;
+            for (auto it = value.begin(); it != value.end(); ++it)
             {
-                std::string const& name = *it;
-                if (it != members.begin())
+                if (!first)
                     write(",", 1);
+                first = false;
 
-                write_string(write, valueToQuotedString(name.c_str()));
+                write_string(write, valueToQuotedString(it.memberName()));
                 write(":", 1);
-                write_value(write, value[name]);
+                write_value(write, *it);
             }
             write("}", 1);
             break;
@@ -54,6 +54,10 @@ public:
     std::string
     getText() const override;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions = JsonOptions::none)
+        const override;
+
     void
     add(Serializer& s) const override;
 
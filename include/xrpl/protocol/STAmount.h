@@ -279,6 +279,10 @@ public:
 
     Json::Value getJson(JsonOptions = JsonOptions::none) const override;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions = JsonOptions::none)
+        const override;
+
     void
     add(Serializer& s) const override;
 
@@ -124,6 +124,9 @@ public:
     Json::Value
     getJson(JsonOptions index) const override;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions index) const override;
+
     void
     add(Serializer& s) const override;
 
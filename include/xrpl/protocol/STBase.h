@@ -21,6 +21,7 @@
 #define RIPPLE_PROTOCOL_STBASE_H_INCLUDED
 
 #include <xrpl/basics/contract.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/Serializer.h>
 
@@ -168,6 +169,16 @@ public:
 
     virtual Json::Value getJson(JsonOptions = JsonOptions::none) const;
 
+    /** Write the same JSON that getJson returns, as one value.
+
+        The caller has already written the key, or the separator if this
+        is an array element. By default this writes getJson(). Types that
+        override it write straight to the writer instead, so a class that
+        changes getJson must also override writeJson if a base does.
+    */
+    virtual void
+    writeJson(Json::Writer& w, JsonOptions = JsonOptions::none) const;
+
     virtual void
     add(Serializer& s) const;
 
@@ -55,6 +55,10 @@ public:
     std::string
     getText() const override;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions = JsonOptions::none)
+        const override;
+
     bool
     isEquivalent(STBase const& t) const override;
 
@@ -158,6 +162,13 @@ STBitString<Bits>::getText() const
     return to_string(value_);
 }
 
+template <int Bits>
+void
+STBitString<Bits>::writeJson(Json::Writer& w, JsonOptions) const
+{
+    w.output(getText());
+}
+
 template <int Bits>
 bool
 STBitString<Bits>::isEquivalent(STBase const& t) const
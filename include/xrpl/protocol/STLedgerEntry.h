@@ -60,6 +60,10 @@ public:
     Json::Value
     getJson(JsonOptions options = JsonOptions::none) const override;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions options = JsonOptions::none)
+        const override;
+
     /** Returns the 'key' (or 'index') of this item.
         The key identifies this entry's position in
         the SHAMap associative container.
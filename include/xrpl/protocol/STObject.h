@@ -39,6 +39,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -156,6 +157,10 @@ public:
     // TODO(tom): options should be an enum.
     Json::Value getJson(JsonOptions = JsonOptions::none) const override;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions = JsonOptions::none)
+        const override;
+
     void
     addWithoutSigningFields(Serializer& s) const;
 
@@ -421,6 +426,25 @@ public:
 
     class FieldErr;
 
+protected:
+    /** A member that a derived class writes beside the fields. */
+    struct JsonMember
+    {
+        char const* name;
+        std::string value;
+    };
+
+    /** Write the present fields and the extra members as one object.
+
+        Members are written in the order a Json::Value lists them, so the
+        result is the same as writing the object that getJson builds.
+    */
+    void
+    writeJsonObject(
+        Json::Writer& w,
+        JsonOptions options,
+        std::span<JsonMember const> extra) const;
+
 private:
     enum WhichFields : bool {
         // These values are carefully chosen to do the right thing if passed
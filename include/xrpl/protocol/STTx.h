@@ -118,6 +118,9 @@ public:
     Json::Value
     getJson(JsonOptions options, bool binary) const;
 
+    void
+    writeJson(Json::Writer& w, JsonOptions options) const override;
+
     void
     sign(PublicKey const& publicKey, SecretKey const& secretKey);
 
@@ -129,6 +129,7 @@ JSS(accounts);                // in: LedgerEntry, Subscribe,
                               //     handlers/Ledger, Unsubscribe
 JSS(accounts_proposed);       // in: Subscribe, Unsubscribe
 JSS(action);
+JSS(acquired);                // out: PerfLog
 JSS(acquiring);               // out: LedgerRequest
 JSS(address);                 // out: PeerImp
 JSS(affected);                // out: AcceptedLedgerTx
@@ -159,6 +160,8 @@ JSS(auth_change_queued);      // out: AccountInfo
 JSS(available);               // out: ValidatorList
 JSS(avg_bps_recv);            // out: Peers
 JSS(avg_bps_sent);            // out: Peers
+JSS(avg_bytes_per_write);     // out: Peers
+JSS(avg_writes_sent);         // out: Peers
 JSS(balance);                 // out: AccountLines
 JSS(balances);                // out: GatewayBalances
 JSS(base);                    // out: LogLevel
@@ -208,6 +211,7 @@ JSS(command);                 // in: RPCHandler
 JSS(complete);                // out: NetworkOPs, InboundLedger
 JSS(complete_ledgers);        // out: NetworkOPs, PeerImp
 JSS(consensus);               // out: NetworkOPs, LedgerConsensus
+JSS(contended);               // out: PerfLog
 JSS(converge_time);           // out: NetworkOPs
 JSS(converge_time_s);         // out: NetworkOPs
 JSS(cookie);                  // out: NetworkOPs
@@ -255,6 +259,7 @@ JSS(duration_us);             // out: NetworkOPs
 JSS(effective);               // out: ValidatorList
                               // in: UNL
 JSS(enabled);                 // out: AmendmentTable
+JSS(end_marker);              // in: LedgerData
 JSS(engine_result);           // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_code);      // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_message);   // out: NetworkOPs, TransactionSign, Submit
@@ -323,6 +328,8 @@ JSS(index);                   // in: LedgerEntry
                               //      LedgerEntry, TxHistory, LedgerData
 JSS(info);                    // out: ServerInfo, ConsensusInfo, FetchInfo
 JSS(initial_sync_duration_us);
+JSS(inner_node_slab_KB);      // out: GetCounts
+JSS(inner_node_slab_size);    // out: GetCounts
 JSS(internal_command);        // in: Internal
 JSS(invalid_API_version);     // out: Many, when a request has an invalid
                               //      version
@@ -396,6 +403,7 @@ JSS(local);                   // out: resource/Logic.h
 JSS(local_txs);               // out: GetCounts
 JSS(local_static_keys);       // out: ValidatorList
 JSS(locked);                  // out: GatewayBalances
+JSS(locks);                   // out: PerfLog
 JSS(low);                     // out: BookChanges
 JSS(lowest_sequence);         // out: AccountInfo
 JSS(lowest_ticket);           // out: AccountInfo
@@ -416,6 +424,7 @@ JSS(max_ledger);              // in/out: LedgerCleaner
 JSS(max_queue_size);          // out: TxQ
 JSS(max_spend_drops);         // out: AccountInfo
 JSS(max_spend_drops_total);   // out: AccountInfo
+JSS(max_us);                  // out: PerfLog
 JSS(mean);                    // out: get_aggregate_price
 JSS(median);                  // out: get_aggregate_price
 JSS(median_fee);              // out: TxQ
@@ -457,6 +466,7 @@ JSS(node_reads_total);        // out: GetCounts
 JSS(node_reads_duration_us);  // out: GetCounts
 JSS(node_size);               // out: server_info
 JSS(nodes);                   // out: VaultInfo
+JSS(nodes_per_second);        // out: InboundLedger
 JSS(nodestore);               // out: GetCounts
 JSS(node_writes);             // out: GetCounts
 JSS(node_written_bytes);      // out: GetCounts
@@ -477,6 +487,10 @@ JSS(oracles);                 // in: get_aggregate_price
 JSS(oracle_document_id);      // in: get_aggregate_price
 JSS(owner);                   // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);             // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
+JSS(p50_us);                  // out: PerfLog
+JSS(p90_us);                  // out: PerfLog
+JSS(p99_us);                  // out: PerfLog
+JSS(p999_us);                 // out: PerfLog
 JSS(page_index);
 JSS(params);                  // RPC
 JSS(parent_close_time);       // out: LedgerToJson
@@ -520,6 +534,7 @@ JSS(queue);                   // in: AccountInfo
 JSS(queue_data);              // out: AccountInfo
 JSS(queued);                  // out: SubmitTransaction
 JSS(queued_duration_us);
+JSS(queued_us);               // out: PerfLog
 JSS(quote_asset);             // in: get_aggregate_price
 JSS(random);                  // out: Random
 JSS(raw_meta);                // out: AcceptedLedgerTx
@@ -546,6 +561,7 @@ JSS(role);                    // out: Ping.cpp
 JSS(rpc);
 JSS(rt_accounts);             // in: Subscribe, Unsubscribe
 JSS(running_duration_us);
+JSS(running_us);              // out: PerfLog
 JSS(search_depth);            // in: RipplePathFind
 JSS(searched_all);            // out: Tx
 JSS(secret);                  // in: TransactionSign,
@@ -568,6 +584,11 @@ JSS(server_version);          // out: NetworkOPs
 JSS(settle_delay);            // out: AccountChannels
 JSS(severity);                // in: LogLevel
 JSS(shares);                  // out: VaultInfo
+JSS(sig_batches);             // out: GetCounts
+JSS(sig_failed);              // out: GetCounts
+JSS(sig_verified);            // out: GetCounts
+JSS(sig_verify_per_second);   // out: GetCounts
+JSS(sig_verify_queue);        // out: GetCounts
 JSS(signature);               // out: NetworkOPs, ChannelAuthorize
 JSS(signature_verified);      // out: ChannelVerify
 JSS(signing_key);             // out: NetworkOPs
@@ -595,6 +616,7 @@ JSS(sub_index);               // in: LedgerEntry
 JSS(subcommand);              // in: PathFind
 JSS(subject);                 // in: LedgerEntry Credential
 JSS(success);                 // rpc
+JSS(sum_us);                  // out: PerfLog
 JSS(supported);               // out: AmendmentTableImpl
 JSS(sync_mode);               // in: Submit
 JSS(system_time_offset);      // out: NetworkOPs
@@ -639,6 +661,11 @@ JSS(treenode_track_size);     // out: GetCounts
 JSS(trusted);                 // out: UnlList
 JSS(trusted_validator_keys);  // out: ValidatorList
 JSS(tx);                      // out: STTx, AccountTx*
+JSS(tx_batch_parallel_us);    // out: GetCounts
+JSS(tx_batch_preclaim_reused);// out: GetCounts
+JSS(tx_batch_serial_us);      // out: GetCounts
+JSS(tx_batch_transactions);   // out: GetCounts
+JSS(tx_batches);              // out: GetCounts
 JSS(tx_blob);                 // in/out: Submit,
                               // in: TransactionSign, AccountTx*
 JSS(tx_hash);                 // in: TransactionEntry
@@ -701,6 +728,7 @@ JSS(volume_b);                  // out: BookChanges
 JSS(vote);                      // in: Feature
 JSS(vote_slots);                // out: amm_info
 JSS(vote_weight);               // out: amm_info
+JSS(wait_us);                   // out: PerfLog
 JSS(warning);                   // rpc:
 JSS(warnings);                  // out: server_info, server_state
 JSS(workers);
@@ -30,6 +30,7 @@
 #include <functional>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
 namespace ripple {
@@ -95,6 +96,10 @@ public:
     virtual void
     write(void const* buffer, std::size_t bytes) = 0;
 
+    /** Send data asynchronously, taking ownership rather than copying. */
+    virtual void
+    write(std::string&& s) = 0;
+
     virtual void
     write(std::shared_ptr<Writer> const& writer, bool keep_alive) = 0;
 
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -104,6 +105,46 @@ public:
     }
 };
 
+/** A message whose bytes are shared with other messages.
+
+    Sending the same bytes to many sessions needs one of these per
+    session, to track that session's progress, but only one copy of the
+    data.
+*/
+class SharedBufferWSMsg : public WSMsg
+{
+    std::shared_ptr<std::string const> data_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit SharedBufferWSMsg(std::shared_ptr<std::string const> data)
+        : data_(std::move(data))
+    {
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)>) override
+    {
+        if (data_->empty())
+            return {true, {}};
+        pos_ += n_;
+        auto const remaining = data_->size() - pos_;
+        boost::tribool done;
+        if (bytes < remaining)
+        {
+            n_ = bytes;
+            done = false;
+        }
+        else
+        {
+            n_ = remaining;
+            done = true;
+        }
+        return {done, {boost::asio::const_buffer(data_->data() + pos_, n_)}};
+    }
+};
+
 struct WSSession
 {
     std::shared_ptr<void> appDefined;
@@ -43,6 +43,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace ripple {
@@ -68,15 +69,11 @@ protected:
 
     struct buffer
     {
-        buffer(void const* ptr, std::size_t len)
-            : data(new char[len]), bytes(len), used(0)
+        explicit buffer(std::string&& s) : data(std::move(s))
         {
-            memcpy(data.get(), ptr, len);
         }
 
-        std::unique_ptr<char[]> data;
-        std::size_t bytes;
-        std::size_t used;
+        std::string data;
     };
 
     Port const& port_;
@@ -191,6 +188,9 @@ protected:
     void
     write(void const* buffer, std::size_t bytes) override;
 
+    void
+    write(std::string&& s) override;
+
     void
     write(std::shared_ptr<Writer> const& writer, bool keep_alive) override;
 
@@ -341,7 +341,7 @@ BaseHTTPPeer<Handler, Impl>::on_write(
         std::vector<boost::asio::const_buffer> v;
         v.reserve(wq2_.size());
         for (auto const& b : wq2_)
-            v.emplace_back(b.data.get(), b.bytes);
+            v.emplace_back(b.data.data(), b.data.size());
         start_timer();
         return boost::asio::async_write(
             impl().stream_,
@@ -425,9 +425,19 @@ BaseHTTPPeer<Handler, Impl>::write(void const* buf, std::size_t bytes)
 {
     if (bytes == 0)
         return;
+    write(std::string(static_cast<char const*>(buf), bytes));
+}
+
+// Send the data without copying it.
+template <class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::write(std::string&& s)
+{
+    if (s.empty())
+        return;
     if ([&] {
             std::lock_guard lock(mutex_);
-            wq_.emplace_back(buf, bytes);
+            wq_.emplace_back(std::move(s));
             return wq_.size() == 1 && wq2_.size() == 0;
         }())
     {
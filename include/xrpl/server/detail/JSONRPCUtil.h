@@ -33,6 +33,16 @@ HTTPReply(
     Json::Output const&,
     beast::Journal j);
 
+/** Write the status line and headers of a JSON reply.
+
+    The caller writes the body, which must be contentLength bytes long.
+*/
+void
+HTTPReplyHeaders(
+    int nStatus,
+    std::size_t contentLength,
+    Json::Output const& output);
+
 }  // namespace ripple
 
 #endif
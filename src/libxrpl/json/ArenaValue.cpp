@@ -0,0 +1,548 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/ArenaValue.h>
+#include <xrpl/json/detail/json_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Json {
+
+void*
+Arena::Upstream::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    ++blocks;
+    return boost::container::pmr::new_delete_resource()->allocate(
+        bytes, alignment);
+}
+
+void
+Arena::Upstream::do_deallocate(
+    void* p,
+    std::size_t bytes,
+    std::size_t alignment)
+{
+    boost::container::pmr::new_delete_resource()->deallocate(
+        p, bytes, alignment);
+}
+
+Arena::Arena(std::size_t initialBytes) : buffer_(initialBytes, &upstream_)
+{
+}
+
+void*
+Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    bytes_ += bytes;
+    return buffer_.allocate(bytes, alignment);
+}
+
+std::string_view
+Arena::copy(std::string_view s)
+{
+    auto const p = static_cast<char*>(allocate(s.size() + 1, 1));
+    std::memcpy(p, s.data(), s.size());
+    p[s.size()] = '\0';
+    return {p, s.size()};
+}
+
+//------------------------------------------------------------------------------
+
+ArenaValue const ArenaValue::null;
+
+ArenaValue::ArenaValue(Arena& arena, ValueType type) : arena_(&arena)
+{
+    reset(type);
+}
+
+void
+ArenaValue::reset(ValueType type)
+{
+    XRPL_ASSERT(arena_, "Json::ArenaValue::reset : has arena");
+
+    value_ = {};
+    type_ = type;
+    switch (type)
+    {
+        case arrayValue:
+            value_.elements_ = new (arena_->allocate(
+                sizeof(Elements), alignof(Elements))) Elements(arena_);
+            break;
+        case objectValue:
+            value_.members_ = new (arena_->allocate(
+                sizeof(Members), alignof(Members))) Members(arena_);
+            break;
+        case stringValue:
+            value_.string_ = "";
+            break;
+        default:
+            break;
+    }
+}
+
+ArenaValue&
+ArenaValue::make()
+{
+    auto const p = arena_->allocate(sizeof(ArenaValue), alignof(ArenaValue));
+    return *new (p) ArenaValue(*arena_);
+}
+
+ArenaValue&
+ArenaValue::operator=(ArenaValue const& other)
+{
+    if (this == &other)
+        return *this;
+
+    switch (other.type_)
+    {
+        case arrayValue:
+            reset(arrayValue);
+            value_.elements_->reserve(other.elements().size());
+            for (auto const element : other.elements())
+                append() = *element;
+            break;
+
+        case objectValue:
+            reset(objectValue);
+            value_.members_->reserve(other.members().size());
+            for (auto const& member : other.members())
+            {
+                auto& value = make();
+                value = *member.value;
+                value_.members_->push_back(
+                    {member.isStatic ? member.name : arena_->copy(member.name),
+                     member.isStatic,
+                     &value});
+            }
+            break;
+
+        case stringValue:
+            *this = std::string(other.value_.string_);
+            break;
+
+        default:
+            type_ = other.type_;
+            value_ = other.value_;
+            break;
+    }
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(Value const& other)
+{
+    switch (other.type())
+    {
+        case nullValue:
+            return *this = nullValue;
+        case intValue:
+            return *this = other.asInt();
+        case uintValue:
+            return *this = other.asUInt();
+        case realValue:
+            return *this = other.asDouble();
+        case stringValue:
+            return *this = other.asCString();
+        case booleanValue:
+            return *this = other.asBool();
+        case arrayValue: {
+            reset(arrayValue);
+            value_.elements_->reserve(other.size());
+            // Missing elements of a sparse array are null.
+            for (UInt i = 0; i < other.size(); ++i)
+                append() = other[i];
+            return *this;
+        }
+        case objectValue: {
+            reset(objectValue);
+            value_.members_->reserve(other.size());
+            // Json::Value visits members in name order, so each one goes at
+            // the end.
+            for (auto it = other.begin(); it != other.end(); ++it)
+            {
+                auto& value = make();
+                value = *it;
+                value_.members_->push_back(
+                    {arena_->copy(it.memberName()), false, &value});
+            }
+            return *this;
+        }
+    }
+    UNREACHABLE("Json::ArenaValue::operator=(Value) : invalid type");
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(ValueType type)
+{
+    reset(type);
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(Int value)
+{
+    reset(intValue);
+    value_.int_ = value;
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(UInt value)
+{
+    reset(uintValue);
+    value_.uint_ = value;
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(double value)
+{
+    reset(realValue);
+    value_.real_ = value;
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(bool value)
+{
+    reset(booleanValue);
+    value_.bool_ = value;
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(char const* value)
+{
+    reset(stringValue);
+    value_.string_ = arena_->copy(value).data();
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(std::string const& value)
+{
+    reset(stringValue);
+    value_.string_ = arena_->copy(value).data();
+    return *this;
+}
+
+ArenaValue&
+ArenaValue::operator=(StaticString const& value)
+{
+    reset(stringValue);
+    value_.string_ = value.c_str();
+    return *this;
+}
+
+char const*
+ArenaValue::asCString() const
+{
+    XRPL_ASSERT(
+        type_ == stringValue, "Json::ArenaValue::asCString : valid type");
+    return value_.string_;
+}
+
+std::string
+ArenaValue::asString() const
+{
+    if (type_ == stringValue)
+        return value_.string_;
+    return toValue().asString();
+}
+
+ArenaValue::Int
+ArenaValue::asInt() const
+{
+    if (type_ == intValue)
+        return value_.int_;
+    return toValue().asInt();
+}
+
+ArenaValue::UInt
+ArenaValue::asUInt() const
+{
+    if (type_ == uintValue)
+        return value_.uint_;
+    return toValue().asUInt();
+}
+
+double
+ArenaValue::asDouble() const
+{
+    if (type_ == realValue)
+        return value_.real_;
+    return toValue().asDouble();
+}
+
+bool
+ArenaValue::asBool() const
+{
+    if (type_ == booleanValue)
+        return value_.bool_;
+    return toValue().asBool();
+}
+
+ArenaValue::UInt
+ArenaValue::size() const
+{
+    switch (type_)
+    {
+        case arrayValue:
+            return value_.elements_->size();
+        case objectValue:
+            return value_.members_->size();
+        default:
+            return 0;
+    }
+}
+
+ArenaValue&
+ArenaValue::operator[](UInt index)
+{
+    XRPL_ASSERT(
+        type_ == nullValue || type_ == arrayValue,
+        "Json::ArenaValue::operator[](UInt) : valid type");
+
+    if (type_ == nullValue)
+        reset(arrayValue);
+
+    while (value_.elements_->size() <= index)
+        append();
+    return *(*value_.elements_)[index];
+}
+
+ArenaValue const&
+ArenaValue::operator[](UInt index) const
+{
+    XRPL_ASSERT(
+        type_ == nullValue || type_ == arrayValue,
+        "Json::ArenaValue::operator[](UInt) const : valid type");
+
+    if (type_ != arrayValue || index >= value_.elements_->size())
+        return null;
+    return *(*value_.elements_)[index];
+}
+
+ArenaValue&
+ArenaValue::append()
+{
+    XRPL_ASSERT(
+        type_ == nullValue || type_ == arrayValue,
+        "Json::ArenaValue::append : valid type");
+
+    if (type_ == nullValue)
+        reset(arrayValue);
+
+    auto& element = make();
+    value_.elements_->push_back(&element);
+    return element;
+}
+
+static bool
+memberLess(ArenaValue::Member const& member, std::string_view key)
+{
+    return member.name < key;
+}
+
+ArenaValue&
+ArenaValue::resolve(std::string_view key, bool isStatic)
+{
+    XRPL_ASSERT(
+        type_ == nullValue || type_ == objectValue,
+        "Json::ArenaValue::resolve : valid type");
+
+    if (type_ == nullValue)
+        reset(objectValue);
+
+    auto& members = *value_.members_;
+
+    // Members are often added in name order, so check the end first.
+    auto it = members.end();
+    if (!members.empty() && !(members.back().name < key))
+    {
+        it = std::lower_bound(
+            members.begin(), members.end(), key, memberLess);
+        if (it != members.end() && it->name == key)
+            return *it->value;
+    }
+
+    auto& value = make();
+    members.insert(
+        it, {isStatic ? key : arena_->copy(key), isStatic, &value});
+    return value;
+}
+
+ArenaValue const*
+ArenaValue::find(std::string_view key) const
+{
+    if (type_ != objectValue)
+        return nullptr;
+
+    auto const& members = *value_.members_;
+    auto const it =
+        std::lower_bound(members.begin(), members.end(), key, memberLess);
+    if (it == members.end() || it->name != key)
+        return nullptr;
+    return it->value;
+}
+
+ArenaValue&
+ArenaValue::operator[](StaticString const& key)
+{
+    return resolve(key.c_str(), true);
+}
+
+ArenaValue&
+ArenaValue::operator[](std::string const& key)
+{
+    return resolve(key, false);
+}
+
+ArenaValue&
+ArenaValue::operator[](char const* key)
+{
+    return resolve(key, false);
+}
+
+ArenaValue const&
+ArenaValue::operator[](StaticString const& key) const
+{
+    auto const value = find(key.c_str());
+    return value ? *value : null;
+}
+
+ArenaValue const&
+ArenaValue::operator[](std::string const& key) const
+{
+    auto const value = find(key);
+    return value ? *value : null;
+}
+
+ArenaValue const&
+ArenaValue::operator[](char const* key) const
+{
+    auto const value = find(key);
+    return value ? *value : null;
+}
+
+bool
+ArenaValue::isMember(std::string_view key) const
+{
+    return find(key) != nullptr;
+}
+
+bool
+ArenaValue::removeMember(std::string_view key)
+{
+    XRPL_ASSERT(
+        type_ == nullValue || type_ == objectValue,
+        "Json::ArenaValue::removeMember : valid type");
+
+    if (type_ != objectValue)
+        return false;
+
+    auto& members = *value_.members_;
+    auto const it =
+        std::lower_bound(members.begin(), members.end(), key, memberLess);
+    if (it == members.end() || it->name != key)
+        return false;
+    members.erase(it);
+    return true;
+}
+
+ArenaValue::Members const&
+ArenaValue::members() const
+{
+    XRPL_ASSERT(
+        type_ == objectValue, "Json::ArenaValue::members : valid type");
+    return *value_.members_;
+}
+
+ArenaValue::Elements const&
+ArenaValue::elements() const
+{
+    XRPL_ASSERT(
+        type_ == arrayValue, "Json::ArenaValue::elements : valid type");
+    return *value_.elements_;
+}
+
+Value
+ArenaValue::toValue() const
+{
+    switch (type_)
+    {
+        case nullValue:
+            return Value();
+        case intValue:
+            return value_.int_;
+        case uintValue:
+            return value_.uint_;
+        case realValue:
+            return value_.real_;
+        case stringValue:
+            return value_.string_;
+        case booleanValue:
+            return value_.bool_;
+        case arrayValue: {
+            Value result(arrayValue);
+            for (auto const element : *value_.elements_)
+                result.append(element->toValue());
+            return result;
+        }
+        case objectValue: {
+            Value result(objectValue);
+            for (auto const& member : *value_.members_)
+            {
+                if (member.isStatic)
+                    result[StaticString(member.name.data())] =
+                        member.value->toValue();
+                else
+                    result[std::string(member.name)] =
+                        member.value->toValue();
+            }
+            return result;
+        }
+    }
+    UNREACHABLE("Json::ArenaValue::toValue : invalid type");
+    return Value();
+}
+
+bool
+operator==(ArenaValue const& x, Value const& y)
+{
+    return x.toValue() == y;
+}
+
+std::string
+to_string(ArenaValue const& value)
+{
+    std::string s;
+    detail::write_value(
+        [&s](void const* data, std::size_t n) {
+            s.append(static_cast<char const*>(data), n);
+        },
+        value);
+    return s;
+}
+
+}  // namespace Json
@@ -22,7 +22,6 @@
 #include <xrpl/json/Writer.h>
 
 #include <cstddef>
-#include <map>
 #include <memory>
 #include <set>
 #include <stack>
@@ -34,15 +33,31 @@ namespace Json {
 
 namespace {
 
-std::map<char, char const*> jsonSpecialCharacterEscape = {
-    {'"', "\\\""},
-    {'\\', "\\\\"},
-    {'/', "\\/"},
-    {'\b', "\\b"},
-    {'\f', "\\f"},
-    {'\n', "\\n"},
-    {'\r', "\\r"},
-    {'\t', "\\t"}};
+char const*
+jsonSpecialCharacterEscape(char c)
+{
+    switch (c)
+    {
+        case '"':
+            return "\\\"";
+        case '\\':
+            return "\\\\";
+        case '/':
+            return "\\/";
+        case '\b':
+            return "\\b";
+        case '\f':
+            return "\\f";
+        case '\n':
+            return "\\n";
+        case '\r':
+            return "\\r";
+        case '\t':
+            return "\\t";
+        default:
+            return nullptr;
+    }
+}
 
 static size_t const jsonEscapeLength = 2;
 
@@ -122,14 +137,14 @@ public:
         auto data = bytes.data();
         for (; position < bytes.size(); ++position)
         {
-            auto i = jsonSpecialCharacterEscape.find(data[position]);
-            if (i != jsonSpecialCharacterEscape.end())
+            auto const escape = jsonSpecialCharacterEscape(data[position]);
+            if (escape)
             {
                 if (writtenUntil < position)
                 {
                     output_({data + writtenUntil, position - writtenUntil});
                 }
-                output_({i->second, jsonEscapeLength});
+                output_({escape, jsonEscapeLength});
                 writtenUntil = position + 1;
             };
         }
@@ -165,16 +180,17 @@ public:
     }
 
     void
-    writeObjectTag(std::string const& tag)
+    writeObjectTag(std::string_view tag)
     {
 #ifndef NDEBUG
         // Make sure we haven't already seen this tag.
         auto& tags = stack_.top().tags;
-        check(tags.find(tag) == tags.end(), "Already seen tag " + tag);
-        tags.insert(tag);
+        check(
+            tags.emplace(tag).second,
+            "Already seen tag " + std::string(tag));
 #endif
 
-        stringOutput(tag);
+        stringOutput({tag.data(), tag.size()});
         output_({&colon, 1});
     }
 
@@ -275,8 +291,33 @@ Writer::output(std::string const& s)
 void
 Writer::output(Json::Value const& value)
 {
-    impl_->markStarted();
-    outputJson(value, impl_->getOutput());
+    // Scalars are written here rather than through a second Writer.
+    switch (value.type())
+    {
+        case Json::nullValue:
+            output(nullptr);
+            return;
+        case Json::intValue:
+            output(value.asInt());
+            return;
+        case Json::uintValue:
+            output(value.asUInt());
+            return;
+        case Json::realValue:
+            output(value.asDouble());
+            return;
+        case Json::stringValue: {
+            auto const s = value.asCString();
+            impl_->stringOutput(s ? s : "");
+            return;
+        }
+        case Json::booleanValue:
+            output(value.asBool());
+            return;
+        default:
+            impl_->markStarted();
+            outputJson(value, impl_->getOutput());
+    }
 }
 
 void
@@ -325,7 +366,7 @@ Writer::rawAppend()
 }
 
 void
-Writer::rawSet(std::string const& tag)
+Writer::rawSet(std::string_view tag)
 {
     check(!tag.empty(), "Tag can't be empty");
 
@@ -347,7 +388,7 @@ Writer::startAppend(CollectionType type)
 }
 
 void
-Writer::startSet(CollectionType type, std::string const& key)
+Writer::startSet(CollectionType type, std::string_view key)
 {
     impl_->nextCollectionEntry(object, "startSet");
     impl_->writeObjectTag(key);
@@ -22,6 +22,7 @@
 #include <xrpl/basics/contract.h>
 #include <xrpl/beast/utility/Zero.h>
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STAccount.h>
@@ -126,4 +127,10 @@ STAccount::getText() const
     return toBase58(value());
 }
 
+void
+STAccount::writeJson(Json::Writer& w, JsonOptions) const
+{
+    w.output(getText());
+}
+
 }  // namespace ripple
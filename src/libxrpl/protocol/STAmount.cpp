@@ -26,6 +26,7 @@
 #include <xrpl/beast/core/LexicalCast.h>
 #include <xrpl/beast/utility/Zero.h>
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/json/json_forwards.h>
 #include <xrpl/json/json_value.h>
 #include <xrpl/protocol/AccountID.h>
@@ -799,6 +800,35 @@ STAmount::getJson(JsonOptions) const
     return elem;
 }
 
+void
+STAmount::writeJson(Json::Writer& w, JsonOptions) const
+{
+    if (native())
+        return w.output(getText());
+
+    // The same members as setJson, in name order.
+    w.startRoot(Json::Writer::object);
+    if (mAsset.holds<MPTIssue>())
+    {
+        w.rawSet(jss::mpt_issuance_id);
+        w.output(to_string(mAsset.get<MPTIssue>()));
+    }
+    else
+    {
+        auto const& issue = mAsset.get<Issue>();
+        w.rawSet(jss::currency);
+        w.output(to_string(issue.currency));
+        if (!isXRP(issue.currency))
+        {
+            w.rawSet(jss::issuer);
+            w.output(toBase58(issue.account));
+        }
+    }
+    w.rawSet(jss::value);
+    w.output(getText());
+    w.finish();
+}
+
 void
 STAmount::add(Serializer& s) const
 {
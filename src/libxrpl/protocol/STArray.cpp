@@ -19,6 +19,7 @@
 
 #include <xrpl/basics/Log.h>
 #include <xrpl/basics/contract.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/json/json_value.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STArray.h>
@@ -163,6 +164,23 @@ STArray::getJson(JsonOptions p) const
     return v;
 }
 
+void
+STArray::writeJson(Json::Writer& w, JsonOptions p) const
+{
+    w.startRoot(Json::Writer::array);
+    for (auto const& object : v_)
+    {
+        if (object.getSType() != STI_NOTPRESENT)
+        {
+            w.startAppend(Json::Writer::object);
+            w.rawSet(object.getFName().getJsonName());
+            object.writeJson(w, p);
+            w.finish();
+        }
+    }
+    w.finish();
+}
+
 void
 STArray::add(Serializer& s) const
 {
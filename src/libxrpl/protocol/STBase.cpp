@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/json/json_value.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STBase.h>
@@ -108,6 +109,12 @@ STBase::getJson(JsonOptions /*options*/) const
     return getText();
 }
 
+void
+STBase::writeJson(Json::Writer& w, JsonOptions options) const
+{
+    w.output(getJson(options));
+}
+
 void
 STBase::add(Serializer& s) const
 {
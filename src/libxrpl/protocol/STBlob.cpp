@@ -19,6 +19,7 @@
 
 #include <xrpl/basics/strHex.h>
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STBase.h>
 #include <xrpl/protocol/STBlob.h>
@@ -59,6 +60,12 @@ STBlob::getText() const
     return strHex(value_);
 }
 
+void
+STBlob::writeJson(Json::Writer& w, JsonOptions) const
+{
+    w.output(getText());
+}
+
 void
 STBlob::add(Serializer& s) const
 {
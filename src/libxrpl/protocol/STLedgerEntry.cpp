@@ -22,6 +22,7 @@
 #include <xrpl/basics/contract.h>
 #include <xrpl/basics/safe_cast.h>
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/json/to_string.h>
 #include <xrpl/protocol/Feature.h>
 #include <xrpl/protocol/Indexes.h>
@@ -145,6 +146,21 @@ STLedgerEntry::getJson(JsonOptions options) const
     return ret;
 }
 
+void
+STLedgerEntry::writeJson(Json::Writer& w, JsonOptions options) const
+{
+    std::array<JsonMember, 2> extra{{{jss::index, to_string(key_)}}};
+    std::size_t count = 1;
+
+    if (getType() == ltMPTOKEN_ISSUANCE)
+        extra[count++] = {
+            jss::mpt_issuance_id,
+            to_string(
+                makeMptID(getFieldU32(sfSequence), getAccountID(sfIssuer)))};
+
+    writeJsonObject(w, options, {extra.data(), count});
+}
+
 bool
 STLedgerEntry::isThreadedType(Rules const& rules) const
 {
@@ -23,6 +23,7 @@
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/basics/contract.h>
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/json/json_value.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Feature.h>
@@ -47,9 +48,12 @@
 #include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/detail/STVar.h>
 
+#include <boost/container/small_vector.hpp>
+
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -846,6 +850,52 @@ STObject::getJson(JsonOptions options) const
     return ret;
 }
 
+void
+STObject::writeJson(Json::Writer& w, JsonOptions options) const
+{
+    writeJsonObject(w, options, {});
+}
+
+void
+STObject::writeJsonObject(
+    Json::Writer& w,
+    JsonOptions options,
+    std::span<JsonMember const> extra) const
+{
+    struct Member
+    {
+        char const* name;
+        STBase const* field;
+        std::string const* value;
+    };
+
+    boost::container::small_vector<Member, 32> members;
+    for (auto const& elem : v_)
+    {
+        if (elem->getSType() != STI_NOTPRESENT)
+            members.push_back(
+                {elem->getFName().getJsonName().c_str(), &elem.get(), nullptr});
+    }
+    for (auto const& member : extra)
+        members.push_back({member.name, nullptr, &member.value});
+
+    // Json::Value keeps its members sorted by name.
+    std::sort(members.begin(), members.end(), [](auto const& a, auto const& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+
+    w.startRoot(Json::Writer::object);
+    for (auto const& member : members)
+    {
+        w.rawSet(member.name);
+        if (member.field)
+            member.field->writeJson(w, options);
+        else
+            w.output(*member.value);
+    }
+    w.finish();
+}
+
 bool
 STObject::operator==(STObject const& obj) const
 {
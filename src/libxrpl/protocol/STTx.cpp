@@ -28,6 +28,7 @@
 #include <xrpl/basics/strHex.h>
 #include <xrpl/beast/utility/Zero.h>
 #include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/Writer.h>
 #include <xrpl/json/json_value.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Batch.h>
@@ -338,6 +339,16 @@ STTx::getJson(JsonOptions options, bool binary) const
     return ret;
 }
 
+void
+STTx::writeJson(Json::Writer& w, JsonOptions options) const
+{
+    if (options & JsonOptions::disable_API_prior_V2)
+        return writeJsonObject(w, JsonOptions::none, {});
+
+    JsonMember const hash{jss::hash, to_string(getTransactionID())};
+    writeJsonObject(w, JsonOptions::none, {&hash, 1});
+}
+
 std::string const&
 STTx::getMetaSQLInsertReplaceHeader()
 {
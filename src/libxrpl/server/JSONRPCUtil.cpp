@@ -97,6 +97,17 @@ HTTPReply(
         return;
     }
 
+    HTTPReplyHeaders(nStatus, content.size() + 2, output);
+    output(content);
+    output("\r\n");
+}
+
+void
+HTTPReplyHeaders(
+    int nStatus,
+    std::size_t contentLength,
+    Json::Output const& output)
+{
     switch (nStatus)
     {
         case 200:
@@ -144,7 +155,7 @@ HTTPReply(
     // if (context.app.config().RPC_ALLOW_REMOTE)
     //    output ("Access-Control-Allow-Origin: *\r\n");
 
-    output(std::to_string(content.size() + 2));
+    output(std::to_string(contentLength));
     output(
         "\r\n"
         "Content-Type: application/json; charset=UTF-8\r\n");
@@ -154,8 +165,6 @@ HTTPReply(
     output(
         "\r\n"
         "\r\n");
-    output(content);
-    output("\r\n");
 }
 
 }  // namespace ripple
@@ -0,0 +1,515 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/unit_test/SuiteJournal.h>
+
+#include <xrpld/app/main/DBInit.h>
+#include <xrpld/app/rdb/backend/detail/Node.h>
+#include <xrpld/core/SociDB.h>
+
+#include <xrpl/basics/StringUtilities.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/utility/rngfill.h>
+#include <xrpl/beast/xor_shift_engine.h>
+#include <xrpl/protocol/AccountID.h>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace ripple {
+namespace test {
+
+namespace {
+
+// The layout of the account transactions table before it stored keys as
+// raw bytes.
+constexpr std::array<char const*, 4> legacyTxDBInit{
+    {"CREATE TABLE AccountTransactions (                \
+        TransID     CHARACTER(64),                      \
+        Account     CHARACTER(64),                      \
+        LedgerSeq   BIGINT UNSIGNED,                    \
+        TxnSeq      INTEGER                             \
+    );",
+     "CREATE INDEX AcctTxIDIndex ON                     \
+        AccountTransactions(TransID);",
+     "CREATE INDEX AcctTxIndex ON                       \
+        AccountTransactions(Account, LedgerSeq, TxnSeq, TransID);",
+     "CREATE INDEX AcctLgrIndex ON                      \
+        AccountTransactions(LedgerSeq, Account, TransID);"}};
+
+struct Row
+{
+    uint256 txID;
+    AccountID account;
+    LedgerIndex ledgerSeq;
+    std::uint32_t txnSeq;
+};
+
+template <std::size_t N>
+void
+execute(soci::session& session, std::array<char const*, N> const& sql)
+{
+    for (auto const& s : sql)
+    {
+        soci::statement st = session.prepare << s;
+        st.execute(true);
+    }
+}
+
+std::unique_ptr<soci::session>
+makeSession(bool current, bool legacy)
+{
+    auto session = std::make_unique<soci::session>();
+    open(*session, "sqlite", ":memory:");
+    if (current)
+        execute(*session, TxDBInit);
+    if (legacy)
+        execute(*session, legacyTxDBInit);
+    return session;
+}
+
+// Write a row the way saveValidatedLedger did before the binary layout.
+void
+insertLegacy(soci::session& session, Row const& row)
+{
+    session << boost::str(
+        boost::format("INSERT INTO AccountTransactions "
+                      "(TransID, Account, LedgerSeq, TxnSeq) "
+                      "VALUES ('%s','%s',%u,%u);") %
+        to_string(row.txID) % toBase58(row.account) % row.ledgerSeq %
+        row.txnSeq);
+}
+
+// The raw transaction is the ID, so pages can be checked by ID.
+void
+insertTransaction(soci::session& session, uint256 const& txID, LedgerIndex seq)
+{
+    session << boost::str(
+        boost::format("INSERT OR REPLACE INTO Transactions "
+                      "(TransID, LedgerSeq, Status, RawTxn, TxnMeta) "
+                      "VALUES ('%s', %u, 'V', X'%s', X'00');") %
+        to_string(txID) % seq % strHex(txID));
+}
+
+std::size_t
+databaseBytes(soci::session& session)
+{
+    std::size_t pages = 0;
+    std::size_t pageSize = 0;
+    session << "PRAGMA page_count;", soci::into(pages);
+    session << "PRAGMA page_size;", soci::into(pageSize);
+    return pages * pageSize;
+}
+
+}  // namespace
+
+class AccountTransactions_test : public beast::unit_test::suite
+{
+    AccountID const alice{1};
+    AccountID const bob{2};
+    AccountID const carol{3};
+
+    // Ledgers 10 through 39 with three transactions each. Every transaction
+    // affects alice, most affect bob and those in even ledgers affect carol.
+    std::vector<Row>
+    makeRows() const
+    {
+        std::vector<Row> rows;
+        for (LedgerIndex seq = 10; seq < 40; ++seq)
+        {
+            for (std::uint32_t txnSeq = 0; txnSeq < 3; ++txnSeq)
+            {
+                uint256 const txID{seq * 100 + txnSeq};
+                rows.push_back({txID, alice, seq, txnSeq});
+                if (txnSeq != 1)
+                    rows.push_back({txID, bob, seq, txnSeq});
+                if (seq % 2 == 0)
+                    rows.push_back({txID, carol, seq, txnSeq});
+            }
+        }
+        return rows;
+    }
+
+    static std::vector<uint256>
+    expected(std::vector<Row> const& rows, AccountID const& account)
+    {
+        std::vector<Row> matching;
+        std::copy_if(
+            rows.begin(),
+            rows.end(),
+            std::back_inserter(matching),
+            [&account](Row const& row) { return row.account == account; });
+        std::sort(matching.begin(), matching.end(), [](auto& a, auto& b) {
+            return std::tie(a.ledgerSeq, a.txnSeq) <
+                std::tie(b.ledgerSeq, b.txnSeq);
+        });
+
+        std::vector<uint256> ids;
+        for (auto const& row : matching)
+            ids.push_back(row.txID);
+        return ids;
+    }
+
+    // Read every page of an account's transactions.
+    std::vector<uint256>
+    readPages(
+        soci::session& session,
+        AccountID const& account,
+        bool forward,
+        std::uint32_t pageLength)
+    {
+        std::vector<uint256> ids;
+        auto const onTransaction =
+            [&ids](std::uint32_t, std::string const&, Blob&& raw, Blob&&) {
+                if (raw.size() == uint256::size())
+                    ids.push_back(uint256::fromVoid(raw.data()));
+            };
+
+        std::optional<RelationalDatabase::AccountTxMarker> marker;
+        for (int pages = 0; pages < 1000; ++pages)
+        {
+            RelationalDatabase::AccountTxPageOptions const options{
+                account, 0, 1000, marker, pageLength, true};
+            auto const page = forward
+                ? detail::oldestAccountTxPage(
+                      session,
+                      [](std::uint32_t) {},
+                      onTransaction,
+                      options,
+                      pageLength)
+                : detail::newestAccountTxPage(
+                      session,
+                      [](std::uint32_t) {},
+                      onTransaction,
+                      options,
+                      pageLength);
+            marker = page.first;
+            if (!marker)
+                break;
+        }
+        return ids;
+    }
+
+    void
+    expectPages(soci::session& session, std::vector<Row> const& rows)
+    {
+        for (auto const& account : {alice, bob, carol})
+        {
+            auto const oldest = expected(rows, account);
+            auto newest = oldest;
+            std::reverse(newest.begin(), newest.end());
+            for (std::uint32_t pageLength : {1, 4, 200})
+            {
+                BEAST_EXPECT(
+                    readPages(session, account, true, pageLength) == oldest);
+                BEAST_EXPECT(
+                    readPages(session, account, false, pageLength) == newest);
+            }
+        }
+    }
+
+    void
+    testWriter()
+    {
+        testcase("writer");
+
+        using namespace detail;
+
+        auto const session = makeSession(true, false);
+        auto rows = makeRows();
+        {
+            soci::transaction tr(*session);
+            AccountTransactionWriter writer(*session);
+            for (auto const& row : rows)
+            {
+                insertTransaction(*session, row.txID, row.ledgerSeq);
+                writer.insert(
+                    row.txID, row.account, row.ledgerSeq, row.txnSeq);
+            }
+            tr.commit();
+        }
+
+        BEAST_EXPECT(!hasLegacyAccountTransactions(*session));
+        BEAST_EXPECT(
+            getRows(*session, TableType::AccountTransactions) == rows.size());
+        BEAST_EXPECT(
+            getMinLedgerSeq(*session, TableType::AccountTransactions) == 10);
+        BEAST_EXPECT(
+            getMaxLedgerSeq(*session, TableType::AccountTransactions) == 39);
+        expectPages(*session, rows);
+
+        // Keys are stored as raw bytes.
+        std::size_t txIDBytes = 0;
+        std::size_t accountBytes = 0;
+        *session << "SELECT length(TransID), length(Account) "
+                    "FROM AccountTransactionsV2 LIMIT 1;",
+            soci::into(txIDBytes), soci::into(accountBytes);
+        BEAST_EXPECT(txIDBytes == 32);
+        BEAST_EXPECT(accountBytes == 20);
+
+        {
+            AccountTransactionWriter writer(*session);
+            writer.deleteTransaction(uint256{1000});
+            writer.deleteLedger(39);
+        }
+        std::erase_if(rows, [](Row const& row) {
+            return row.txID == uint256{1000} || row.ledgerSeq == 39;
+        });
+        BEAST_EXPECT(
+            getRows(*session, TableType::AccountTransactions) == rows.size());
+        BEAST_EXPECT(
+            getMaxLedgerSeq(*session, TableType::AccountTransactions) == 38);
+        expectPages(*session, rows);
+    }
+
+    void
+    testMigration()
+    {
+        testcase("migration");
+
+        using namespace detail;
+
+        SuiteJournal journal("AccountTransactions_test", *this);
+        auto const session = makeSession(true, true);
+        auto rows = makeRows();
+
+        // Older ledgers were written before the upgrade.
+        std::size_t legacyRows = 0;
+        {
+            soci::transaction tr(*session);
+            AccountTransactionWriter writer(*session);
+            for (auto const& row : rows)
+            {
+                insertTransaction(*session, row.txID, row.ledgerSeq);
+                if (row.ledgerSeq < 25)
+                {
+                    insertLegacy(*session, row);
+                    ++legacyRows;
+                }
+                else
+                    writer.insert(
+                        row.txID, row.account, row.ledgerSeq, row.txnSeq);
+            }
+            tr.commit();
+        }
+
+        BEAST_EXPECT(hasLegacyAccountTransactions(*session));
+        BEAST_EXPECT(
+            getRows(*session, TableType::AccountTransactions) == rows.size());
+        BEAST_EXPECT(
+            getMinLedgerSeq(*session, TableType::AccountTransactions) == 10);
+        BEAST_EXPECT(
+            getMaxLedgerSeq(*session, TableType::AccountTransactions) == 39);
+        expectPages(*session, rows);
+
+        // Saving a ledger again replaces its rows in either table.
+        {
+            AccountTransactionWriter writer(*session);
+            writer.deleteLedger(12);
+            writer.deleteTransaction(uint256{1301});
+            for (auto const& row : rows)
+            {
+                if (row.ledgerSeq == 12)
+                    writer.insert(
+                        row.txID, row.account, row.ledgerSeq, row.txnSeq);
+            }
+        }
+        std::erase_if(
+            rows, [](Row const& row) { return row.txID == uint256{1301}; });
+        BEAST_EXPECT(
+            getRows(*session, TableType::AccountTransactions) == rows.size());
+        expectPages(*session, rows);
+
+        // A row that can't be parsed is dropped rather than stopping the
+        // migration.
+        *session << "INSERT INTO AccountTransactions "
+                    "(TransID, Account, LedgerSeq, TxnSeq) "
+                    "VALUES ('XYZ', 'notAnAccount', 5, 0);";
+
+        int batches = 0;
+        while (!migrateAccountTransactions(*session, 7, journal))
+        {
+            if (!BEAST_EXPECT(++batches < 1000))
+                break;
+        }
+        BEAST_EXPECT(batches > 1);
+
+        BEAST_EXPECT(!hasLegacyAccountTransactions(*session));
+        BEAST_EXPECT(
+            getRows(*session, TableType::AccountTransactions) == rows.size());
+        expectPages(*session, rows);
+
+        // Once done, further calls do nothing.
+        BEAST_EXPECT(migrateAccountTransactions(*session, 7, journal));
+
+        deleteBeforeLedgerSeq(*session, TableType::AccountTransactions, 20);
+        std::erase_if(rows, [](Row const& row) { return row.ledgerSeq < 20; });
+        BEAST_EXPECT(
+            getMinLedgerSeq(*session, TableType::AccountTransactions) == 20);
+        expectPages(*session, rows);
+    }
+
+public:
+    void
+    run() override
+    {
+        testWriter();
+        testMigration();
+    }
+};
+
+// Compares the cost of writing account transactions as concatenated text
+// with the prepared, binary writer.
+class AccountTransactionsWrite_test : public beast::unit_test::suite
+{
+    static constexpr int ledgers = 500;
+    static constexpr int transactions = 100;
+    static constexpr int accounts = 3;
+
+    using Ledger = std::vector<std::pair<uint256, std::vector<AccountID>>>;
+
+    static std::vector<Ledger>
+    makeLedgers()
+    {
+        beast::xor_shift_engine rng(19);
+        std::vector<AccountID> pool(1000);
+        for (auto& account : pool)
+            beast::rngfill(account.begin(), account.size(), rng);
+
+        std::vector<Ledger> result(ledgers);
+        for (auto& ledger : result)
+        {
+            ledger.resize(transactions);
+            for (auto& [txID, affected] : ledger)
+            {
+                beast::rngfill(txID.begin(), txID.size(), rng);
+                for (int i = 0; i < accounts; ++i)
+                    affected.push_back(pool[rng() % pool.size()]);
+            }
+        }
+        return result;
+    }
+
+    static void
+    writeText(soci::session& session, LedgerIndex seq, Ledger const& ledger)
+    {
+        soci::transaction tr(session);
+        session << boost::str(
+            boost::format(
+                "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;") %
+            seq);
+
+        std::uint32_t txnSeq = 0;
+        for (auto const& [txID, affected] : ledger)
+        {
+            std::string const txnId(to_string(txID));
+            session << boost::str(
+                boost::format(
+                    "DELETE FROM AccountTransactions WHERE TransID = '%s';") %
+                txnId);
+
+            std::string sql(
+                "INSERT INTO AccountTransactions "
+                "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
+            bool first = true;
+            for (auto const& account : affected)
+            {
+                sql += first ? "('" : ", ('";
+                first = false;
+                sql += txnId;
+                sql += "','";
+                sql += toBase58(account);
+                sql += "',";
+                sql += std::to_string(seq);
+                sql += ",";
+                sql += std::to_string(txnSeq);
+                sql += ")";
+            }
+            session << sql + ";";
+            ++txnSeq;
+        }
+        tr.commit();
+    }
+
+    static void
+    writeBinary(soci::session& session, LedgerIndex seq, Ledger const& ledger)
+    {
+        soci::transaction tr(session);
+        detail::AccountTransactionWriter writer(session);
+        writer.deleteLedger(seq);
+
+        std::uint32_t txnSeq = 0;
+        for (auto const& [txID, affected] : ledger)
+        {
+            writer.deleteTransaction(txID);
+            for (auto const& account : affected)
+                writer.insert(txID, account, seq, txnSeq);
+            ++txnSeq;
+        }
+        tr.commit();
+    }
+
+    template <class Write>
+    void
+    measure(
+        char const* name,
+        soci::session& session,
+        std::vector<Ledger> const& data,
+        Write write)
+    {
+        using namespace std::chrono;
+
+        auto const start = steady_clock::now();
+        LedgerIndex seq = 1;
+        for (auto const& ledger : data)
+            write(session, seq++, ledger);
+        auto const us =
+            duration_cast<microseconds>(steady_clock::now() - start).count();
+
+        std::size_t const rows = ledgers * transactions * accounts;
+        log << name << ": " << us / ledgers << " us per ledger, "
+            << databaseBytes(session) / rows << " bytes per row" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("write cost");
+
+        auto const data = makeLedgers();
+        {
+            auto const session = makeSession(false, true);
+            measure("text", *session, data, &writeText);
+        }
+        {
+            auto const session = makeSession(true, false);
+            measure("binary", *session, data, &writeBinary);
+        }
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AccountTransactions, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(AccountTransactionsWrite, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,439 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/unit_test/SuiteJournal.h>
+
+#include <xrpld/app/main/DBInit.h>
+#include <xrpld/app/rdb/backend/detail/AccountTxIndex.h>
+#include <xrpld/app/rdb/backend/detail/Node.h>
+#include <xrpld/core/SociDB.h>
+
+#include <xrpl/basics/StringUtilities.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/utility/temp_dir.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/TxMeta.h>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+
+namespace ripple {
+namespace test {
+
+class AccountTxIndex_test : public beast::unit_test::suite
+{
+    using AccountTxIndex = detail::AccountTxIndex;
+    using Ledgers = std::map<LedgerIndex, std::vector<AccountTxIndex::Entry>>;
+
+    struct Page
+    {
+        std::vector<uint256> ids;
+        std::optional<RelationalDatabase::AccountTxMarker> marker;
+
+        bool
+        operator==(Page const& other) const
+        {
+            return ids == other.ids &&
+                marker.has_value() == other.marker.has_value() &&
+                (!marker ||
+                 (marker->ledgerSeq == other.marker->ledgerSeq &&
+                  marker->txnSeq == other.marker->txnSeq));
+        }
+    };
+
+    AccountID const alice{1};
+    AccountID const bob{2};
+    AccountID const carol{3};
+
+    // Ledgers 10 through 39 with three transactions each. Every transaction
+    // affects alice, most affect bob and those in even ledgers affect carol.
+    Ledgers
+    makeLedgers() const
+    {
+        Ledgers ledgers;
+        for (LedgerIndex seq = 10; seq < 40; ++seq)
+        {
+            auto& entries = ledgers[seq];
+            for (std::uint32_t txnSeq = 0; txnSeq < 3; ++txnSeq)
+            {
+                uint256 const txID{seq * 100 + txnSeq};
+                entries.push_back({alice, seq, txnSeq, txID});
+                if (txnSeq != 1)
+                    entries.push_back({bob, seq, txnSeq, txID});
+                if (seq % 2 == 0)
+                    entries.push_back({carol, seq, txnSeq, txID});
+            }
+        }
+        return ledgers;
+    }
+
+    static std::vector<uint256>
+    expected(Ledgers const& ledgers, AccountID const& account, bool forward)
+    {
+        std::vector<uint256> ids;
+        for (auto const& [seq, entries] : ledgers)
+        {
+            for (auto const& e : entries)
+            {
+                if (e.account == account)
+                    ids.push_back(e.txID);
+            }
+        }
+        if (!forward)
+            std::reverse(ids.begin(), ids.end());
+        return ids;
+    }
+
+    static std::vector<uint256>
+    read(
+        AccountTxIndex const& index,
+        AccountID const& account,
+        bool forward,
+        LedgerIndex minLedger = 0,
+        LedgerIndex maxLedger = 1000,
+        std::optional<AccountTxIndex::Position> start = {})
+    {
+        std::vector<uint256> ids;
+        index.forEach(
+            account,
+            minLedger,
+            maxLedger,
+            start,
+            forward,
+            [&ids](AccountTxIndex::Entry const& e) {
+                ids.push_back(e.txID);
+                return true;
+            });
+        return ids;
+    }
+
+    void
+    expectIndex(AccountTxIndex const& index, Ledgers const& ledgers)
+    {
+        for (auto const& account : {alice, bob, carol})
+        {
+            BEAST_EXPECT(
+                read(index, account, true) == expected(ledgers, account, true));
+            BEAST_EXPECT(
+                read(index, account, false) ==
+                expected(ledgers, account, false));
+        }
+    }
+
+    // The metadata of a transaction that modified each account's root.
+    static Blob
+    makeMeta(
+        uint256 const& txID,
+        LedgerIndex seq,
+        std::uint32_t txnSeq,
+        std::vector<AccountID> const& accounts)
+    {
+        TxMeta meta(txID, seq);
+        for (auto const& account : accounts)
+        {
+            auto const sle = std::make_shared<SLE>(keylet::account(account));
+            STObject finals(sfFinalFields);
+            finals.emplace_back(STAccount(sfAccount, account));
+            meta.getAffectedNode(sle, sfModifiedNode)
+                .emplace_back(std::move(finals));
+        }
+
+        Serializer s;
+        meta.addRaw(s, tesSUCCESS, txnSeq);
+        return s.peekData();
+    }
+
+    // The raw transaction is the ID, so pages can be checked by ID.
+    static void
+    insertTransaction(
+        soci::session& session,
+        uint256 const& txID,
+        LedgerIndex seq,
+        Blob const& meta)
+    {
+        session << boost::str(
+            boost::format("INSERT OR REPLACE INTO Transactions "
+                          "(TransID, LedgerSeq, Status, RawTxn, TxnMeta) "
+                          "VALUES ('%s', %u, 'V', X'%s', X'%s');") %
+            to_string(txID) % seq % strHex(txID) % strHex(meta));
+    }
+
+    // Read every page of an account's transactions, from the table or the
+    // index.
+    std::vector<Page>
+    readPages(
+        soci::session& session,
+        AccountTxIndex const* index,
+        AccountID const& account,
+        bool forward,
+        std::uint32_t pageLength)
+    {
+        std::vector<Page> pages;
+        auto const onTransaction =
+            [&pages](std::uint32_t, std::string const&, Blob&& raw, Blob&&) {
+                if (raw.size() == uint256::bytes)
+                    pages.back().ids.push_back(uint256::fromVoid(raw.data()));
+            };
+        auto const onUnsavedLedger = [](std::uint32_t) {};
+
+        std::optional<RelationalDatabase::AccountTxMarker> marker;
+        do
+        {
+            pages.emplace_back();
+            RelationalDatabase::AccountTxPageOptions const options{
+                account, 0, 1000, marker, pageLength, true};
+            if (index)
+                marker = forward ? detail::oldestAccountTxPage(
+                                       session,
+                                       *index,
+                                       onUnsavedLedger,
+                                       onTransaction,
+                                       options,
+                                       pageLength)
+                                       .first
+                                 : detail::newestAccountTxPage(
+                                       session,
+                                       *index,
+                                       onUnsavedLedger,
+                                       onTransaction,
+                                       options,
+                                       pageLength)
+                                       .first;
+            else
+                marker = forward ? detail::oldestAccountTxPage(
+                                       session,
+                                       onUnsavedLedger,
+                                       onTransaction,
+                                       options,
+                                       pageLength)
+                                       .first
+                                 : detail::newestAccountTxPage(
+                                       session,
+                                       onUnsavedLedger,
+                                       onTransaction,
+                                       options,
+                                       pageLength)
+                                       .first;
+            pages.back().marker = marker;
+        } while (marker && pages.size() < 1000);
+        return pages;
+    }
+
+    void
+    testIndex(bool onDisk)
+    {
+        testcase(onDisk ? "on disk" : "in memory");
+
+        SuiteJournal journal("AccountTxIndex_test", *this);
+        beast::temp_dir dir;
+
+        AccountTxIndex::Setup setup;
+        if (onDisk)
+            setup.path = dir.file("index");
+        setup.memtableEntries = 16;
+        setup.fanout = 3;
+
+        auto ledgers = makeLedgers();
+        auto index = std::make_unique<AccountTxIndex>(setup, journal);
+        BEAST_EXPECT(!index->built());
+        BEAST_EXPECT(!index->minLedgerSeq());
+
+        for (auto const& [seq, entries] : ledgers)
+            index->saveLedger(seq, entries);
+
+        BEAST_EXPECT(index->segments() >= setup.fanout);
+        BEAST_EXPECT(index->needsCompaction());
+        BEAST_EXPECT(index->minLedgerSeq() == 10);
+        BEAST_EXPECT(index->maxLedgerSeq() == 39);
+        expectIndex(*index, ledgers);
+
+        {
+            // A range, starting part way through a ledger.
+            auto const ids = read(
+                *index, bob, true, 20, 25, AccountTxIndex::Position{20, 2});
+            BEAST_EXPECT(ids.size() == 11);
+            BEAST_EXPECT(ids.front() == uint256{2002});
+            BEAST_EXPECT(ids.back() == uint256{2502});
+        }
+        {
+            auto const ids = read(
+                *index, bob, false, 20, 25, AccountTxIndex::Position{25, 0});
+            BEAST_EXPECT(ids.size() == 11);
+            BEAST_EXPECT(ids.front() == uint256{2500});
+            BEAST_EXPECT(ids.back() == uint256{2000});
+        }
+
+        // Saving a ledger again replaces its entries, including those
+        // already written to a segment.
+        ledgers[12] = {{alice, 12, 0, uint256{1200}}};
+        index->saveLedger(12, ledgers[12]);
+        ledgers[39].clear();
+        index->saveLedger(39, ledgers[39]);
+        expectIndex(*index, ledgers);
+
+        while (index->compact())
+            ;
+        BEAST_EXPECT(!index->needsCompaction());
+        expectIndex(*index, ledgers);
+
+        index->deleteBefore(20);
+        std::erase_if(ledgers, [](auto const& l) { return l.first < 20; });
+        BEAST_EXPECT(index->minLedgerSeq() == 20);
+        expectIndex(*index, ledgers);
+
+        index->setBuilt(true);
+        BEAST_EXPECT(index->built());
+
+        if (!onDisk)
+            return;
+
+        // Ledgers not yet in a segment are replayed from the log.
+        ledgers[40] = {{carol, 40, 0, uint256{4000}}};
+        index->saveLedger(40, ledgers[40]);
+        index.reset();
+
+        index = std::make_unique<AccountTxIndex>(setup, journal);
+        BEAST_EXPECT(index->built());
+        BEAST_EXPECT(index->minLedgerSeq() == 20);
+        BEAST_EXPECT(index->maxLedgerSeq() == 40);
+        expectIndex(*index, ledgers);
+    }
+
+    void
+    testPages()
+    {
+        testcase("pages");
+
+        SuiteJournal journal("AccountTxIndex_test", *this);
+        auto const session = std::make_unique<soci::session>();
+        open(*session, "sqlite", ":memory:");
+        for (auto const& sql : TxDBInit)
+        {
+            soci::statement st = session->prepare << sql;
+            st.execute(true);
+        }
+
+        auto ledgers = makeLedgers();
+        {
+            soci::transaction tr(*session);
+            detail::AccountTransactionWriter writer(*session);
+            for (auto const& [seq, entries] : ledgers)
+            {
+                std::map<std::uint32_t, std::vector<AccountID>> affected;
+                for (auto const& e : entries)
+                {
+                    affected[e.txnSeq].push_back(e.account);
+                    writer.insert(e.txID, e.account, e.ledgerSeq, e.txnSeq);
+                }
+                for (auto const& [txnSeq, accounts] : affected)
+                {
+                    uint256 const txID{seq * 100 + txnSeq};
+                    insertTransaction(
+                        *session,
+                        txID,
+                        seq,
+                        makeMeta(txID, seq, txnSeq, accounts));
+                }
+            }
+            tr.commit();
+        }
+
+        // The index is built from the metadata in the Transactions table,
+        // one range of ledgers at a time.
+        AccountTxIndex index(AccountTxIndex::Setup{}, journal);
+        auto const first =
+            detail::indexAccountTransactions(*session, index, 0, 24, journal);
+        BEAST_EXPECT(first == 15);
+        BEAST_EXPECT(
+            first +
+                detail::indexAccountTransactions(
+                    *session, index, 24, 100, journal) ==
+            ledgers.size());
+        expectIndex(index, ledgers);
+        BEAST_EXPECT(
+            detail::indexAccountTransactions(
+                *session, index, 39, 100, journal) == 0);
+
+        // An offset skips entries in the index, as it skips table rows.
+        for (bool forward : {true, false})
+        {
+            auto const all = expected(ledgers, bob, forward);
+            RelationalDatabase::AccountTxOptions const options{
+                bob, 0, 1000, 3, 5, true};
+            auto const txs = forward
+                ? detail::getOldestAccountTxsB(*session, index, options).first
+                : detail::getNewestAccountTxsB(*session, index, options).first;
+            BEAST_EXPECT(txs.size() == 5);
+            for (std::size_t i = 0; i < txs.size(); ++i)
+            {
+                auto const& raw = std::get<0>(txs[i]);
+                BEAST_EXPECT(
+                    raw.size() == uint256::bytes &&
+                    uint256::fromVoid(raw.data()) == all[i + 3]);
+            }
+        }
+
+        // Pages and markers are the same as those read from the table.
+        for (auto const& account : {alice, bob, carol})
+        {
+            for (std::uint32_t pageLength : {1, 4, 200})
+            {
+                for (bool forward : {true, false})
+                {
+                    auto const pages = readPages(
+                        *session, &index, account, forward, pageLength);
+                    BEAST_EXPECT(
+                        pages ==
+                        readPages(
+                            *session, nullptr, account, forward, pageLength));
+
+                    std::vector<uint256> ids;
+                    for (auto const& page : pages)
+                        ids.insert(ids.end(), page.ids.begin(), page.ids.end());
+                    BEAST_EXPECT(ids == expected(ledgers, account, forward));
+                }
+            }
+        }
+
+        // A transaction saved again in a later ledger is only found there,
+        // even though its old entry is still in the index.
+        insertTransaction(
+            *session, uint256{1000}, 40, makeMeta(uint256{1000}, 40, 0, {}));
+        index.saveLedger(40, {{alice, 40, 0, uint256{1000}}});
+        auto const pages = readPages(*session, &index, alice, true, 200);
+        BEAST_EXPECT(pages.size() == 1);
+        BEAST_EXPECT(pages.front().ids.front() == uint256{1001});
+        BEAST_EXPECT(pages.front().ids.back() == uint256{1000});
+    }
+
+public:
+    void
+    run() override
+    {
+        testIndex(false);
+        testIndex(true);
+        testPages();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AccountTxIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -23,6 +23,10 @@
 #include <xrpl/basics/chrono.h>
 #include <xrpl/beast/unit_test.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace ripple {
 namespace test {
 
@@ -270,6 +274,91 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testShards()
+    {
+        testcase("Shards");
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(getSetup(2s, 1s), stopwatch);
+
+        // Enough keys to land in every shard
+        std::vector<uint256> keys;
+        for (std::uint64_t i = 1; i <= 16 * HashRouter::shardCount; ++i)
+            keys.emplace_back(i);
+
+        for (auto const& key : keys)
+            BEAST_EXPECT(router.setFlags(key, HashRouterFlags::SAVED));
+
+        ++stopwatch;
+        // Only the even keys are accessed
+        for (std::size_t i = 0; i < keys.size(); i += 2)
+            BEAST_EXPECT(router.getFlags(keys[i]) == HashRouterFlags::SAVED);
+
+        ++stopwatch;
+        // The odd keys expire whether or not their shard has been swept
+        bool expected = true;
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            auto const flags = router.getFlags(keys[i]);
+            expected = expected &&
+                (flags ==
+                 (i % 2 == 0 ? HashRouterFlags::SAVED
+                             : HashRouterFlags::UNDEFINED));
+        }
+        BEAST_EXPECT(expected);
+    }
+
+    void
+    testConcurrency()
+    {
+        testcase("Concurrency");
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(getSetup(50s, 10s), stopwatch);
+
+        // Each peer receives every message; only one sees it first, and
+        // only one relays it.
+        std::size_t const peers = 8;
+        std::size_t const messages = 5000;
+        std::atomic<std::size_t> created{0};
+        std::atomic<std::size_t> relayed{0};
+        std::atomic<std::size_t> skipped{0};
+
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < peers; ++p)
+        {
+            threads.emplace_back([&, p] {
+                auto const peer = static_cast<HashRouter::PeerShortID>(p + 1);
+                for (std::uint64_t i = 0; i < messages; ++i)
+                {
+                    uint256 const key{i + 1};
+                    if (router.addSuppressionPeer(key, peer))
+                        ++created;
+                    if (auto const toSkip = router.shouldRelay(key))
+                    {
+                        ++relayed;
+                        skipped += toSkip->size();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        BEAST_EXPECT(created == messages);
+        BEAST_EXPECT(relayed == messages);
+
+        // Every peer was recorded, either in the set released by the relay
+        // or in the set left for the next one.
+        for (std::uint64_t i = 0; i < messages; ++i)
+            router.addSuppressionPeer(uint256{i + 1}, 0);
+        stopwatch.advance(10s);
+        for (std::uint64_t i = 0; i < messages; ++i)
+            skipped += router.shouldRelay(uint256{i + 1})->size();
+        BEAST_EXPECT(skipped == peers * messages);
+    }
+
     void
     testSetup()
     {
@@ -418,6 +507,8 @@ public:
         testSetFlags();
         testRelay();
         testProcess();
+        testShards();
+        testConcurrency();
         testSetup();
         testFlagsOps();
     }
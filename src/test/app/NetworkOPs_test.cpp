@@ -21,6 +21,7 @@
 #include <test/jtx/CaptureLogs.h>
 #include <test/jtx/Env.h>
 
+#include <xrpld/app/misc/CanonicalTXSet.h>
 #include <xrpld/app/misc/HashRouter.h>
 
 namespace ripple {
@@ -33,6 +34,7 @@ public:
     run() override
     {
         testAllBadHeldTransactions();
+        testBatchChecks();
     }
 
     void
@@ -72,6 +74,87 @@ public:
         BEAST_EXPECT(
             logs.find("No transaction to process!") != std::string::npos);
     }
+
+    void
+    testBatchChecks()
+    {
+        // Large batches are preflighted and preclaimed across several threads
+        // before being applied in canonical order.
+        testcase("Batch checks");
+
+        using namespace jtx;
+        Env env{*this};
+        auto const alice = Account{"alice"};
+        auto const bob = Account{"bob"};
+        auto const carol = Account{"carol"};
+        env.fund(XRP(10000), alice, bob, carol);
+        env.close();
+
+        auto const aliceSeq = env.seq(alice);
+        auto const bobSeq = env.seq(bob);
+
+        int const perAccount = 40;
+        CanonicalTXSet set(env.closed()->info().hash);
+        for (int i = 0; i < perAccount; ++i)
+        {
+            set.insert(
+                env.jt(pay(alice, carol, XRP(1)), seq(aliceSeq + i)).stx);
+            set.insert(env.jt(pay(bob, carol, XRP(1)), seq(bobSeq + i)).stx);
+        }
+        // An invalid transaction fails its checks without affecting the rest.
+        set.insert(env.jt(pay(carol, carol, XRP(1))).stx);
+
+        env.app().getOPs().processTransactionSet(set);
+
+        BEAST_EXPECT(env.seq(alice) == aliceSeq + perAccount);
+        BEAST_EXPECT(env.seq(bob) == bobSeq + perAccount);
+
+        auto const counter = [&env](Json::StaticString const& key) {
+            auto const result = env.rpc("get_counts")[jss::result];
+            return std::stoull(result[key].asString());
+        };
+
+        auto const result = env.rpc("get_counts")[jss::result];
+        BEAST_EXPECT(result[jss::status] == "success");
+        for (auto const& key :
+             {jss::tx_batches,
+              jss::tx_batch_transactions,
+              jss::tx_batch_parallel_us,
+              jss::tx_batch_serial_us,
+              jss::tx_batch_preclaim_reused})
+            BEAST_EXPECT(result.isMember(key));
+        BEAST_EXPECT(counter(jss::tx_batches) > 0);
+        BEAST_EXPECT(
+            counter(jss::tx_batch_transactions) >= 2 * perAccount + 1);
+
+        env.close();
+        BEAST_EXPECT(env.seq(alice) == aliceSeq + perAccount);
+
+        // Transactions that read nothing written by the ones applied
+        // before them keep their preclaim results.
+        std::vector<Account> senders;
+        std::vector<Account> receivers;
+        for (int i = 0; i < 20; ++i)
+        {
+            senders.emplace_back("sender" + std::to_string(i));
+            receivers.emplace_back("receiver" + std::to_string(i));
+            env.fund(XRP(1000), senders.back(), receivers.back());
+        }
+        env.close();
+
+        CanonicalTXSet independent(env.closed()->info().hash);
+        for (std::size_t i = 0; i < senders.size(); ++i)
+            independent.insert(
+                env.jt(pay(senders[i], receivers[i], XRP(1))).stx);
+
+        auto const reusedBefore = counter(jss::tx_batch_preclaim_reused);
+        env.app().getOPs().processTransactionSet(independent);
+        BEAST_EXPECT(
+            counter(jss::tx_batch_preclaim_reused) - reusedBefore ==
+            senders.size());
+        for (std::size_t i = 0; i < senders.size(); ++i)
+            BEAST_EXPECT(env.balance(receivers[i]) == XRP(1001));
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(NetworkOPs, app, ripple);
@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+
+#include <xrpld/app/ledger/OrderBookDB.h>
+
+namespace ripple {
+namespace test {
+
+class OrderBookDB_test : public beast::unit_test::suite
+{
+    void
+    testOffers()
+    {
+        testcase("books follow validated offers");
+
+        using namespace jtx;
+        Env env{*this};
+        auto& db = env.app().getOrderBookDB();
+
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        env.fund(XRP(10000), gw, alice);
+        env.close();
+        env.trust(USD(1000), alice);
+        env.trust(EUR(1000), alice);
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, alice, EUR(100)));
+        env.close();
+
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 0);
+        BEAST_EXPECT(!db.isBookToXRP(USD.issue()));
+
+        // Two offers at different qualities share one book
+        auto const seq1 = env.seq(alice);
+        env(offer(alice, USD(10), XRP(10)));
+        auto const seq2 = env.seq(alice);
+        env(offer(alice, USD(10), XRP(20)));
+        auto const seq3 = env.seq(alice);
+        env(offer(alice, USD(10), EUR(10)));
+        env.close();
+
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 2);
+        BEAST_EXPECT(db.isBookToXRP(USD.issue()));
+
+        // Removing one quality leaves the book in place
+        env(offer_cancel(alice, seq1));
+        env.close();
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 2);
+        BEAST_EXPECT(db.isBookToXRP(USD.issue()));
+
+        // Removing the last quality removes the book
+        env(offer_cancel(alice, seq2));
+        env.close();
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 1);
+        BEAST_EXPECT(!db.isBookToXRP(USD.issue()));
+
+        env(offer_cancel(alice, seq3));
+        env.close();
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 0);
+        BEAST_EXPECT(db.getBooksByTakerPays(USD.issue()).empty());
+
+        // A book created again after removal is tracked again
+        env(offer(alice, USD(10), XRP(10)));
+        env.close();
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 1);
+        BEAST_EXPECT(db.isBookToXRP(USD.issue()));
+    }
+
+    void
+    testAMM()
+    {
+        testcase("books follow validated AMMs");
+
+        using namespace jtx;
+        Env env{*this};
+        auto& db = env.app().getOrderBookDB();
+
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(30000), gw, alice);
+        env.close();
+        env.trust(USD(30000), alice);
+        env(pay(gw, alice, USD(10000)));
+        env.close();
+
+        AMM amm(env, alice, XRP(10000), USD(10000));
+        env.close();
+
+        BEAST_EXPECT(db.isBookToXRP(USD.issue()));
+        BEAST_EXPECT(db.getBookSize(xrpIssue()) == 1);
+
+        amm.withdrawAll(alice);
+        env.close();
+        BEAST_EXPECT(!amm.ammExists());
+
+        BEAST_EXPECT(!db.isBookToXRP(USD.issue()));
+        BEAST_EXPECT(db.getBookSize(USD.issue()) == 0);
+        BEAST_EXPECT(db.getBookSize(xrpIssue()) == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testOffers();
+        testAMM();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OrderBookDB, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
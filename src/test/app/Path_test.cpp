@@ -20,13 +20,16 @@
 #include <test/jtx.h>
 #include <test/jtx/AMM.h>
 #include <test/jtx/AMMTest.h>
+#include <test/jtx/WSClient.h>
 #include <test/jtx/envconfig.h>
 #include <test/jtx/permissioned_dex.h>
 
+#include <xrpld/core/CoroTask.h>
 #include <xrpld/core/JobQueue.h>
 #include <xrpld/rpc/RPCHandler.h>
 #include <xrpld/rpc/detail/RPCHelpers.h>
 #include <xrpld/rpc/detail/Tuning.h>
+#include <xrpld/rpc/handlers/Handlers.h>
 
 #include <xrpl/beast/unit_test.h>
 #include <xrpl/json/json_reader.h>
@@ -35,12 +38,14 @@
 #include <xrpl/protocol/jss.h>
 #include <xrpl/resource/Fees.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -320,6 +325,156 @@ public:
         BEAST_EXPECT(result.isMember(jss::error));
     }
 
+    void
+    stackless_ripple_path_find()
+    {
+        testcase("stackless ripple_path_find");
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->PATH_SEARCH_OLD = 7;
+            cfg->PATH_SEARCH = 7;
+            cfg->PATH_SEARCH_MAX = 10;
+            cfg->STACKLESS_RPC = true;
+            return cfg;
+        }));
+        auto const gw = Account("gateway");
+        env.fund(XRP(10000), "alice", "bob", gw);
+        env.close();
+        env.trust(gw["USD"](100), "alice", "bob");
+        env.close();
+
+        BEAST_EXPECT(RPC::hasAsyncHandler(
+            RPC::apiVersionIfUnspecified, false, "ripple_path_find"));
+        BEAST_EXPECT(!RPC::hasAsyncHandler(
+            RPC::apiVersionIfUnspecified, false, "account_info"));
+
+        {
+            // Called directly, without a JobQueue::Coro.
+            auto& app = env.app();
+            Resource::Charge loadType = Resource::feeReferenceRPC;
+            Resource::Consumer c;
+            RPC::JsonContext context{
+                {env.journal,
+                 app,
+                 loadType,
+                 app.getOPs(),
+                 app.getLedgerMaster(),
+                 c,
+                 Role::USER,
+                 {},
+                 {},
+                 RPC::apiVersionIfUnspecified},
+                rpf(Account("alice"), Account("bob"), 0),
+                {}};
+
+            Json::Value result;
+            gate g;
+            runCoroTask(
+                RPC::doCommandAsync(context, result),
+                [&g](RPC::Status const&) { g.signal(); });
+            BEAST_EXPECT(g.wait_for(5s));
+            BEAST_EXPECT(!result.isMember(jss::error));
+            BEAST_EXPECT(result.isMember(jss::alternatives));
+        }
+
+        // Over a websocket, commands with and without a stackless handler
+        // get the same responses as they would in a JobQueue::Coro.
+        auto wsc = makeWSClient(env.app().config());
+        {
+            auto params = rpf(Account("alice"), Account("bob"), 0);
+            params.removeMember(jss::command);
+            auto const jv = wsc->invoke("ripple_path_find", params);
+            BEAST_EXPECT(jv[jss::status] == jss::success);
+            BEAST_EXPECT(jv[jss::result].isMember(jss::alternatives));
+        }
+        {
+            Json::Value params;
+            params[jss::account] = Account("alice").human();
+            auto const jv = wsc->invoke("account_info", params);
+            BEAST_EXPECT(jv[jss::status] == jss::success);
+            BEAST_EXPECT(
+                jv[jss::result][jss::account_data][jss::Account] ==
+                Account("alice").human());
+        }
+        {
+            auto const jv = wsc->invoke("no_such_command");
+            BEAST_EXPECT(jv[jss::status] == jss::error);
+            BEAST_EXPECT(jv[jss::error] == "unknownCmd");
+        }
+
+        // Over HTTP, only a request for a command that may suspend gets a
+        // JobQueue::Coro.
+        {
+            auto const params = rpf(Account("alice"), Account("bob"), 0);
+            auto const jv = env.rpc(
+                "json", "ripple_path_find", to_string(params))[jss::result];
+            BEAST_EXPECT(jv[jss::status] == jss::success);
+            BEAST_EXPECT(jv.isMember(jss::alternatives));
+        }
+        {
+            Json::Value params;
+            params[jss::account] = Account("alice").human();
+            auto const jv = env.rpc(
+                "json", "account_info", to_string(params))[jss::result];
+            BEAST_EXPECT(jv[jss::status] == jss::success);
+            BEAST_EXPECT(
+                jv[jss::account_data][jss::Account] ==
+                Account("alice").human());
+        }
+
+        // A server that is not standalone hands the request to the
+        // path-finding engine, and the task waits on a CoroEvent until the
+        // engine has run. Many requests are made so that most of them
+        // suspend rather than find the engine already done.
+        {
+            auto& app = env.app();
+            constexpr int requests = 20;
+            std::vector<Resource::Charge> loadTypes(
+                requests, Resource::feeReferenceRPC);
+            std::vector<Resource::Consumer> consumers(requests);
+            std::vector<RPC::JsonContext> contexts;
+            contexts.reserve(requests);
+            for (int i = 0; i < requests; ++i)
+                contexts.push_back(RPC::JsonContext{
+                    {env.journal,
+                     app,
+                     loadTypes[i],
+                     app.getOPs(),
+                     app.getLedgerMaster(),
+                     consumers[i],
+                     Role::USER,
+                     {},
+                     {},
+                     RPC::apiVersionIfUnspecified},
+                    rpf(Account("alice"), Account("bob"), 0),
+                    {}});
+
+            std::vector<Json::Value> results(requests);
+            std::atomic<int> finished{0};
+            gate g;
+            for (int i = 0; i < requests; ++i)
+            {
+                runCoroTask(
+                    doRipplePathRequestAsync(contexts[i]),
+                    [&, i](Json::Value const& result) {
+                        results[i] = result;
+                        if (++finished == requests)
+                            g.signal();
+                    });
+            }
+            BEAST_EXPECT(g.wait_for(5s));
+            for (auto const& result : results)
+            {
+                BEAST_EXPECT(result[jss::status] == jss::success);
+                BEAST_EXPECT(result.isMember(jss::alternatives));
+                // Answered by the engine, not against the current ledger.
+                BEAST_EXPECT(result.isMember(jss::ledger_index));
+                BEAST_EXPECT(!result.isMember(jss::ledger_current_index));
+            }
+        }
+    }
+
     void
     no_direct_path_no_intermediary_no_alternatives()
     {
@@ -2090,6 +2245,7 @@ public:
     run() override
     {
         source_currencies_limit();
+        stackless_ripple_path_find();
         no_direct_path_no_intermediary_no_alternatives();
         direct_path_no_intermediary();
         payment_auto_path_find();
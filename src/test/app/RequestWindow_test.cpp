@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/detail/RequestWindow.h>
+
+#include <xrpl/beast/unit_test.h>
+
+namespace ripple {
+namespace test {
+
+class RequestWindow_test : public beast::unit_test::suite
+{
+    using clock_type = RequestWindow::clock_type;
+
+    // A peer that answers a request one round trip after it is sent, but
+    // needs `service` to produce each reply. Keeps the window full until
+    // `replies` replies have arrived.
+    static void
+    simulate(
+        RequestWindow& w,
+        clock_type::time_point& now,
+        clock_type::duration rtt,
+        clock_type::duration service,
+        int useful,
+        int replies)
+    {
+        std::deque<clock_type::time_point> due;
+        auto done = now;
+        for (int i = 0; i < replies; ++i)
+        {
+            while (w.available() != 0)
+            {
+                w.sent(now);
+                done = std::max(now + rtt, done + service);
+                due.push_back(done);
+            }
+            now = due.front();
+            due.pop_front();
+            w.received(now, useful);
+        }
+    }
+
+    void
+    testGrowth()
+    {
+        using namespace std::chrono_literals;
+        testcase("window grows with a peer that keeps up");
+
+        RequestWindow w(128, 4);
+        clock_type::time_point now;
+
+        BEAST_EXPECT(w.window() == 1);
+        BEAST_EXPECT(w.available() == 1);
+
+        w.sent(now);
+        BEAST_EXPECT(w.available() == 0);
+
+        // A full reply after one round trip opens the window by one.
+        now += 100ms;
+        w.received(now, 128);
+        BEAST_EXPECT(w.outstanding() == 0);
+        BEAST_EXPECT(w.window() == 2);
+        BEAST_EXPECT(std::lround(w.nodesPerSecond()) == 1280);
+
+        // The peer could serve ten requests per round trip.
+        simulate(w, now, 100ms, 10ms, 128, 40);
+        BEAST_EXPECT(w.window() == 4);
+    }
+
+    void
+    testSlowPeer()
+    {
+        using namespace std::chrono_literals;
+        testcase("window stays small for a slow peer");
+
+        {
+            // One reply per round trip: keep just one more queued.
+            RequestWindow w(128, 4);
+            clock_type::time_point now;
+            simulate(w, now, 100ms, 100ms, 128, 40);
+            BEAST_EXPECT(w.window() == 2);
+        }
+        {
+            // Replies carry few useful nodes.
+            RequestWindow w(128, 4);
+            clock_type::time_point now;
+            simulate(w, now, 100ms, 10ms, 16, 40);
+            BEAST_EXPECT(w.window() == 2);
+        }
+    }
+
+    void
+    testShrink()
+    {
+        using namespace std::chrono_literals;
+        testcase("useless replies and expired requests shrink the window");
+
+        RequestWindow w(128, 8);
+        clock_type::time_point now;
+
+        simulate(w, now, 100ms, 5ms, 128, 100);
+        BEAST_EXPECT(w.window() == 8);
+
+        w.received(now, 0);
+        BEAST_EXPECT(w.window() == 4);
+
+        // Requests the peer never answers are dropped once too old.
+        while (w.outstanding() != 0)
+            w.received(now, 128);
+        while (w.available() != 0)
+            w.sent(now);
+        auto const outstanding = w.outstanding();
+        auto const window = w.window();
+        w.expire(now + 1s, 3s);
+        BEAST_EXPECT(w.outstanding() == outstanding);
+        w.expire(now + 4s, 3s);
+        BEAST_EXPECT(w.outstanding() == 0);
+        BEAST_EXPECT(w.window() == std::max<std::size_t>(1, window / 2));
+
+        // A late reply to an expired request is ignored.
+        w.received(now + 5s, 128);
+        BEAST_EXPECT(w.window() == std::max<std::size_t>(1, window / 2));
+    }
+
+public:
+    void
+    run() override
+    {
+        testGrowth();
+        testSlowPeer();
+        testShrink();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RequestWindow, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
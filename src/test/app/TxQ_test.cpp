@@ -5058,8 +5058,87 @@ class TxQMetaInfo_test : public TxQPosNegFlows_test
     }
 };
 
+// Measures how long it takes to drain a deep queue into new open ledgers
+// when most of the queued transactions are not yet applicable.
+class TxQStress_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        constexpr std::size_t accountCount = 10000;
+        constexpr std::size_t txPerAccount = 10;
+        constexpr std::size_t txPerLedger = 1000;
+
+        Env env(
+            *this,
+            makeConfig(
+                {{"minimum_txn_in_ledger_standalone",
+                  std::to_string(txPerLedger)},
+                 {"minimum_queue_size",
+                  std::to_string(accountCount * txPerAccount)},
+                 {"maximum_txn_per_account", std::to_string(txPerAccount)}}));
+        auto& txq = env.app().getTxQ();
+
+        std::vector<Account> accounts;
+        accounts.reserve(accountCount);
+        for (std::size_t i = 0; i < accountCount; ++i)
+        {
+            accounts.emplace_back("stress" + std::to_string(i));
+            env.fund(XRP(1000), noripple(accounts.back()));
+            if (accounts.size() % (txPerLedger / 2) == 0)
+                env.close();
+        }
+        env.close();
+
+        // Fill the open ledger so everything after this is queued.
+        auto metrics = txq.getMetrics(*env.current());
+        for (auto i = metrics.txInLedger; i <= metrics.txPerLedger; ++i)
+            env(noop(env.master));
+
+        // Each account's later transactions pay more than its first, so
+        // most of the high fee end of the queue is waiting on a
+        // sequence gap.
+        auto const baseFee = env.current()->fees().base.drops();
+        for (std::size_t t = 0; t < txPerAccount; ++t)
+        {
+            for (std::size_t i = 0; i < accountCount; ++i)
+            {
+                auto const& account = accounts[i];
+                env(noop(account),
+                    seq(env.seq(account) + t),
+                    fee(baseFee * (1 + t) + i % 7),
+                    ter(terQUEUED));
+            }
+        }
+        metrics = txq.getMetrics(*env.current());
+        BEAST_EXPECT(metrics.txCount == accountCount * txPerAccount);
+        log << metrics.txCount << " queued transactions from "
+            << accountCount << " accounts" << std::endl;
+
+        while (metrics.txCount > 0)
+        {
+            auto const before = metrics.txCount;
+            auto const start = steady_clock::now();
+            env.close();
+            auto const elapsed =
+                duration_cast<microseconds>(steady_clock::now() - start);
+            metrics = txq.getMetrics(*env.current());
+            if (!BEAST_EXPECT(metrics.txCount < before))
+                break;
+            log << "close applied " << (before - metrics.txCount)
+                << " queued transactions in " << elapsed.count() << "us, "
+                << metrics.txCount << " remain" << std::endl;
+        }
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(TxQPosNegFlows, app, ripple, 1);
 BEAST_DEFINE_TESTSUITE_PRIO(TxQMetaInfo, app, ripple, 1);
+BEAST_DEFINE_TESTSUITE_MANUAL(TxQStress, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
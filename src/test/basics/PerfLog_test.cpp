@@ -20,10 +20,13 @@
 #include <test/jtx/Env.h>
 #include <test/jtx/TestHelpers.h>
 
+#include <xrpld/perflog/Histogram.h>
 #include <xrpld/perflog/PerfLog.h>
+#include <xrpld/perflog/TracedMutex.h>
 #include <xrpld/rpc/detail/Handler.h>
 
 #include <xrpl/basics/random.h>
+#include <xrpl/beast/insight/NullCollector.h>
 #include <xrpl/beast/unit_test.h>
 #include <xrpl/beast/utility/Journal.h>
 #include <xrpl/json/json_reader.h>
@@ -32,6 +35,9 @@
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -111,7 +117,11 @@ class PerfLog_test : public beast::unit_test::suite
             perf::PerfLog::Setup const setup{
                 withFile == WithFile::no ? "" : logFile(), logInterval()};
             return perf::make_PerfLog(
-                setup, app_, j_, [this]() { return signalStop(); });
+                setup,
+                app_,
+                j_,
+                [this]() { return signalStop(); },
+                beast::insight::NullCollector::New());
         }
 
         // Block until the log file has grown in size, indicating that the
@@ -1046,6 +1056,214 @@ public:
         }
     }
 
+    void
+    testHistogram()
+    {
+        testcase("histogram");
+
+        using perf::Histogram;
+
+        // Small values are exact and every bucket is contiguous with the
+        // next one.
+        for (std::uint64_t v = 0; v < Histogram::subBuckets; ++v)
+            BEAST_EXPECT(Histogram::bucketMax(Histogram::bucket(v)) == v);
+        bool contiguous = true;
+        for (std::size_t b = 1; b < Histogram::bucketCount; ++b)
+        {
+            auto const first = Histogram::bucketMax(b - 1) + 1;
+            contiguous = contiguous && Histogram::bucket(first) == b &&
+                Histogram::bucket(first - 1) == b - 1;
+        }
+        BEAST_EXPECT(contiguous);
+
+        // Each value is within 1/16th of the top of its bucket.
+        bool precise = true;
+        for (std::uint64_t v = 1; v < (std::uint64_t(1) << 30); v = v * 3 + 1)
+        {
+            auto const top = Histogram::bucketMax(Histogram::bucket(v));
+            precise = precise && top >= v && top - v <= v / 16;
+        }
+        BEAST_EXPECT(precise);
+
+        // Huge values land in the last bucket.
+        BEAST_EXPECT(
+            Histogram::bucket(std::numeric_limits<std::uint64_t>::max()) ==
+            Histogram::bucketCount - 1);
+
+        Histogram h;
+        BEAST_EXPECT(h.snapshot().percentile(0.99) == 0);
+        for (std::uint64_t v = 1; v <= 1000; ++v)
+            h.record(v);
+        auto snap = h.snapshot();
+        BEAST_EXPECT(snap.count == 1000);
+        BEAST_EXPECT(snap.sum == 500500);
+        BEAST_EXPECT(snap.max == 1000);
+        auto near = [](std::uint64_t actual, std::uint64_t expected) {
+            return actual >= expected && actual - expected <= expected / 16;
+        };
+        BEAST_EXPECT(near(snap.percentile(0.5), 500));
+        BEAST_EXPECT(near(snap.percentile(0.99), 990));
+        BEAST_EXPECT(snap.percentile(0.999) <= 1000);
+        BEAST_EXPECT(snap.percentile(1) == 1000);
+        BEAST_EXPECT(snap.percentile(0) == 1);
+
+        Histogram other;
+        other.record(1000000);
+        snap += other.snapshot();
+        BEAST_EXPECT(snap.count == 1001);
+        BEAST_EXPECT(snap.max == 1000000);
+        BEAST_EXPECT(snap.percentile(1) == 1000000);
+
+        auto const json = snap.json();
+        BEAST_EXPECT(json[jss::count] == "1001");
+        BEAST_EXPECT(json[jss::max_us] == "1000000");
+        BEAST_EXPECT(json.isMember(jss::p50_us));
+        BEAST_EXPECT(json.isMember(jss::p90_us));
+        BEAST_EXPECT(json.isMember(jss::p99_us));
+        BEAST_EXPECT(json.isMember(jss::p999_us));
+
+        // Concurrent recording loses nothing.
+        Histogram shared;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&shared, t] {
+                for (std::uint64_t v = 0; v < 10000; ++v)
+                    shared.record(v * (t + 1));
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        snap = shared.snapshot();
+        BEAST_EXPECT(snap.count == 40000);
+        BEAST_EXPECT(snap.max == 9999 * 4);
+    }
+
+    void
+    testLatency()
+    {
+        testcase("latency histograms");
+
+        using namespace std::chrono;
+        Fixture fixture{env_.app(), j_};
+        auto perfLog{fixture.perfLog(WithFile::no)};
+        perfLog->resizeJobs(1);
+
+        // Nothing has run, so no job types are reported.
+        {
+            auto const latency = perfLog->latencyJson();
+            BEAST_EXPECT(latency[jss::job_queue].size() == 0);
+            BEAST_EXPECT(!latency.isMember(jss::locks));
+        }
+
+        for (int i = 1; i <= 100; ++i)
+        {
+            perfLog->jobQueue(jtCLIENT);
+            perfLog->jobStart(
+                jtCLIENT, microseconds(i), steady_clock::now(), 0);
+            perfLog->jobFinish(jtCLIENT, microseconds(10 * i), 0);
+        }
+
+        auto const latency = perfLog->latencyJson();
+        Json::Value const& jq = latency[jss::job_queue];
+        BEAST_EXPECT(jq.size() == 2);
+        for (std::string const& name :
+             {JobTypes::name(jtCLIENT), std::string{jss::total}})
+        {
+            Json::Value const& job = jq[name];
+            BEAST_EXPECT(job[jss::queued_us][jss::count] == "100");
+            BEAST_EXPECT(job[jss::queued_us][jss::max_us] == "100");
+            BEAST_EXPECT(job[jss::running_us][jss::count] == "100");
+            BEAST_EXPECT(job[jss::running_us][jss::max_us] == "1000");
+            auto const p99 = jsonToUint64(job[jss::running_us][jss::p99_us]);
+            BEAST_EXPECT(p99 >= 990 && p99 <= 1000);
+        }
+    }
+
+    void
+    testLockTracing()
+    {
+        testcase("lock tracing");
+
+        using namespace std::chrono_literals;
+        using Mutex = perf::TracedMutex<std::mutex>;
+
+        perf::LockSites::enable(false);
+        Mutex busy{"PerfLog_test.busy"};
+        Mutex idle{"PerfLog_test.idle"};
+
+        auto& sites = perf::LockSites::instance();
+        auto& busySite = sites.get("PerfLog_test.busy");
+        auto& idleSite = sites.get("PerfLog_test.idle");
+        BEAST_EXPECT(&busySite != &idleSite);
+
+        // Nothing is recorded while tracing is off.
+        {
+            std::lock_guard lock(busy);
+        }
+        BEAST_EXPECT(busySite.acquired == 0);
+
+        Fixture fixture{env_.app(), j_};
+        perf::PerfLog::Setup setup{"", fixture.logInterval()};
+        setup.traceLocks = 1;
+        auto perfLog = perf::make_PerfLog(
+            setup,
+            env_.app(),
+            j_,
+            [&fixture]() { fixture.signalStop(); },
+            beast::insight::NullCollector::New());
+        BEAST_EXPECT(perf::LockSites::enabled());
+
+        {
+            std::lock_guard lock(idle);
+        }
+        BEAST_EXPECT(idleSite.acquired == 1);
+        BEAST_EXPECT(idleSite.contended == 0);
+
+        // Hold busy while another thread waits for it.
+        std::atomic<bool> waiting{false};
+        std::thread waiter;
+        {
+            std::unique_lock lock(busy);
+            waiter = std::thread([&] {
+                waiting = true;
+                std::lock_guard lock(busy);
+            });
+            while (!waiting)
+                std::this_thread::yield();
+            std::this_thread::sleep_for(20ms);
+        }
+        waiter.join();
+        BEAST_EXPECT(busySite.acquired == 2);
+        BEAST_EXPECT(busySite.contended == 1);
+        auto const wait = busySite.wait.snapshot();
+        BEAST_EXPECT(wait.count == 1);
+        BEAST_EXPECT(wait.max >= 1000);
+
+        // Only the most contended site is reported.
+        auto const locks = perfLog->latencyJson()[jss::locks];
+        BEAST_EXPECT(locks.size() == 1);
+        BEAST_EXPECT(locks.isMember("PerfLog_test.busy"));
+        BEAST_EXPECT(locks["PerfLog_test.busy"][jss::contended] == "1");
+
+        // Tracing works with condition_variable_any.
+        std::condition_variable_any cv;
+        bool ready = false;
+        std::thread notifier([&] {
+            std::lock_guard lock(idle);
+            ready = true;
+            cv.notify_one();
+        });
+        {
+            std::unique_lock lock(idle);
+            cv.wait(lock, [&] { return ready; });
+        }
+        notifier.join();
+        BEAST_EXPECT(ready);
+
+        perf::LockSites::enable(false);
+    }
+
     void
     run() override
     {
@@ -1058,6 +1276,9 @@ public:
         testInvalidID(WithFile::yes);
         testRotate(WithFile::no);
         testRotate(WithFile::yes);
+        testHistogram();
+        testLatency();
+        testLockTracing();
     }
 };
 
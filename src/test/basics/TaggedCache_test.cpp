@@ -23,6 +23,11 @@
 #include <xrpl/basics/TaggedCache.ipp>
 #include <xrpl/basics/chrono.h>
 #include <xrpl/protocol/Protocol.h>
+#include <xrpl/protocol/digest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 
@@ -40,7 +45,7 @@ class TaggedCache_test : public beast::unit_test::suite
 {
 public:
     void
-    run() override
+    testBasics()
     {
         using namespace std::chrono_literals;
         using namespace beast::severities;
@@ -149,8 +154,155 @@ public:
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
     }
+
+    void
+    testConcurrentAccess()
+    {
+        testcase("concurrent access");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("TaggedCache_test", *this);
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        using Key = LedgerIndex;
+        using Value = std::string;
+        using Cache = TaggedCache<Key, Value>;
+
+        Cache c("test", 0, 1s, clock, journal);
+
+        // Every thread canonicalizes its own copy of the same keys while
+        // another thread sweeps. All threads must agree on one object per
+        // key, and that object must carry the right value.
+        constexpr Key keyCount = 1000;
+        constexpr int threadCount = 8;
+        std::vector<std::vector<std::shared_ptr<Value>>> seen(threadCount);
+        std::atomic<bool> wrongValue = false;
+        std::atomic<bool> done = false;
+
+        std::thread sweeper([&]() {
+            while (!done)
+                c.sweep();
+        });
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                auto& mine = seen[t];
+                mine.reserve(keyCount);
+                for (Key k = 0; k < keyCount; ++k)
+                {
+                    auto p = std::make_shared<Value>(std::to_string(k));
+                    c.canonicalize_replace_client(k, p);
+                    if (auto const f = c.fetch(k); f && *f != *p)
+                        wrongValue = true;
+                    mine.push_back(std::move(p));
+                }
+            });
+        }
+
+        for (auto& w : workers)
+            w.join();
+        done = true;
+        sweeper.join();
+
+        BEAST_EXPECT(!wrongValue);
+
+        bool canonical = true;
+        for (int t = 1; t < threadCount; ++t)
+        {
+            for (Key k = 0; k < keyCount; ++k)
+                canonical = canonical && seen[t][k] == seen[0][k];
+        }
+        BEAST_EXPECT(canonical);
+        BEAST_EXPECT(c.getCacheSize() == keyCount);
+        BEAST_EXPECT(c.getTrackSize() == keyCount);
+
+        // Once nobody holds a reference and the entries age out, a sweep
+        // empties every partition.
+        seen.clear();
+        clock.advance(2s);
+        c.sweep();
+        BEAST_EXPECT(c.getCacheSize() == 0);
+        BEAST_EXPECT(c.getTrackSize() == 0);
+    }
+
+    void
+    run() override
+    {
+        testBasics();
+        testConcurrentAccess();
+    }
+};
+
+// Measures lookup throughput of a warm cache as the number of threads
+// hitting it grows.
+class TaggedCacheContention_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+        test::SuiteJournal journal("TaggedCacheContention_test", *this);
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        using Cache = TaggedCache<uint256, std::string>;
+        Cache c("bench", 0, 60s, clock, journal);
+
+        constexpr std::size_t keyCount = 100000;
+        constexpr std::size_t lookupsPerThread = 200000;
+
+        std::vector<uint256> keys;
+        keys.reserve(keyCount);
+        for (std::size_t i = 0; i < keyCount; ++i)
+        {
+            keys.push_back(sha512Half(i));
+            c.insert(keys.back(), std::to_string(i));
+        }
+
+        for (std::size_t const threads : {1, 2, 4, 8, 16, 32, 64})
+        {
+            std::atomic<std::size_t> hits = 0;
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+
+            auto const start = steady_clock::now();
+            for (std::size_t t = 0; t < threads; ++t)
+            {
+                workers.emplace_back([&, t]() {
+                    std::size_t found = 0;
+                    // Each thread strides through the keys from a different
+                    // offset, so threads hit every partition at once.
+                    auto k = (t * 7919) % keyCount;
+                    for (std::size_t i = 0; i < lookupsPerThread; ++i)
+                    {
+                        if (c.fetch(keys[k]))
+                            ++found;
+                        k = (k + 104729) % keyCount;
+                    }
+                    hits += found;
+                });
+            }
+            for (auto& w : workers)
+                w.join();
+            auto const elapsed =
+                duration_cast<microseconds>(steady_clock::now() - start);
+
+            BEAST_EXPECT(hits == threads * lookupsPerThread);
+            log << threads << " threads: "
+                << (threads * lookupsPerThread * 1000000) /
+                    std::max<std::int64_t>(1, elapsed.count())
+                << " lookups/s in " << elapsed.count() << "us" << std::endl;
+        }
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(TaggedCache, basics, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(TaggedCacheContention, basics, ripple);
 
 }  // namespace ripple
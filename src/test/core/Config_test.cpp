@@ -486,6 +486,49 @@ main
         BEAST_EXPECT(c.NETWORK_ID == 10000);
     }
 
+    void
+    testWorkers()
+    {
+        testcase("workers");
+
+        auto load = [](std::string const& workers, Config& c) {
+            try
+            {
+                c.loadFromString("[workers]\n" + workers + "\n");
+                return true;
+            }
+            catch (std::runtime_error const&)
+            {
+                return false;
+            }
+        };
+
+        {
+            Config c;
+            BEAST_EXPECT(load("8", c));
+            BEAST_EXPECT(c.WORKERS == 8);
+            BEAST_EXPECT(!c.WORK_STEALING);
+        }
+        {
+            Config c;
+            BEAST_EXPECT(load("threads = 12\nscheduler = stealing", c));
+            BEAST_EXPECT(c.WORKERS == 12);
+            BEAST_EXPECT(c.WORK_STEALING);
+        }
+        {
+            Config c;
+            BEAST_EXPECT(load("scheduler=shared", c));
+            BEAST_EXPECT(c.WORKERS == 0);
+            BEAST_EXPECT(!c.WORK_STEALING);
+        }
+        {
+            Config c;
+            BEAST_EXPECT(!load("threads=0", c));
+            BEAST_EXPECT(!load("scheduler=fastest", c));
+            BEAST_EXPECT(!load("stealing=1", c));
+        }
+    }
+
     void
     testValidatorsFile()
     {
@@ -1513,6 +1556,7 @@ r.ripple.com:51235
         testAmendment();
         testOverlay();
         testNetworkID();
+        testWorkers();
     }
 };
 
@@ -0,0 +1,373 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+
+#include <xrpld/core/CoroTask.h>
+#include <xrpld/core/JobQueue.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace ripple {
+namespace test {
+
+namespace {
+
+class gate
+{
+private:
+    std::condition_variable cv_;
+    std::mutex mutex_;
+    bool signaled_ = false;
+
+public:
+    // Thread safe, blocks until signaled or period expires.
+    // Returns `true` if signaled.
+    template <class Rep, class Period>
+    bool
+    wait_for(std::chrono::duration<Rep, Period> const& rel_time)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        auto b = cv_.wait_for(lk, rel_time, [this] { return signaled_; });
+        signaled_ = false;
+        return b;
+    }
+
+    void
+    signal()
+    {
+        std::lock_guard lk(mutex_);
+        signaled_ = true;
+        cv_.notify_all();
+    }
+};
+
+CoroTask<int>
+answer()
+{
+    co_return 42;
+}
+
+CoroTask<int>
+addOne()
+{
+    co_return co_await answer() + 1;
+}
+
+CoroTask<int>
+fail()
+{
+    Throw<std::runtime_error>("fail");
+    co_return 0;
+}
+
+CoroTask<std::string>
+catchFailure()
+{
+    try
+    {
+        co_await fail();
+    }
+    catch (std::runtime_error const& e)
+    {
+        co_return e.what();
+    }
+    co_return "";
+}
+
+CoroTask<std::thread::id>
+waitFor(std::shared_ptr<CoroEvent> event)
+{
+    co_await *event;
+    co_return std::this_thread::get_id();
+}
+
+}  // namespace
+
+class CoroTask_test : public beast::unit_test::suite
+{
+public:
+    void
+    testTask()
+    {
+        testcase("task");
+
+        int value = 0;
+        runCoroTask(addOne(), [&value](int v) { value = v; });
+        BEAST_EXPECT(value == 43);
+
+        std::string what;
+        runCoroTask(
+            catchFailure(), [&what](std::string const& w) { what = w; });
+        BEAST_EXPECT(what == "fail");
+
+        // A task that is never awaited never runs.
+        bool ran = false;
+        {
+            auto task = [](bool& ran) -> CoroTask<int> {
+                ran = true;
+                co_return 0;
+            }(ran);
+        }
+        BEAST_EXPECT(!ran);
+    }
+
+    void
+    testEvent()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("event");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+        auto& jq = env.app().getJobQueue();
+
+        {
+            // Notified before the wait, the task doesn't suspend.
+            auto event = std::make_shared<CoroEvent>(jq, jtCLIENT, "test");
+            event->notify();
+            std::optional<std::thread::id> id;
+            runCoroTask(
+                waitFor(event), [&id](std::thread::id i) { id = i; });
+            BEAST_EXPECT(id == std::this_thread::get_id());
+        }
+
+        {
+            // Notified after the wait, the task resumes on the JobQueue.
+            auto event = std::make_shared<CoroEvent>(jq, jtCLIENT, "test");
+            gate g;
+            std::thread::id id;
+            runCoroTask(waitFor(event), [&](std::thread::id i) {
+                id = i;
+                g.signal();
+            });
+            BEAST_EXPECT(!g.wait_for(10ms));
+
+            std::thread notifier([event]() { event->notify(); });
+            auto const notifierId = notifier.get_id();
+            notifier.join();
+            BEAST_EXPECT(g.wait_for(5s));
+            BEAST_EXPECT(id != notifierId);
+            BEAST_EXPECT(id != std::this_thread::get_id());
+        }
+
+        {
+            // Notify and wait race, and every task finishes exactly once.
+            constexpr int tasks = 1000;
+            std::atomic<int> finished{0};
+            gate g;
+            for (int i = 0; i < tasks; ++i)
+            {
+                auto event =
+                    std::make_shared<CoroEvent>(jq, jtCLIENT, "test");
+                jq.addJob(jtCLIENT, "test", [event]() { event->notify(); });
+                runCoroTask(waitFor(event), [&](std::thread::id) {
+                    if (++finished == tasks)
+                        g.signal();
+                });
+            }
+            BEAST_EXPECT(g.wait_for(5s));
+            BEAST_EXPECT(finished == tasks);
+        }
+    }
+
+    void
+    testStop()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        testcase("stop");
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+        auto& jq = env.app().getJobQueue();
+
+        // The JobQueue doesn't stop while a task is suspended.
+        auto event = std::make_shared<CoroEvent>(jq, jtCLIENT, "test");
+        std::optional<std::thread::id> id;
+        runCoroTask(waitFor(event), [&id](std::thread::id i) { id = i; });
+
+        gate stopped;
+        std::thread stopper([&]() {
+            jq.stop();
+            stopped.signal();
+        });
+        BEAST_EXPECT(!stopped.wait_for(100ms));
+        BEAST_EXPECT(!id);
+
+        event->notify();
+        BEAST_EXPECT(stopped.wait_for(5s));
+        stopper.join();
+        BEAST_EXPECT(id);
+    }
+
+    void
+    run() override
+    {
+        testTask();
+        testEvent();
+        testStop();
+    }
+};
+
+// Holds many requests suspended at once, first in JobQueue::Coro and then
+// in CoroTask, and reports the memory they take and how quickly they are
+// all resumed and finished.
+class CoroTaskSessions_test : public beast::unit_test::suite
+{
+    static constexpr int sessions = 10000;
+
+    // Resident memory of the process in kilobytes, or 0 if unknown.
+    static std::int64_t
+    residentKB()
+    {
+#if defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        std::int64_t size = 0;
+        std::int64_t resident = 0;
+        if (statm >> size >> resident)
+            return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+        return 0;
+    }
+
+    template <class Duration>
+    void
+    report(char const* name, std::int64_t kb, Duration elapsed)
+    {
+        using namespace std::chrono;
+        auto const us = std::max<std::int64_t>(
+            1, duration_cast<microseconds>(elapsed).count());
+        log << name << ": " << sessions << " suspended requests, " << kb
+            << " KB resident (" << (kb * 1024) / sessions
+            << " bytes each), " << (std::int64_t(sessions) * 1000000) / us
+            << " requests/s" << std::endl;
+    }
+
+    void
+    testStackful(JobQueue& jq)
+    {
+        using namespace std::chrono;
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<JobQueue::Coro>> suspended;
+        suspended.reserve(sessions);
+        std::atomic<int> finished{0};
+        gate started;
+        gate done;
+
+        auto const before = residentKB();
+        auto const start = steady_clock::now();
+        for (int i = 0; i < sessions; ++i)
+        {
+            jq.postCoro(jtCLIENT, "bench", [&](auto const& coro) {
+                {
+                    std::lock_guard lock(mutex);
+                    suspended.push_back(coro);
+                    if (suspended.size() == sessions)
+                        started.signal();
+                }
+                coro->yield();
+                if (++finished == sessions)
+                    done.signal();
+            });
+        }
+        BEAST_EXPECT(started.wait_for(60s));
+        auto const held = residentKB() - before;
+        for (auto const& coro : suspended)
+            coro->post();
+        BEAST_EXPECT(done.wait_for(60s));
+        report("JobQueue::Coro", held, steady_clock::now() - start);
+        jq.rendezvous();
+    }
+
+    void
+    testStackless(JobQueue& jq)
+    {
+        using namespace std::chrono;
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<CoroEvent>> suspended;
+        suspended.reserve(sessions);
+        std::atomic<int> finished{0};
+        gate started;
+        gate done;
+
+        auto const before = residentKB();
+        auto const start = steady_clock::now();
+        for (int i = 0; i < sessions; ++i)
+        {
+            jq.addJob(jtCLIENT, "bench", [&]() {
+                auto event =
+                    std::make_shared<CoroEvent>(jq, jtCLIENT, "bench");
+                runCoroTask(waitFor(event), [&](std::thread::id) {
+                    if (++finished == sessions)
+                        done.signal();
+                });
+                std::lock_guard lock(mutex);
+                suspended.push_back(std::move(event));
+                if (suspended.size() == sessions)
+                    started.signal();
+            });
+        }
+        BEAST_EXPECT(started.wait_for(60s));
+        auto const held = residentKB() - before;
+        for (auto const& event : suspended)
+            event->notify();
+        BEAST_EXPECT(done.wait_for(60s));
+        report("CoroTask", held, steady_clock::now() - start);
+        jq.rendezvous();
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->FORCE_MULTI_THREAD = true;
+            return cfg;
+        }));
+        testStackless(env.app().getJobQueue());
+        testStackful(env.app().getJobQueue());
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CoroTask, core, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(CoroTaskSessions, core, ripple);
+
+}  // namespace test
+}  // namespace ripple
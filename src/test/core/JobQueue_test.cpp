@@ -21,8 +21,13 @@
 
 #include <xrpld/core/JobQueue.h>
 
+#include <xrpl/beast/insight/NullCollector.h>
 #include <xrpl/beast/unit_test.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 namespace ripple {
 namespace test {
 
@@ -151,16 +156,305 @@ class JobQueue_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testPostCoroWhileStopping()
+    {
+        testcase("postCoro while stopping");
+
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+
+        JobQueue& jQueue = env.app().getJobQueue();
+
+        // A Coro suspended when stop() begins keeps stop() waiting until
+        // it is given up on.
+        std::atomic<int> runs{0};
+        auto const suspended = jQueue.postCoro(
+            jtCLIENT,
+            "PostCoroStopping1",
+            [&runs](std::shared_ptr<JobQueue::Coro> const& coro) {
+                ++runs;
+                coro->yield();
+                ++runs;
+            });
+        BEAST_EXPECT(suspended != nullptr);
+        if (!suspended)
+            return;
+        suspended->join();
+        BEAST_EXPECT(runs == 1);
+
+        std::thread stopper([&jQueue]() { jQueue.stop(); });
+        while (!jQueue.isStopping())
+            std::this_thread::yield();
+        // Let stop() reach its wait for suspended coroutines.
+        std::this_thread::sleep_for(50ms);
+
+        // A Coro posted now is refused, and so is resuming the suspended
+        // one. Giving up on both must wake stop().
+        bool unprotected;
+        auto const late = jQueue.postCoro(
+            jtCLIENT,
+            "PostCoroStopping2",
+            [&unprotected](std::shared_ptr<JobQueue::Coro> const&) {
+                unprotected = false;
+            });
+        BEAST_EXPECT(late == nullptr);
+        BEAST_EXPECT(!jQueue.isStopped());
+
+        BEAST_EXPECT(!suspended->post());
+        suspended->expectEarlyExit();
+
+        stopper.join();
+        BEAST_EXPECT(jQueue.isStopped());
+        BEAST_EXPECT(runs == 1);
+    }
+
+    void
+    testWorkStealing()
+    {
+        testcase("work stealing");
+
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+
+        auto makeQueue = [&env](int threads) {
+            return std::make_unique<JobQueue>(
+                threads,
+                beast::insight::NullCollector::New(),
+                env.journal,
+                env.app().logs(),
+                env.app().getPerfLog(),
+                true);
+        };
+
+        {
+            // Every job runs, including jobs added by jobs.
+            auto jq = makeQueue(4);
+            std::atomic<int> ran{0};
+            for (int i = 0; i < 500; ++i)
+            {
+                jq->addJob(i % 2 ? jtCLIENT : jtTRANSACTION, "test", [&]() {
+                    ++ran;
+                    jq->addJob(jtLEDGER_DATA, "child", [&]() { ++ran; });
+                });
+            }
+            jq->rendezvous();
+            BEAST_EXPECT(ran == 1000);
+            BEAST_EXPECT(jq->getJobCount(jtLEDGER_DATA) == 0);
+            jq->stop();
+            BEAST_EXPECT(!jq->addJob(jtCLIENT, "stopped", []() {}));
+        }
+
+        {
+            // With one thread, waiting jobs run by priority, and in the
+            // order they were added within a type.
+            auto jq = makeQueue(1);
+            std::atomic<bool> release{false};
+            std::atomic<bool> started{false};
+            jq->addJob(jtCLIENT, "gate", [&]() {
+                started = true;
+                while (!release)
+                    std::this_thread::sleep_for(1ms);
+            });
+            while (!started)
+                std::this_thread::sleep_for(1ms);
+
+            std::vector<std::pair<JobType, int>> order;
+            JobType const types[] = {jtCLIENT, jtLEDGER_DATA, jtTRANSACTION};
+            for (int i = 0; i < 30; ++i)
+            {
+                auto const type = types[i % 3];
+                jq->addJob(type, "ordered", [&order, type, i]() {
+                    order.emplace_back(type, i);
+                });
+            }
+            BEAST_EXPECT(jq->getJobCount(jtTRANSACTION) == 10);
+            BEAST_EXPECT(jq->getJobCountTotal(jtCLIENT) == 11);
+            BEAST_EXPECT(jq->getJobCountGE(jtTRANSACTION) == 20);
+
+            release = true;
+            jq->rendezvous();
+            BEAST_EXPECT(order.size() == 30);
+            BEAST_EXPECT(std::is_sorted(
+                order.begin(), order.end(), [](auto const& a, auto const& b) {
+                    if (a.first != b.first)
+                        return a.first > b.first;
+                    return a.second < b.second;
+                }));
+            jq->stop();
+        }
+
+        {
+            // Per-type limits hold across all the threads.
+            auto jq = makeQueue(8);
+            std::atomic<int> active{0};
+            std::atomic<int> peak{0};
+            for (int i = 0; i < 40; ++i)
+            {
+                jq->addJob(jtPACK, "limited", [&]() {
+                    auto const now = ++active;
+                    auto seen = peak.load();
+                    while (now > seen && !peak.compare_exchange_weak(seen, now))
+                        ;
+                    std::this_thread::sleep_for(1ms);
+                    --active;
+                });
+            }
+            jq->rendezvous();
+            BEAST_EXPECT(peak == 1);
+            jq->stop();
+        }
+    }
+
+    void
+    testParallelFor()
+    {
+        testcase("parallelFor");
+
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+
+        JobQueue& jQueue = env.app().getJobQueue();
+        {
+            // Every index is visited exactly once.
+            std::vector<std::atomic<int>> seen(1000);
+            jQueue.parallelFor(jtCLIENT, "parallelFor", 1000, 4, [&](auto i) {
+                ++seen[i];
+            });
+            BEAST_EXPECT(std::all_of(seen.begin(), seen.end(), [](auto& s) {
+                return s == 1;
+            }));
+        }
+        {
+            // Exceptions reach the caller after the other calls finish.
+            std::atomic<int> ran{0};
+            bool threw = false;
+            try
+            {
+                jQueue.parallelFor(jtCLIENT, "parallelFor", 64, 4, [&](auto i) {
+                    ++ran;
+                    if (i == 10)
+                        Throw<std::runtime_error>("parallelFor");
+                });
+            }
+            catch (std::runtime_error const&)
+            {
+                threw = true;
+            }
+            BEAST_EXPECT(threw);
+            BEAST_EXPECT(ran == 64);
+        }
+        {
+            // A type whose single slot is taken still completes, on the
+            // calling thread.
+            std::atomic<bool> release{false};
+            std::atomic<bool> started{false};
+            jQueue.addJob(jtPACK, "gate", [&]() {
+                started = true;
+                while (!release)
+                    std::this_thread::sleep_for(1ms);
+            });
+            while (!started)
+                std::this_thread::sleep_for(1ms);
+
+            auto const caller = std::this_thread::get_id();
+            bool onCaller = true;
+            jQueue.parallelFor(jtPACK, "parallelFor", 16, 4, [&](auto) {
+                onCaller = onCaller && std::this_thread::get_id() == caller;
+            });
+            BEAST_EXPECT(onCaller);
+            release = true;
+            jQueue.rendezvous();
+        }
+        {
+            // Once the queue stops, the caller does all of the work.
+            jQueue.stop();
+            std::atomic<int> ran{0};
+            jQueue.parallelFor(
+                jtCLIENT, "parallelFor", 16, 4, [&](auto) { ++ran; });
+            BEAST_EXPECT(ran == 16);
+        }
+    }
+
 public:
     void
     run() override
     {
         testAddJob();
         testPostCoro();
+        testPostCoroWhileStopping();
+        testWorkStealing();
+        testParallelFor();
+    }
+};
+
+// Compares how many short jobs per second the shared and the work-stealing
+// schedulers run as the number of threads grows.
+class JobQueueThroughput_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+        jtx::Env env{*this};
+
+        constexpr int producers = 4;
+        constexpr int jobsPerProducer = 50000;
+        JobType const types[] = {
+            jtCLIENT, jtTRANSACTION, jtLEDGER_DATA, jtVALIDATION_t, jtBATCH};
+
+        for (int const threads : {2, 4, 8, 16, 32, 64})
+        {
+            for (bool const stealing : {false, true})
+            {
+                JobQueue jq(
+                    threads,
+                    beast::insight::NullCollector::New(),
+                    env.journal,
+                    env.app().logs(),
+                    env.app().getPerfLog(),
+                    stealing);
+
+                std::atomic<std::uint64_t> sum{0};
+                std::vector<std::thread> workers;
+                workers.reserve(producers);
+
+                auto const start = steady_clock::now();
+                for (int p = 0; p < producers; ++p)
+                {
+                    workers.emplace_back([&, p]() {
+                        for (int i = 0; i < jobsPerProducer; ++i)
+                        {
+                            jq.addJob(types[(p + i) % 5], "bench", [&sum, i]() {
+                                sum.fetch_add(i, std::memory_order_relaxed);
+                            });
+                        }
+                    });
+                }
+                for (auto& w : workers)
+                    w.join();
+                jq.rendezvous();
+                auto const elapsed =
+                    duration_cast<microseconds>(steady_clock::now() - start);
+                jq.stop();
+
+                constexpr std::uint64_t jobs = producers * jobsPerProducer;
+                BEAST_EXPECT(
+                    sum == producers * (jobsPerProducer - 1) *
+                            std::uint64_t(jobsPerProducer) / 2);
+                log << threads << " threads, "
+                    << (stealing ? "stealing" : "shared") << ": "
+                    << (jobs * 1000000) /
+                        std::max<std::int64_t>(1, elapsed.count())
+                    << " jobs/s" << std::endl;
+            }
+        }
     }
 };
 
 BEAST_DEFINE_TESTSUITE(JobQueue, core, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(JobQueueThroughput, core, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -86,6 +86,12 @@ class PerfLogTest : public PerfLog
         return Json::Value();
     }
 
+    Json::Value
+    latencyJson() const override
+    {
+        return Json::Value();
+    }
+
     void
     resizeJobs(int const resize) override
     {
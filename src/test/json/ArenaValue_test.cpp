@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/json/ArenaValue.h>
+#include <xrpl/json/json_value.h>
+#include <xrpl/json/json_writer.h>
+#include <xrpl/json/to_string.h>
+#include <xrpl/protocol/jss.h>
+
+#include <chrono>
+#include <string>
+
+namespace ripple {
+
+namespace {
+
+// Build the same response into a Json::Value or a Json::ArenaValue.
+template <class JsonValue>
+void
+buildLedgerData(JsonValue& result, int objects)
+{
+    result[jss::ledger_index] = 1000u;
+    result[jss::ledger_hash] = std::string(64, 'A');
+    result[jss::validated] = true;
+    auto& state = result[jss::state];
+    state = Json::arrayValue;
+    for (int i = 0; i < objects; ++i)
+    {
+        auto& entry = state.append(Json::objectValue);
+        entry[jss::index] = std::string(64, '0' + i % 10);
+        entry[jss::type] = Json::StaticString("AccountRoot");
+        entry[jss::Account] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        entry[jss::balance] = std::to_string(1000000 + i);
+        entry[jss::Flags] = 0u;
+        entry[jss::Fee] = i % 7;
+        entry[jss::Sequence] = static_cast<Json::UInt>(i);
+        entry[jss::ledger_index] = 999u;
+    }
+    result[jss::marker] = std::string(64, 'F');
+}
+
+}  // namespace
+
+struct ArenaValue_test : beast::unit_test::suite
+{
+    void
+    testBuild()
+    {
+        testcase("build");
+
+        Json::Value value;
+        Json::Document doc;
+        buildLedgerData(value, 25);
+        buildLedgerData(doc.root(), 25);
+
+        BEAST_EXPECT(Json::to_string(doc.root()) == Json::to_string(value));
+        BEAST_EXPECT(doc.root() == value);
+        BEAST_EXPECT(doc.root().toValue() == value);
+
+        std::string streamed;
+        Json::stream(doc.root(), [&streamed](void const* p, std::size_t n) {
+            streamed.append(static_cast<char const*>(p), n);
+        });
+        BEAST_EXPECT(streamed == Json::to_string(value) + "\n");
+
+        auto const& root = doc.root();
+        BEAST_EXPECT(root.isObject());
+        BEAST_EXPECT(root.size() == value.size());
+        BEAST_EXPECT(root[jss::state].size() == 25);
+        BEAST_EXPECT(root[jss::validated].asBool());
+        BEAST_EXPECT(root[jss::ledger_index].asUInt() == 1000);
+        BEAST_EXPECT(root[jss::ledger_index].asString() == "1000");
+        BEAST_EXPECT(
+            root[jss::state][3u][jss::balance].asString() == "1000003");
+        BEAST_EXPECT(root["missing"].isNull());
+        BEAST_EXPECT(root[jss::state][25u].isNull());
+    }
+
+    void
+    testMembers()
+    {
+        testcase("members");
+
+        Json::Document doc;
+        auto& root = doc.root();
+
+        // Names added out of order are visited in order.
+        root["zebra"] = 1;
+        root[jss::account] = "a";
+        root[std::string("middle")] = 2.5;
+        root["apple"] = Json::nullValue;
+        BEAST_EXPECT(
+            Json::to_string(root) ==
+            R"({"account":"a","apple":null,"middle":2.5,"zebra":1})");
+
+        // A reference to a member survives adding others around it.
+        auto& middle = root["middle"];
+        for (int i = 0; i < 100; ++i)
+            root["key" + std::to_string(i)] = i;
+        middle = "still here";
+        BEAST_EXPECT(root["middle"].asString() == "still here");
+        BEAST_EXPECT(root.size() == 104);
+
+        BEAST_EXPECT(root.isMember("key42"));
+        BEAST_EXPECT(root.removeMember("key42"));
+        BEAST_EXPECT(!root.isMember("key42"));
+        BEAST_EXPECT(!root.removeMember("key42"));
+        BEAST_EXPECT(root.size() == 103);
+
+        // Assigning to an existing member replaces it.
+        root[jss::account] = Json::objectValue;
+        root[jss::account][jss::value] = 5;
+        BEAST_EXPECT(root.size() == 103);
+        BEAST_EXPECT(root[jss::account][jss::value].asInt() == 5);
+
+        // Arrays grow with nulls, like Json::Value.
+        Json::Value value;
+        value[3u] = 7;
+        Json::Document array(Json::nullValue);
+        array.root()[3u] = 7;
+        BEAST_EXPECT(Json::to_string(array.root()) == "[null,null,null,7]");
+        BEAST_EXPECT(Json::to_string(array.root()) == Json::to_string(value));
+    }
+
+    void
+    testCopy()
+    {
+        testcase("copy");
+
+        Json::Value value;
+        buildLedgerData(value, 10);
+        value["dynamic name"] = -12;
+        value["real"] = 0.5;
+
+        Json::Document doc;
+        doc.root() = value;
+        BEAST_EXPECT(doc.root() == value);
+        BEAST_EXPECT(Json::to_string(doc.root()) == Json::to_string(value));
+
+        // Between documents, and within one.
+        Json::Document other;
+        other.root() = doc.root();
+        other.root()["copy"] = doc.root()[jss::state];
+        BEAST_EXPECT(other.root()["copy"] == value[jss::state]);
+        other.root()["copy"] = other.root();
+        BEAST_EXPECT(other.root()["copy"][jss::state] == value[jss::state]);
+        BEAST_EXPECT(doc.root() == value);
+    }
+
+    void
+    testArena()
+    {
+        testcase("arena");
+
+        // Static names are not copied into the arena.
+        Json::Document interned;
+        Json::Document copied;
+        for (auto const& name : {jss::account, jss::ledger_index, jss::state})
+        {
+            interned.root()[name] = 1;
+            copied.root()[std::string(name.c_str())] = 1;
+        }
+        BEAST_EXPECT(interned.root() == copied.root().toValue());
+        BEAST_EXPECT(interned.arena().bytes() < copied.arena().bytes());
+
+        // A large document takes a few blocks from the heap.
+        Json::Document doc;
+        buildLedgerData(doc.root(), 1000);
+        BEAST_EXPECT(doc.arena().blocks() > 0);
+        BEAST_EXPECT(doc.arena().blocks() < 100);
+    }
+
+    void
+    run() override
+    {
+        testBuild();
+        testMembers();
+        testCopy();
+        testArena();
+    }
+};
+
+// Builds and serializes a large ledger_data-like response with Json::Value
+// and with Json::Document, and reports the time taken and the number of
+// heap allocations.
+class ArenaValueResponse_test : public beast::unit_test::suite
+{
+    static constexpr int objects = 100000;
+    static constexpr int rounds = 5;
+
+    // Json::Value allocates a map for each object, a node for each member
+    // and element, and a copy of each string. The names used here are all
+    // static so they are not copied.
+    static std::size_t
+    allocations(Json::Value const& value)
+    {
+        std::size_t n = 0;
+        switch (value.type())
+        {
+            case Json::stringValue:
+                return 1;
+            case Json::arrayValue:
+            case Json::objectValue:
+                n = 1;
+                for (auto const& child : value)
+                    n += 1 + allocations(child);
+                return n;
+            default:
+                return 0;
+        }
+    }
+
+    template <class Build>
+    void
+    measure(char const* name, Build build)
+    {
+        using namespace std::chrono;
+
+        microseconds buildTime{0};
+        microseconds writeTime{0};
+        std::size_t allocs = 0;
+        std::size_t bytes = 0;
+        for (int i = 0; i < rounds; ++i)
+        {
+            auto const start = steady_clock::now();
+            build([&](auto const& root, std::size_t n) {
+                auto const built = steady_clock::now();
+                std::string out;
+                Json::stream(root, [&out](void const* p, std::size_t size) {
+                    out.append(static_cast<char const*>(p), size);
+                });
+                auto const written = steady_clock::now();
+                buildTime += duration_cast<microseconds>(built - start);
+                writeTime += duration_cast<microseconds>(written - built);
+                allocs = n;
+                bytes = out.size();
+            });
+        }
+        log << name << ": build " << buildTime.count() / rounds
+            << " us, write " << writeTime.count() / rounds << " us, "
+            << allocs << " heap allocations, " << bytes << " bytes"
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("large response");
+
+        measure("Json::Value", [](auto&& done) {
+            Json::Value value;
+            buildLedgerData(value, objects);
+            done(value, allocations(value));
+        });
+
+        measure("Json::Document", [](auto&& done) {
+            Json::Document doc;
+            buildLedgerData(doc.root(), objects);
+            done(doc.root(), doc.arena().blocks());
+        });
+
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ArenaValue, json, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(ArenaValueResponse, json, ripple);
+
+}  // namespace ripple
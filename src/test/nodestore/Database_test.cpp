@@ -657,6 +657,36 @@ public:
                 fetchCopyOfBatch(*db, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Read it back with one batch request, large enough to be
+                // split between the read threads, interleaving hashes that
+                // were never stored
+                auto const missing =
+                    createPredictableBatch(numObjsToTest, rng());
+                std::vector<uint256> hashes;
+                hashes.reserve(batch.size() + missing.size());
+                for (int i = 0; i < batch.size(); ++i)
+                {
+                    hashes.push_back(batch[i]->getHash());
+                    hashes.push_back(missing[i]->getHash());
+                }
+
+                auto const objects = db->fetchNodeObjects(hashes);
+                BEAST_EXPECT(objects.size() == hashes.size());
+
+                Batch copy;
+                bool missingAbsent = true;
+                for (int i = 0; i < objects.size(); ++i)
+                {
+                    if (i % 2)
+                        missingAbsent = missingAbsent && !objects[i];
+                    else if (objects[i])
+                        copy.push_back(objects[i]);
+                }
+                BEAST_EXPECT(missingAbsent);
+                BEAST_EXPECT(areBatchesEqual(batch, copy));
+            }
         }
 
         if (testPersistence)
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/nodestore/TestBase.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <xrpld/nodestore/DummyScheduler.h>
+#include <xrpld/nodestore/Manager.h>
+#include <xrpld/nodestore/detail/DatabaseRotatingImp.h>
+#include <xrpld/nodestore/detail/MappedStore.h>
+
+#include <xrpl/basics/ByteUtilities.h>
+#include <xrpl/beast/utility/temp_dir.h>
+#include <xrpl/protocol/HashPrefix.h>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace ripple {
+namespace NodeStore {
+
+class MappedStore_test : public TestBase
+{
+    // Inner nodes are stored in their own fixed-size slots, so mix some in.
+    static Batch
+    createBatch(int numObjects, std::uint64_t seed)
+    {
+        auto batch = createPredictableBatch(numObjects, seed);
+        beast::xor_shift_engine rng(~seed);
+        for (int i = 0; i < numObjects / 4; ++i)
+        {
+            uint256 hash;
+            beast::rngfill(hash.begin(), hash.size(), rng);
+
+            Blob blob(MappedStore::innerNodeBytes);
+            beast::rngfill(blob.data(), blob.size(), rng);
+            boost::endian::store_big_u32(
+                blob.data(), static_cast<std::uint32_t>(HashPrefix::innerNode));
+
+            batch.push_back(NodeObject::createObject(
+                hotACCOUNT_NODE, std::move(blob), hash));
+        }
+        return batch;
+    }
+
+    std::unique_ptr<Backend>
+    makeBackend(
+        std::string const& type,
+        std::string const& path,
+        Scheduler& scheduler,
+        beast::Journal journal)
+    {
+        Section params;
+        params.set("type", type);
+        params.set("path", path);
+        auto backend = Manager::instance().make_Backend(
+            params, megabytes(4), scheduler, journal);
+        backend->open();
+        return backend;
+    }
+
+    void
+    testBackend()
+    {
+        testcase("read-only backend");
+
+        DummyScheduler scheduler;
+        test::SuiteJournal journal("MappedStore_test", *this);
+        beast::temp_dir tempDir;
+        auto const path = tempDir.file("history.map");
+
+        auto batch = createBatch(2000, 71);
+
+        {
+            auto source = makeBackend(
+                "memory", tempDir.file("source"), scheduler, journal);
+            storeBatch(*source, batch);
+            // A duplicate appears once in the index.
+            source->store(batch.front());
+            BEAST_EXPECT(
+                writeMappedStore(*source, path, journal) == batch.size());
+
+            // Merging many small sorted runs writes the same file, and
+            // leaves no temporary files behind.
+            auto const merged = tempDir.file("merged.map");
+            BEAST_EXPECT(
+                writeMappedStore(*source, merged, journal, 7) == batch.size());
+            auto const read = [](std::string const& file) {
+                std::ifstream is(file, std::ios::binary);
+                return std::string(
+                    std::istreambuf_iterator<char>(is),
+                    std::istreambuf_iterator<char>());
+            };
+            BEAST_EXPECT(read(path) == read(merged));
+            BEAST_EXPECT(!boost::filesystem::exists(merged + ".run0"));
+            BEAST_EXPECT(!boost::filesystem::exists(merged + ".objects"));
+        }
+
+        auto backend = makeBackend("mapped", path, scheduler, journal);
+        {
+            Batch copy;
+            fetchCopyOfBatch(*backend, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+        }
+
+        {
+            std::vector<uint256 const*> keys;
+            for (auto const& object : batch)
+                keys.push_back(&object->getHash());
+            auto const [copy, status] = backend->fetchBatch(keys);
+            BEAST_EXPECT(status == ok);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+        }
+
+        fetchMissing(*backend, createPredictableBatch(100, 72));
+
+        {
+            Batch copy;
+            backend->for_each(
+                [&copy](std::shared_ptr<NodeObject> o) { copy.push_back(o); });
+            std::sort(batch.begin(), batch.end(), LessThan{});
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+        }
+
+        try
+        {
+            backend->store(batch.front());
+            fail("store should throw");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+
+        // Inner nodes are read in place from an aligned slot.
+        MappedStore store(path);
+        BEAST_EXPECT(store.size() == batch.size());
+        bool aligned = true;
+        for (auto const& object : batch)
+        {
+            auto const record = store.find(object->getHash().data());
+            if (!record)
+            {
+                aligned = false;
+                break;
+            }
+            auto const address =
+                reinterpret_cast<std::uintptr_t>(record->data.data());
+            if (record->data.size() == MappedStore::innerNodeBytes)
+                aligned = aligned && address % 8 == 0;
+        }
+        BEAST_EXPECT(aligned);
+    }
+
+    void
+    testInvalidFiles()
+    {
+        testcase("invalid files");
+
+        DummyScheduler scheduler;
+        test::SuiteJournal journal("MappedStore_test", *this);
+        beast::temp_dir tempDir;
+        auto const path = tempDir.file("history.map");
+
+        {
+            auto source = makeBackend(
+                "memory", tempDir.file("empty"), scheduler, journal);
+            BEAST_EXPECT(writeMappedStore(*source, path, journal) == 0);
+        }
+        {
+            // An empty store is valid and finds nothing.
+            MappedStore store(path);
+            BEAST_EXPECT(store.size() == 0);
+            BEAST_EXPECT(!store.find(uint256{1}.data()));
+        }
+
+        auto expectThrow = [&](std::string const& file) {
+            try
+            {
+                MappedStore store(file);
+                fail("opening " + file + " should throw");
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        };
+
+        expectThrow(tempDir.file("missing.map"));
+
+        {
+            // Truncated
+            std::ofstream os(
+                tempDir.file("short.map"), std::ios::binary | std::ios::trunc);
+            os << "XRPLNMAP";
+        }
+        expectThrow(tempDir.file("short.map"));
+
+        {
+            // Wrong magic
+            std::fstream os(
+                path, std::ios::binary | std::ios::in | std::ios::out);
+            os.seekp(0);
+            os << "NOTAMAP!";
+        }
+        expectThrow(path);
+    }
+
+    void
+    testRotatingTier()
+    {
+        testcase("read-only tier below rotating backends");
+
+        DummyScheduler scheduler;
+        test::SuiteJournal journal("MappedStore_test", *this);
+        beast::temp_dir tempDir;
+        auto const path = tempDir.file("history.map");
+
+        auto const history = createBatch(400, 81);
+        auto const recent = createPredictableBatch(100, 82);
+
+        {
+            auto source = makeBackend(
+                "memory", tempDir.file("history"), scheduler, journal);
+            storeBatch(*source, history);
+            writeMappedStore(*source, path, journal);
+        }
+
+        std::shared_ptr<Backend> writable =
+            makeBackend("memory", tempDir.file("writable"), scheduler, journal);
+        storeBatch(*writable, recent);
+
+        std::shared_ptr<Backend> archive =
+            makeBackend("memory", tempDir.file("archive"), scheduler, journal);
+        auto const archived = createPredictableBatch(50, 83);
+        storeBatch(*archive, archived);
+
+        DatabaseRotatingImp db(
+            scheduler,
+            1,
+            writable,
+            archive,
+            Section{},
+            journal,
+            makeBackend("mapped", path, scheduler, journal));
+
+        Batch copy;
+        fetchCopyOfBatch(db, &copy, history);
+        BEAST_EXPECT(areBatchesEqual(history, copy));
+        fetchCopyOfBatch(db, &copy, recent);
+        BEAST_EXPECT(areBatchesEqual(recent, copy));
+
+        // Objects read from the immutable tier are not copied forward.
+        fetchMissing(*writable, history);
+
+        // A batch mixing every tier, with misses, lands in order.
+        std::vector<uint256> hashes;
+        for (std::size_t i = 0; i < history.size(); ++i)
+        {
+            hashes.push_back(history[i]->getHash());
+            if (i < recent.size())
+                hashes.push_back(recent[i]->getHash());
+            if (i % 7 == 0)
+                hashes.push_back(uint256{i + 1});
+        }
+        auto const results = db.fetchNodeObjects(hashes, 0, false);
+        bool matched = results.size() == hashes.size();
+        for (std::size_t i = 0; matched && i < hashes.size(); ++i)
+        {
+            if (results[i])
+                matched = results[i]->getHash() == hashes[i];
+            else
+                matched = hashes[i] < uint256{history.size() + 1};
+        }
+        BEAST_EXPECT(matched);
+
+        // Like a single fetch, a batch copies objects found in the archive
+        // forward only when asked to.
+        hashes.clear();
+        for (auto const& object : archived)
+            hashes.push_back(object->getHash());
+        BEAST_EXPECT(
+            db.fetchNodeObjects(hashes, 0, false).size() == hashes.size());
+        fetchMissing(*writable, archived);
+        db.fetchNodeObjects(hashes, 0, true);
+        fetchCopyOfBatch(*writable, &copy, archived);
+        BEAST_EXPECT(areBatchesEqual(archived, copy));
+
+        // Rotation leaves the immutable tier in place.
+        db.rotate(
+            makeBackend("memory", tempDir.file("next"), scheduler, journal),
+            [](std::string const&, std::string const&) {});
+        db.rotate(
+            makeBackend("memory", tempDir.file("last"), scheduler, journal),
+            [](std::string const&, std::string const&) {});
+        fetchCopyOfBatch(db, &copy, history);
+        BEAST_EXPECT(areBatchesEqual(history, copy));
+    }
+
+public:
+    void
+    run() override
+    {
+        testBackend();
+        testInvalidFiles();
+        testRotatingTier();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(MappedStore, nodestore, ripple);
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/overlay/Message.h>
+#include <xrpld/overlay/detail/SendQueue.h>
+#include <xrpld/overlay/detail/Tuning.h>
+
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/messages.h>
+
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+namespace test {
+
+class SendQueue_test : public beast::unit_test::suite
+{
+    using Compressed = compression::Compressed;
+    using Messages = std::vector<std::shared_ptr<Message>>;
+
+    static std::shared_ptr<Message>
+    transaction(std::size_t size = 100)
+    {
+        protocol::TMTransaction m;
+        m.set_rawtransaction(std::string(size, 't'));
+        m.set_status(protocol::tsNEW);
+        return std::make_shared<Message>(m, protocol::mtTRANSACTION);
+    }
+
+    static std::shared_ptr<Message>
+    validation()
+    {
+        protocol::TMValidation m;
+        m.set_validation(std::string(100, 'v'));
+        return std::make_shared<Message>(m, protocol::mtVALIDATION);
+    }
+
+    static std::shared_ptr<Message>
+    proposal()
+    {
+        protocol::TMProposeSet m;
+        m.set_proposeseq(0);
+        m.set_currenttxhash(std::string(32, 'h'));
+        m.set_nodepubkey(std::string(33, 'k'));
+        m.set_closetime(0);
+        m.set_signature(std::string(70, 's'));
+        m.set_previousledger(std::string(32, 'p'));
+        return std::make_shared<Message>(m, protocol::mtPROPOSE_LEDGER);
+    }
+
+    static std::shared_ptr<Message>
+    manifest()
+    {
+        protocol::TMManifests m;
+        m.add_list()->set_stobject(std::string(100, 'm'));
+        return std::make_shared<Message>(m, protocol::mtMANIFESTS);
+    }
+
+    // Start a write and return the messages it selected, in order.
+    Messages
+    write(SendQueue& queue, Messages const& all)
+    {
+        Messages written;
+        for (auto const& buffer : queue.startWrite(Compressed::Off))
+        {
+            for (auto const& m : all)
+            {
+                if (m->getBuffer(Compressed::Off).data() == buffer.data())
+                {
+                    written.push_back(m);
+                    break;
+                }
+            }
+        }
+        BEAST_EXPECT(written.size() == queue.writing());
+        return written;
+    }
+
+    void
+    testGather()
+    {
+        testcase("gather");
+
+        // No more than maxWriteMessages messages go in one write.
+        {
+            SendQueue queue;
+            Messages all;
+            for (int i = 0; i < Tuning::maxWriteMessages + 10; ++i)
+            {
+                all.push_back(transaction());
+                queue.push(all.back());
+            }
+
+            auto const first = write(queue, all);
+            BEAST_EXPECT(first.size() == Tuning::maxWriteMessages);
+            BEAST_EXPECT(first.front() == all.front());
+            queue.finishWrite();
+            BEAST_EXPECT(queue.size() == 10);
+
+            auto const second = write(queue, all);
+            BEAST_EXPECT(second.size() == 10);
+            BEAST_EXPECT(second.back() == all.back());
+            queue.finishWrite();
+            BEAST_EXPECT(queue.empty());
+        }
+
+        // No more than maxWriteBytes, unless a message is larger on its own.
+        {
+            SendQueue queue;
+            Messages all;
+            for (auto const size :
+                 {Tuning::maxWriteBytes / 3,
+                  Tuning::maxWriteBytes / 3,
+                  Tuning::maxWriteBytes / 3,
+                  2 * Tuning::maxWriteBytes,
+                  std::size_t{100}})
+            {
+                all.push_back(transaction(size));
+                queue.push(all.back());
+            }
+
+            // The headers take three of the first messages over the limit.
+            BEAST_EXPECT((write(queue, all) == Messages{all[0], all[1]}));
+            queue.finishWrite();
+            BEAST_EXPECT(write(queue, all) == Messages{all[2]});
+            queue.finishWrite();
+            BEAST_EXPECT(write(queue, all) == Messages{all[3]});
+            queue.finishWrite();
+            BEAST_EXPECT(write(queue, all) == Messages{all[4]});
+            queue.finishWrite();
+            BEAST_EXPECT(queue.empty());
+        }
+    }
+
+    void
+    testPriority()
+    {
+        testcase("priority");
+
+        // Consensus messages overtake bulk traffic but not each other, so a
+        // manifest stays ahead of the validation signed with its key.
+        SendQueue queue;
+        auto const t1 = transaction();
+        auto const m1 = manifest();
+        auto const v1 = validation();
+        auto const p1 = proposal();
+        auto const t2 = transaction();
+        Messages const all{t1, m1, v1, p1, t2};
+        for (auto const& m : all)
+            queue.push(m);
+
+        BEAST_EXPECT(queue.priorityQueued() == 3);
+        BEAST_EXPECT((write(queue, all) == Messages{m1, v1, p1, t1, t2}));
+        BEAST_EXPECT(queue.priorityQueued() == 0);
+        queue.finishWrite();
+        BEAST_EXPECT(queue.empty());
+    }
+
+    void
+    testPartialBatches()
+    {
+        testcase("partial batches");
+
+        SendQueue queue;
+        Messages all;
+        auto const push = [&](std::shared_ptr<Message> const& m) {
+            all.push_back(m);
+            queue.push(m);
+            return m;
+        };
+
+        // Messages queued during a write never go ahead of it.
+        auto const t1 = push(transaction());
+        auto const t2 = push(transaction());
+        BEAST_EXPECT((write(queue, all) == Messages{t1, t2}));
+        BEAST_EXPECT(queue.writing() == 2);
+
+        auto const t3 = push(transaction());
+        Messages validations;
+        for (int i = 0; i < Tuning::maxWriteMessages + 6; ++i)
+            validations.push_back(push(validation()));
+        BEAST_EXPECT(queue.writing() == 2);
+        BEAST_EXPECT(queue.priorityQueued() == validations.size());
+
+        queue.finishWrite();
+        BEAST_EXPECT(queue.writing() == 0);
+        BEAST_EXPECT(queue.size() == validations.size() + 1);
+
+        // A write that takes only part of the priority lane leaves the rest
+        // of it ahead of the bulk traffic.
+        BEAST_EXPECT(
+            write(queue, all) ==
+            Messages(
+                validations.begin(),
+                validations.begin() + Tuning::maxWriteMessages));
+        BEAST_EXPECT(queue.priorityQueued() == 6);
+
+        auto const t4 = push(transaction());
+        auto const p1 = push(proposal());
+        BEAST_EXPECT(queue.priorityQueued() == 7);
+        queue.finishWrite();
+
+        Messages expected(
+            validations.begin() + Tuning::maxWriteMessages, validations.end());
+        expected.insert(expected.end(), {p1, t3, t4});
+        BEAST_EXPECT(write(queue, all) == expected);
+        BEAST_EXPECT(queue.priorityQueued() == 0);
+        queue.finishWrite();
+        BEAST_EXPECT(queue.empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        testGather();
+        testPriority();
+        testPartialBatches();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SendQueue, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
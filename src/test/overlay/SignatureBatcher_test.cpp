@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+
+#include <xrpld/core/JobQueue.h>
+#include <xrpld/overlay/detail/SignatureBatcher.h>
+
+#include <xrpl/beast/insight/NullCollector.h>
+#include <xrpl/beast/unit_test.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class SignatureBatcher_test : public beast::unit_test::suite
+{
+    void
+    testResults()
+    {
+        testcase("results reach their continuations");
+
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+
+        SignatureBatcher batcher(
+            env.app().getJobQueue(),
+            beast::insight::NullCollector::New(),
+            env.journal);
+
+        // More than one batch's worth, so several jobs share the work.
+        constexpr int count = 3 * SignatureBatcher::maxBatchSize + 7;
+
+        std::mutex m;
+        std::condition_variable cv;
+        std::vector<int> results(count, -1);
+        int done = 0;
+
+        for (int i = 0; i < count; ++i)
+        {
+            batcher.add(
+                i % 2 ? jtTRANSACTION : jtVALIDATION_ut,
+                [i]() {
+                    if (i % 11 == 0)
+                        throw std::runtime_error("malformed");
+                    return i % 3 != 0;
+                },
+                [&, i](bool good) {
+                    std::lock_guard lock(m);
+                    results[i] = good ? 1 : 0;
+                    if (++done == count)
+                        cv.notify_all();
+                });
+        }
+
+        {
+            std::unique_lock lock(m);
+            BEAST_EXPECT(cv.wait_for(lock, 30s, [&] { return done == count; }));
+        }
+
+        int failed = 0;
+        bool correct = true;
+        for (int i = 0; i < count; ++i)
+        {
+            bool const expected = i % 11 != 0 && i % 3 != 0;
+            correct = correct && results[i] == (expected ? 1 : 0);
+            if (!expected)
+                ++failed;
+        }
+        BEAST_EXPECT(correct);
+
+        BEAST_EXPECT(batcher.pending(jtTRANSACTION) == 0);
+        BEAST_EXPECT(batcher.pending(jtVALIDATION_ut) == 0);
+
+        Json::Value counts(Json::objectValue);
+        batcher.getCountsJson(counts);
+        BEAST_EXPECT(counts[jss::sig_verified] == std::to_string(count));
+        BEAST_EXPECT(counts["sig_failed"] == std::to_string(failed));
+        BEAST_EXPECT(counts[jss::sig_verify_queue] == 0);
+    }
+
+    void
+    testGetCounts()
+    {
+        testcase("get_counts");
+
+        using namespace jtx;
+        Env env{*this};
+
+        auto const result = env.rpc("get_counts");
+        BEAST_EXPECT(result[jss::result].isMember(jss::sig_verified));
+        BEAST_EXPECT(result[jss::result].isMember(jss::sig_verify_per_second));
+    }
+
+public:
+    void
+    run() override
+    {
+        testResults();
+        testGetCounts();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SignatureBatcher, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
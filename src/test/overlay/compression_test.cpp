@@ -29,6 +29,7 @@
 #include <xrpld/overlay/Message.h>
 #include <xrpld/overlay/detail/Handshake.h>
 #include <xrpld/overlay/detail/ProtocolMessage.h>
+#include <xrpld/overlay/detail/TrafficCount.h>
 #include <xrpld/overlay/detail/ZeroCopyStream.h>
 #include <xrpld/shamap/SHAMapNodeID.h>
 
@@ -37,6 +38,7 @@
 #include <xrpl/beast/utility/Journal.h>
 #include <xrpl/protocol/HashPrefix.h>
 #include <xrpl/protocol/PublicKey.h>
+#include <xrpl/protocol/STValidation.h>
 #include <xrpl/protocol/SecretKey.h>
 #include <xrpl/protocol/Sign.h>
 #include <xrpl/protocol/digest.h>
@@ -48,6 +50,7 @@
 #include <boost/endian/conversion.hpp>
 
 #include <algorithm>
+#include <chrono>
 
 namespace ripple {
 
@@ -94,7 +97,20 @@ public:
 
         Message m(*proto, mt);
 
-        auto& buffer = m.getBuffer(Compressed::On);
+        doTest(m, proto, Compressed::On, nbuffers);
+        doTest(m, proto, Compressed::Dictionary, nbuffers);
+        measure(*proto, mt, msg);
+    }
+
+    template <typename T>
+    void
+    doTest(
+        Message& m,
+        std::shared_ptr<T> const& proto,
+        Compressed compressed,
+        uint16_t nbuffers)
+    {
+        auto& buffer = m.getBuffer(compressed);
 
         boost::beast::multi_buffer buffers;
 
@@ -132,7 +148,8 @@ public:
             stream,
             header->payload_wire_size,
             decompressed.data(),
-            header->uncompressed_size);
+            header->uncompressed_size,
+            header->algorithm);
         BEAST_EXPECT(decompressedSize == header->uncompressed_size);
         auto const proto1 = std::make_shared<T>();
 
@@ -145,6 +162,52 @@ public:
             decompressed.begin()));
     }
 
+    // Log the wire size with each compression, and its cost per uncompressed
+    // byte, under the message's traffic category.
+    void
+    measure(
+        ::google::protobuf::Message const& proto,
+        protocol::MessageType mt,
+        std::string const& msg)
+    {
+        using namespace std::chrono;
+
+        auto const bytes = Message(proto, mt).getBuffer(Compressed::Off).size();
+        // Compress about 4MB, or the message once if it is larger
+        auto const rounds = std::max<std::size_t>(1, megabytes(4) / bytes);
+
+        auto run = [&](Compressed compressed) {
+            std::size_t wireBytes = 0;
+            auto const start = steady_clock::now();
+            for (std::size_t i = 0; i < rounds; ++i)
+                wireBytes = Message(proto, mt).getBuffer(compressed).size();
+            auto const elapsed = steady_clock::now() - start;
+            return std::make_pair(
+                wireBytes, duration_cast<nanoseconds>(elapsed).count());
+        };
+
+        // Building the message is timed once and subtracted
+        auto const base = run(Compressed::Off).second;
+
+        auto const category = TrafficCount::categorize(proto, mt, false);
+
+        std::stringstream str;
+        str << msg << " (" << TrafficCount::to_string(category)
+            << "): " << bytes << " bytes";
+        for (auto const compressed : {Compressed::On, Compressed::Dictionary})
+        {
+            auto const [wireBytes, ns] = run(compressed);
+            str << (compressed == Compressed::On ? ", lz4 " : ", lz4d ")
+                << wireBytes << " bytes ("
+                << 100 * (static_cast<double>(bytes) - wireBytes) / bytes
+                << "% saved, "
+                << static_cast<double>(std::max<std::int64_t>(ns - base, 0)) /
+                    (rounds * bytes)
+                << " ns/byte)";
+        }
+        log << str.str() << std::endl;
+    }
+
     std::shared_ptr<protocol::TMManifests>
     buildManifests(int n)
     {
@@ -236,6 +299,53 @@ public:
         return transaction;
     }
 
+    std::shared_ptr<protocol::TMProposeSet>
+    buildProposal()
+    {
+        auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+        auto const position = sha512Half(rand_int<std::uint64_t>());
+        auto const prevLedger = sha512Half(rand_int<std::uint64_t>());
+        auto const sig = signDigest(pk, sk, sha512Half(position, prevLedger));
+
+        auto proposal = std::make_shared<protocol::TMProposeSet>();
+        proposal->set_proposeseq(0);
+        proposal->set_closetime(rand_int<std::uint32_t>());
+        proposal->set_currenttxhash(position.data(), position.size());
+        proposal->set_previousledger(prevLedger.data(), prevLedger.size());
+        proposal->set_nodepubkey(pk.data(), pk.size());
+        proposal->set_signature(sig.data(), sig.size());
+
+        return proposal;
+    }
+
+    std::shared_ptr<protocol::TMValidation>
+    buildValidation()
+    {
+        auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+        auto const ledgerHash = sha512Half(rand_int<std::uint64_t>());
+
+        auto const v = std::make_shared<STValidation>(
+            NetClock::time_point{NetClock::duration{rand_int<std::uint32_t>()}},
+            pk,
+            sk,
+            calcNodeID(pk),
+            [&](STValidation& v) {
+                v.setFieldH256(sfLedgerHash, ledgerHash);
+                v.setFieldH256(
+                    sfConsensusHash, sha512Half(rand_int<std::uint64_t>()));
+                v.setFieldH256(sfValidatedHash, ledgerHash);
+                v.setFieldU32(sfLedgerSequence, rand_int<std::uint32_t>());
+                v.setFieldU64(sfCookie, rand_int<std::uint64_t>());
+                v.setFlag(vfFullValidation);
+            });
+        auto const serialized = v->getSerialized();
+
+        auto validation = std::make_shared<protocol::TMValidation>();
+        validation->set_validation(serialized.data(), serialized.size());
+
+        return validation;
+    }
+
     std::shared_ptr<protocol::TMGetLedger>
     buildGetLedger()
     {
@@ -414,6 +524,10 @@ public:
             protocol::mtTRANSACTION,
             1,
             "TMTransaction");
+        // 148B
+        doTest(buildProposal(), protocol::mtPROPOSE_LEDGER, 1, "TMProposeSet");
+        // 222B
+        doTest(buildValidation(), protocol::mtVALIDATION, 1, "TMValidation");
         // 87B
         doTest(buildGetLedger(), protocol::mtGET_LEDGER, 1, "TMGetLedger");
         // 61KB
@@ -469,45 +583,62 @@ public:
     testHandshake()
     {
         testcase("Handshake");
-        auto getEnv = [&](bool enable) {
+        auto getEnv = [&](bool enable, bool dictionary) {
             Config c;
             std::stringstream str;
             str << "[reduce_relay]\n"
                 << "vp_base_squelch_enable=1\n"
                 << "[compression]\n"
-                << enable << "\n";
+                << enable << "\n"
+                << "[compression_dictionary]\n"
+                << dictionary << "\n";
             c.loadFromString(str.str());
             auto env = std::make_shared<jtx::Env>(*this);
             env->app().config().COMPRESSION = c.COMPRESSION;
+            env->app().config().COMPRESSION_DICTIONARY =
+                c.COMPRESSION_DICTIONARY;
             env->app().config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE =
                 c.VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE;
             return env;
         };
-        auto handshake = [&](int outboundEnable, int inboundEnable) {
+        auto handshake = [&](int outboundEnable,
+                             int inboundEnable,
+                             bool outboundDictionary,
+                             bool inboundDictionary) {
             beast::IP::Address addr =
                 boost::asio::ip::make_address("172.1.1.100");
 
-            auto env = getEnv(outboundEnable);
+            auto env = getEnv(outboundEnable, outboundDictionary);
             auto request = ripple::makeRequest(
                 true,
                 env->app().config().COMPRESSION,
                 false,
                 env->app().config().TX_REDUCE_RELAY_ENABLE,
-                env->app().config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE);
+                env->app().config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE,
+                env->app().config().COMPRESSION_DICTIONARY);
             http_request_type http_request;
             http_request.version(request.version());
             http_request.base() = request.base();
             // feature enabled on the peer's connection only if both sides are
             // enabled
             auto const peerEnabled = inboundEnable && outboundEnable;
+            // and the dictionary only if both sides enable it too
+            auto const expected = !peerEnabled ? Compressed::Off
+                : outboundDictionary && inboundDictionary
+                ? Compressed::Dictionary
+                : Compressed::On;
             // inbound is enabled if the request's header has the feature
             // enabled and the peer's configuration is enabled
             auto const inboundEnabled = peerFeatureEnabled(
                 http_request, FEATURE_COMPR, "lz4", inboundEnable);
             BEAST_EXPECT(!(peerEnabled ^ inboundEnabled));
+            BEAST_EXPECT(
+                peerCompression(
+                    http_request, inboundEnable, inboundDictionary) ==
+                expected);
 
             env.reset();
-            env = getEnv(inboundEnable);
+            env = getEnv(inboundEnable, inboundDictionary);
             auto http_resp = ripple::makeResponse(
                 true,
                 http_request,
@@ -522,11 +653,49 @@ public:
             auto const outboundEnabled = peerFeatureEnabled(
                 http_resp, FEATURE_COMPR, "lz4", outboundEnable);
             BEAST_EXPECT(!(peerEnabled ^ outboundEnabled));
+            BEAST_EXPECT(
+                peerCompression(
+                    http_resp, outboundEnable, outboundDictionary) ==
+                expected);
         };
-        handshake(1, 1);
-        handshake(1, 0);
-        handshake(0, 1);
-        handshake(0, 0);
+        for (bool const outboundDictionary : {false, true})
+        {
+            for (bool const inboundDictionary : {false, true})
+            {
+                handshake(1, 1, outboundDictionary, inboundDictionary);
+                handshake(1, 0, outboundDictionary, inboundDictionary);
+                handshake(0, 1, outboundDictionary, inboundDictionary);
+                handshake(0, 0, outboundDictionary, inboundDictionary);
+            }
+        }
+
+        // The dictionary is off by default
+        {
+            Config c;
+            c.loadFromString("[compression]\n1\n");
+            BEAST_EXPECT(c.COMPRESSION && !c.COMPRESSION_DICTIONARY);
+        }
+
+        // A peer that only offers lz4 doesn't get the dictionary
+        {
+            http_request_type request;
+            request.insert("X-Protocol-Ctl", "compr=lz4");
+            BEAST_EXPECT(
+                peerCompression(request, true, true) == Compressed::On);
+            auto const features = makeFeaturesResponseHeader(
+                request, true, false, false, false, true);
+            BEAST_EXPECT(features == "compr=lz4;");
+        }
+
+        // Nor does a peer that offers it to a server that doesn't enable it
+        {
+            http_request_type request;
+            request.insert("X-Protocol-Ctl", "compr=lz4,lz4d1");
+            BEAST_EXPECT(peerCompression(request, true) == Compressed::On);
+            auto const features =
+                makeFeaturesResponseHeader(request, true, false, false, false);
+            BEAST_EXPECT(features == "compr=lz4;");
+        }
     }
 
     void
@@ -135,6 +135,9 @@ public:
         // known category returns known string value
         BEAST_EXPECT(
             TrafficCount::to_string(TrafficCount::category::total) == "total");
+        BEAST_EXPECT(
+            TrafficCount::to_string(TrafficCount::category::writes) ==
+            "writes");
 
         // return "unknown" for unknown categories
         BEAST_EXPECT(
@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <test/jtx.h>
+#include <test/jtx/mpt.h>
+
+#include <xrpl/json/Output.h>
+#include <xrpl/json/Writer.h>
+#include <xrpl/protocol/jss.h>
+
+#include <chrono>
+
+namespace ripple {
+
+namespace {
+
+std::string
+writeJson(STBase const& st, JsonOptions options)
+{
+    std::string s;
+    {
+        Json::Writer w(Json::stringOutput(s));
+        st.writeJson(w, options);
+    }
+    return s;
+}
+
+// A ledger holding payments in XRP, an IOU and an MPT, an offer and a memo.
+void
+buildLedger(test::jtx::Env& env, int payments)
+{
+    using namespace test::jtx;
+
+    Account const alice("alice");
+    Account const bob("bob");
+    Account const gw("gw");
+    auto const USD = gw["USD"];
+
+    env.fund(XRP(100000), alice, bob, gw);
+    env.close();
+    env.trust(USD(100000), alice, bob);
+    env(pay(gw, alice, USD(10000)));
+    env(offer(alice, XRP(100), USD(50)));
+    env(pay(alice, bob, XRP(1)), memo("data", "format", "type"));
+
+    MPTTester mpt(env, gw, {.holders = {bob}, .fund = false});
+    mpt.create({.flags = tfMPTCanTransfer});
+    mpt.authorize({.account = bob});
+    mpt.pay(gw, bob, 100);
+
+    for (int i = 0; i < payments; ++i)
+    {
+        if (i % 2)
+            env(pay(alice, bob, USD(1)));
+        else
+            env(pay(bob, alice, drops(1000 + i)));
+    }
+    env.close();
+}
+
+}  // namespace
+
+class STWriteJson_test : public beast::unit_test::suite
+{
+    void
+    expectSame(STBase const& st, JsonOptions options)
+    {
+        auto const expected = Json::jsonAsString(st.getJson(options));
+        auto const actual = writeJson(st, options);
+        if (!BEAST_EXPECT(actual == expected))
+            log << expected << "\n" << actual << std::endl;
+    }
+
+    void
+    testLedger()
+    {
+        testcase("transactions, metadata and ledger entries");
+
+        using namespace test::jtx;
+        Env env(*this);
+        buildLedger(env, 10);
+
+        for (auto const& [tx, meta] : env.closed()->txs)
+        {
+            expectSame(*tx, JsonOptions::none);
+            expectSame(*tx, JsonOptions::disable_API_prior_V2);
+            expectSame(*meta, JsonOptions::none);
+        }
+
+        bool sawIssuance = false;
+        for (auto const& sle : env.closed()->sles)
+        {
+            sawIssuance |= sle->getType() == ltMPTOKEN_ISSUANCE;
+            expectSame(*sle, JsonOptions::none);
+        }
+        BEAST_EXPECT(sawIssuance);
+    }
+
+    void
+    testValues()
+    {
+        testcase("values");
+
+        using namespace test::jtx;
+        Account const gw("gw");
+
+        expectSame(STAmount(sfAmount, XRPAmount(-17)), JsonOptions::none);
+        expectSame(gw["USD"](-1.5).value(), JsonOptions::none);
+        expectSame(
+            STAmount(sfAmount, MPTIssue(makeMptID(3, gw.id())), 12),
+            JsonOptions::none);
+        expectSame(STAccount(sfAccount), JsonOptions::none);
+        expectSame(STBlob(sfMemoData), JsonOptions::none);
+
+        // A type without its own writer falls back to getJson.
+        STVector256 hashes(sfHashes);
+        hashes.push_back(uint256{1});
+        expectSame(hashes, JsonOptions::none);
+
+        // Strings are escaped.
+        STObject obj(sfMemo);
+        std::string const text = "a \"quoted\"\\ line\n";
+        obj.setFieldVL(sfMemoData, Slice(text.data(), text.size()));
+        STArray memos(sfMemos);
+        memos.push_back(obj);
+        memos.push_back(STObject(sfMemo));
+        expectSame(memos, JsonOptions::none);
+
+        Json::Value value;
+        value["text"] = text;
+        value["number"] = -3;
+        std::string s;
+        {
+            Json::Writer w(Json::stringOutput(s));
+            w.startRoot(Json::Writer::object);
+            w.rawSet(Json::StaticString("value"));
+            w.output(value);
+        }
+        BEAST_EXPECT(
+            s ==
+            R"({"value":{"number":-3,"text":"a \"quoted\"\\ line\n"}})");
+    }
+
+public:
+    void
+    run() override
+    {
+        testLedger();
+        testValues();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STWriteJson, protocol, ripple);
+
+/** Compare getJson followed by Json::jsonAsString with writeJson. */
+class STWriteJsonSpeed_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace test::jtx;
+        using clock = std::chrono::steady_clock;
+
+        Env env(*this, envconfig(), nullptr, beast::severities::kError);
+        buildLedger(env, 2000);
+
+        auto const ledger = env.closed();
+        int const rounds = 20;
+
+        auto const time = [&](auto&& f) {
+            std::size_t bytes = 0;
+            auto const start = clock::now();
+            for (int i = 0; i < rounds; ++i)
+            {
+                for (auto const& [tx, meta] : ledger->txs)
+                {
+                    bytes += f(*tx, JsonOptions::none).size();
+                    bytes += f(*meta, JsonOptions::none).size();
+                }
+            }
+            auto const elapsed = clock::now() - start;
+            return std::make_pair(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    elapsed)
+                    .count(),
+                bytes);
+        };
+
+        auto const dom = time([](STBase const& st, JsonOptions options) {
+            return Json::jsonAsString(st.getJson(options));
+        });
+        auto const direct = time(
+            [](STBase const& st, JsonOptions options) {
+                return writeJson(st, options);
+            });
+
+        log << "getJson + jsonAsString: " << dom.first << "us\n"
+            << "writeJson:              " << direct.first << "us"
+            << std::endl;
+        BEAST_EXPECT(dom.second == direct.second);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(STWriteJsonSpeed, protocol, ripple);
+
+}  // namespace ripple
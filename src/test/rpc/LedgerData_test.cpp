@@ -177,6 +177,35 @@ public:
                 "Invalid field 'marker', not valid.");
         }
 
+        {
+            // invalid end marker
+            Json::Value jvParams;
+            jvParams[jss::end_marker] = "NOT_A_MARKER";
+            auto const jrr = env.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+            BEAST_EXPECT(jrr[jss::error] == "invalidParams");
+            BEAST_EXPECT(
+                jrr[jss::error_message] ==
+                "Invalid field 'end_marker', not valid.");
+        }
+
+        {
+            // end marker before the marker
+            Json::Value jvParams;
+            jvParams[jss::marker] = std::string(64, 'B');
+            jvParams[jss::end_marker] = std::string(64, 'A');
+            auto const jrr = env.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+            BEAST_EXPECT(jrr[jss::error] == "invalidParams");
+            BEAST_EXPECT(
+                jrr[jss::error_message] ==
+                "Invalid field 'end_marker', not valid.");
+        }
+
         {
             // ask for a bad ledger index
             Json::Value jvParams;
@@ -239,6 +268,67 @@ public:
         BEAST_EXPECT(running_total == total_count);
     }
 
+    void
+    testPartitions()
+    {
+        using namespace test::jtx;
+        Env env{*this};
+        Account const gw{"gateway"};
+        env.fund(XRP(100000), gw);
+        for (auto i = 0; i < 40; i++)
+        {
+            Account const bob{std::string("bob") + std::to_string(i)};
+            env.fund(XRP(1000), bob);
+        }
+        env.close();
+
+        // A closed ledger, so the walk reads ahead in the state map.
+        Json::Value jvParams;
+        jvParams[jss::ledger_index] = "closed";
+        jvParams[jss::binary] = true;
+
+        std::vector<std::string> expected;
+        {
+            auto const jrr = env.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+            BEAST_EXPECT(!jrr.isMember(jss::marker));
+            for (auto const& entry : jrr[jss::state])
+                expected.push_back(entry[jss::index].asString());
+        }
+
+        // One range of keys per leading nibble, paged separately, returns
+        // every entry once and in order.
+        std::vector<std::string> found;
+        std::string const nibbles = "0123456789ABCDEF";
+        for (int i = 0; i < 16; ++i)
+        {
+            Json::Value params = jvParams;
+            params[jss::limit] = 2;
+            if (i != 0)
+                params[jss::marker] = nibbles[i - 1] + std::string(63, 'F');
+            params[jss::end_marker] = nibbles[i] + std::string(63, 'F');
+            for (;;)
+            {
+                auto const jrr = env.rpc(
+                    "json",
+                    "ledger_data",
+                    boost::lexical_cast<std::string>(params))[jss::result];
+                for (auto const& entry : jrr[jss::state])
+                {
+                    auto const index = entry[jss::index].asString();
+                    BEAST_EXPECT(index[0] == nibbles[i]);
+                    found.push_back(index);
+                }
+                if (!jrr.isMember(jss::marker))
+                    break;
+                params[jss::marker] = jrr[jss::marker];
+            }
+        }
+        BEAST_EXPECT(found == expected);
+    }
+
     void
     testLedgerHeader()
     {
@@ -518,6 +608,7 @@ public:
         testCurrentLedgerBinary();
         testBadInput();
         testMarkerFollow();
+        testPartitions();
         testLedgerHeader();
         testLedgerType();
     }
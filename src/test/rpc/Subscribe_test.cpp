@@ -399,6 +399,47 @@ public:
         }
     }
 
+    void
+    testSharedTransactions()
+    {
+        testcase("transactions shared between subscribers");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+
+        // Subscribers on the same API version are sent the same message;
+        // each version gets its own.
+        auto subscribe = [&](unsigned apiVersion) {
+            auto wsc = makeWSClient(env.app().config());
+            Json::Value stream{Json::objectValue};
+            stream[jss::api_version] = apiVersion;
+            stream[jss::streams] = Json::arrayValue;
+            stream[jss::streams].append("transactions");
+            auto const jv = wsc->invoke("subscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+            return wsc;
+        };
+        auto v1 = subscribe(1);
+        auto v2a = subscribe(2);
+        auto v2b = subscribe(2);
+
+        env.fund(XRP(10000), "alice");
+        env.close();
+
+        auto isPayment = [](Json::Value const& jv) {
+            return jv[jss::tx_json][jss::TransactionType] == jss::Payment;
+        };
+        auto const a = v2a->findMsg(5s, isPayment);
+        auto const b = v2b->findMsg(5s, isPayment);
+        BEAST_EXPECT(a && b && *a == *b);
+
+        auto const c = v1->findMsg(5s, [](Json::Value const& jv) {
+            return jv[jss::transaction][jss::TransactionType] == jss::Payment;
+        });
+        BEAST_EXPECT(c && !c->isMember(jss::tx_json));
+    }
+
     void
     testManifests()
     {
@@ -1595,6 +1636,7 @@ public:
         testLedger();
         testTransactions_APIv1();
         testTransactions_APIv2();
+        testSharedTransactions();
         testManifests();
         testValidations(all - xrpFees);
         testValidations(all);
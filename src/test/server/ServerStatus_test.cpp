@@ -1205,6 +1205,49 @@ class ServerStatus_test : public beast::unit_test::suite,
         BEAST_EXPECT(std::regex_search(resp.body(), body));
     }
 
+    void
+    testLargeReplies(boost::asio::yield_context& yield)
+    {
+        testcase("Large replies over HTTP and WS");
+
+        using namespace test::jtx;
+        Env env{*this};
+        for (int i = 0; i < 300; ++i)
+            env.fund(XRP(1000), Account("account" + std::to_string(i)));
+        env.close();
+
+        Json::Value params;
+        params[jss::binary] = false;
+        params[jss::limit] = 256;
+        params[jss::ledger_index] = "validated";
+
+        Json::Value request;
+        request[jss::method] = "ledger_data";
+        request[jss::params] = Json::arrayValue;
+        request[jss::params].append(params);
+
+        boost::beast::http::response<boost::beast::http::string_body> resp;
+        boost::system::error_code ec;
+        doHTTPRequest(env, yield, false, resp, ec, to_string(request));
+        if (!BEAST_EXPECT(
+                !ec && resp.result() == boost::beast::http::status::ok))
+            return;
+
+        // The body is the JSON, a newline and a CRLF, as before.
+        auto const& body = resp.body();
+        BEAST_EXPECT(body.size() > 64 * 1024);
+        BEAST_EXPECT(body.ends_with("}\n\r\n"));
+
+        Json::Value http;
+        BEAST_EXPECT(Json::Reader{}.parse(body, http));
+        BEAST_EXPECT(http[jss::result][jss::state].size() == 256);
+
+        auto wsc = makeWSClient(env.app().config());
+        auto ws = wsc->invoke("ledger_data", params);
+        BEAST_EXPECT(
+            ws[jss::result][jss::state] == http[jss::result][jss::state]);
+    }
+
 public:
     void
     run() override
@@ -1241,6 +1284,7 @@ public:
             testWSRequests(yield);
             testRPCRequests(yield);
             testStatusNotOkay(yield);
+            testLargeReplies(yield);
         });
     }
 };
@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <xrpld/shamap/NodeCacheSnapshot.h>
+
+#include <xrpl/basics/random.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/utility/temp_dir.h>
+#include <xrpl/beast/xor_shift_engine.h>
+
+#include <fstream>
+
+namespace ripple {
+namespace tests {
+
+class NodeCacheSnapshot_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine eng_;
+
+    boost::intrusive_ptr<SHAMapItem>
+    makeRandomAS()
+    {
+        Serializer s;
+        for (int d = 0; d < 3; ++d)
+            s.add32(rand_int<std::uint32_t>(eng_));
+        return make_shamapitem(s.getSHA512Half(), s.slice());
+    }
+
+    void
+    expectThrow(boost::filesystem::path const& path)
+    {
+        try
+        {
+            readNodeCacheSnapshot(path);
+            fail("reading " + path.string() + " should throw");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    testSetup()
+    {
+        testcase("setup");
+
+        {
+            auto const setup = setup_NodeCacheSnapshot(Section{}, "/db");
+            BEAST_EXPECT(setup.path == "/db/node_cache.snapshot");
+            BEAST_EXPECT(setup.interval == std::chrono::minutes{10});
+            BEAST_EXPECT(setup.maxNodes == 65536);
+        }
+        {
+            Section section;
+            section.set("path", "/var/warm");
+            section.set("interval", "0");
+            section.set("nodes", "100");
+            auto const setup = setup_NodeCacheSnapshot(section, "/db");
+            BEAST_EXPECT(setup.path == "/var/warm");
+            BEAST_EXPECT(setup.interval == std::chrono::minutes{0});
+            BEAST_EXPECT(setup.maxNodes == 100);
+        }
+        {
+            Section section;
+            section.set("nodes", "0");
+            try
+            {
+                setup_NodeCacheSnapshot(section, "/db");
+                fail("zero nodes should throw");
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        }
+    }
+
+    void
+    testSnapshot()
+    {
+        testcase("snapshot");
+
+        test::SuiteJournal journal("NodeCacheSnapshot_test", *this);
+        beast::temp_dir dir;
+        boost::filesystem::path const path = dir.file("node_cache.snapshot");
+
+        TestNodeFamily f(journal);
+        auto const parallelFor = [&f](std::size_t count, auto const& fn) {
+            f.parallelFor(count, fn);
+        };
+        SHAMap map(SHAMapType::FREE, f);
+        for (int i = 0; i < 5000; ++i)
+            map.addItem(SHAMapNodeType::tnACCOUNT_STATE, makeRandomAS());
+        map.flushDirty(hotACCOUNT_NODE);
+        map.setImmutable();
+
+        std::vector<uint256> inner;
+        map.visitResident([&inner](SHAMapInnerNode const& node) {
+            inner.push_back(node.getHash().as_uint256());
+            return true;
+        });
+        BEAST_EXPECT(inner.size() > 16);
+        BEAST_EXPECT(inner.front() == map.getHash().as_uint256());
+
+        // The nodes nearest the root are kept.
+        {
+            auto const snapshot = makeNodeCacheSnapshot(f, {&map}, 17);
+            BEAST_EXPECT(
+                snapshot.innerNodes ==
+                std::vector<uint256>(inner.begin(), inner.begin() + 17));
+        }
+
+        f.getFullBelowCache()->insert(inner[1]);
+        f.getFullBelowCache()->insert(inner[2]);
+        f.getFullBelowCache()->insert(uint256{1});
+
+        // Nodes shared by several maps are saved once.
+        auto snapshot = makeNodeCacheSnapshot(f, {&map, &map}, 1 << 20);
+        snapshot.ledgerSeq = 7;
+        snapshot.lastRotated = 5;
+        BEAST_EXPECT(snapshot.innerNodes == inner);
+        BEAST_EXPECT(snapshot.fullBelow.size() == 3);
+
+        writeNodeCacheSnapshot(snapshot, path);
+        {
+            auto const copy = readNodeCacheSnapshot(path);
+            BEAST_EXPECT(copy.ledgerSeq == 7);
+            BEAST_EXPECT(copy.lastRotated == 5);
+            BEAST_EXPECT(copy.innerNodes == snapshot.innerNodes);
+            BEAST_EXPECT(copy.fullBelow == snapshot.fullBelow);
+        }
+
+        // FullBelow keys are restored only if the node store has not
+        // rotated, and only for nodes it still holds.
+        for (std::uint32_t const lastRotated : {6, 5})
+        {
+            f.getTreeNodeCache()->clear();
+            f.getFullBelowCache()->reset();
+
+            auto const warmed =
+                warmNodeCaches(f, snapshot, lastRotated, parallelFor, nullptr);
+            BEAST_EXPECT(warmed.innerNodes == inner.size());
+            BEAST_EXPECT(f.getTreeNodeCache()->size() == inner.size());
+            for (auto const& hash : inner)
+                BEAST_EXPECT(f.getTreeNodeCache()->fetch(hash));
+
+            auto const fb = f.getFullBelowCache();
+            BEAST_EXPECT(warmed.fullBelow == (lastRotated == 5 ? 2 : 0));
+            BEAST_EXPECT(fb->touch_if_exists(inner[1]) == (lastRotated == 5));
+            BEAST_EXPECT(!fb->touch_if_exists(uint256{1}));
+        }
+
+        // The warmed nodes stay in the cache across a sweep while they
+        // are held, and are dropped once they are released.
+        {
+            f.getTreeNodeCache()->clear();
+            auto warmed = warmNodeCaches(f, snapshot, 5, parallelFor, nullptr);
+            BEAST_EXPECT(warmed.nodes.size() == inner.size());
+
+            auto const sweep = [&f]() {
+                f.clock().advance(std::chrono::minutes{2});
+                f.getTreeNodeCache()->sweep();
+            };
+
+            sweep();
+            for (auto const& hash : inner)
+                BEAST_EXPECT(f.getTreeNodeCache()->fetch(hash));
+
+            warmed.nodes.clear();
+            sweep();
+            sweep();
+            BEAST_EXPECT(f.getTreeNodeCache()->size() == 0);
+            BEAST_EXPECT(!f.getTreeNodeCache()->fetch(inner.front()));
+        }
+
+        // Warming stops when asked.
+        {
+            f.getTreeNodeCache()->clear();
+            auto const warmed =
+                warmNodeCaches(f, snapshot, 5, parallelFor, [] {
+                    return true;
+                });
+            BEAST_EXPECT(warmed.innerNodes == 0);
+            BEAST_EXPECT(warmed.fullBelow == 0);
+            BEAST_EXPECT(warmed.nodes.empty());
+        }
+
+        // A new file replaces the old one.
+        snapshot.innerNodes.resize(1);
+        writeNodeCacheSnapshot(snapshot, path);
+        BEAST_EXPECT(readNodeCacheSnapshot(path).innerNodes.size() == 1);
+        BEAST_EXPECT(!boost::filesystem::exists(path.string() + ".tmp"));
+
+        expectThrow(dir.file("missing.snapshot"));
+
+        {
+            // Truncated
+            boost::filesystem::resize_file(
+                path, boost::filesystem::file_size(path) - 1);
+        }
+        expectThrow(path);
+
+        {
+            // Wrong magic
+            std::ofstream os(path.string(), std::ios::binary | std::ios::trunc);
+            os << std::string(64, 'X');
+        }
+        expectThrow(path);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSetup();
+        testSnapshot();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(NodeCacheSnapshot, shamap, ripple);
+
+}  // namespace tests
+}  // namespace ripple
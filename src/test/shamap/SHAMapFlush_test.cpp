@@ -0,0 +1,211 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <xrpld/shamap/SHAMap.h>
+#include <xrpld/shamap/SHAMapItem.h>
+
+#include <xrpl/basics/random.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/xor_shift_engine.h>
+
+#include <chrono>
+#include <vector>
+
+namespace ripple {
+namespace tests {
+
+class SHAMapFlush_test : public beast::unit_test::suite
+{
+protected:
+    static std::vector<boost::intrusive_ptr<SHAMapItem>>
+    makeItems(std::size_t count, beast::xor_shift_engine& eng)
+    {
+        std::vector<boost::intrusive_ptr<SHAMapItem>> items;
+        items.reserve(count);
+        while (count--)
+        {
+            Serializer s;
+            for (int d = 0; d < 3; ++d)
+                s.add32(rand_int<std::uint32_t>(eng));
+            items.push_back(make_shamapitem(s.getSHA512Half(), s.slice()));
+        }
+        return items;
+    }
+
+    static void
+    addItems(
+        SHAMap& map,
+        std::vector<boost::intrusive_ptr<SHAMapItem>> const& items,
+        std::size_t first,
+        std::size_t last)
+    {
+        for (auto i = first; i < last; ++i)
+            map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE, make_shamapitem(*items[i]));
+    }
+
+public:
+    void
+    testKnownHash(beast::Journal const& journal)
+    {
+        testcase("batched rehash matches known hashes");
+
+        // The hashes were computed independently of SHAMap, from the keys
+        // and data alone.
+        constexpr uint256 fullHash(
+            "B8C5759C8701F66029027EBFEE10D1FFD520984AABE30218C1AAC4027989248A");
+        constexpr uint256 trimmedHash(
+            "2F6923499C447C197224E0C416B6EBABF28A087331CA9BAC5DDFE13C53462C36");
+
+        // Large enough that the deepest levels are hashed in parallel
+        std::vector<boost::intrusive_ptr<SHAMapItem>> items;
+        for (std::uint32_t i = 0; i < 20000; ++i)
+        {
+            Serializer s;
+            s.add32(i);
+            items.push_back(make_shamapitem(s.getSHA512Half(), s.slice()));
+        }
+
+        TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::STATE, f);
+        addItems(map, items, 0, items.size());
+        map.flushDirty(hotACCOUNT_NODE);
+        BEAST_EXPECT(map.getHash().as_uint256() == fullHash);
+
+        auto trimmed = map.snapShot(true);
+        for (std::size_t i = 0; i < items.size(); i += 7)
+            BEAST_EXPECT(trimmed->delItem(items[i]->key()));
+        trimmed->flushDirty(hotACCOUNT_NODE);
+        BEAST_EXPECT(trimmed->getHash().as_uint256() == trimmedHash);
+        BEAST_EXPECT(map.getHash().as_uint256() == fullHash);
+    }
+
+    void
+    testBatchMatchesIncremental(beast::Journal const& journal)
+    {
+        testcase("batched rehash matches incremental rehash");
+
+        beast::xor_shift_engine eng;
+        // Large enough that the deepest levels are hashed in parallel
+        auto const items = makeItems(20000, eng);
+
+        TestNodeFamily f1(journal);
+        SHAMap incremental(SHAMapType::STATE, f1);
+        incremental.setUnbacked();
+
+        // Flush after every few insertions so every walk only sees a
+        // handful of dirty nodes per level.
+        for (std::size_t i = 0; i < items.size(); i += 16)
+        {
+            addItems(
+                incremental, items, i, std::min(items.size(), i + 16));
+            incremental.unshare();
+        }
+
+        TestNodeFamily f2(journal);
+        SHAMap batched(SHAMapType::STATE, f2);
+        addItems(batched, items, 0, items.size());
+        BEAST_EXPECT(
+            batched.flushDirty(hotACCOUNT_NODE) >
+            static_cast<int>(items.size()));
+
+        BEAST_EXPECT(batched.getHash() == incremental.getHash());
+        batched.invariants();
+
+        // Every node written by the batched flush must be retrievable
+        // from the backend, so a fresh map can be loaded from the root.
+        SHAMap loaded(SHAMapType::STATE, batched.getHash().as_uint256(), f2);
+        BEAST_EXPECT(loaded.fetchRoot(batched.getHash(), nullptr));
+        std::vector<SHAMapMissingNode> missing;
+        loaded.walkMap(missing, 1);
+        BEAST_EXPECT(missing.empty());
+
+        // A snapshot modified and flushed again only rehashes the dirty
+        // path and agrees with the incrementally built map.
+        auto mutated = batched.snapShot(true);
+        TestNodeFamily f3(journal);
+        SHAMap reference(SHAMapType::STATE, f3);
+        reference.setUnbacked();
+        addItems(reference, items, 0, items.size());
+        for (std::size_t i = 0; i < items.size(); i += 7)
+        {
+            mutated->delItem(items[i]->key());
+            reference.delItem(items[i]->key());
+        }
+        mutated->flushDirty(hotACCOUNT_NODE);
+        reference.unshare();
+        BEAST_EXPECT(mutated->getHash() == reference.getHash());
+        BEAST_EXPECT(batched.getHash() != mutated->getHash());
+    }
+
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapFlush_test", *this);
+        testKnownHash(journal);
+        testBatchMatchesIncremental(journal);
+    }
+};
+
+// Measures how long flushDirty takes to rehash a state map against the
+// number of dirty leaves.
+class SHAMapFlushTiming_test : public SHAMapFlush_test
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+        test::SuiteJournal journal("SHAMapFlushTiming_test", *this);
+
+        beast::xor_shift_engine eng;
+        auto const base = makeItems(500000, eng);
+
+        for (std::size_t const dirty : {100, 1000, 10000, 100000})
+        {
+            TestNodeFamily f(journal);
+            SHAMap map(SHAMapType::STATE, f);
+            map.setUnbacked();
+            addItems(map, base, 0, base.size());
+            map.unshare();
+
+            auto const extra = makeItems(dirty, eng);
+            auto snap = map.snapShot(true);
+            addItems(*snap, extra, 0, extra.size());
+
+            auto const start = steady_clock::now();
+            auto const flushed = snap->unshare();
+            auto const elapsed = duration_cast<microseconds>(
+                steady_clock::now() - start);
+
+            log << dirty << " dirty leaves: " << flushed << " nodes in "
+                << elapsed.count() << "us" << std::endl;
+        }
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SHAMapFlush, shamap, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapFlushTiming, shamap, ripple);
+
+}  // namespace tests
+}  // namespace ripple
@@ -169,13 +169,20 @@ public:
 
             for (std::size_t i = 0; i < b.size(); ++i)
             {
+                // Half the nodes are deserialized ahead of time, the way
+                // InboundLedger hashes them before taking its lock.
+                auto const added = (i % 2 == 0)
+                    ? destination.addKnownNode(
+                          b[i].first, makeSlice(b[i].second), nullptr)
+                    : destination.addKnownNode(
+                          b[i].first,
+                          SHAMapTreeNode::makeFromWire(makeSlice(b[i].second)),
+                          nullptr);
+
                 // Don't use BEAST_EXPECT here b/c it will be called a
                 // non-deterministic number of times and the number of tests run
                 // should be deterministic
-                if (!destination
-                         .addKnownNode(
-                             b[i].first, makeSlice(b[i].second), nullptr)
-                         .isUseful())
+                if (!added.isUseful())
                     fail("", __FILE__, __LINE__);
             }
         } while (true);
@@ -21,11 +21,13 @@
 #include <test/unit_test/SuiteJournal.h>
 
 #include <xrpld/shamap/SHAMap.h>
+#include <xrpld/shamap/SHAMapInnerNode.h>
 
 #include <xrpl/basics/Blob.h>
 #include <xrpl/basics/Buffer.h>
 #include <xrpl/beast/unit_test.h>
 #include <xrpl/beast/utility/Journal.h>
+#include <xrpl/protocol/digest.h>
 
 namespace ripple {
 namespace tests {
@@ -124,6 +126,234 @@ public:
 
         run(true, journal);
         run(false, journal);
+        testSlabAllocation(journal);
+        testPrefetch(journal);
+        testCompareParallel(journal);
+    }
+
+    void
+    testCompareParallel(beast::Journal const& journal)
+    {
+        testcase("compare in parallel");
+
+        tests::TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::TRANSACTION, f);
+        map.setUnbacked();
+        for (int i = 0; i < 5000; ++i)
+        {
+            map.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(sha512Half(i), IntToVUC(i)));
+        }
+
+        // Remove, add and change items all over the other map.
+        auto other = map.snapShot(true);
+        for (int i = 0; i < 5000; i += 50)
+            BEAST_EXPECT(other->delItem(sha512Half(i)));
+        for (int i = 5000; i < 5100; ++i)
+        {
+            other->addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(sha512Half(i), IntToVUC(i)));
+        }
+        for (int i = 25; i < 5000; i += 100)
+        {
+            other->updateGiveItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(sha512Half(i), IntToVUC(i + 1)));
+        }
+
+        auto const same = [](SHAMap::Delta const& a, SHAMap::Delta const& b) {
+            return std::equal(
+                a.begin(),
+                a.end(),
+                b.begin(),
+                b.end(),
+                [](auto const& x, auto const& y) {
+                    return x.first == y.first &&
+                        x.second.first == y.second.first &&
+                        x.second.second == y.second.second;
+                });
+        };
+
+        SHAMap::Delta serial;
+        BEAST_EXPECT(map.compare(*other, serial, 100000));
+        BEAST_EXPECT(serial.size() == 250);
+
+        SHAMap::Delta parallel;
+        BEAST_EXPECT(map.compareParallel(*other, parallel, 100000));
+        BEAST_EXPECT(same(serial, parallel));
+        BEAST_EXPECT(f.parallelForCalls() == 1);
+
+        // The other way around, each difference is reversed.
+        SHAMap::Delta reversed;
+        BEAST_EXPECT(other->compareParallel(map, reversed, 100000));
+        BEAST_EXPECT(reversed.size() == serial.size());
+        for (auto const& [key, items] : reversed)
+        {
+            auto const it = serial.find(key);
+            BEAST_EXPECT(
+                it != serial.end() && it->second.first == items.second &&
+                it->second.second == items.first);
+        }
+
+        // Too many differences. The workers share one budget, so the
+        // limit applies to the whole comparison as it does in compare.
+        SHAMap::Delta limited;
+        BEAST_EXPECT(!map.compareParallel(*other, limited, 100));
+        BEAST_EXPECT(limited.size() == 100);
+
+        SHAMap::Delta exact;
+        BEAST_EXPECT(!map.compareParallel(*other, exact, 250));
+        BEAST_EXPECT(exact.size() == 250);
+
+        SHAMap::Delta enough;
+        BEAST_EXPECT(map.compareParallel(*other, enough, 251));
+        BEAST_EXPECT(same(serial, enough));
+
+        // Small maps are compared on the calling thread.
+        SHAMap small(SHAMapType::TRANSACTION, f);
+        small.setUnbacked();
+        for (int i = 0; i < 40; ++i)
+        {
+            small.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(sha512Half(i), IntToVUC(i)));
+        }
+        auto const smallOther = small.snapShot(true);
+        for (int i = 0; i < 40; i += 4)
+            BEAST_EXPECT(smallOther->delItem(sha512Half(i)));
+
+        auto const calls = f.parallelForCalls();
+        SHAMap::Delta smallSerial;
+        SHAMap::Delta smallParallel;
+        BEAST_EXPECT(small.compare(*smallOther, smallSerial, 100));
+        BEAST_EXPECT(small.compareParallel(*smallOther, smallParallel, 100));
+        BEAST_EXPECT(smallSerial.size() == 10);
+        BEAST_EXPECT(same(smallSerial, smallParallel));
+        BEAST_EXPECT(f.parallelForCalls() == calls);
+
+        SHAMap::Delta none;
+        BEAST_EXPECT(map.compareParallel(map, none, 100));
+        BEAST_EXPECT(none.empty());
+    }
+
+    void
+    testPrefetch(beast::Journal const& journal)
+    {
+        testcase("prefetch");
+
+        tests::TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::STATE, f);
+        std::vector<uint256> keys;
+        for (int i = 0; i < 5000; ++i)
+        {
+            keys.push_back(sha512Half(i));
+            map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                make_shamapitem(keys.back(), IntToVUC(i)));
+        }
+        map.flushDirty(hotACCOUNT_NODE);
+        std::sort(keys.begin(), keys.end());
+
+        // Load the map from the database, with nothing cached.
+        auto const load = [&]() {
+            f.reset();
+            auto loaded = std::make_unique<SHAMap>(
+                SHAMapType::STATE, map.getHash().as_uint256(), f);
+            BEAST_EXPECT(loaded->fetchRoot(map.getHash(), nullptr));
+            return loaded;
+        };
+
+        // Walks 300 items after the start, returning the number of reads.
+        uint256 const start = keys[1000];
+        auto const walk = [&](SHAMap const& loaded) {
+            auto const reads = f.db().getFetchTotalCount();
+            int count = 0;
+            for (auto it = loaded.upper_bound(start);
+                 it != loaded.end() && count < 300;
+                 ++it, ++count)
+                BEAST_EXPECT(it->key() == keys[1001 + count]);
+            BEAST_EXPECT(count == 300);
+            return f.db().getFetchTotalCount() - reads;
+        };
+
+        BEAST_EXPECT(walk(*load()) > 0);
+
+        {
+            // The walk finds every node it visits in memory.
+            auto const loaded = load();
+            loaded->prefetch(start, 301);
+            BEAST_EXPECT(walk(*loaded) == 0);
+        }
+
+        {
+            // A walk past the prefetched items reads the rest one by one.
+            auto const loaded = load();
+            loaded->prefetch(start, 10);
+            BEAST_EXPECT(walk(*loaded) > 0);
+        }
+
+        {
+            // Lookups of prefetched items, and of items that aren't in the
+            // map, find every node in memory.
+            auto const loaded = load();
+            std::vector<uint256> lookups;
+            for (int i = 0; i < 100; ++i)
+                lookups.push_back(keys[i * 37]);
+            for (int i = 0; i < 10; ++i)
+                lookups.push_back(sha512Half(-i - 1));
+            loaded->prefetch(lookups);
+
+            auto const reads = f.db().getFetchTotalCount();
+            for (int i = 0; i < 100; ++i)
+                BEAST_EXPECT(loaded->hasItem(lookups[i]));
+            for (int i = 100; i < lookups.size(); ++i)
+                BEAST_EXPECT(!loaded->hasItem(lookups[i]));
+            BEAST_EXPECT(f.db().getFetchTotalCount() == reads);
+        }
+    }
+
+    void
+    testSlabAllocation(beast::Journal const& journal)
+    {
+        testcase("inner node slab");
+
+        tests::TestNodeFamily f(journal);
+        auto const before = SHAMapInnerNode::slabStats();
+
+        // A node is freed to wherever it came from, even after the mode
+        // changes.
+        auto heap = std::make_unique<SHAMap>(SHAMapType::FREE, f);
+        SHAMapInnerNode::setSlabAllocation(true);
+        auto slab = std::make_unique<SHAMap>(SHAMapType::FREE, f);
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto const key = sha512Half(i);
+            BEAST_EXPECT(slab->addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(key, IntToVUC(i))));
+        }
+        slab->invariants();
+        SHAMapInnerNode::setSlabAllocation(false);
+
+        auto const during = SHAMapInnerNode::slabStats();
+        BEAST_EXPECT(during.nodes > before.nodes);
+        BEAST_EXPECT(during.bytes > 0);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto const key = sha512Half(i);
+            BEAST_EXPECT(heap->addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(key, IntToVUC(i))));
+        }
+        BEAST_EXPECT(heap->getHash() == slab->getHash());
+        BEAST_EXPECT(SHAMapInnerNode::slabStats().nodes == during.nodes);
+
+        slab.reset();
+        heap.reset();
+        BEAST_EXPECT(SHAMapInnerNode::slabStats().nodes == before.nodes);
     }
 
     void
@@ -402,7 +632,97 @@ class SHAMapPathProof_test : public beast::unit_test::suite
     }
 };
 
+// Builds a state-map-sized SHAMap with inner nodes allocated from the heap
+// and then from the slab, and reports the time and memory each took. The
+// number of items defaults to 1,000,000 and may be given as the argument.
+class SHAMapInnerNodeSlab_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+        test::SuiteJournal journal("SHAMapInnerNodeSlab_test", *this);
+
+        std::size_t items = 1000000;
+        if (!arg().empty())
+            items = std::stoull(arg());
+
+        // The leaves are shared, so only the inner nodes differ.
+        std::vector<boost::intrusive_ptr<SHAMapItem>> leaves;
+        leaves.reserve(items);
+        for (std::size_t i = 0; i < items; ++i)
+        {
+            auto const key = sha512Half(i);
+            leaves.push_back(
+                make_shamapitem(key, Slice(key.data(), key.size())));
+        }
+
+        for (bool const slab : {false, true})
+        {
+            SHAMapInnerNode::setSlabAllocation(slab);
+            auto const before = SHAMapInnerNode::slabStats();
+
+            tests::TestNodeFamily f(journal);
+            auto map = std::make_shared<SHAMap>(SHAMapType::STATE, f);
+            map->setUnbacked();
+
+            auto start = steady_clock::now();
+            for (auto const& leaf : leaves)
+                map->addItem(SHAMapNodeType::tnACCOUNT_STATE, leaf);
+            map->getHash();
+            auto const build = duration_cast<milliseconds>(
+                steady_clock::now() - start);
+
+            // Each following ledger copies the path to every changed leaf.
+            start = steady_clock::now();
+            for (std::size_t ledger = 0; ledger < 10; ++ledger)
+            {
+                auto next = map->snapShot(true);
+                for (std::size_t i = ledger; i < items; i += 1000)
+                    next->updateGiveItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(leaves[i]->key(), Slice(&ledger, 8)));
+                next->getHash();
+                map = std::move(next);
+            }
+            auto const update = duration_cast<milliseconds>(
+                steady_clock::now() - start);
+
+            std::size_t inner = 0;
+            map->visitNodes([&inner](SHAMapTreeNode& node) {
+                if (node.isInner())
+                    ++inner;
+                return true;
+            });
+            auto const after = SHAMapInnerNode::slabStats();
+
+            start = steady_clock::now();
+            map.reset();
+            auto const release = duration_cast<milliseconds>(
+                steady_clock::now() - start);
+
+            log << (slab ? "slab" : "heap") << ": " << items << " items, "
+                << inner << " inner nodes of " << sizeof(SHAMapInnerNode)
+                << " bytes; build " << build.count() << "ms, 10 ledgers "
+                << update.count() << "ms, release " << release.count()
+                << "ms" << std::endl;
+            if (slab)
+                log << "    " << after.nodes - before.nodes
+                    << " nodes in the slab, "
+                    << (after.bytes - before.bytes) / 1024 / 1024
+                    << " MiB newly reserved" << std::endl;
+            else
+                log << "    " << inner << " heap allocations" << std::endl;
+        }
+
+        SHAMapInnerNode::setSlabAllocation(false);
+        pass();
+    }
+};
+
 BEAST_DEFINE_TESTSUITE(SHAMap, shamap, ripple);
 BEAST_DEFINE_TESTSUITE(SHAMapPathProof, shamap, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapInnerNodeSlab, shamap, ripple);
 }  // namespace tests
 }  // namespace ripple
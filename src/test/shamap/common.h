@@ -26,6 +26,11 @@
 
 #include <xrpl/basics/chrono.h>
 
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
 namespace ripple {
 namespace tests {
 
@@ -42,6 +47,8 @@ private:
 
     beast::Journal const j_;
 
+    std::atomic<std::size_t> parallelForCalls_{0};
+
 public:
     TestNodeFamily(beast::Journal j)
         : fbCache_(std::make_shared<FullBelowCache>(
@@ -121,6 +128,43 @@ public:
         tnCache_->reset();
     }
 
+    void
+    parallelFor(std::size_t count, std::function<void(std::size_t)> const& f)
+        override
+    {
+        ++parallelForCalls_;
+        std::vector<std::exception_ptr> errors(count);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                try
+                {
+                    f(i);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+        for (auto const& error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    /** The number of times parallelFor was called. */
+    std::size_t
+    parallelForCalls() const
+    {
+        return parallelForCalls_;
+    }
+
     beast::manual_clock<std::chrono::steady_clock>
     clock()
     {
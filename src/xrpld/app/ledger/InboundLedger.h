@@ -21,12 +21,14 @@
 #define RIPPLE_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
 #include <xrpld/app/ledger/Ledger.h>
+#include <xrpld/app/ledger/detail/RequestWindow.h>
 #include <xrpld/app/ledger/detail/TimeoutCounter.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/overlay/PeerSet.h>
 
 #include <xrpl/basics/CountedObject.h>
 
+#include <map>
 #include <mutex>
 #include <set>
 #include <utility>
@@ -123,10 +125,23 @@ public:
 private:
     enum class TriggerReason { added, reply, timeout };
 
+    // The nodes of a reply, deserialized and hashed before taking the lock
+    using PreparedNodes = std::vector<
+        std::pair<SHAMapNodeID, intr_ptr::SharedPtr<SHAMapTreeNode>>>;
+
+    struct ReceivedData
+    {
+        std::weak_ptr<Peer> peer;
+        std::shared_ptr<protocol::TMLedgerData> packet;
+        // Empty if the nodes are to be taken from the packet
+        PreparedNodes nodes;
+    };
+
     void
     filterNodes(
         std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
-        TriggerReason reason);
+        TriggerReason reason,
+        std::size_t requests);
 
     void
     trigger(std::shared_ptr<Peer> const&, TriggerReason);
@@ -153,13 +168,22 @@ private:
     pmDowncast() override;
 
     int
-    processData(std::shared_ptr<Peer> peer, protocol::TMLedgerData& data);
+    processData(
+        std::shared_ptr<Peer> peer,
+        protocol::TMLedgerData& data,
+        PreparedNodes& nodes);
+
+    static PreparedNodes
+    prepareNodes(protocol::TMLedgerData const& packet);
 
     bool
     takeHeader(std::string const& data);
 
     void
-    receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode&);
+    receiveNode(
+        protocol::TMLedgerData& packet,
+        PreparedNodes& nodes,
+        SHAMapAddNode&);
 
     bool
     takeTxRootNode(Slice const& data, SHAMapAddNode&);
@@ -174,6 +198,7 @@ private:
     neededStateHashes(int max, SHAMapSyncFilter* filter) const;
 
     clock_type& m_clock;
+    clock_type::time_point const mStarted;
     clock_type::time_point mLastAction;
 
     std::shared_ptr<Ledger> mLedger;
@@ -189,11 +214,13 @@ private:
 
     SHAMapAddNode mStats;
 
+    // How many node requests each peer that has answered may have
+    // outstanding
+    std::map<Peer::id_t, RequestWindow> mPeerWindows;
+
     // Data we have received from peers
     std::mutex mReceivedDataLock;
-    std::vector<
-        std::pair<std::weak_ptr<Peer>, std::shared_ptr<protocol::TMLedgerData>>>
-        mReceivedData;
+    std::vector<ReceivedData> mReceivedData;
     bool mReceiveDispatched;
     std::unique_ptr<PeerSet> mPeerSet;
 };
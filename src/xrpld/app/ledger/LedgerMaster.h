@@ -28,6 +28,7 @@
 #include <xrpld/app/ledger/LedgerReplay.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/misc/CanonicalTXSet.h>
+#include <xrpld/perflog/TracedMutex.h>
 
 #include <xrpl/basics/RangeSet.h>
 #include <xrpl/basics/UptimeClock.h>
@@ -59,6 +60,8 @@ public:
 
     virtual ~LedgerMaster() = default;
 
+    using MutexType = perf::TracedMutex<std::recursive_mutex>;
+
     LedgerIndex
     getCurrentLedgerIndex();
     LedgerIndex
@@ -67,7 +70,7 @@ public:
     bool
     isCompatible(ReadView const&, beast::Journal::Stream, char const* reason);
 
-    std::recursive_mutex&
+    MutexType&
     peekMutex();
 
     // The current ledger is the ledger we believe new transactions should go in
@@ -297,14 +300,14 @@ private:
         std::uint32_t missing,
         bool& progress,
         InboundLedger::Reason reason,
-        std::unique_lock<std::recursive_mutex>&);
+        std::unique_lock<MutexType>&);
     // Try to publish ledgers, acquire missing ledgers.  Always called with
     // m_mutex locked.  The passed lock is a reminder to callers.
     void
-    doAdvance(std::unique_lock<std::recursive_mutex>&);
+    doAdvance(std::unique_lock<MutexType>&);
 
     std::vector<std::shared_ptr<Ledger const>>
-    findNewLedgersToPublish(std::unique_lock<std::recursive_mutex>&);
+    findNewLedgersToPublish(std::unique_lock<MutexType>&);
 
     void
     updatePaths();
@@ -312,12 +315,12 @@ private:
     // Returns true if work started.  Always called with m_mutex locked.
     // The passed lock is a reminder to callers.
     bool
-    newPFWork(char const* name, std::unique_lock<std::recursive_mutex>&);
+    newPFWork(char const* name, std::unique_lock<MutexType>&);
 
     Application& app_;
     beast::Journal m_journal;
 
-    std::recursive_mutex mutable m_mutex;
+    MutexType mutable m_mutex{"LedgerMaster"};
 
     // The ledger that most recently closed.
     LedgerHolder mClosedLedger;
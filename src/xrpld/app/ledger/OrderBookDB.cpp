@@ -63,6 +63,11 @@ OrderBookDB::setup(std::shared_ptr<ReadView const> const& ledger)
 
     if (app_.config().PATH_SEARCH_MAX != 0)
     {
+        {
+            std::lock_guard sl(mLock);
+            updating_ = true;
+        }
+
         if (app_.config().standalone())
             update(ledger);
         else
@@ -91,15 +96,41 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
     decltype(xrpBooks_) xrpBooks;
     decltype(domainBooks_) domainBooks;
     decltype(xrpDomainBooks_) xrpDomainBooks;
+    decltype(bookRefs_) bookRefs;
 
     allBooks.reserve(allBooks_.size());
     xrpBooks.reserve(xrpBooks_.size());
+    bookRefs.reserve(bookRefs_.size());
 
     JLOG(j_.debug()) << "Beginning update (" << ledger->seq() << ")";
 
+    // Give up on this update; the next validated ledger schedules another.
+    auto const abandon = [this]() {
+        seq_.store(0);
+        std::lock_guard sl(mLock);
+        updating_ = false;
+        indexSeq_ = 0;
+        pendingDeltas_.clear();
+    };
+
     // walk through the entire ledger looking for orderbook/AMM entries
     int cnt = 0;
 
+    auto addBook = [&](Book const& book) {
+        if (book.domain)
+            domainBooks[{book.in, *book.domain}].insert(book.out);
+        else
+            allBooks[book.in].insert(book.out);
+
+        if (book.domain && isXRP(book.out))
+            xrpDomainBooks.insert({book.in, *book.domain});
+        else if (isXRP(book.out))
+            xrpBooks.insert(book.in);
+
+        ++bookRefs[book];
+        ++cnt;
+    };
+
     try
     {
         for (auto& sle : ledger->sles)
@@ -108,7 +139,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
             {
                 JLOG(j_.info())
                     << "Update halted because the process is stopping";
-                seq_.store(0);
+                abandon();
                 return;
             }
 
@@ -124,32 +155,14 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
                 book.out.account = sle->getFieldH160(sfTakerGetsIssuer);
                 book.domain = (*sle)[~sfDomainID];
 
-                if (book.domain)
-                    domainBooks_[{book.in, *book.domain}].insert(book.out);
-                else
-                    allBooks[book.in].insert(book.out);
-
-                if (book.domain && isXRP(book.out))
-                    xrpDomainBooks.insert({book.in, *book.domain});
-                else if (isXRP(book.out))
-                    xrpBooks.insert(book.in);
-
-                ++cnt;
+                addBook(book);
             }
             else if (sle->getType() == ltAMM)
             {
                 auto const issue1 = (*sle)[sfAsset].get<Issue>();
                 auto const issue2 = (*sle)[sfAsset2].get<Issue>();
-                auto addBook = [&](Issue const& in, Issue const& out) {
-                    allBooks[in].insert(out);
-
-                    if (isXRP(out))
-                        xrpBooks.insert(in);
-
-                    ++cnt;
-                };
-                addBook(issue1, issue2);
-                addBook(issue2, issue1);
+                addBook(Book(issue1, issue2, std::nullopt));
+                addBook(Book(issue2, issue1, std::nullopt));
             }
         }
     }
@@ -157,7 +170,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
     {
         JLOG(j_.info()) << "Missing node in " << ledger->seq()
                         << " during update: " << mn.what();
-        seq_.store(0);
+        abandon();
         return;
     }
 
@@ -170,11 +183,190 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
         xrpBooks_.swap(xrpBooks);
         domainBooks_.swap(domainBooks);
         xrpDomainBooks_.swap(xrpDomainBooks);
+        bookRefs_.swap(bookRefs);
+
+        // Catch up with the ledgers validated while the walk was running.
+        indexSeq_ = ledger->seq();
+        for (auto const& [seq, delta] : pendingDeltas_)
+        {
+            if (seq <= indexSeq_)
+                continue;
+            if (seq != indexSeq_ + 1)
+                break;
+            applyDelta(delta, sl);
+            indexSeq_ = seq;
+        }
+        pendingDeltas_.clear();
+        updating_ = false;
     }
 
     app_.getLedgerMaster().newOrderBookDB();
 }
 
+void
+OrderBookDB::applyLedger(AcceptedLedger const& ledger)
+{
+    if (app_.config().PATH_SEARCH_MAX == 0)
+        return;  // pathfinding has been disabled
+
+    // Bound on the number of ledgers held back while a full update runs
+    constexpr std::size_t maxPendingDeltas = 1024;
+
+    auto const& view = ledger.getLedger();
+    auto const seq = view->seq();
+
+    BookDelta delta;
+    for (auto const& tx : ledger)
+    {
+        for (auto const& node : tx->getMeta().getNodes())
+        {
+            try
+            {
+                int change = 0;
+                STObject const* data = nullptr;
+
+                if (node.getFName() == sfCreatedNode)
+                {
+                    change = 1;
+                    data = dynamic_cast<STObject const*>(
+                        node.peekAtPField(sfNewFields));
+                }
+                else if (node.getFName() == sfDeletedNode)
+                {
+                    change = -1;
+                    data = dynamic_cast<STObject const*>(
+                        node.peekAtPField(sfFinalFields));
+                }
+
+                if (!data)
+                    continue;
+
+                auto const type = node.getFieldU16(sfLedgerEntryType);
+
+                if (type == ltDIR_NODE &&
+                    data->isFieldPresent(sfExchangeRate) &&
+                    (*data)[~sfRootIndex] == node.getFieldH256(sfLedgerIndex))
+                {
+                    // Fields left at their default value (e.g. the XRP
+                    // currency and issuer) are omitted from the metadata
+                    // of a created node.
+                    Book book;
+                    book.in.currency =
+                        (*data)[~sfTakerPaysCurrency].value_or(beast::zero);
+                    book.in.account =
+                        (*data)[~sfTakerPaysIssuer].value_or(beast::zero);
+                    book.out.currency =
+                        (*data)[~sfTakerGetsCurrency].value_or(beast::zero);
+                    book.out.account =
+                        (*data)[~sfTakerGetsIssuer].value_or(beast::zero);
+                    book.domain = (*data)[~sfDomainID];
+                    delta.emplace_back(std::move(book), change);
+                }
+                else if (type == ltAMM)
+                {
+                    auto const issue1 = data->isFieldPresent(sfAsset)
+                        ? (*data)[sfAsset].get<Issue>()
+                        : xrpIssue();
+                    auto const issue2 = data->isFieldPresent(sfAsset2)
+                        ? (*data)[sfAsset2].get<Issue>()
+                        : xrpIssue();
+                    delta.emplace_back(
+                        Book(issue1, issue2, std::nullopt), change);
+                    delta.emplace_back(
+                        Book(issue2, issue1, std::nullopt), change);
+                }
+            }
+            catch (std::exception const& ex)
+            {
+                JLOG(j_.info())
+                    << "applyLedger: field not found (" << ex.what() << ")";
+            }
+        }
+    }
+
+    {
+        std::lock_guard sl(mLock);
+
+        if (updating_)
+        {
+            if (pendingDeltas_.size() < maxPendingDeltas)
+                pendingDeltas_.emplace(seq, std::move(delta));
+            return;
+        }
+
+        if (indexSeq_ != 0 && seq <= indexSeq_)
+            return;
+
+        if (indexSeq_ != 0 && seq == indexSeq_ + 1)
+        {
+            applyDelta(delta, sl);
+            indexSeq_ = seq;
+            return;
+        }
+
+        if (indexSeq_ != 0)
+        {
+            JLOG(j_.info()) << "Gap in order book updates: " << indexSeq_
+                            << " to " << seq;
+            indexSeq_ = 0;
+            seq_.store(0);
+        }
+    }
+
+    // There is no index that can be carried forward to this ledger.
+    setup(view);
+}
+
+void
+OrderBookDB::applyDelta(
+    BookDelta const& delta,
+    std::lock_guard<std::recursive_mutex> const& sl)
+{
+    for (auto const& [book, change] : delta)
+    {
+        if (change > 0)
+        {
+            if (++bookRefs_[book] == 1)
+                addOrderBook(book);
+        }
+        else if (auto it = bookRefs_.find(book); it != bookRefs_.end())
+        {
+            if (--it->second == 0)
+            {
+                bookRefs_.erase(it);
+                removeOrderBook(book, sl);
+            }
+        }
+    }
+}
+
+void
+OrderBookDB::removeOrderBook(
+    Book const& book,
+    std::lock_guard<std::recursive_mutex> const&)
+{
+    bool const toXRP = isXRP(book.out);
+
+    auto removeFrom = [&](auto& container, auto const& key) {
+        if (auto it = container.find(key); it != container.end())
+        {
+            it->second.erase(book.out);
+            if (it->second.empty())
+                container.erase(it);
+        }
+    };
+
+    if (book.domain)
+        removeFrom(domainBooks_, std::make_pair(book.in, *book.domain));
+    else
+        removeFrom(allBooks_, book.in);
+
+    if (book.domain && toXRP)
+        xrpDomainBooks_.erase({book.in, *book.domain});
+    else if (toXRP)
+        xrpBooks_.erase(book.in);
+}
+
 void
 OrderBookDB::addOrderBook(Book const& book)
 {
@@ -20,6 +20,7 @@
 #ifndef RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 #define RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 
+#include <xrpld/app/ledger/AcceptedLedger.h>
 #include <xrpld/app/ledger/AcceptedLedgerTx.h>
 #include <xrpld/app/ledger/BookListeners.h>
 #include <xrpld/app/main/Application.h>
@@ -27,8 +28,10 @@
 #include <xrpl/protocol/MultiApiJson.h>
 #include <xrpl/protocol/UintTypes.h>
 
+#include <map>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -42,6 +45,16 @@ public:
     void
     update(std::shared_ptr<ReadView const> const& ledger);
 
+    /** Bring the book index up to date with a newly validated ledger.
+
+        Books whose first quality directory (or AMM) was created by the
+        ledger's transactions are added, and books whose last quality
+        directory was deleted are removed. If the ledger does not directly
+        follow the one the index reflects, a full update is scheduled.
+    */
+    void
+    applyLedger(AcceptedLedger const& ledger);
+
     void
     addOrderBook(Book const&);
 
@@ -75,6 +88,17 @@ public:
         MultiApiJson const& jvObj);
 
 private:
+    // Books added (+1) and removed (-1) by a single ledger
+    using BookDelta = std::vector<std::pair<Book, int>>;
+
+    void
+    applyDelta(
+        BookDelta const& delta,
+        std::lock_guard<std::recursive_mutex> const&);
+
+    void
+    removeOrderBook(Book const&, std::lock_guard<std::recursive_mutex> const&);
+
     Application& app_;
 
     // Maps order books by "issue in" to "issue out":
@@ -89,6 +113,19 @@ private:
     // does an order book to XRP exist
     hash_set<std::pair<Issue, Domain>> xrpDomainBooks_;
 
+    // Number of quality directories (and AMM instances) backing each book
+    // in the validated ledger the index reflects.
+    hash_map<Book, std::uint32_t> bookRefs_;
+
+    // Sequence of the validated ledger the index reflects, or 0 if there is
+    // no index that can be maintained incrementally.
+    std::uint32_t indexSeq_ = 0;
+
+    // Set while a full update is scheduled or running; deltas of ledgers
+    // published in the meantime are held here and replayed on completion.
+    bool updating_ = false;
+    std::map<std::uint32_t, BookDelta> pendingDeltas_;
+
     std::recursive_mutex mLock;
 
     using BookToListenersMap = hash_map<Book, BookListeners::pointer>;
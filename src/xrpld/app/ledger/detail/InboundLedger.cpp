@@ -61,6 +61,10 @@ enum {
     ,
     missingNodesFind = 256
 
+    // Most nodes to look for, including those already requested
+    ,
+    missingNodesMax = 2048
+
     // Number of nodes to request for a reply
     ,
     reqNodesReply = 128
@@ -68,6 +72,10 @@ enum {
     // Number of nodes to request blindly
     ,
     reqNodes = 12
+
+    // Most node requests a peer that is keeping up may have outstanding
+    ,
+    maxRequestsPerPeer = 4
 };
 
 // millisecond for each ledger timeout
@@ -87,6 +95,7 @@ InboundLedger::InboundLedger(
           {jtLEDGER_DATA, "InboundLedger", 5},
           app.journal("InboundLedger"))
     , m_clock(clock)
+    , mStarted(clock.now())
     , mHaveHeader(false)
     , mHaveState(false)
     , mHaveTransactions(false)
@@ -183,8 +192,8 @@ InboundLedger::~InboundLedger()
     // for populating a different ledger
     for (auto& entry : mReceivedData)
     {
-        if (entry.second->type() == protocol::liAS_NODE)
-            app_.getInboundLedgers().gotStaleData(entry.second);
+        if (entry.packet->type() == protocol::liAS_NODE)
+            app_.getInboundLedgers().gotStaleData(entry.packet);
     }
     if (!isDone())
     {
@@ -367,6 +376,10 @@ InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
 {
     mRecentNodes.clear();
 
+    auto const now = m_clock.now();
+    for (auto& [id, window] : mPeerWindows)
+        window.expire(now, ledgerAcquireTimeout);
+
     if (isDone())
     {
         JLOG(journal_.info()) << "Already done " << hash_;
@@ -616,6 +629,45 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
     else
         tmGL.set_querydepth(1);
 
+    // A peer that answered may have several requests outstanding, so
+    // that it always has the next one queued.
+    RequestWindow* window = nullptr;
+    std::size_t requests = 1;
+    if (peer && reason == TriggerReason::reply)
+    {
+        window = &mPeerWindows
+                      .try_emplace(
+                          peer->id(), reqNodesReply, maxRequestsPerPeer)
+                      .first->second;
+        requests = window->available();
+        if (requests == 0)
+        {
+            JLOG(journal_.trace()) << "Requests to " << peer->id()
+                                   << " already outstanding";
+            return;
+        }
+    }
+
+    // Look past the nodes already requested from other peers.
+    int const findNodes = std::min<std::size_t>(
+        missingNodesFind * requests + mRecentNodes.size(), missingNodesMax);
+
+    auto sendNodes =
+        [&](std::vector<std::pair<SHAMapNodeID, uint256>> const& nodes) {
+            for (std::size_t i = 0; i < nodes.size(); i += reqNodesReply)
+            {
+                tmGL.clear_nodeids();
+                auto const end =
+                    std::min<std::size_t>(i + reqNodesReply, nodes.size());
+                for (auto j = i; j < end; ++j)
+                    *(tmGL.add_nodeids()) = nodes[j].first.getRawString();
+
+                mPeerSet->sendRequest(tmGL, peer);
+                if (window)
+                    window->sent(m_clock.now());
+            }
+        };
+
     // Get the state data first because it's the most likely to be useful
     // if we wind up abandoning this fetch.
     if (mHaveHeader && !mHaveState && !failed_)
@@ -647,7 +699,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             // Release the lock while we process the large state map
             sl.unlock();
             auto nodes =
-                mLedger->stateMap().getMissingNodes(missingNodesFind, &filter);
+                mLedger->stateMap().getMissingNodes(findNodes, &filter);
             sl.lock();
 
             // Make sure nothing happened while we released the lock
@@ -667,21 +719,17 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                 }
                 else
                 {
-                    filterNodes(nodes, reason);
+                    filterNodes(nodes, reason, requests);
 
                     if (!nodes.empty())
                     {
                         tmGL.set_itype(protocol::liAS_NODE);
-                        for (auto const& id : nodes)
-                        {
-                            *(tmGL.add_nodeids()) = id.first.getRawString();
-                        }
 
                         JLOG(journal_.trace())
                             << "Sending AS node request (" << nodes.size()
                             << ") to "
                             << (peer ? "selected peer" : "all peers");
-                        mPeerSet->sendRequest(tmGL, peer);
+                        sendNodes(nodes);
                         return;
                     }
                     else
@@ -719,8 +767,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             TransactionStateSF filter(
                 mLedger->txMap().family().db(), app_.getLedgerMaster());
 
-            auto nodes =
-                mLedger->txMap().getMissingNodes(missingNodesFind, &filter);
+            auto nodes = mLedger->txMap().getMissingNodes(findNodes, &filter);
 
             if (nodes.empty())
             {
@@ -736,19 +783,15 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             }
             else
             {
-                filterNodes(nodes, reason);
+                filterNodes(nodes, reason, requests);
 
                 if (!nodes.empty())
                 {
                     tmGL.set_itype(protocol::liTX_NODE);
-                    for (auto const& n : nodes)
-                    {
-                        *(tmGL.add_nodeids()) = n.first.getRawString();
-                    }
                     JLOG(journal_.trace())
                         << "Sending TX node request (" << nodes.size()
                         << ") to " << (peer ? "selected peer" : "all peers");
-                    mPeerSet->sendRequest(tmGL, peer);
+                    sendNodes(nodes);
                     return;
                 }
                 else
@@ -772,7 +815,8 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
 void
 InboundLedger::filterNodes(
     std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
-    TriggerReason reason)
+    TriggerReason reason,
+    std::size_t requests)
 {
     // Sort nodes so that the ones we haven't recently
     // requested come before the ones we have.
@@ -802,7 +846,7 @@ InboundLedger::filterNodes(
     }
 
     std::size_t const limit =
-        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
+        (reason == TriggerReason::reply) ? reqNodesReply * requests : reqNodes;
 
     if (nodes.size() > limit)
         nodes.resize(limit);
@@ -863,7 +907,10 @@ InboundLedger::takeHeader(std::string const& data)
     Call with a lock
 */
 void
-InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
+InboundLedger::receiveNode(
+    protocol::TMLedgerData& packet,
+    PreparedNodes& nodes,
+    SHAMapAddNode& san)
 {
     if (!mHaveHeader)
     {
@@ -904,21 +951,9 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
     {
         auto const f = filter.get();
 
-        for (auto const& node : packet.nodes())
+        for (auto& [nodeID, node] : nodes)
         {
-            auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
-
-            if (!nodeID)
-                throw std::runtime_error("data does not properly deserialize");
-
-            if (nodeID->isRoot())
-            {
-                san += map.addRootNode(rootHash, makeSlice(node.nodedata()), f);
-            }
-            else
-            {
-                san += map.addKnownNode(*nodeID, makeSlice(node.nodedata()), f);
-            }
+            san += map.addKnownNode(nodeID, std::move(node), f);
 
             if (!san.isGood())
             {
@@ -926,6 +961,36 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
                 return;
             }
         }
+
+        // Nodes that were not prepared are deserialized here.
+        if (nodes.empty())
+        {
+            for (auto const& node : packet.nodes())
+            {
+                auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
+
+                if (!nodeID)
+                    throw std::runtime_error(
+                        "data does not properly deserialize");
+
+                if (nodeID->isRoot())
+                {
+                    san += map.addRootNode(
+                        rootHash, makeSlice(node.nodedata()), f);
+                }
+                else
+                {
+                    san += map.addKnownNode(
+                        *nodeID, makeSlice(node.nodedata()), f);
+                }
+
+                if (!san.isGood())
+                {
+                    JLOG(journal_.warn()) << "Received bad node data";
+                    return;
+                }
+            }
+        }
     }
     catch (std::exception const& e)
     {
@@ -1036,6 +1101,48 @@ InboundLedger::getNeededHashes()
     return ret;
 }
 
+/** Deserialize and hash the nodes of a reply
+    Returns nothing if the reply holds a root node or anything malformed,
+    leaving those to be handled, and charged for, with the ledger locked.
+*/
+InboundLedger::PreparedNodes
+InboundLedger::prepareNodes(protocol::TMLedgerData const& packet)
+{
+    PreparedNodes nodes;
+
+    if ((packet.type() != protocol::liTX_NODE) &&
+        (packet.type() != protocol::liAS_NODE))
+        return nodes;
+
+    nodes.reserve(packet.nodes().size());
+
+    try
+    {
+        for (auto const& node : packet.nodes())
+        {
+            if (!node.has_nodeid() || !node.has_nodedata())
+                return {};
+
+            auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
+            if (!nodeID || nodeID->isRoot())
+                return {};
+
+            auto treeNode =
+                SHAMapTreeNode::makeFromWire(makeSlice(node.nodedata()));
+            if (!treeNode)
+                return {};
+
+            nodes.emplace_back(*nodeID, std::move(treeNode));
+        }
+    }
+    catch (std::exception const&)
+    {
+        return {};
+    }
+
+    return nodes;
+}
+
 /** Stash a TMLedgerData received from a peer for later processing
     Returns 'true' if we need to dispatch
 */
@@ -1044,12 +1151,16 @@ InboundLedger::gotData(
     std::weak_ptr<Peer> peer,
     std::shared_ptr<protocol::TMLedgerData> const& data)
 {
+    // Do the hashing before taking any lock, so that replies from
+    // several peers are verified in parallel.
+    auto nodes = prepareNodes(*data);
+
     std::lock_guard sl(mReceivedDataLock);
 
     if (isDone())
         return false;
 
-    mReceivedData.emplace_back(peer, data);
+    mReceivedData.push_back({std::move(peer), data, std::move(nodes)});
 
     if (mReceiveDispatched)
         return false;
@@ -1069,7 +1180,8 @@ InboundLedger::gotData(
 int
 InboundLedger::processData(
     std::shared_ptr<Peer> peer,
-    protocol::TMLedgerData& packet)
+    protocol::TMLedgerData& packet,
+    PreparedNodes& nodes)
 {
     if (packet.type() == protocol::liBASE)
     {
@@ -1157,7 +1269,7 @@ InboundLedger::processData(
         }
 
         SHAMapAddNode san;
-        receiveNode(packet, san);
+        receiveNode(packet, nodes, san);
 
         JLOG(journal_.debug())
             << "Ledger "
@@ -1280,11 +1392,24 @@ InboundLedger::runData()
             data.swap(mReceivedData);
         }
 
+        // Add the whole batch to the maps under one lock
+        ScopedLockType sl(mtx_);
+        auto const now = m_clock.now();
+
         for (auto& entry : data)
         {
-            if (auto peer = entry.first.lock())
+            if (auto peer = entry.peer.lock())
             {
-                int count = processData(peer, *(entry.second));
+                int count = processData(peer, *entry.packet, entry.nodes);
+
+                if ((entry.packet->type() == protocol::liTX_NODE) ||
+                    (entry.packet->type() == protocol::liAS_NODE))
+                {
+                    if (auto const it = mPeerWindows.find(peer->id());
+                        it != mPeerWindows.end())
+                        it->second.received(now, count);
+                }
+
                 dataCounts.update(std::move(peer), count);
             }
         }
@@ -1326,6 +1451,15 @@ InboundLedger::getJson(int)
 
     ret[jss::timeouts] = timeouts_;
 
+    {
+        using namespace std::chrono;
+        auto const elapsed =
+            duration_cast<milliseconds>(m_clock.now() - mStarted).count();
+        auto const nodes = static_cast<std::int64_t>(mStats.getGood());
+        ret[jss::nodes_per_second] =
+            elapsed > 0 ? static_cast<Json::UInt>(nodes * 1000 / elapsed) : 0;
+    }
+
     if (mHaveHeader && !mHaveState)
     {
         Json::Value hv(Json::arrayValue);
@@ -210,11 +210,22 @@ public:
 
             // Stash the data for later processing and see if we need to
             // dispatch
-            if (ledger->gotData(std::weak_ptr<Peer>(peer), packet))
+            auto stash =
+                [this, ledger, weak = std::weak_ptr<Peer>(peer), packet]() {
+                    if (ledger->gotData(weak, packet))
+                        app_.getJobQueue().addJob(
+                            jtLEDGER_DATA, "processLedgerData", [ledger]() {
+                                ledger->runData();
+                            });
+                };
+
+            // Nodes are hashed as they are stashed. Do that on a job of its
+            // own, so that replies from several peers are hashed at once.
+            if (packet->type() == protocol::liBASE)
+                stash();
+            else
                 app_.getJobQueue().addJob(
-                    jtLEDGER_DATA, "processLedgerData", [ledger]() {
-                        ledger->runData();
-                    });
+                    jtLEDGER_DATA, "prepareLedgerData", std::move(stash));
 
             return true;
         }
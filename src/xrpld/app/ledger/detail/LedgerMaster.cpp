@@ -1206,7 +1206,7 @@ LedgerMaster::getLedgerHashForHistory(
 
 std::vector<std::shared_ptr<Ledger const>>
 LedgerMaster::findNewLedgersToPublish(
-    std::unique_lock<std::recursive_mutex>& sl)
+    std::unique_lock<MutexType>& sl)
 {
     std::vector<std::shared_ptr<Ledger const>> ret;
 
@@ -1527,7 +1527,7 @@ LedgerMaster::newOrderBookDB()
 bool
 LedgerMaster::newPFWork(
     char const* name,
-    std::unique_lock<std::recursive_mutex>&)
+    std::unique_lock<MutexType>&)
 {
     if (!app_.isStopping() && mPathFindThread < 2 &&
         app_.getPathRequests().requestsPending())
@@ -1546,7 +1546,7 @@ LedgerMaster::newPFWork(
     return mPathFindThread > 0 && !app_.isStopping();
 }
 
-std::recursive_mutex&
+LedgerMaster::MutexType&
 LedgerMaster::peekMutex()
 {
     return m_mutex;
@@ -1802,7 +1802,7 @@ LedgerMaster::fetchForHistory(
     std::uint32_t missing,
     bool& progress,
     InboundLedger::Reason reason,
-    std::unique_lock<std::recursive_mutex>& sl)
+    std::unique_lock<MutexType>& sl)
 {
     scope_unlock sul{sl};
     if (auto hash = getLedgerHashForHistory(missing, reason))
@@ -1913,7 +1913,7 @@ LedgerMaster::fetchForHistory(
 
 // Try to publish ledgers, acquire missing ledgers
 void
-LedgerMaster::doAdvance(std::unique_lock<std::recursive_mutex>& sl)
+LedgerMaster::doAdvance(std::unique_lock<MutexType>& sl)
 {
     do
     {
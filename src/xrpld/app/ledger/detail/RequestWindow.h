@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_REQUESTWINDOW_H_INCLUDED
+#define RIPPLE_APP_LEDGER_REQUESTWINDOW_H_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <optional>
+
+namespace ripple {
+
+/** Paces the node requests sent to one peer while acquiring a ledger.
+
+    Sending one request and waiting for the reply leaves the peer idle for
+    a round trip. The window keeps enough requests outstanding to cover
+    the peer's bandwidth-delay product: the rate at which the peer has
+    been returning useful nodes, measured once per round trip, times the
+    shortest round trip seen, expressed in requests, plus one so that the
+    next request is always queued. Since the measured rate can only grow
+    while the window does, a fast peer opens the window until it stops
+    keeping up or the window reaches its limit. A useless reply or a
+    request left unanswered halves it.
+*/
+class RequestWindow
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    RequestWindow(std::size_t nodesPerRequest, std::size_t maxRequests)
+        : nodesPerRequest_(nodesPerRequest), maxRequests_(maxRequests)
+    {
+    }
+
+    /** The number of requests that may be sent now. */
+    std::size_t
+    available() const
+    {
+        return window_ > outstanding_.size() ? window_ - outstanding_.size()
+                                             : 0;
+    }
+
+    /** A request was sent. */
+    void
+    sent(clock_type::time_point now)
+    {
+        // The peer was idle, so start measuring afresh.
+        if (outstanding_.empty())
+        {
+            epoch_ = now;
+            epochNodes_ = 0;
+        }
+        outstanding_.push_back(now);
+    }
+
+    /** A reply arrived. Replies are matched to requests in order.
+
+        @param useful The number of new nodes the reply carried.
+    */
+    void
+    received(clock_type::time_point now, int useful)
+    {
+        using namespace std::chrono;
+
+        // Replies to requests that expired, or were sent before the peer
+        // had a window, are not tracked.
+        if (outstanding_.empty())
+            return;
+
+        auto const latency = now - outstanding_.front();
+        outstanding_.pop_front();
+        if (!minLatency_ || latency < *minLatency_)
+            minLatency_ = latency;
+
+        if (useful <= 0)
+        {
+            window_ = std::max<std::size_t>(1, window_ / 2);
+            return;
+        }
+
+        epochNodes_ += useful;
+        auto const elapsed = now - epoch_;
+        if (elapsed < *minLatency_ || elapsed <= clock_type::duration::zero())
+            return;
+
+        auto const seconds = [](clock_type::duration d) {
+            return duration_cast<duration<double>>(d).count();
+        };
+        auto const rate = epochNodes_ / seconds(elapsed);
+        nodesPerSecond_ =
+            nodesPerSecond_ == 0 ? rate : (nodesPerSecond_ + rate) / 2;
+        epoch_ = now;
+        epochNodes_ = 0;
+
+        auto const inFlight = nodesPerSecond_ * seconds(*minLatency_);
+        auto const target = 1 +
+            static_cast<std::size_t>(std::ceil(inFlight / nodesPerRequest_));
+        window_ = std::clamp<std::size_t>(target, 1, maxRequests_);
+    }
+
+    /** Forget requests older than `maxAge`. A busy peer drops requests
+        without answering them.
+    */
+    void
+    expire(clock_type::time_point now, clock_type::duration maxAge)
+    {
+        auto const before = outstanding_.size();
+        while (!outstanding_.empty() && now - outstanding_.front() > maxAge)
+            outstanding_.pop_front();
+
+        if (outstanding_.size() != before)
+            window_ = std::max<std::size_t>(1, window_ / 2);
+    }
+
+    /** The number of requests the peer may have outstanding. */
+    std::size_t
+    window() const
+    {
+        return window_;
+    }
+
+    std::size_t
+    outstanding() const
+    {
+        return outstanding_.size();
+    }
+
+    /** The smoothed rate at which the peer returns useful nodes. */
+    double
+    nodesPerSecond() const
+    {
+        return nodesPerSecond_;
+    }
+
+private:
+    std::size_t const nodesPerRequest_;
+    std::size_t const maxRequests_;
+
+    // When each outstanding request was sent, oldest first.
+    std::deque<clock_type::time_point> outstanding_;
+    std::optional<clock_type::duration> minLatency_;
+
+    // The useful nodes received since the rate was last sampled.
+    clock_type::time_point epoch_;
+    std::size_t epochNodes_ = 0;
+
+    double nodesPerSecond_ = 0;
+    std::size_t window_ = 1;
+};
+
+}  // namespace ripple
+
+#endif
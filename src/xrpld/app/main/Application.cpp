@@ -55,7 +55,9 @@
 #include <xrpld/overlay/make_Overlay.h>
 #include <xrpld/perflog/PerfLog.h>
 #include <xrpld/rpc/detail/RPCHelpers.h>
+#include <xrpld/shamap/NodeCacheSnapshot.h>
 #include <xrpld/shamap/NodeFamily.h>
+#include <xrpld/shamap/SHAMapInnerNode.h>
 
 #include <xrpl/basics/ByteUtilities.h>
 #include <xrpl/basics/ResolverAsio.h>
@@ -72,6 +74,7 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/system/error_code.hpp>
 
 #include <date/date.h>
@@ -166,13 +169,13 @@ public:
     std::uint64_t const instanceCookie_;
 
     beast::Journal m_journal;
+    std::unique_ptr<CollectorManager> m_collectorManager;
     std::unique_ptr<perf::PerfLog> perfLog_;
-    Application::MutexType m_masterMutex;
+    Application::MutexType m_masterMutex{"MasterLock"};
 
     // Required by the SHAMapStore
     TransactionMaster m_txMaster;
 
-    std::unique_ptr<CollectorManager> m_collectorManager;
     std::unique_ptr<JobQueue> m_jobQueue;
     NodeStoreScheduler m_nodeStoreScheduler;
     std::unique_ptr<SHAMapStore> m_shaMapStore;
@@ -188,6 +191,11 @@ public:
 
     std::unique_ptr<NodeStore::Database> m_nodeStore;
     NodeFamily nodeFamily_;
+    NodeCacheSnapshot::Setup nodeCacheSnapshot_;
+    std::mutex nodeCacheSnapshotMutex_;
+    std::chrono::steady_clock::time_point nodeCacheSnapshotSaved_;
+    // The nodes read from the snapshot, held until a ledger uses them
+    std::vector<intr_ptr::SharedPtr<SHAMapTreeNode>> warmedNodes_;
     // VFALCO TODO Make OrderBookDB abstract
     OrderBookDB m_orderBookDB;
     std::unique_ptr<PathRequests> m_pathRequests;
@@ -277,6 +285,12 @@ public:
                   std::numeric_limits<std::uint64_t>::max() - 1))
         , m_journal(logs_->journal("Application"))
 
+        // PerfLog publishes through the collector, which therefore comes
+        // first. The collector does not use the PerfLog.
+        , m_collectorManager(make_CollectorManager(
+              config_->section(SECTION_INSIGHT),
+              logs_->journal("Collector")))
+
         // PerfLog must be started before any other threads are launched.
         , perfLog_(perf::make_PerfLog(
               perf::setup_PerfLog(
@@ -284,14 +298,11 @@ public:
                   config_->CONFIG_DIR),
               *this,
               logs_->journal("PerfLog"),
-              [this] { signalStop("PerfLog"); }))
+              [this] { signalStop("PerfLog"); },
+              m_collectorManager->group("perf")))
 
         , m_txMaster(*this)
 
-        , m_collectorManager(make_CollectorManager(
-              config_->section(SECTION_INSIGHT),
-              logs_->journal("Collector")))
-
         , m_jobQueue(std::make_unique<JobQueue>(
               [](std::unique_ptr<Config> const& config) {
                   if (config->standalone() && !config->FORCE_MULTI_THREAD)
@@ -318,7 +329,8 @@ public:
               m_collectorManager->group("jobq"),
               logs_->journal("JobQueue"),
               *logs_,
-              *perfLog_))
+              *perfLog_,
+              config_->WORK_STEALING))
 
         , m_nodeStoreScheduler(*m_jobQueue)
 
@@ -982,6 +994,23 @@ public:
         // VFALCO TODO fix the dependency inversion using an observer,
         //         have listeners register for "onSweep ()" notification.
 
+        // Before the sweep, which drops FullBelow keys worth saving.
+        if (!nodeCacheSnapshot_.path.empty() &&
+            nodeCacheSnapshot_.interval.count() > 0 &&
+            std::chrono::steady_clock::now() - nodeCacheSnapshotSaved_ >=
+                nodeCacheSnapshot_.interval)
+        {
+            saveNodeCacheSnapshot();
+        }
+
+        // Once there is a validated ledger its maps hold the warmed nodes
+        // they use, and the rest may age out of the cache.
+        if (m_ledgerMaster->getValidatedLedger())
+        {
+            std::lock_guard lock(nodeCacheSnapshotMutex_);
+            warmedNodes_.clear();
+        }
+
         {
             std::shared_ptr<FullBelowCache const> const fullBelowCache =
                 nodeFamily_.getFullBelowCache();
@@ -1164,6 +1193,12 @@ private:
 
     void
     setMaxDisallowedLedger();
+
+    void
+    saveNodeCacheSnapshot();
+
+    void
+    loadNodeCacheSnapshot();
 };
 
 //------------------------------------------------------------------------------
@@ -1222,6 +1257,18 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     // Optionally turn off logging to console.
     logs_->silent(config_->silent());
 
+    // Before any ledger is loaded, so every inner node comes from the slab.
+    if (config_->INNER_NODE_SLAB)
+        SHAMapInnerNode::setSlabAllocation(true);
+
+    if (config_->exists(SECTION_NODE_CACHE_SNAPSHOT))
+    {
+        nodeCacheSnapshot_ = setup_NodeCacheSnapshot(
+            config_->section(SECTION_NODE_CACHE_SNAPSHOT),
+            config_->legacy("database_path"));
+        nodeCacheSnapshotSaved_ = std::chrono::steady_clock::now();
+    }
+
     if (!initRelationalDatabase() || !initNodeStore())
         return false;
 
@@ -1539,6 +1586,13 @@ ApplicationImp::start(bool withTimers)
     if (overlay_)
         overlay_->start();
 
+    if (!nodeCacheSnapshot_.path.empty())
+    {
+        m_jobQueue->addJob(jtWARM, "loadNodeCacheSnapshot", [this]() {
+            loadNodeCacheSnapshot();
+        });
+    }
+
     if (grpcServer_->start())
         fixConfigPorts(
             *config_, {{SECTION_PORT_GRPC, grpcServer_->getEndpoint()}});
@@ -1626,6 +1680,9 @@ ApplicationImp::run()
             return validators().trustedPublisher(pubKey);
         });
 
+    if (!nodeCacheSnapshot_.path.empty())
+        saveNodeCacheSnapshot();
+
     // The order of these stop calls is delicate.
     // Re-ordering them risks undefined behavior.
     m_loadManager->stop();
@@ -1703,6 +1760,98 @@ ApplicationImp::fdRequired() const
 
 //------------------------------------------------------------------------------
 
+void
+ApplicationImp::saveNodeCacheSnapshot()
+{
+    std::lock_guard lock(nodeCacheSnapshotMutex_);
+    nodeCacheSnapshotSaved_ = std::chrono::steady_clock::now();
+
+    try
+    {
+        auto const validated = m_ledgerMaster->getValidatedLedger();
+        auto const closed = m_ledgerMaster->getClosedLedger();
+
+        std::vector<SHAMap const*> maps;
+        for (auto const& ledger : {validated, closed})
+        {
+            if (ledger)
+                maps.push_back(&ledger->stateMap());
+        }
+
+        auto snapshot = makeNodeCacheSnapshot(
+            nodeFamily_, maps, nodeCacheSnapshot_.maxNodes);
+        if (auto const& ledger = validated ? validated : closed)
+            snapshot.ledgerSeq = ledger->info().seq;
+        snapshot.lastRotated = m_shaMapStore->getLastRotated();
+
+        writeNodeCacheSnapshot(snapshot, nodeCacheSnapshot_.path);
+
+        JLOG(m_journal.info())
+            << "Saved node cache snapshot of ledger " << snapshot.ledgerSeq
+            << ": " << snapshot.innerNodes.size() << " inner nodes, "
+            << snapshot.fullBelow.size() << " full below keys";
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(m_journal.warn())
+            << "Unable to save node cache snapshot: " << e.what();
+    }
+}
+
+void
+ApplicationImp::loadNodeCacheSnapshot()
+{
+    using namespace std::chrono;
+
+    auto const& path = nodeCacheSnapshot_.path;
+    if (!boost::filesystem::exists(path))
+    {
+        JLOG(m_journal.info()) << "No node cache snapshot at " << path.string();
+        return;
+    }
+
+    try
+    {
+        auto const start = steady_clock::now();
+        auto const snapshot = readNodeCacheSnapshot(path);
+        auto warmed = warmNodeCaches(
+            nodeFamily_,
+            snapshot,
+            m_shaMapStore->getLastRotated(),
+            [this](
+                std::size_t count, std::function<void(std::size_t)> const& f) {
+                m_jobQueue->parallelFor(
+                    jtWARM,
+                    "warmNodeCaches",
+                    count,
+                    nodeCacheSnapshot_.threads - 1,
+                    f);
+            },
+            [this]() { return isStopping(); });
+
+        if (!m_ledgerMaster->getValidatedLedger())
+        {
+            std::lock_guard lock(nodeCacheSnapshotMutex_);
+            warmedNodes_ = std::move(warmed.nodes);
+        }
+
+        JLOG(m_journal.info())
+            << "Loaded node cache snapshot of ledger " << snapshot.ledgerSeq
+            << ": " << warmed.innerNodes << " of "
+            << snapshot.innerNodes.size() << " inner nodes, "
+            << warmed.fullBelow << " of " << snapshot.fullBelow.size()
+            << " full below keys in "
+            << duration_cast<milliseconds>(steady_clock::now() - start)
+                   .count()
+            << "ms";
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(m_journal.warn())
+            << "Unable to load node cache snapshot: " << e.what();
+    }
+}
+
 void
 ApplicationImp::startGenesisLedger()
 {
@@ -22,6 +22,7 @@
 
 #include <xrpld/core/Config.h>
 #include <xrpld/overlay/PeerReservationTable.h>
+#include <xrpld/perflog/TracedMutex.h>
 #include <xrpld/shamap/TreeNodeCache.h>
 
 #include <xrpl/basics/TaggedCache.h>
@@ -123,8 +124,10 @@ public:
             * State of the consensus engine
 
         other things
+
+        Waits for it are traced as "MasterLock" when lock tracing is enabled.
     */
-    using MutexType = std::recursive_mutex;
+    using MutexType = perf::TracedMutex<std::recursive_mutex>;
     virtual MutexType&
     getMasterMutex() = 0;
 
@@ -85,18 +85,21 @@ inline constexpr std::array<char const*, 8> TxDBInit{
      "CREATE INDEX IF NOT EXISTS TxLgrIndex ON           \
         Transactions(LedgerSeq);",
 
-     "CREATE TABLE IF NOT EXISTS AccountTransactions (   \
-        TransID     CHARACTER(64),                      \
-        Account     CHARACTER(64),                      \
+     // Transaction IDs and accounts are stored as 32 and 20 byte blobs.
+     // Databases created before this table held them as hex and base58
+     // text in AccountTransactions, which is migrated in the background.
+     "CREATE TABLE IF NOT EXISTS AccountTransactionsV2 ( \
+        TransID     BLOB NOT NULL,                      \
+        Account     BLOB NOT NULL,                      \
         LedgerSeq   BIGINT UNSIGNED,                    \
         TxnSeq      INTEGER                             \
     );",
-     "CREATE INDEX IF NOT EXISTS AcctTxIDIndex ON        \
-        AccountTransactions(TransID);",
-     "CREATE INDEX IF NOT EXISTS AcctTxIndex ON          \
-        AccountTransactions(Account, LedgerSeq, TxnSeq, TransID);",
-     "CREATE INDEX IF NOT EXISTS AcctLgrIndex ON         \
-        AccountTransactions(LedgerSeq, Account, TransID);",
+     "CREATE INDEX IF NOT EXISTS AcctTxV2IDIndex ON      \
+        AccountTransactionsV2(TransID);",
+     "CREATE INDEX IF NOT EXISTS AcctTxV2Index ON        \
+        AccountTransactionsV2(Account, LedgerSeq, TxnSeq, TransID);",
+     "CREATE INDEX IF NOT EXISTS AcctLgrV2Index ON       \
+        AccountTransactionsV2(LedgerSeq, Account, TransID);",
 
      "END TRANSACTION;"}};
 
@@ -22,8 +22,12 @@
 #include <xrpld/core/Config.h>
 #include <xrpld/core/ConfigSections.h>
 #include <xrpld/core/TimeKeeper.h>
+#include <xrpld/nodestore/DummyScheduler.h>
+#include <xrpld/nodestore/Manager.h>
+#include <xrpld/nodestore/detail/MappedStore.h>
 #include <xrpld/rpc/RPCCall.h>
 
+#include <xrpl/basics/ByteUtilities.h>
 #include <xrpl/basics/Log.h>
 #include <xrpl/beast/core/CurrentThreadName.h>
 #include <xrpl/protocol/BuildInfo.h>
@@ -397,6 +401,10 @@ run(int argc, char** argv)
         po::value<std::string>(),
         "Load the specified ledger file.")(
         "load", "Load the current ledger from the local DB.")(
+        "mapped_export",
+        po::value<std::string>(),
+        "Write the contents of [node_db] to the specified read-only mapped "
+        "store file and exit.")(
         "net", "Get the initial ledger from the network.")(
         "replay", "Replay a ledger close.")(
         "trap_tx_hash",
@@ -614,6 +622,35 @@ run(int argc, char** argv)
         return 0;
     }
 
+    if (vm.count("mapped_export"))
+    {
+        try
+        {
+            NodeStore::DummyScheduler scheduler;
+            auto backend = NodeStore::Manager::instance().make_Backend(
+                config->section(ConfigSection::nodeDatabase()),
+                megabytes(
+                    config->getValueFor(SizedItem::burstSize, std::nullopt)),
+                scheduler,
+                config->journal());
+            backend->open(false);
+
+            auto const path = vm["mapped_export"].as<std::string>();
+            auto const count =
+                NodeStore::writeMappedStore(*backend, path, config->journal());
+            std::cout << "Wrote " << count << " objects to " << path
+                      << std::endl;
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "exception " << e.what() << " in function " << __func__
+                      << std::endl;
+            return -1;
+        }
+
+        return 0;
+    }
+
     if (vm.contains("force_ledger_present_range"))
     {
         try
@@ -20,32 +20,73 @@
 #include <xrpld/app/misc/HashRouter.h>
 #include <xrpld/core/Config.h>
 
+#include <algorithm>
+
 namespace ripple {
 
+HashRouter::HashRouter(Setup const& setup, Stopwatch& clock)
+    : setup_(setup)
+    , clock_(clock)
+    , sweepInterval_(std::max(setup_.holdTime / 8, std::chrono::seconds{1}))
+{
+    // Roughly the entries a busy server holds over the default hold time,
+    // so the shards rarely rehash.
+    constexpr std::size_t expectedEntries = 32768;
+
+    auto const now = clock_.now();
+    for (auto& shard : shards_)
+    {
+        shard.entries.reserve(expectedEntries / shardCount);
+        shard.nextSweep = now + sweepInterval_;
+    }
+}
+
 auto
-HashRouter::emplace(uint256 const& key) -> std::pair<Entry&, bool>
+HashRouter::shard(uint256 const& key) -> Shard&
 {
-    auto iter = suppressionMap_.find(key);
+    return shards_[shardHash_(key) & (shardCount - 1)];
+}
+
+auto
+HashRouter::emplace(Shard& shard, uint256 const& key, Stopwatch::time_point now)
+    -> std::pair<Entry&, bool>
+{
+    auto iter = shard.entries.find(key);
 
-    if (iter != suppressionMap_.end())
+    if (iter != shard.entries.end())
     {
-        suppressionMap_.touch(iter);
+        // An expired entry that hasn't been swept yet starts over
+        if (iter->second.expired(now, setup_.holdTime))
+        {
+            iter->second = Entry(now);
+            return std::make_pair(std::ref(iter->second), true);
+        }
+
+        iter->second.touch(now);
         return std::make_pair(std::ref(iter->second), false);
     }
 
     // See if any supressions need to be expired
-    expire(suppressionMap_, setup_.holdTime);
+    if (now >= shard.nextSweep)
+    {
+        std::erase_if(shard.entries, [&](auto const& item) {
+            return item.second.expired(now, setup_.holdTime);
+        });
+        shard.nextSweep = now + sweepInterval_;
+    }
 
     return std::make_pair(
-        std::ref(suppressionMap_.emplace(key, Entry()).first->second), true);
+        std::ref(shard.entries.emplace(key, Entry(now)).first->second), true);
 }
 
 void
 HashRouter::addSuppression(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    emplace(key);
+    emplace(shard, key, now);
 }
 
 bool
@@ -57,9 +98,11 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer)
 std::pair<bool, std::optional<Stopwatch::time_point>>
 HashRouter::addSuppressionPeerWithStatus(uint256 const& key, PeerShortID peer)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(shard, key, now);
     result.first.addPeer(peer);
     return {result.second, result.first.relayed()};
 }
@@ -70,9 +113,11 @@ HashRouter::addSuppressionPeer(
     PeerShortID peer,
     HashRouterFlags& flags)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    auto [s, created] = emplace(key);
+    auto [s, created] = emplace(shard, key, now);
     s.addPeer(peer);
     flags = s.getFlags();
     return created;
@@ -85,21 +130,25 @@ HashRouter::shouldProcess(
     HashRouterFlags& flags,
     std::chrono::seconds tx_interval)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(shard, key, now);
     auto& s = result.first;
     s.addPeer(peer);
     flags = s.getFlags();
-    return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
+    return s.shouldProcess(now, tx_interval);
 }
 
 HashRouterFlags
 HashRouter::getFlags(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    return emplace(key).first.getFlags();
+    return emplace(shard, key, now).first.getFlags();
 }
 
 bool
@@ -108,9 +157,11 @@ HashRouter::setFlags(uint256 const& key, HashRouterFlags flags)
     XRPL_ASSERT(
         static_cast<bool>(flags), "ripple::HashRouter::setFlags : valid input");
 
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(shard, key, now).first;
 
     if ((s.getFlags() & flags) == flags)
         return false;
@@ -123,11 +174,13 @@ auto
 HashRouter::shouldRelay(uint256 const& key)
     -> std::optional<std::set<PeerShortID>>
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    auto const now = clock_.now();
+    std::lock_guard lock(shard.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(shard, key, now).first;
 
-    if (!s.shouldRelay(suppressionMap_.clock().now(), setup_.relayTime))
+    if (!s.shouldRelay(now, setup_.relayTime))
         return {};
 
     return s.releasePeerSet();
@@ -24,8 +24,10 @@
 #include <xrpl/basics/UnorderedContainers.h>
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/basics/chrono.h>
-#include <xrpl/beast/container/aged_unordered_map.h>
+#include <xrpl/basics/hardened_hash.h>
 
+#include <array>
+#include <mutex>
 #include <optional>
 #include <set>
 
@@ -92,6 +94,12 @@ class Config;
     This table keeps track of which hashes have been received by which peers.
     It is used to manage the routing and broadcasting of messages in the peer
     to peer overlay.
+
+    Every relayed message passes through here, so the table is split into
+    shards, each with its own lock. An entry expires once it has not been
+    accessed for the hold time: an expired entry that is found is treated
+    as new, and each shard drops its expired entries in one pass at most
+    once per sweep interval.
 */
 class HashRouter
 {
@@ -129,8 +137,23 @@ private:
     class Entry : public CountedObject<Entry>
     {
     public:
-        Entry()
+        explicit Entry(Stopwatch::time_point now) : touched_(now)
+        {
+        }
+
+        /** Record an access, which keeps the entry from expiring */
+        void
+        touch(Stopwatch::time_point now)
         {
+            touched_ = now;
+        }
+
+        /** True if the entry has not been accessed for holdTime */
+        bool
+        expired(Stopwatch::time_point now, std::chrono::seconds holdTime)
+            const
+        {
+            return touched_ + holdTime <= now;
         }
 
         void
@@ -193,6 +216,7 @@ private:
         }
 
     private:
+        Stopwatch::time_point touched_;
         HashRouterFlags flags_ = HashRouterFlags::UNDEFINED;
         std::set<PeerShortID> peers_;
         // This could be generalized to a map, if more
@@ -201,11 +225,20 @@ private:
         std::optional<Stopwatch::time_point> processed_;
     };
 
-public:
-    HashRouter(Setup const& setup, Stopwatch& clock)
-        : setup_(setup), suppressionMap_(clock)
+    /** A part of the table, with its own lock. */
+    struct Shard
     {
-    }
+        std::mutex mutex;
+        hardened_hash_map<uint256, Entry> entries;
+        // Expired entries stay in place until this time
+        Stopwatch::time_point nextSweep;
+    };
+
+public:
+    // The number of shards; a power of two
+    static constexpr std::size_t shardCount = 64;
+
+    HashRouter(Setup const& setup, Stopwatch& clock);
 
     HashRouter&
     operator=(HashRouter const&) = delete;
@@ -268,22 +301,26 @@ public:
     shouldRelay(uint256 const& key);
 
 private:
-    // pair.second indicates whether the entry was created
-    std::pair<Entry&, bool>
-    emplace(uint256 const&);
+    Shard&
+    shard(uint256 const& key);
 
-    std::mutex mutable mutex_;
+    // pair.second indicates whether the entry was created. The shard's
+    // mutex must be held.
+    std::pair<Entry&, bool>
+    emplace(Shard& shard, uint256 const& key, Stopwatch::time_point now);
 
     // Configurable parameters
     Setup const setup_;
 
-    // Stores all suppressed hashes and their expiration time
-    beast::aged_unordered_map<
-        uint256,
-        Entry,
-        Stopwatch::clock_type,
-        hardened_hash<strong_hash>>
-        suppressionMap_;
+    Stopwatch& clock_;
+
+    // How often a shard drops its expired entries
+    std::chrono::seconds const sweepInterval_;
+
+    // Picks the shard for a key, independently of the shards' own hashing
+    hardened_hash<strong_hash> const shardHash_;
+
+    std::array<Shard, shardCount> shards_;
 };
 
 HashRouter::Setup
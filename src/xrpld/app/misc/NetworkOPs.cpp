@@ -51,6 +51,7 @@
 #include <xrpld/rpc/CTID.h>
 #include <xrpld/rpc/DeliveredAmount.h>
 #include <xrpld/rpc/MPTokenIssuanceID.h>
+#include <xrpld/rpc/PublishedJson.h>
 #include <xrpld/rpc/ServerHandler.h>
 
 #include <xrpl/basics/UptimeClock.h>
@@ -85,6 +86,167 @@
 
 namespace ripple {
 
+namespace {
+
+/** A view of the open ledger that remembers what is read through it.
+
+    Transactions in a batch are preclaimed ahead of time through one of
+    these. Later, while the batch is applied, the result is reused if
+    every state item preclaim read is still the same object in the view
+    being applied to. Items in an open view are never modified in place:
+    a transaction that changes one installs a new copy, so an unchanged
+    pointer means unchanged contents.
+*/
+class RecordingView final : public ReadView
+{
+public:
+    explicit RecordingView(ReadView const& base) : base_(base)
+    {
+    }
+
+    /** Returns `true` if `view` still holds everything that was read.
+
+        Iterating over the state map can not be checked this way, so a
+        view that did that is only unchanged while nothing was applied.
+    */
+    bool
+    unchangedIn(ReadView const& view, bool nothingApplied) const
+    {
+        if (nothingApplied)
+            return true;
+        if (ranged_)
+            return false;
+        for (auto const& [k, sle] : reads_)
+        {
+            if (view.read(k) != sle)
+                return false;
+        }
+        for (auto const& [k, found] : exists_)
+        {
+            if (view.exists(k) != found)
+                return false;
+        }
+        return true;
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists(Keylet const& k) const override
+    {
+        auto const found = base_.exists(k);
+        exists_.emplace_back(k, found);
+        return found;
+    }
+
+    std::optional<key_type>
+    succ(key_type const& key, std::optional<key_type> const& last)
+        const override
+    {
+        ranged_ = true;
+        return base_.succ(key, last);
+    }
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override
+    {
+        auto sle = base_.read(k);
+        reads_.emplace_back(k, sle);
+        return sle;
+    }
+
+    STAmount
+    balanceHook(
+        AccountID const& account,
+        AccountID const& issuer,
+        STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook(AccountID const& account, std::uint32_t count)
+        const override
+    {
+        return base_.ownerCountHook(account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        ranged_ = true;
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        ranged_ = true;
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override
+    {
+        ranged_ = true;
+        return base_.slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists(key_type const& key) const override
+    {
+        return base_.txExists(key);
+    }
+
+    tx_type
+    txRead(key_type const& key) const override
+    {
+        return base_.txRead(key);
+    }
+
+private:
+    ReadView const& base_;
+    mutable std::vector<std::pair<Keylet, std::shared_ptr<SLE const>>> reads_;
+    mutable std::vector<std::pair<Keylet, bool>> exists_;
+    mutable bool ranged_ = false;
+};
+
+}  // namespace
+
 class NetworkOPsImp final : public NetworkOPs
 {
     /**
@@ -124,6 +286,27 @@ class NetworkOPsImp final : public NetworkOPs
         running,
     };
 
+    /**
+     * Checks run on a batch of transactions before it is applied.
+     */
+    struct BatchChecks
+    {
+        // The open ledger the preclaim results were computed against.
+        std::shared_ptr<OpenView const> view;
+        // The load fee scaling factors in effect at the time.
+        std::pair<std::uint32_t, std::uint32_t> scaling;
+        std::vector<std::optional<PreflightResult>> preflight;
+        std::vector<std::optional<PreclaimResult>> preclaim;
+        // What each preclaim read. A preclaim result refers to its view.
+        std::vector<std::unique_ptr<RecordingView>> reads;
+    };
+
+    // A batch is only split across jobs when each gets this many.
+    static constexpr std::size_t minChecksPerThread = 16;
+
+    // The most extra jobs that share the checks of one batch.
+    static constexpr std::size_t maxCheckHelpers = 7;
+
     static std::array<char const*, 5> const states_;
 
     /**
@@ -357,6 +540,14 @@ public:
     void
     apply(std::unique_lock<std::mutex>& batchLock);
 
+    /**
+     * Run preflight and preclaim for every transaction in a batch against
+     * the current open ledger, sharing large batches with other jobs.
+     * Called without any locks held.
+     */
+    BatchChecks
+    checkBatch(std::vector<TransactionStatus> const& transactions);
+
     //
     // Owner functions.
     //
@@ -470,6 +661,8 @@ public:
     updateLocalTx(ReadView const& view) override;
     std::size_t
     getLocalTxCount() override;
+    void
+    getCountsJson(Json::Value& obj) override;
 
     //
     // Monitoring: publisher side.
@@ -805,6 +998,15 @@ private:
     DispatchState mDispatchState = DispatchState::none;
     std::vector<TransactionStatus> mTransactions;
 
+    // Transaction batch timing. The parallel part is the time spent in
+    // checkBatch; the serial part runs from then until the batch has been
+    // applied to the open ledger, including waiting for the locks.
+    std::atomic<std::uint64_t> batchCount_{0};
+    std::atomic<std::uint64_t> batchTxCount_{0};
+    std::atomic<std::uint64_t> batchParallelUs_{0};
+    std::atomic<std::uint64_t> batchSerialUs_{0};
+    std::atomic<std::uint64_t> preclaimReused_{0};
+
     StateAccounting accounting_{};
 
     std::set<uint256> pendingValidations_;
@@ -1500,27 +1702,51 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
 
     batchLock.unlock();
 
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+    auto const checks = checkBatch(transactions);
+    auto const checked = steady_clock::now();
+
     {
         std::unique_lock masterLock{app_.getMasterMutex(), std::defer_lock};
         bool changed = false;
+        std::size_t reused = 0;
         {
             std::unique_lock ledgerLock{
                 m_ledgerMaster.peekMutex(), std::defer_lock};
             std::lock(masterLock, ledgerLock);
 
             app_.openLedger().modify([&](OpenView& view, beast::Journal j) {
-                for (TransactionStatus& e : transactions)
+                // A preclaim result computed ahead of time is only used
+                // against the same open ledger, under the same load fee
+                // scaling, and while nothing it read has been changed by
+                // the transactions applied before it.
+                bool const sameLedger =
+                    app_.openLedger().current() == checks.view;
+                auto const txCount = view.txCount();
+                auto const& feeTrack = app_.getFeeTrack();
+
+                for (std::size_t i = 0; i < transactions.size(); ++i)
                 {
-                    // we check before adding to the batch
-                    ApplyFlags flags = tapNONE;
-                    if (e.admin)
-                        flags |= tapUNLIMITED;
+                    TransactionStatus& e = transactions[i];
 
-                    if (e.failType == FailHard::yes)
-                        flags |= tapFAIL_HARD;
+                    PreclaimResult const* pcresult = nullptr;
+                    if (checks.preclaim[i] && sameLedger &&
+                        feeTrack.getScalingFactors() == checks.scaling &&
+                        checks.reads[i]->unchangedIn(
+                            view, view.txCount() == txCount))
+                    {
+                        pcresult = &*checks.preclaim[i];
+                        ++reused;
+                    }
 
                     auto const result = app_.getTxQ().apply(
-                        app_, view, e.transaction->getSTransaction(), flags, j);
+                        app_,
+                        view,
+                        e.transaction->getSTransaction(),
+                        *checks.preflight[i],
+                        pcresult,
+                        j);
                     e.result = result.ter;
                     e.applied = result.applied;
                     changed = changed || result.applied;
@@ -1528,6 +1754,21 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                 return changed;
             });
         }
+
+        auto const parallel = duration_cast<microseconds>(checked - start);
+        auto const serial =
+            duration_cast<microseconds>(steady_clock::now() - checked);
+        ++batchCount_;
+        batchTxCount_ += transactions.size();
+        batchParallelUs_ += parallel.count();
+        batchSerialUs_ += serial.count();
+        preclaimReused_ += reused;
+        JLOG(m_journal.debug())
+            << "Applied batch of " << transactions.size()
+            << " transactions: " << parallel.count() << "us checking, "
+            << serial.count() << "us applying, " << reused
+            << " preclaim results reused";
+
         if (changed)
             reportFeeChange();
 
@@ -1749,6 +1990,72 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
     mDispatchState = DispatchState::none;
 }
 
+NetworkOPsImp::BatchChecks
+NetworkOPsImp::checkBatch(std::vector<TransactionStatus> const& transactions)
+{
+    BatchChecks checks;
+    checks.view = app_.openLedger().current();
+    checks.scaling = app_.getFeeTrack().getScalingFactors();
+    checks.preflight.resize(transactions.size());
+    checks.preclaim.resize(transactions.size());
+    checks.reads.resize(transactions.size());
+
+    auto const& view = *checks.view;
+    auto const j = app_.journal("OpenLedger");
+
+    // Preflight only depends on the rules and preclaim only reads the view,
+    // so every transaction can be checked independently.
+    auto const chunkCount = std::max<std::size_t>(
+        1,
+        std::min(
+            maxCheckHelpers + 1, transactions.size() / minChecksPerThread));
+    auto const chunk = (transactions.size() + chunkCount - 1) / chunkCount;
+
+    // The other chunks are checked by jobs, so the work counts against the
+    // job type's limit and is waited for at shutdown.
+    m_job_queue.parallelFor(
+        jtBATCH,
+        "checkTransactions",
+        chunkCount,
+        maxCheckHelpers,
+        [&](std::size_t c) {
+            STAmountSO stAmountSO{
+                view.rules().enabled(fixSTAmountCanonicalize)};
+            NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
+
+            auto const first = std::min(transactions.size(), c * chunk);
+            auto const last = std::min(transactions.size(), first + chunk);
+            for (auto i = first; i < last; ++i)
+            {
+                auto const& e = transactions[i];
+
+                // we check before adding to the batch
+                ApplyFlags flags = tapNONE;
+                if (e.admin)
+                    flags |= tapUNLIMITED;
+
+                if (e.failType == FailHard::yes)
+                    flags |= tapFAIL_HARD;
+
+                auto& pfresult = checks.preflight[i];
+                pfresult.emplace(preflight(
+                    app_,
+                    view.rules(),
+                    *e.transaction->getSTransaction(),
+                    flags,
+                    j));
+                if (pfresult->ter == tesSUCCESS)
+                {
+                    checks.reads[i] = std::make_unique<RecordingView>(view);
+                    checks.preclaim[i].emplace(
+                        preclaim(*pfresult, app_, *checks.reads[i]));
+                }
+            }
+        });
+
+    return checks;
+}
+
 //
 // Owner functions
 //
@@ -2252,12 +2559,13 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::domain] = mo.domain;
         jvObj[jss::manifest] = strHex(mo.serialized);
 
+        auto const msg = std::make_shared<PublishedJson const>(jvObj);
         for (auto i = mStreamMaps[sManifests].begin();
              i != mStreamMaps[sManifests].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->publish(msg, true);
                 ++i;
             }
             else
@@ -2355,6 +2663,7 @@ NetworkOPsImp::pubServer()
 
         mLastFeeSummary = f;
 
+        auto const msg = std::make_shared<PublishedJson const>(jvObj);
         for (auto i = mStreamMaps[sServer].begin();
              i != mStreamMaps[sServer].end();)
         {
@@ -2365,7 +2674,7 @@ NetworkOPsImp::pubServer()
             //             sending of JSON data.
             if (p)
             {
-                p->send(jvObj, true);
+                p->publish(msg, true);
                 ++i;
             }
             else
@@ -2388,11 +2697,12 @@ NetworkOPsImp::pubConsensus(ConsensusPhase phase)
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
+        auto const msg = std::make_shared<PublishedJson const>(jvObj);
         for (auto i = streamMap.begin(); i != streamMap.end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->publish(msg, true);
                 ++i;
             }
             else
@@ -2496,14 +2806,13 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
                 }
             });
 
+        PublishedMultiApiJson published{multiObj};
         for (auto i = mStreamMaps[sValidations].begin();
              i != mStreamMaps[sValidations].end();)
         {
             if (auto p = i->second.lock())
             {
-                multiObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(published(p->getApiVersion()), true);
                 ++i;
             }
             else
@@ -2525,6 +2834,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
         jvObj[jss::type] = "peerStatusChange";
 
+        auto const msg = std::make_shared<PublishedJson const>(jvObj);
         for (auto i = mStreamMaps[sPeerStatus].begin();
              i != mStreamMaps[sPeerStatus].end();)
         {
@@ -2532,7 +2842,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->publish(msg, true);
                 ++i;
             }
             else
@@ -2801,6 +3111,7 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
         Json::Value nodestore(Json::objectValue);
         app_.getNodeStore().getCountsJson(nodestore);
         info[jss::counters][jss::nodestore] = nodestore;
+        info[jss::counters][jss::latency] = app_.getPerfLog().latencyJson();
         info[jss::current_activities] = app_.getPerfLog().currentJson();
     }
 
@@ -3071,6 +3382,7 @@ NetworkOPsImp::pubProposedTransaction(
     {
         std::lock_guard sl(mSubLock);
 
+        PublishedMultiApiJson published{jvObj};
         auto it = mStreamMaps[sRTTransactions].begin();
         while (it != mStreamMaps[sRTTransactions].end())
         {
@@ -3078,9 +3390,7 @@ NetworkOPsImp::pubProposedTransaction(
 
             if (p)
             {
-                jvObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(published(p->getApiVersion()), true);
                 ++it;
             }
             else
@@ -3112,6 +3422,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
         alpAccepted->getLedger().get() == lpAccepted.get(),
         "ripple::NetworkOPsImp::pubLedger : accepted input");
 
+    app_.getOrderBookDB().applyLedger(*alpAccepted);
+
     {
         JLOG(m_journal.debug())
             << "Publishing ledger " << lpAccepted->info().seq << " "
@@ -3147,13 +3459,14 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
+            auto const msg = std::make_shared<PublishedJson const>(jvObj);
             auto it = mStreamMaps[sLedger].begin();
             while (it != mStreamMaps[sLedger].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->publish(msg, true);
                     ++it;
                 }
                 else
@@ -3163,7 +3476,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
         if (!mStreamMaps[sBookChanges].empty())
         {
-            Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
+            auto const msg = std::make_shared<PublishedJson const>(
+                ripple::RPC::computeBookChanges(lpAccepted));
 
             auto it = mStreamMaps[sBookChanges].begin();
             while (it != mStreamMaps[sBookChanges].end())
@@ -3171,7 +3485,7 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->publish(msg, true);
                     ++it;
                 }
                 else
@@ -3248,6 +3562,20 @@ NetworkOPsImp::getLocalTxCount()
     return m_localTX->size();
 }
 
+void
+NetworkOPsImp::getCountsJson(Json::Value& obj)
+{
+    XRPL_ASSERT(
+        obj.isObject(),
+        "ripple::NetworkOPsImp::getCountsJson : valid input type");
+
+    obj[jss::tx_batches] = std::to_string(batchCount_);
+    obj[jss::tx_batch_transactions] = std::to_string(batchTxCount_);
+    obj[jss::tx_batch_parallel_us] = std::to_string(batchParallelUs_);
+    obj[jss::tx_batch_serial_us] = std::to_string(batchSerialUs_);
+    obj[jss::tx_batch_preclaim_reused] = std::to_string(preclaimReused_);
+}
+
 // This routine should only be used to publish accepted or validated
 // transactions.
 MultiApiJson
@@ -3376,6 +3704,8 @@ NetworkOPsImp::pubValidatedTransaction(
     {
         std::lock_guard sl(mSubLock);
 
+        // Serialized at most once per API version, for both streams.
+        PublishedMultiApiJson published{jvObj};
         auto it = mStreamMaps[sTransactions].begin();
         while (it != mStreamMaps[sTransactions].end())
         {
@@ -3383,9 +3713,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                jvObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(published(p->getApiVersion()), true);
                 ++it;
             }
             else
@@ -3400,9 +3728,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                jvObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(published(p->getApiVersion()), true);
                 ++it;
             }
             else
@@ -3520,11 +3846,11 @@ NetworkOPsImp::pubAccountTransaction(
         auto const trResult = transaction.getResult();
         MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
 
-        for (InfoSub::ref isrListener : notify)
         {
-            jvObj.visit(
-                isrListener->getApiVersion(),  //
-                [&](Json::Value const& jv) { isrListener->send(jv, true); });
+            PublishedMultiApiJson published{jvObj};
+            for (InfoSub::ref isrListener : notify)
+                isrListener->publish(
+                    published(isrListener->getApiVersion()), true);
         }
 
         if (last)
@@ -3602,10 +3928,12 @@ NetworkOPsImp::pubProposedAccountTransaction(
         // Create two different Json objects, for different API versions
         MultiApiJson jvObj = transJson(tx, result, false, ledger, std::nullopt);
 
-        for (InfoSub::ref isrListener : notify)
-            jvObj.visit(
-                isrListener->getApiVersion(),  //
-                [&](Json::Value const& jv) { isrListener->send(jv, true); });
+        {
+            PublishedMultiApiJson published{jvObj};
+            for (InfoSub::ref isrListener : notify)
+                isrListener->publish(
+                    published(isrListener->getApiVersion()), true);
+        }
 
         XRPL_ASSERT(
             jvObj.isMember(jss::account_history_tx_stream) ==
@@ -260,6 +260,10 @@ public:
     virtual std::size_t
     getLocalTxCount() = 0;
 
+    /** Add transaction batch statistics to a get_counts response. */
+    virtual void
+    getCountsJson(Json::Value& obj) = 0;
+
     //--------------------------------------------------------------------------
     //
     // Monitoring: publisher side
@@ -117,6 +117,12 @@ SHAMapStoreImp::SHAMapStoreImp(
 
     get_if_exists(section, "online_delete", deleteInterval_);
 
+    // The read-only tier sits below the rotating backends.
+    if (!deleteInterval_ && !get(section, "mapped_path").empty())
+    {
+        Throw<std::runtime_error>("mapped_path requires online_delete");
+    }
+
     if (deleteInterval_)
     {
         // Configuration that affects the behavior of online delete
@@ -190,6 +196,22 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             state_db_.setState(state);
         }
 
+        // An immutable store of older history may be placed below the
+        // rotating backends.
+        std::shared_ptr<NodeStore::Backend> readOnlyBackend;
+        if (auto const mapped = get(nscfg, "mapped_path"); !mapped.empty())
+        {
+            Section section;
+            section.set("type", "Mapped");
+            section.set("path", mapped);
+            readOnlyBackend = NodeStore::Manager::instance().make_Backend(
+                section,
+                0,
+                scheduler_,
+                app_.logs().journal(nodeStoreName_));
+            readOnlyBackend->open(false);
+        }
+
         // Create NodeStore with two backends to allow online deletion of
         // data
         auto dbr = std::make_unique<NodeStore::DatabaseRotatingImp>(
@@ -198,7 +220,8 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             std::move(writableBackend),
             std::move(archiveBackend),
             nscfg,
-            app_.logs().journal(nodeStoreName_));
+            app_.logs().journal(nodeStoreName_),
+            std::move(readOnlyBackend));
         fdRequired_ += dbr->fdRequired();
         dbRotating_ = dbr.get();
         db.reset(dynamic_cast<NodeStore::Database*>(dbr.release()));
@@ -245,14 +268,18 @@ SHAMapStoreImp::fdRequired() const
 }
 
 bool
-SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
+SHAMapStoreImp::copyNode(
+    std::uint64_t& nodeCount,
+    std::vector<uint256>& pending,
+    SHAMapTreeNode const& node)
 {
-    // Copy a single record from node to dbRotating_
-    dbRotating_->fetchNodeObject(
-        node.getHash().as_uint256(),
-        0,
-        NodeStore::FetchType::synchronous,
-        true);
+    // Copy records from node to dbRotating_, a batch at a time
+    pending.push_back(node.getHash().as_uint256());
+    if (pending.size() >= copyBatchSize_)
+    {
+        dbRotating_->fetchNodeObjects(pending, 0, true);
+        pending.clear();
+    }
     if (!(++nodeCount % checkHealthInterval_))
     {
         if (healthWait() == stopping)
@@ -324,6 +351,8 @@ SHAMapStoreImp::run()
 
             JLOG(journal_.debug()) << "copying ledger " << validatedSeq;
             std::uint64_t nodeCount = 0;
+            std::vector<uint256> pending;
+            pending.reserve(copyBatchSize_);
 
             try
             {
@@ -332,7 +361,10 @@ SHAMapStoreImp::run()
                         &SHAMapStoreImp::copyNode,
                         this,
                         std::ref(nodeCount),
+                        std::ref(pending),
                         std::placeholders::_1));
+                if (!pending.empty())
+                    dbRotating_->fetchNodeObjects(pending, 0, true);
             }
             catch (SHAMapMissingNode const& e)
             {
@@ -75,6 +75,8 @@ private:
     std::string const dbPrefix_ = "rippledb";
     // check health/stop status as records are copied
     std::uint64_t const checkHealthInterval_ = 1000;
+    // Nodes copied forward before rotation are read in batches this large
+    static constexpr std::size_t copyBatchSize_ = 256;
     // minimum # of ledgers to maintain for health of network
     static std::uint32_t const minimumDeletionInterval_ = 256;
     // minimum # of ledgers required for standalone mode.
@@ -152,6 +154,9 @@ public:
     LedgerIndex
     getLastRotated() override
     {
+        // Without online delete the state database is never opened
+        if (!deleteInterval_)
+            return 0;
         return state_db_.getState().lastRotated;
     }
 
@@ -177,7 +182,10 @@ public:
 private:
     // callback for visitNodes
     bool
-    copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node);
+    copyNode(
+        std::uint64_t& nodeCount,
+        std::vector<uint256>& pending,
+        SHAMapTreeNode const& node);
     void
     run();
     void
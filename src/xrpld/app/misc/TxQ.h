@@ -278,6 +278,31 @@ public:
         ApplyFlags flags,
         beast::Journal j);
 
+    /**
+        Add a new transaction to the open ledger, hold it in the queue,
+        or reject it, reusing checks that were run ahead of time.
+
+        The result is exactly the same as calling the overload above with
+        the flags from `pfresult`.
+
+        @param pfresult The result of `preflight` for `*tx`. If the rules
+                        have changed since, preflight is run again and
+                        `pcresult` is ignored.
+        @param pcresult Optional result of `preclaim` for `pfresult`. The
+                        caller must guarantee that it was computed against
+                        a view of the same ledger, that nothing it read
+                        differs in `view`, and that the load fee scaling
+                        factors are the same.
+    */
+    ApplyResult
+    apply(
+        Application& app,
+        OpenView& view,
+        std::shared_ptr<STTx const> const& tx,
+        PreflightResult const& pfresult,
+        PreclaimResult const* pcresult,
+        beast::Journal j);
+
     /**
         Fill the new open ledger with transactions from the queue.
 
@@ -518,6 +543,10 @@ private:
         /// set without copies, pointers, etc.
         boost::intrusive::set_member_hook<> byFeeListHook;
 
+        /// Used by TxQ::accept to index the transactions that can
+        /// be applied next.
+        boost::intrusive::set_member_hook<> byHeadListHook;
+
         /// The complete transaction.
         std::shared_ptr<STTx const> txn;
 
@@ -738,7 +767,8 @@ private:
         Application& app,
         OpenView& view,
         std::shared_ptr<STTx const> const& tx,
-        ApplyFlags flags,
+        PreflightResult const& pfresult,
+        PreclaimResult const* pcresult,
         beast::Journal j);
 
     // Helper function that removes a replaced entry in _byFee.
@@ -755,6 +785,14 @@ private:
     using FeeMultiSet = boost::intrusive::
         multiset<MaybeTx, FeeHook, boost::intrusive::compare<OrderCandidates>>;
 
+    using HeadHook = boost::intrusive::member_hook<
+        MaybeTx,
+        boost::intrusive::set_member_hook<>,
+        &MaybeTx::byHeadListHook>;
+
+    using HeadMultiSet = boost::intrusive::
+        multiset<MaybeTx, HeadHook, boost::intrusive::compare<OrderCandidates>>;
+
     using AccountMap = std::map<AccountID, TxQAccount>;
 
     /// Setup parameters used to control the behavior of the queue
@@ -819,12 +857,12 @@ private:
 
     /// Erase and return the next entry in byFee_ (lower fee level)
     FeeMultiSet::iterator_type erase(FeeMultiSet::const_iterator_type);
-    /** Erase and return the next entry for the account (if fee level
-        is higher), or next entry in byFee_ (lower fee level).
-        Used to get the next "applyable" MaybeTx for accept().
+    /** Erase an entry taken from `heads`, and add the account's next
+        sequence-based transaction to `heads` if the entry was the first.
+        Used to keep track of the "applyable" MaybeTxs for accept().
     */
-    FeeMultiSet::iterator_type eraseAndAdvance(
-        FeeMultiSet::const_iterator_type);
+    void
+    eraseHead(FeeMultiSet::const_iterator_type, HeadMultiSet& heads);
     /// Erase a range of items, based on TxQAccount::TxMap iterators
     TxQAccount::TxMap::iterator
     erase(
@@ -462,43 +462,34 @@ TxQ::erase(TxQ::FeeMultiSet::const_iterator_type candidateIter)
     return newCandidateIter;
 }
 
-auto
-TxQ::eraseAndAdvance(TxQ::FeeMultiSet::const_iterator_type candidateIter)
-    -> FeeMultiSet::iterator_type
+void
+TxQ::eraseHead(
+    TxQ::FeeMultiSet::const_iterator_type candidateIter,
+    HeadMultiSet& heads)
 {
-    auto& txQAccount = byAccount_.at(candidateIter->account);
-    auto const accountIter =
-        txQAccount.transactions.find(candidateIter->seqProxy);
     XRPL_ASSERT(
-        accountIter != txQAccount.transactions.end(),
-        "ripple::TxQ::eraseAndAdvance : account found");
+        !candidateIter->byHeadListHook.is_linked(),
+        "ripple::TxQ::eraseHead : taken from heads");
+    auto& txQAccount = byAccount_.at(candidateIter->account);
 
     // Note that sequence-based transactions must be applied in sequence order
     // from smallest to largest.  But ticket-based transactions can be
     // applied in any order.
     XRPL_ASSERT(
         candidateIter->seqProxy.isTicket() ||
-            accountIter == txQAccount.transactions.begin(),
-        "ripple::TxQ::eraseAndAdvance : ticket or sequence");
-    XRPL_ASSERT(
-        byFee_.iterator_to(accountIter->second) == candidateIter,
-        "ripple::TxQ::eraseAndAdvance : found in byFee");
-    auto const accountNextIter = std::next(accountIter);
-
-    // Check if the next transaction for this account is earlier in the queue,
-    // which means we skipped it earlier, and need to try it again.
-    auto const feeNextIter = std::next(candidateIter);
-    bool const useAccountNext =
-        accountNextIter != txQAccount.transactions.end() &&
-        accountNextIter->first > candidateIter->seqProxy &&
-        (feeNextIter == byFee_.end() ||
-         byFee_.value_comp()(accountNextIter->second, *feeNextIter));
-
-    auto const candidateNextIter = byFee_.erase(candidateIter);
-    txQAccount.transactions.erase(accountIter);
-
-    return useAccountNext ? byFee_.iterator_to(accountNextIter->second)
-                          : candidateNextIter;
+            candidateIter->seqProxy == txQAccount.transactions.begin()->first,
+        "ripple::TxQ::eraseHead : ticket or sequence");
+    bool const wasFirst = candidateIter->seqProxy.isSeq();
+
+    erase(candidateIter);
+
+    // The ticket-based transactions are in heads already, or were tried.
+    if (wasFirst && !txQAccount.empty())
+    {
+        auto& next = txQAccount.transactions.begin()->second;
+        if (next.seqProxy.isSeq())
+            heads.insert(next);
+    }
 }
 
 auto
@@ -741,12 +732,39 @@ TxQ::apply(
     // etc. before doing potentially expensive queue
     // replace and multi-transaction operations.
     auto const pfresult = preflight(app, view.rules(), *tx, flags, j);
+    return apply(app, view, tx, pfresult, nullptr, j);
+}
+
+ApplyResult
+TxQ::apply(
+    Application& app,
+    OpenView& view,
+    std::shared_ptr<STTx const> const& tx,
+    PreflightResult const& pfresult,
+    PreclaimResult const* pcresult,
+    beast::Journal j)
+{
+    XRPL_ASSERT(
+        &pfresult.tx == tx.get(),
+        "ripple::TxQ::apply : preflight result matches transaction");
+
+    // Checks made under other rules, for example before an amendment
+    // was enabled, are not reused.
+    if (pfresult.rules != view.rules())
+        return apply(app, view, tx, pfresult.flags, j);
+
+    STAmountSO stAmountSO{view.rules().enabled(fixSTAmountCanonicalize)};
+    NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
+
+    auto flags = pfresult.flags;
+
     if (pfresult.ter != tesSUCCESS)
         return {pfresult.ter, false};
 
     // See if the transaction paid a high enough fee that it can go straight
     // into the ledger.
-    if (auto directApplied = tryDirectApply(app, view, tx, flags, j))
+    if (auto directApplied =
+            tryDirectApply(app, view, tx, pfresult, pcresult, j))
         return *directApplied;
 
     // If we get past tryDirectApply() without returning then we expect
@@ -1164,10 +1182,11 @@ TxQ::apply(
     // Note that earlier code has already verified that the sequence/ticket
     // is valid.  So we use a special entry point that runs all of the
     // preclaim checks with the exception of the sequence check.
-    auto const pcresult =
-        preclaim(pfresult, app, multiTxn ? multiTxn->openView : view);
-    if (!pcresult.likelyToClaimFee)
-        return {pcresult.ter, false};
+    auto const claim = pcresult && !multiTxn
+        ? *pcresult
+        : preclaim(pfresult, app, multiTxn ? multiTxn->openView : view);
+    if (!claim.likelyToClaimFee)
+        return {claim.ter, false};
 
     // Too low of a fee should get caught by preclaim
     XRPL_ASSERT(feeLevelPaid >= baseLevel, "ripple::TxQ::apply : minimum fee");
@@ -1405,12 +1424,11 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
 /*
     How the txs are moved from the queue to the new open ledger.
 
-    1. Iterate over the txs from highest fee level to lowest.
+    1. Index the txs that can be applied next: the first
+        sequence-based tx of each account, and every ticket-based tx.
+    2. Take the txs from the index from highest fee level to lowest.
         For each tx:
-        a) Is this the first tx in the queue for this account?
-            No: Skip this tx. We'll come back to it later.
-            Yes: Continue to the next sub-step.
-        b) Is the tx fee level less than the current required
+        a) Is the tx fee level less than the current required
                 fee level?
             Yes: Stop iterating. Continue to the next step.
             No: Try to apply the transaction. Did it apply?
@@ -1424,12 +1442,13 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
                         (see below).
                     No: Leave it in the queue, track the retries,
                         and continue iterating.
-    2. Return indicator of whether the open ledger was modified.
+    3. Return indicator of whether the open ledger was modified.
 
-    "Appropriate candidate" is defined as the tx that has the
-        highest fee level of:
+    When a sequence-based tx leaves the queue, the account's tx
+        with the next sequence is added to the index, so the
+        "appropriate candidate" is the highest fee level of:
         * the tx for the current account with the next sequence.
-        * the next tx in the queue, simply ordered by fee.
+        * the next tx in the index, simply ordered by fee.
 */
 bool
 TxQ::accept(Application& app, OpenView& view)
@@ -1446,124 +1465,133 @@ TxQ::accept(Application& app, OpenView& view)
 
     auto const metricsSnapshot = feeMetrics_.getSnapshot();
 
-    for (auto candidateIter = byFee_.begin(); candidateIter != byFee_.end();)
+    // Walking byFee_ would pass over every queued transaction that isn't
+    // the first of its account, for each one applied. Index only the ones
+    // that can be applied.
+    HeadMultiSet heads;
+    for (auto& [_, account] : byAccount_)
     {
-        auto& account = byAccount_.at(candidateIter->account);
-        auto const beginIter = account.transactions.begin();
-        if (candidateIter->seqProxy.isSeq() &&
-            candidateIter->seqProxy > beginIter->first)
+        auto iter = account.transactions.begin();
+        if (iter != account.transactions.end() && iter->first.isSeq())
         {
-            // There is a sequence transaction at the front of the queue and
-            // candidate has a later sequence, so skip this candidate.  We
-            // need to process sequence-based transactions in sequence order.
-            JLOG(j_.trace())
-                << "Skipping queued transaction " << candidateIter->txID
-                << " from account " << candidateIter->account
-                << " as it is not the first.";
-            candidateIter++;
-            continue;
+            heads.insert(iter->second);
+            iter = account.transactions.lower_bound(
+                SeqProxy{SeqProxy::ticket, 0});
         }
-        auto const requiredFeeLevel =
-            getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
+        for (; iter != account.transactions.end(); ++iter)
+            heads.insert(iter->second);
+    }
+
+    // The required fee level only changes when a transaction is applied.
+    auto requiredFeeLevel =
+        getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
+
+    while (!heads.empty())
+    {
+        auto const candidateIter = byFee_.iterator_to(*heads.begin());
+        heads.erase(heads.begin());
+
+        auto& account = byAccount_.at(candidateIter->account);
         auto const feeLevelPaid = candidateIter->feeLevel;
         JLOG(j_.trace()) << "Queued transaction " << candidateIter->txID
                          << " from account " << candidateIter->account
                          << " has fee level of " << feeLevelPaid
                          << " needs at least " << requiredFeeLevel;
-        if (feeLevelPaid >= requiredFeeLevel)
-        {
-            JLOG(j_.trace()) << "Applying queued transaction "
-                             << candidateIter->txID << " to open ledger.";
+        if (feeLevelPaid < requiredFeeLevel)
+            break;
 
-            auto const [txnResult, didApply, _metadata] =
-                candidateIter->apply(app, view, j_);
+        JLOG(j_.trace()) << "Applying queued transaction "
+                         << candidateIter->txID << " to open ledger.";
 
-            if (didApply)
-            {
-                // Remove the candidate from the queue
-                JLOG(j_.debug())
-                    << "Queued transaction " << candidateIter->txID
-                    << " applied successfully with " << transToken(txnResult)
-                    << ". Remove from queue.";
-
-                candidateIter = eraseAndAdvance(candidateIter);
-                ledgerChanged = true;
-            }
-            else if (
-                isTefFailure(txnResult) || isTemMalformed(txnResult) ||
-                candidateIter->retriesRemaining <= 0)
-            {
-                if (candidateIter->retriesRemaining <= 0)
-                    account.retryPenalty = true;
-                else
-                    account.dropPenalty = true;
-                JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
-                                 << " failed with " << transToken(txnResult)
-                                 << ". Remove from queue.";
-                candidateIter = eraseAndAdvance(candidateIter);
-            }
+        auto const [txnResult, didApply, _metadata] =
+            candidateIter->apply(app, view, j_);
+
+        if (didApply)
+        {
+            // Remove the candidate from the queue
+            JLOG(j_.debug())
+                << "Queued transaction " << candidateIter->txID
+                << " applied successfully with " << transToken(txnResult)
+                << ". Remove from queue.";
+
+            eraseHead(candidateIter, heads);
+            ledgerChanged = true;
+            requiredFeeLevel =
+                getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
+        }
+        else if (
+            isTefFailure(txnResult) || isTemMalformed(txnResult) ||
+            candidateIter->retriesRemaining <= 0)
+        {
+            if (candidateIter->retriesRemaining <= 0)
+                account.retryPenalty = true;
+            else
+                account.dropPenalty = true;
+            JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
+                             << " failed with " << transToken(txnResult)
+                             << ". Remove from queue.";
+            eraseHead(candidateIter, heads);
+        }
+        else
+        {
+            JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
+                             << " failed with " << transToken(txnResult)
+                             << ". Leave in queue."
+                             << " Applied: " << didApply
+                             << ". Flags: " << candidateIter->flags;
+            if (account.retryPenalty && candidateIter->retriesRemaining > 2)
+                candidateIter->retriesRemaining = 1;
             else
+                --candidateIter->retriesRemaining;
+            candidateIter->lastResult = txnResult;
+            if (account.dropPenalty && account.transactions.size() > 1 &&
+                isFull<95>())
             {
-                JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
-                                 << " failed with " << transToken(txnResult)
-                                 << ". Leave in queue."
-                                 << " Applied: " << didApply
-                                 << ". Flags: " << candidateIter->flags;
-                if (account.retryPenalty && candidateIter->retriesRemaining > 2)
-                    candidateIter->retriesRemaining = 1;
+                // The queue is close to full, this account has multiple
+                // txs queued, and this account has had a transaction
+                // fail.
+                if (candidateIter->seqProxy.isTicket())
+                {
+                    // Since the failed transaction has a ticket, order
+                    // doesn't matter.  Drop this one.
+                    JLOG(j_.info())
+                        << "Queue is nearly full, and transaction "
+                        << candidateIter->txID << " failed with "
+                        << transToken(txnResult)
+                        << ". Removing ticketed tx from account "
+                        << account.account;
+                    eraseHead(candidateIter, heads);
+                }
                 else
-                    --candidateIter->retriesRemaining;
-                candidateIter->lastResult = txnResult;
-                if (account.dropPenalty && account.transactions.size() > 1 &&
-                    isFull<95>())
                 {
-                    // The queue is close to full, this account has multiple
-                    // txs queued, and this account has had a transaction
-                    // fail.
-                    if (candidateIter->seqProxy.isTicket())
-                    {
-                        // Since the failed transaction has a ticket, order
-                        // doesn't matter.  Drop this one.
-                        JLOG(j_.info())
-                            << "Queue is nearly full, and transaction "
-                            << candidateIter->txID << " failed with "
-                            << transToken(txnResult)
-                            << ". Removing ticketed tx from account "
-                            << account.account;
-                        candidateIter = eraseAndAdvance(candidateIter);
-                    }
-                    else
+                    // Even though we're giving this transaction another
+                    // chance, chances are it won't recover. To avoid
+                    // making things worse, drop the _last_ transaction for
+                    // this account.
+                    auto dropRIter = account.transactions.rbegin();
+                    XRPL_ASSERT(
+                        dropRIter->second.account == candidateIter->account,
+                        "ripple::TxQ::accept : account check");
+
+                    JLOG(j_.info())
+                        << "Queue is nearly full, and transaction "
+                        << candidateIter->txID << " failed with "
+                        << transToken(txnResult)
+                        << ". Removing last item from account "
+                        << account.account;
+                    auto endIter = byFee_.iterator_to(dropRIter->second);
+                    if (endIter != candidateIter)
                     {
-                        // Even though we're giving this transaction another
-                        // chance, chances are it won't recover. To avoid
-                        // making things worse, drop the _last_ transaction for
-                        // this account.
-                        auto dropRIter = account.transactions.rbegin();
-                        XRPL_ASSERT(
-                            dropRIter->second.account == candidateIter->account,
-                            "ripple::TxQ::accept : account check");
-
-                        JLOG(j_.info())
-                            << "Queue is nearly full, and transaction "
-                            << candidateIter->txID << " failed with "
-                            << transToken(txnResult)
-                            << ". Removing last item from account "
-                            << account.account;
-                        auto endIter = byFee_.iterator_to(dropRIter->second);
-                        if (endIter != candidateIter)
-                            erase(endIter);
-                        ++candidateIter;
+                        if (endIter->byHeadListHook.is_linked())
+                            heads.erase(heads.iterator_to(*endIter));
+                        erase(endIter);
                     }
                 }
-                else
-                    ++candidateIter;
             }
         }
-        else
-        {
-            break;
-        }
     }
+    // The candidates left in heads stay in the queue.
+    heads.clear();
 
     // All transactions that can be moved out of the queue into the open
     // ledger have been. Rebuild the queue using the open ledger's
@@ -1680,9 +1708,11 @@ TxQ::tryDirectApply(
     Application& app,
     OpenView& view,
     std::shared_ptr<STTx const> const& tx,
-    ApplyFlags flags,
+    PreflightResult const& pfresult,
+    PreclaimResult const* pcresult,
     beast::Journal j)
 {
+    auto flags = pfresult.flags;
     auto const account = (*tx)[sfAccount];
     auto const sleAccount = view.read(keylet::account(account));
 
@@ -1715,8 +1745,8 @@ TxQ::tryDirectApply(
         JLOG(j_.trace()) << "Applying transaction " << transactionID
                          << " to open ledger.";
 
-        auto const [txnResult, didApply, metadata] =
-            ripple::apply(app, view, *tx, flags, j);
+        auto const [txnResult, didApply, metadata] = doApply(
+            pcresult ? *pcresult : preclaim(pfresult, app, view), app, view);
 
         JLOG(j_.trace()) << "New transaction " << transactionID
                          << (didApply ? " applied successfully with "
@@ -0,0 +1,1199 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/rdb/backend/detail/AccountTxIndex.h>
+
+#include <xrpl/basics/Blob.h>
+#include <xrpl/basics/Log.h>
+#include <xrpl/basics/contract.h>
+#include <xrpl/beast/utility/instrumentation.h>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/predef.h>
+
+#if BOOST_OS_WINDOWS
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+
+namespace ripple {
+namespace detail {
+
+namespace {
+
+constexpr std::array<char, 8> magic{'X', 'R', 'P', 'L', 'A', 'T', 'X', 'S'};
+constexpr std::uint32_t version = 1;
+constexpr std::size_t headerBytes = 64;
+constexpr std::size_t walHeaderBytes = 8;
+
+constexpr char const* manifestName = "MANIFEST";
+
+void
+write(std::ofstream& os, void const* data, std::size_t size)
+{
+    os.write(static_cast<char const*>(data), size);
+    if (!os)
+        Throw<std::runtime_error>("AccountTxIndex: write failed");
+}
+
+/** Flush a file, or the entries of a directory, to stable storage. */
+void
+syncToDisk(boost::filesystem::path const& path, bool directory = false)
+{
+#if BOOST_OS_WINDOWS
+    // Windows cannot open a directory for writing; NTFS journals renames.
+    if (directory)
+        return;
+    int const fd = ::_open(path.string().c_str(), _O_RDWR | _O_BINARY);
+    bool const ok = fd >= 0 && ::_commit(fd) == 0;
+    if (fd >= 0)
+        ::_close(fd);
+#else
+    int const fd = ::open(path.c_str(), directory ? O_RDONLY : O_RDWR);
+    bool const ok = fd >= 0 && ::fsync(fd) == 0;
+    if (fd >= 0)
+        ::close(fd);
+#endif
+    if (!ok)
+        Throw<std::runtime_error>(
+            "AccountTxIndex: unable to sync '" + path.string() + "'");
+}
+
+LedgerIndex
+ledgerOf(std::uint8_t const* key)
+{
+    return boost::endian::load_big_u32(key + 20);
+}
+
+int
+compare(std::uint8_t const* a, std::uint8_t const* b)
+{
+    return std::memcmp(a, b, AccountTxIndex::entryBytes);
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+
+/** An immutable run of sorted entries, mapped from a file or in memory.
+
+    @code
+    header      64 bytes, integers little-endian
+                  0  magic "XRPLATXS"
+                  8  u32 version
+                 12  u32 entry size
+                 16  u64 segment id
+                 24  u32 level
+                 28  u32 lowest ledger
+                 32  u32 highest ledger
+                 40  u64 number of entries
+                 48  u64 total file size
+
+    entries     sorted, entryBytes each
+    @endcode
+*/
+class AccountTxIndex::Segment
+{
+public:
+    Segment(
+        boost::filesystem::path const& path,
+        std::uint64_t id,
+        std::uint32_t level)
+        : path_(path)
+    {
+        using namespace boost::interprocess;
+
+        try
+        {
+            file_ = file_mapping(path.string().c_str(), read_only);
+            region_ = mapped_region(file_, read_only);
+        }
+        catch (interprocess_exception const& e)
+        {
+            Throw<std::runtime_error>(
+                "AccountTxIndex: unable to map '" + path.string() +
+                "': " + e.what());
+        }
+
+        // A lookup touches a few pages near each binary search probe.
+        region_.advise(mapped_region::advice_random);
+        init(
+            static_cast<std::uint8_t const*>(region_.get_address()),
+            region_.get_size(),
+            id,
+            level);
+    }
+
+    Segment(Blob&& data, std::uint64_t id, std::uint32_t level)
+        : memory_(std::move(data))
+    {
+        init(memory_.data(), memory_.size(), id, level);
+    }
+
+    ~Segment()
+    {
+        if (!retired_ || path_.empty())
+            return;
+
+        region_ = boost::interprocess::mapped_region();
+        file_ = boost::interprocess::file_mapping();
+        boost::system::error_code ec;
+        boost::filesystem::remove(path_, ec);
+    }
+
+    Segment(Segment const&) = delete;
+    Segment&
+    operator=(Segment const&) = delete;
+
+    /** Remove the file once the last reader lets go of the segment. */
+    void
+    retire() const
+    {
+        retired_ = true;
+    }
+
+    std::uint8_t const*
+    at(std::uint64_t i) const
+    {
+        return base_ + headerBytes + i * entryBytes;
+    }
+
+    /** The position of the first entry not less than `key`. */
+    std::uint64_t
+    lowerBound(Key const& key) const
+    {
+        std::uint64_t lo = 0;
+        std::uint64_t hi = count_;
+        while (lo < hi)
+        {
+            auto const mid = lo + (hi - lo) / 2;
+            if (compare(at(mid), key.data()) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    /** The position of the first entry greater than `key`. */
+    std::uint64_t
+    upperBound(Key const& key) const
+    {
+        std::uint64_t lo = 0;
+        std::uint64_t hi = count_;
+        while (lo < hi)
+        {
+            auto const mid = lo + (hi - lo) / 2;
+            if (compare(at(mid), key.data()) <= 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    bool
+    mayContain(LedgerIndex ledgerSeq) const
+    {
+        return ledgerSeq >= minLedger_ && ledgerSeq <= maxLedger_;
+    }
+
+    std::uint64_t
+    id() const
+    {
+        return id_;
+    }
+
+    std::uint32_t
+    level() const
+    {
+        return level_;
+    }
+
+    std::uint64_t
+    size() const
+    {
+        return count_;
+    }
+
+    LedgerIndex
+    minLedger() const
+    {
+        return minLedger_;
+    }
+
+    LedgerIndex
+    maxLedger() const
+    {
+        return maxLedger_;
+    }
+
+private:
+    void
+    init(
+        std::uint8_t const* base,
+        std::size_t size,
+        std::uint64_t id,
+        std::uint32_t level)
+    {
+        auto const bad = [this](std::string const& why) {
+            Throw<std::runtime_error>(
+                "AccountTxIndex: '" + path_.string() +
+                "' is not a valid segment: " + why);
+        };
+
+        if (size < headerBytes)
+            bad("short header");
+        if (std::memcmp(base, magic.data(), magic.size()) != 0)
+            bad("bad magic");
+        if (boost::endian::load_little_u32(base + 8) != version)
+            bad("unsupported version");
+        if (boost::endian::load_little_u32(base + 12) != entryBytes)
+            bad("unsupported entry size");
+        if (boost::endian::load_little_u64(base + 16) != id ||
+            boost::endian::load_little_u32(base + 24) != level)
+            bad("id does not match the manifest");
+
+        base_ = base;
+        id_ = id;
+        level_ = level;
+        minLedger_ = boost::endian::load_little_u32(base + 28);
+        maxLedger_ = boost::endian::load_little_u32(base + 32);
+        count_ = boost::endian::load_little_u64(base + 40);
+
+        if (boost::endian::load_little_u64(base + 48) != size)
+            bad("truncated");
+        if (count_ != (size - headerBytes) / entryBytes ||
+            (size - headerBytes) % entryBytes != 0)
+            bad("entry count inconsistent with size");
+    }
+
+    boost::filesystem::path path_;
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    Blob memory_;
+    std::uint8_t const* base_ = nullptr;
+    std::uint64_t id_ = 0;
+    std::uint32_t level_ = 0;
+    LedgerIndex minLedger_ = 0;
+    LedgerIndex maxLedger_ = 0;
+    std::uint64_t count_ = 0;
+    mutable std::atomic<bool> retired_{false};
+};
+
+//------------------------------------------------------------------------------
+
+/** A range of entries from one segment or in-memory table. */
+struct AccountTxIndex::Cursor
+{
+    std::uint64_t id = 0;
+
+    // A segment's entries are contiguous.
+    std::uint8_t const* first = nullptr;
+    std::uint8_t const* last = nullptr;
+
+    bool inMemory = false;
+    std::set<Key>::const_iterator setFirst;
+    std::set<Key>::const_iterator setLast;
+
+    bool
+    empty() const
+    {
+        return inMemory ? setFirst == setLast : first == last;
+    }
+
+    std::uint8_t const*
+    front() const
+    {
+        return inMemory ? setFirst->data() : first;
+    }
+
+    std::uint8_t const*
+    back() const
+    {
+        return inMemory ? std::prev(setLast)->data() : last - entryBytes;
+    }
+
+    void
+    popFront()
+    {
+        if (inMemory)
+            ++setFirst;
+        else
+            first += entryBytes;
+    }
+
+    void
+    popBack()
+    {
+        if (inMemory)
+            --setLast;
+        else
+            last -= entryBytes;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+AccountTxIndex::AccountTxIndex(Setup const& setup, beast::Journal j)
+    : setup_(setup), j_(j)
+{
+    XRPL_ASSERT(
+        setup_.memtableEntries > 0 && setup_.fanout > 1,
+        "ripple::detail::AccountTxIndex::AccountTxIndex : valid setup");
+
+    memtable_.id = 1;
+    if (setup_.path.empty())
+        return;
+
+    namespace fs = boost::filesystem;
+    fs::create_directories(setup_.path);
+
+    if (fs::exists(setup_.path / manifestName))
+        readManifest();
+
+    // Anything the manifest does not name is left over from a write that
+    // did not finish. Logs of segments already written can go too.
+    std::vector<std::uint64_t> wals;
+    for (fs::directory_iterator it(setup_.path);
+         it != fs::directory_iterator();
+         ++it)
+    {
+        auto const& path = it->path();
+        auto const ext = path.extension().string();
+        if (ext == ".wal")
+        {
+            std::uint64_t id = 0;
+            std::istringstream is(path.stem().string());
+            if (is >> id && id >= memtable_.id)
+            {
+                wals.push_back(id);
+                continue;
+            }
+        }
+        else if (ext == ".seg")
+        {
+            auto const named = std::any_of(
+                segments_.begin(), segments_.end(), [&](auto const& s) {
+                    return segmentPath(s->id(), s->level()) == path;
+                });
+            if (named)
+                continue;
+        }
+        else if (ext != ".tmp")
+        {
+            continue;
+        }
+
+        JLOG(j_.info()) << "AccountTxIndex: removing " << path.filename();
+        fs::remove(path);
+    }
+
+    std::sort(wals.begin(), wals.end());
+    if (!wals.empty())
+        memtable_.id = wals.back();
+
+    std::size_t replayed = 0;
+    for (auto const id : wals)
+    {
+        std::ifstream is(walPath(id).string(), std::ios::binary);
+        std::array<std::uint8_t, walHeaderBytes> header;
+        while (is.read(reinterpret_cast<char*>(header.data()), header.size()))
+        {
+            auto const ledgerSeq =
+                boost::endian::load_little_u32(header.data());
+            auto const count =
+                boost::endian::load_little_u32(header.data() + 4);
+
+            std::vector<Key> keys(count);
+            if (count &&
+                !is.read(
+                    reinterpret_cast<char*>(keys.data()),
+                    count * entryBytes))
+            {
+                JLOG(j_.warn()) << "AccountTxIndex: ignoring a partial "
+                                   "ledger at the end of "
+                                << walPath(id).filename();
+                break;
+            }
+
+            apply(memtable_, ledgerSeq, std::move(keys));
+            ++replayed;
+        }
+    }
+
+    if (replayed)
+    {
+        JLOG(j_.info()) << "AccountTxIndex: replayed " << replayed
+                        << " ledgers";
+        flush();
+    }
+    else
+    {
+        openWal(memtable_.id);
+    }
+
+    for (auto const id : wals)
+    {
+        if (id < memtable_.id)
+            fs::remove(walPath(id));
+    }
+
+    JLOG(j_.info()) << "AccountTxIndex: opened " << segments_.size()
+                    << " segments with " << size() << " entries";
+}
+
+AccountTxIndex::~AccountTxIndex() = default;
+
+AccountTxIndex::Key
+AccountTxIndex::makeKey(Entry const& e)
+{
+    Key key;
+    std::memcpy(key.data(), e.account.data(), 20);
+    boost::endian::store_big_u32(key.data() + 20, e.ledgerSeq);
+    boost::endian::store_big_u32(key.data() + 24, e.txnSeq);
+    std::memcpy(key.data() + 28, e.txID.data(), 32);
+    return key;
+}
+
+AccountTxIndex::Entry
+AccountTxIndex::makeEntry(std::uint8_t const* key)
+{
+    return {
+        AccountID::fromVoid(key),
+        boost::endian::load_big_u32(key + 20),
+        boost::endian::load_big_u32(key + 24),
+        uint256::fromVoid(key + 28)};
+}
+
+bool
+AccountTxIndex::isLive(std::uint8_t const* key, std::uint64_t id) const
+{
+    auto const ledgerSeq = ledgerOf(key);
+    if (ledgerSeq < floor_)
+        return false;
+
+    auto const it = replaced_.find(ledgerSeq);
+    return it == replaced_.end() || it->second <= id;
+}
+
+void
+AccountTxIndex::apply(
+    Memtable& memtable,
+    LedgerIndex ledgerSeq,
+    std::vector<Key> keys)
+{
+    if (ledgerSeq < floor_)
+        return;
+
+    if (auto it = memtable.ledgers.find(ledgerSeq);
+        it != memtable.ledgers.end())
+    {
+        for (auto const& key : it->second)
+            memtable.keys.erase(key);
+        memtable.ledgers.erase(it);
+    }
+    else
+    {
+        auto const older = std::any_of(
+                               segments_.begin(),
+                               segments_.end(),
+                               [ledgerSeq](auto const& s) {
+                                   return s->mayContain(ledgerSeq);
+                               }) ||
+            (flushing_ && flushing_->ledgers.count(ledgerSeq));
+        if (older)
+            replaced_[ledgerSeq] = memtable.id;
+    }
+
+    memtable.keys.insert(keys.begin(), keys.end());
+    memtable.ledgers[ledgerSeq] = std::move(keys);
+}
+
+void
+AccountTxIndex::saveLedger(
+    LedgerIndex ledgerSeq,
+    std::vector<Entry> const& entries)
+{
+    std::vector<Key> keys;
+    keys.reserve(entries.size());
+    for (auto const& e : entries)
+    {
+        XRPL_ASSERT(
+            e.ledgerSeq == ledgerSeq,
+            "ripple::detail::AccountTxIndex::saveLedger : entry in ledger");
+        keys.push_back(makeKey(e));
+    }
+
+    bool full = false;
+    {
+        std::unique_lock lock(mutex_);
+        if (wal_.is_open())
+        {
+            std::array<std::uint8_t, walHeaderBytes> header;
+            boost::endian::store_little_u32(header.data(), ledgerSeq);
+            boost::endian::store_little_u32(
+                header.data() + 4, static_cast<std::uint32_t>(keys.size()));
+            write(wal_, header.data(), header.size());
+            write(wal_, keys.data(), keys.size() * entryBytes);
+            wal_.flush();
+            if (!wal_)
+                Throw<std::runtime_error>("AccountTxIndex: write failed");
+
+            // The ledger is saved once its log record is on disk.
+            syncToDisk(walPath(memtable_.id));
+        }
+
+        apply(memtable_, ledgerSeq, std::move(keys));
+        full = memtable_.keys.size() >= setup_.memtableEntries;
+    }
+
+    if (full)
+        flush();
+}
+
+void
+AccountTxIndex::deleteBefore(LedgerIndex ledgerSeq)
+{
+    std::vector<std::shared_ptr<Segment const>> dropped;
+    {
+        std::unique_lock lock(mutex_);
+        if (ledgerSeq <= floor_)
+            return;
+        floor_ = ledgerSeq;
+
+        auto& ledgers = memtable_.ledgers;
+        for (auto it = ledgers.begin();
+             it != ledgers.end() && it->first < floor_;)
+        {
+            for (auto const& key : it->second)
+                memtable_.keys.erase(key);
+            it = ledgers.erase(it);
+        }
+
+        std::erase_if(segments_, [&](auto const& s) {
+            if (s->maxLedger() >= floor_)
+                return false;
+            dropped.push_back(s);
+            return true;
+        });
+
+        replaced_.erase(replaced_.begin(), replaced_.lower_bound(floor_));
+    }
+
+    // The old manifest still names the dropped segments, so their files
+    // go only once it is replaced.
+    writeManifest();
+    for (auto const& s : dropped)
+        s->retire();
+}
+
+void
+AccountTxIndex::forEach(
+    AccountID const& account,
+    LedgerIndex minLedger,
+    LedgerIndex maxLedger,
+    std::optional<Position> const& start,
+    bool forward,
+    std::function<bool(Entry const&)> const& f) const
+{
+    std::shared_lock lock(mutex_);
+
+    minLedger = std::max(minLedger, floor_);
+    if (minLedger > maxLedger)
+        return;
+
+    Key low = makeKey({account, minLedger, 0, beast::zero});
+    Key high = makeKey({account, maxLedger, 0, beast::zero});
+    std::fill(high.begin() + 24, high.end(), 0xff);
+
+    if (start)
+    {
+        auto at = makeKey(
+            {account, start->ledgerSeq, start->txnSeq, beast::zero});
+        if (forward)
+        {
+            low = std::max(low, at);
+        }
+        else
+        {
+            std::fill(at.begin() + 28, at.end(), 0xff);
+            high = std::min(high, at);
+        }
+    }
+
+    if (high < low)
+        return;
+
+    std::vector<Cursor> cursors;
+    cursors.reserve(segments_.size() + 2);
+    for (auto const& s : segments_)
+    {
+        Cursor c;
+        c.id = s->id();
+        c.first = s->at(s->lowerBound(low));
+        c.last = s->at(s->upperBound(high));
+        if (!c.empty())
+            cursors.push_back(c);
+    }
+
+    for (auto const* m : {flushing_.get(), &memtable_})
+    {
+        if (!m)
+            continue;
+        Cursor c;
+        c.id = m->id;
+        c.inMemory = true;
+        c.setFirst = m->keys.lower_bound(low);
+        c.setLast = m->keys.upper_bound(high);
+        if (!c.empty())
+            cursors.push_back(c);
+    }
+
+    std::uint8_t const* previous = nullptr;
+    while (true)
+    {
+        Cursor* best = nullptr;
+        for (auto& c : cursors)
+        {
+            if (c.empty())
+                continue;
+            if (!best)
+                best = &c;
+            else if (forward ? compare(c.front(), best->front()) < 0
+                             : compare(c.back(), best->back()) > 0)
+                best = &c;
+        }
+
+        if (!best)
+            return;
+
+        auto const key = forward ? best->front() : best->back();
+        if (forward)
+            best->popFront();
+        else
+            best->popBack();
+
+        if (!isLive(key, best->id))
+            continue;
+
+        // A ledger saved twice with the same contents.
+        if (previous && compare(previous, key) == 0)
+            continue;
+        previous = key;
+
+        if (!f(makeEntry(key)))
+            return;
+    }
+}
+
+std::optional<LedgerIndex>
+AccountTxIndex::minLedgerSeq() const
+{
+    std::shared_lock lock(mutex_);
+
+    std::optional<LedgerIndex> result;
+    auto const consider = [&](LedgerIndex low, LedgerIndex high) {
+        if (high < floor_)
+            return;
+        low = std::max(low, floor_);
+        if (!result || low < *result)
+            result = low;
+    };
+
+    for (auto const& s : segments_)
+        consider(s->minLedger(), s->maxLedger());
+    for (auto const* m : {flushing_.get(), &memtable_})
+    {
+        if (m && !m->ledgers.empty())
+            consider(m->ledgers.begin()->first, m->ledgers.rbegin()->first);
+    }
+    return result;
+}
+
+std::optional<LedgerIndex>
+AccountTxIndex::maxLedgerSeq() const
+{
+    std::shared_lock lock(mutex_);
+
+    std::optional<LedgerIndex> result;
+    auto const consider = [&](LedgerIndex seq) {
+        if (seq >= floor_ && (!result || seq > *result))
+            result = seq;
+    };
+
+    for (auto const& s : segments_)
+        consider(s->maxLedger());
+    for (auto const* m : {flushing_.get(), &memtable_})
+    {
+        if (m && !m->ledgers.empty())
+            consider(m->ledgers.rbegin()->first);
+    }
+    return result;
+}
+
+std::size_t
+AccountTxIndex::size() const
+{
+    std::shared_lock lock(mutex_);
+
+    std::size_t result = memtable_.keys.size();
+    if (flushing_)
+        result += flushing_->keys.size();
+    for (auto const& s : segments_)
+        result += s->size();
+    return result;
+}
+
+std::size_t
+AccountTxIndex::segments() const
+{
+    std::shared_lock lock(mutex_);
+    return segments_.size();
+}
+
+void
+AccountTxIndex::flush()
+{
+    std::lock_guard flushLock(flushMutex_);
+
+    std::shared_ptr<Memtable const> frozen;
+    {
+        std::unique_lock lock(mutex_);
+        if (memtable_.ledgers.empty())
+            return;
+
+        // Lookups read the frozen table until its segment is in place.
+        frozen = std::make_shared<Memtable const>(std::move(memtable_));
+        flushing_ = frozen;
+        memtable_ = Memtable{};
+        memtable_.id = frozen->id + 1;
+        if (!setup_.path.empty())
+            openWal(memtable_.id);
+    }
+
+    auto it = frozen->keys.begin();
+    auto segment = makeSegment(frozen->id, 0, [&]() -> std::uint8_t const* {
+        return it == frozen->keys.end() ? nullptr : (it++)->data();
+    });
+
+    {
+        std::unique_lock lock(mutex_);
+        if (segment)
+            segments_.push_back(std::move(segment));
+        flushing_.reset();
+    }
+
+    writeManifest();
+
+    if (!setup_.path.empty())
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(walPath(frozen->id), ec);
+    }
+
+    JLOG(j_.debug()) << "AccountTxIndex: wrote segment " << frozen->id
+                     << " with " << frozen->keys.size() << " entries";
+}
+
+bool
+AccountTxIndex::needsCompaction() const
+{
+    std::shared_lock lock(mutex_);
+
+    std::map<std::uint32_t, std::size_t> levels;
+    for (auto const& s : segments_)
+    {
+        if (++levels[s->level()] >= setup_.fanout)
+            return true;
+    }
+    return false;
+}
+
+bool
+AccountTxIndex::compact()
+{
+    std::lock_guard compactLock(compactMutex_);
+
+    std::vector<std::shared_ptr<Segment const>> inputs;
+    std::map<LedgerIndex, std::uint64_t> replaced;
+    LedgerIndex floor = 0;
+    {
+        std::shared_lock lock(mutex_);
+
+        std::map<std::uint32_t, std::vector<std::shared_ptr<Segment const>>>
+            levels;
+        for (auto const& s : segments_)
+            levels[s->level()].push_back(s);
+
+        for (auto& [level, segments] : levels)
+        {
+            if (segments.size() >= setup_.fanout)
+            {
+                inputs = std::move(segments);
+                break;
+            }
+        }
+
+        if (inputs.empty())
+            return false;
+
+        // Ledgers replaced later are saved with a higher id than any input,
+        // so they keep shadowing the merged segment.
+        replaced = replaced_;
+        floor = floor_;
+    }
+
+    std::uint64_t id = 0;
+    std::vector<Cursor> cursors;
+    for (auto const& s : inputs)
+    {
+        id = std::max(id, s->id());
+        Cursor c;
+        c.id = s->id();
+        c.first = s->at(0);
+        c.last = s->at(s->size());
+        cursors.push_back(c);
+    }
+
+    auto const level = inputs.front()->level() + 1;
+    std::size_t dropped = 0;
+    std::uint8_t const* previous = nullptr;
+    auto segment = makeSegment(id, level, [&]() -> std::uint8_t const* {
+        while (true)
+        {
+            Cursor* best = nullptr;
+            for (auto& c : cursors)
+            {
+                if (!c.empty() &&
+                    (!best || compare(c.front(), best->front()) < 0))
+                    best = &c;
+            }
+
+            if (!best)
+                return nullptr;
+
+            auto const key = best->front();
+            best->popFront();
+
+            auto const ledgerSeq = ledgerOf(key);
+            auto const it = replaced.find(ledgerSeq);
+            if (ledgerSeq < floor ||
+                (it != replaced.end() && it->second > best->id) ||
+                (previous && compare(previous, key) == 0))
+            {
+                ++dropped;
+                continue;
+            }
+
+            previous = key;
+            return key;
+        }
+    });
+
+    {
+        std::unique_lock lock(mutex_);
+        std::erase_if(segments_, [&inputs](auto const& s) {
+            return std::find(inputs.begin(), inputs.end(), s) != inputs.end();
+        });
+        if (segment)
+            segments_.push_back(segment);
+        gcReplaced();
+    }
+
+    writeManifest();
+    for (auto const& s : inputs)
+        s->retire();
+
+    JLOG(j_.info()) << "AccountTxIndex: merged " << inputs.size()
+                    << " segments into level " << level << ", dropped "
+                    << dropped << " entries";
+
+    return needsCompaction();
+}
+
+bool
+AccountTxIndex::built() const
+{
+    std::shared_lock lock(mutex_);
+    return built_;
+}
+
+void
+AccountTxIndex::setBuilt(bool built)
+{
+    {
+        std::unique_lock lock(mutex_);
+        built_ = built;
+    }
+
+    flush();
+    writeManifest();
+}
+
+void
+AccountTxIndex::gcReplaced()
+{
+    // A replacement matters only while an older source may hold the ledger.
+    std::erase_if(replaced_, [this](auto const& r) {
+        auto const& [ledgerSeq, id] = r;
+        return std::none_of(
+                   segments_.begin(),
+                   segments_.end(),
+                   [&](auto const& s) {
+                       return s->id() < id && s->mayContain(ledgerSeq);
+                   }) &&
+            !(flushing_ && flushing_->id < id &&
+              flushing_->ledgers.count(ledgerSeq));
+    });
+}
+
+std::shared_ptr<AccountTxIndex::Segment const>
+AccountTxIndex::makeSegment(
+    std::uint64_t id,
+    std::uint32_t level,
+    std::function<std::uint8_t const*()> const& next)
+{
+    std::array<std::uint8_t, headerBytes> header{};
+    std::uint64_t count = 0;
+    LedgerIndex minLedger = ~LedgerIndex(0);
+    LedgerIndex maxLedger = 0;
+
+    auto const finishHeader = [&](std::uint64_t fileSize) {
+        std::memcpy(header.data(), magic.data(), magic.size());
+        boost::endian::store_little_u32(header.data() + 8, version);
+        boost::endian::store_little_u32(header.data() + 12, entryBytes);
+        boost::endian::store_little_u64(header.data() + 16, id);
+        boost::endian::store_little_u32(header.data() + 24, level);
+        boost::endian::store_little_u32(header.data() + 28, minLedger);
+        boost::endian::store_little_u32(header.data() + 32, maxLedger);
+        boost::endian::store_little_u64(header.data() + 40, count);
+        boost::endian::store_little_u64(header.data() + 48, fileSize);
+    };
+
+    auto const visit = [&](std::uint8_t const* key) {
+        auto const ledgerSeq = ledgerOf(key);
+        minLedger = std::min(minLedger, ledgerSeq);
+        maxLedger = std::max(maxLedger, ledgerSeq);
+        ++count;
+    };
+
+    if (setup_.path.empty())
+    {
+        Blob data(headerBytes);
+        while (auto const key = next())
+        {
+            data.insert(data.end(), key, key + entryBytes);
+            visit(key);
+        }
+        if (count == 0)
+            return {};
+
+        finishHeader(data.size());
+        std::copy(header.begin(), header.end(), data.begin());
+        return std::make_shared<Segment const>(std::move(data), id, level);
+    }
+
+    auto const path = segmentPath(id, level);
+    auto const staging = path.string() + ".tmp";
+    try
+    {
+        std::ofstream out(staging, std::ios::binary | std::ios::trunc);
+        if (!out)
+            Throw<std::runtime_error>(
+                "AccountTxIndex: unable to create '" + staging + "'");
+
+        write(out, header.data(), header.size());
+        while (auto const key = next())
+        {
+            write(out, key, entryBytes);
+            visit(key);
+        }
+
+        if (count == 0)
+        {
+            out.close();
+            boost::filesystem::remove(staging);
+            return {};
+        }
+
+        finishHeader(headerBytes + count * entryBytes);
+        out.seekp(0);
+        write(out, header.data(), header.size());
+        out.close();
+        if (!out)
+            Throw<std::runtime_error>("AccountTxIndex: close failed");
+
+        // The manifest may name the segment as soon as it is renamed, so
+        // its contents and then its name must be on disk first.
+        syncToDisk(staging);
+        boost::filesystem::rename(staging, path);
+        syncToDisk(setup_.path, true);
+    }
+    catch (std::exception const&)
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(staging, ec);
+        Rethrow();
+    }
+
+    return std::make_shared<Segment const>(path, id, level);
+}
+
+void
+AccountTxIndex::openWal(std::uint64_t id)
+{
+    if (wal_.is_open())
+        wal_.close();
+
+    auto const path = walPath(id);
+    wal_.open(path.string(), std::ios::binary | std::ios::trunc);
+    if (!wal_)
+        Throw<std::runtime_error>(
+            "AccountTxIndex: unable to create '" + path.string() + "'");
+    syncToDisk(setup_.path, true);
+}
+
+void
+AccountTxIndex::writeManifest()
+{
+    if (setup_.path.empty())
+        return;
+
+    std::lock_guard manifestLock(manifestMutex_);
+
+    std::ostringstream os;
+    {
+        std::shared_lock lock(mutex_);
+        os << "version " << version << '\n';
+        os << "next " << (flushing_ ? flushing_->id : memtable_.id) << '\n';
+        os << "floor " << floor_ << '\n';
+        os << "built " << built_ << '\n';
+        for (auto const& s : segments_)
+            os << "segment " << s->id() << ' ' << s->level() << '\n';
+        for (auto const& [ledgerSeq, id] : replaced_)
+            os << "replaced " << ledgerSeq << ' ' << id << '\n';
+    }
+
+    auto const path = setup_.path / manifestName;
+    auto const staging = path.string() + ".tmp";
+    {
+        std::ofstream out(staging, std::ios::trunc);
+        auto const text = os.str();
+        out << text;
+        out.close();
+        if (!out)
+            Throw<std::runtime_error>(
+                "AccountTxIndex: unable to write '" + staging + "'");
+    }
+    syncToDisk(staging);
+    boost::filesystem::rename(staging, path);
+    syncToDisk(setup_.path, true);
+}
+
+void
+AccountTxIndex::readManifest()
+{
+    auto const path = setup_.path / manifestName;
+    std::ifstream in(path.string());
+
+    auto const bad = [&path](std::string const& why) {
+        Throw<std::runtime_error>(
+            "AccountTxIndex: '" + path.string() + "' is corrupt: " + why);
+    };
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream is(line);
+        std::string key;
+        is >> key;
+
+        if (key == "version")
+        {
+            std::uint32_t v = 0;
+            if (!(is >> v) || v != version)
+                bad("unsupported version");
+        }
+        else if (key == "next")
+        {
+            if (!(is >> memtable_.id))
+                bad(line);
+        }
+        else if (key == "floor")
+        {
+            if (!(is >> floor_))
+                bad(line);
+        }
+        else if (key == "built")
+        {
+            if (!(is >> built_))
+                bad(line);
+        }
+        else if (key == "segment")
+        {
+            std::uint64_t id = 0;
+            std::uint32_t level = 0;
+            if (!(is >> id >> level))
+                bad(line);
+            segments_.push_back(
+                std::make_shared<Segment const>(
+                    segmentPath(id, level), id, level));
+        }
+        else if (key == "replaced")
+        {
+            LedgerIndex ledgerSeq = 0;
+            std::uint64_t id = 0;
+            if (!(is >> ledgerSeq >> id))
+                bad(line);
+            replaced_[ledgerSeq] = id;
+        }
+        else if (!key.empty())
+        {
+            bad(line);
+        }
+    }
+}
+
+boost::filesystem::path
+AccountTxIndex::segmentPath(std::uint64_t id, std::uint32_t level) const
+{
+    return setup_.path /
+        (std::to_string(id) + "-" + std::to_string(level) + ".seg");
+}
+
+boost::filesystem::path
+AccountTxIndex::walPath(std::uint64_t id) const
+{
+    return setup_.path / (std::to_string(id) + ".wal");
+}
+
+}  // namespace detail
+}  // namespace ripple
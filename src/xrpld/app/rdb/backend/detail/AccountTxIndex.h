@@ -0,0 +1,281 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_RDB_BACKEND_DETAIL_ACCOUNTTXINDEX_H_INCLUDED
+#define RIPPLE_APP_RDB_BACKEND_DETAIL_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/beast/utility/Journal.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/Protocol.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <vector>
+
+namespace ripple {
+namespace detail {
+
+/** An append-only index of the transactions that affected each account.
+
+    account_tx reads this instead of the AccountTransactions table when
+    `[relational_db] account_tx_index=segments` is configured. Each entry is
+    a fixed size binary key of account, ledger sequence, transaction
+    sequence and transaction ID, so the entries of one account are adjacent
+    and in the order account_tx returns them. The transactions themselves
+    stay in the Transactions table.
+
+    New ledgers go to an in-memory table and to a write-ahead log, which is
+    flushed to disk before saveLedger returns. Once the table holds enough
+    entries it is written out as an immutable sorted segment. Segments are
+    grouped in levels: when a level holds `fanout` segments, compact()
+    merges them into one segment of the next level. A lookup is a binary
+    search in each segment followed by a merge of the adjacent entries, so
+    reading a page costs the size of the page, not the size of the index.
+
+    Saving a ledger that is already in a segment does not modify the
+    segment. The ledger is recorded as replaced and the older entries are
+    skipped by lookups, then dropped by the next compaction that reads
+    them. Online deletion raises a floor below which entries are ignored
+    and drops segments once they lie entirely below it.
+
+    All files live in one directory:
+
+    @code
+    MANIFEST        the segments in use, the floor and the replaced ledgers
+    <id>-<level>.seg
+                    64 byte header, then the sorted entries
+    <id>.wal        the ledgers saved since segment <id - 1> was written
+    @endcode
+
+    If the directory is empty the index is kept in memory only.
+*/
+class AccountTxIndex
+{
+public:
+    /** The size of one entry: account, ledger, transaction, ID. */
+    static constexpr std::size_t entryBytes = 20 + 4 + 4 + 32;
+
+    struct Entry
+    {
+        AccountID account;
+        LedgerIndex ledgerSeq;
+        std::uint32_t txnSeq;
+        uint256 txID;
+    };
+
+    struct Setup
+    {
+        explicit Setup() = default;
+
+        /** The directory holding the index, or empty to stay in memory. */
+        boost::filesystem::path path;
+
+        /** The number of entries held in memory before writing a segment. */
+        std::size_t memtableEntries = 1 << 18;
+
+        /** The number of segments in a level before they are merged. */
+        std::size_t fanout = 8;
+    };
+
+    /** A position in an account's transactions, as in AccountTxMarker. */
+    struct Position
+    {
+        LedgerIndex ledgerSeq;
+        std::uint32_t txnSeq;
+    };
+
+    /** Open the index, replaying any ledgers not yet in a segment.
+
+        @throws std::runtime_error if a file is missing or corrupt.
+    */
+    AccountTxIndex(Setup const& setup, beast::Journal j);
+
+    ~AccountTxIndex();
+
+    AccountTxIndex(AccountTxIndex const&) = delete;
+    AccountTxIndex&
+    operator=(AccountTxIndex const&) = delete;
+
+    /** Replace the entries of a ledger.
+
+        Writes a segment first if the in-memory table is full.
+    */
+    void
+    saveLedger(LedgerIndex ledgerSeq, std::vector<Entry> const& entries);
+
+    /** Ignore every entry for a ledger before `ledgerSeq`. */
+    void
+    deleteBefore(LedgerIndex ledgerSeq);
+
+    /** Visit an account's entries in order.
+
+        @param account The account.
+        @param minLedger The first ledger to visit.
+        @param maxLedger The last ledger to visit.
+        @param start If set, the first position to visit in the direction
+               of travel. Entries before it are skipped.
+        @param forward True for ascending order, false for descending.
+        @param f Called for each entry. Returns false to stop.
+    */
+    void
+    forEach(
+        AccountID const& account,
+        LedgerIndex minLedger,
+        LedgerIndex maxLedger,
+        std::optional<Position> const& start,
+        bool forward,
+        std::function<bool(Entry const&)> const& f) const;
+
+    /** The lowest ledger with entries, if any. */
+    std::optional<LedgerIndex>
+    minLedgerSeq() const;
+
+    /** The highest ledger with entries, if any. */
+    std::optional<LedgerIndex>
+    maxLedgerSeq() const;
+
+    /** The number of entries stored, counting replaced entries that have
+        not been compacted away yet.
+    */
+    std::size_t
+    size() const;
+
+    /** The number of segments in use. */
+    std::size_t
+    segments() const;
+
+    /** Write the in-memory entries to a new segment. */
+    void
+    flush();
+
+    /** True if some level holds enough segments to merge. */
+    bool
+    needsCompaction() const;
+
+    /** Merge the segments of the lowest full level.
+
+        Runs while lookups and saves continue; only the final swap of the
+        segment list takes the lock.
+
+        @return True if another level is full afterwards.
+    */
+    bool
+    compact();
+
+    /** True once every existing ledger has been indexed.
+
+        A new index starts out unbuilt. The owner indexes the ledgers in
+        the Transactions table, in ascending order, and then calls
+        setBuilt. If the server stops part way, the build resumes after
+        maxLedgerSeq(). The owner clears the flag when it finds ledgers
+        the index is missing, and builds again from there.
+    */
+    bool
+    built() const;
+
+    void
+    setBuilt(bool built);
+
+private:
+    using Key = std::array<std::uint8_t, entryBytes>;
+
+    class Segment;
+
+    struct Memtable
+    {
+        std::uint64_t id = 0;
+        std::set<Key> keys;
+        std::map<LedgerIndex, std::vector<Key>> ledgers;
+    };
+
+    struct Cursor;
+
+    static Key
+    makeKey(Entry const& e);
+
+    static Entry
+    makeEntry(std::uint8_t const* key);
+
+    bool
+    isLive(std::uint8_t const* key, std::uint64_t id) const;
+
+    void
+    apply(
+        Memtable& memtable,
+        LedgerIndex ledgerSeq,
+        std::vector<Key> keys);
+
+    std::shared_ptr<Segment const>
+    makeSegment(
+        std::uint64_t id,
+        std::uint32_t level,
+        std::function<std::uint8_t const*()> const& next);
+
+    void
+    openWal(std::uint64_t id);
+
+    void
+    writeManifest();
+
+    void
+    readManifest();
+
+    void
+    gcReplaced();
+
+    boost::filesystem::path
+    segmentPath(std::uint64_t id, std::uint32_t level) const;
+
+    boost::filesystem::path
+    walPath(std::uint64_t id) const;
+
+    Setup const setup_;
+    beast::Journal const j_;
+
+    // Guards everything below it. Lookups take it shared.
+    mutable std::shared_mutex mutex_;
+    std::vector<std::shared_ptr<Segment const>> segments_;
+    Memtable memtable_;
+    std::shared_ptr<Memtable const> flushing_;
+    std::map<LedgerIndex, std::uint64_t> replaced_;
+    LedgerIndex floor_ = 0;
+    bool built_ = false;
+    std::ofstream wal_;
+
+    // Serialize segment writes, merges and manifest writes respectively.
+    std::mutex flushMutex_;
+    std::mutex compactMutex_;
+    std::mutex manifestMutex_;
+};
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
@@ -57,7 +57,7 @@ to_string(TableType type)
         case TableType::Transactions:
             return "Transactions";
         case TableType::AccountTransactions:
-            return "AccountTransactions";
+            return "AccountTransactionsV2";
         default:
             UNREACHABLE("ripple::detail::to_string : invalid TableType");
             return "Unknown";
@@ -91,26 +91,32 @@ makeLedgerDBs(
             setup.startUp == Config::LOAD_FILE ||
             setup.startUp == Config::REPLAY)
         {
-            // Check if AccountTransactions has primary key
-            std::string cid, name, type;
-            std::size_t notnull, dflt_value, pk;
-            soci::indicator ind;
-            soci::statement st =
-                (tx->getSession().prepare
-                     << ("PRAGMA table_info(AccountTransactions);"),
-                 soci::into(cid),
-                 soci::into(name),
-                 soci::into(type),
-                 soci::into(notnull),
-                 soci::into(dflt_value, ind),
-                 soci::into(pk));
-
-            st.execute();
-            while (st.fetch())
+            // Check if the account transactions tables have a primary key.
+            // The legacy table is only present until it has been migrated.
+            for (auto const table :
+                 {"AccountTransactionsV2", "AccountTransactions"})
             {
-                if (pk == 1)
+                std::string cid, name, type;
+                std::size_t notnull, dflt_value, pk;
+                soci::indicator ind;
+                soci::statement st =
+                    (tx->getSession().prepare
+                         << ("PRAGMA table_info(" + std::string(table) +
+                             ");"),
+                     soci::into(cid),
+                     soci::into(name),
+                     soci::into(type),
+                     soci::into(notnull),
+                     soci::into(dflt_value, ind),
+                     soci::into(pk));
+
+                st.execute();
+                while (st.fetch())
                 {
-                    return {std::move(lgr), std::move(tx), false};
+                    if (pk == 1)
+                    {
+                        return {std::move(lgr), std::move(tx), false};
+                    }
                 }
             }
         }
@@ -121,31 +127,72 @@ makeLedgerDBs(
         return {std::move(lgr), {}, true};
 }
 
+bool
+hasLegacyAccountTransactions(soci::session& session)
+{
+    int tables = 0;
+    session << "SELECT COUNT(*) FROM sqlite_master "
+               "WHERE type = 'table' AND name = 'AccountTransactions';",
+        soci::into(tables);
+    return tables != 0;
+}
+
+/**
+ * @brief tableNames Returns the names of the tables holding the rows of
+ *        the given type. Until its migration finishes, account transactions
+ *        are split between the current table and the legacy one.
+ * @param session Session with the database.
+ * @param type An enum denoting the table's type.
+ * @return Names of the tables.
+ */
+static std::vector<std::string>
+tableNames(soci::session& session, TableType type)
+{
+    std::vector<std::string> names{to_string(type)};
+    if (type == TableType::AccountTransactions &&
+        hasLegacyAccountTransactions(session))
+        names.emplace_back("AccountTransactions");
+    return names;
+}
+
 std::optional<LedgerIndex>
 getMinLedgerSeq(soci::session& session, TableType type)
 {
-    std::string query = "SELECT MIN(LedgerSeq) FROM " + to_string(type) + ";";
-    // SOCI requires boost::optional (not std::optional) as the parameter.
-    boost::optional<LedgerIndex> m;
-    session << query, soci::into(m);
-    return m ? *m : std::optional<LedgerIndex>();
+    std::optional<LedgerIndex> result;
+    for (auto const& table : tableNames(session, type))
+    {
+        std::string query = "SELECT MIN(LedgerSeq) FROM " + table + ";";
+        // SOCI requires boost::optional (not std::optional) as the parameter.
+        boost::optional<LedgerIndex> m;
+        session << query, soci::into(m);
+        if (m && (!result || *m < *result))
+            result = *m;
+    }
+    return result;
 }
 
 std::optional<LedgerIndex>
 getMaxLedgerSeq(soci::session& session, TableType type)
 {
-    std::string query = "SELECT MAX(LedgerSeq) FROM " + to_string(type) + ";";
-    // SOCI requires boost::optional (not std::optional) as the parameter.
-    boost::optional<LedgerIndex> m;
-    session << query, soci::into(m);
-    return m ? *m : std::optional<LedgerIndex>();
+    std::optional<LedgerIndex> result;
+    for (auto const& table : tableNames(session, type))
+    {
+        std::string query = "SELECT MAX(LedgerSeq) FROM " + table + ";";
+        // SOCI requires boost::optional (not std::optional) as the parameter.
+        boost::optional<LedgerIndex> m;
+        session << query, soci::into(m);
+        if (m && (!result || *m > *result))
+            result = *m;
+    }
+    return result;
 }
 
 void
 deleteByLedgerSeq(soci::session& session, TableType type, LedgerIndex ledgerSeq)
 {
-    session << "DELETE FROM " << to_string(type)
-            << " WHERE LedgerSeq == " << ledgerSeq << ";";
+    for (auto const& table : tableNames(session, type))
+        session << "DELETE FROM " << table << " WHERE LedgerSeq == "
+                << ledgerSeq << ";";
 }
 
 void
@@ -154,20 +201,26 @@ deleteBeforeLedgerSeq(
     TableType type,
     LedgerIndex ledgerSeq)
 {
-    session << "DELETE FROM " << to_string(type) << " WHERE LedgerSeq < "
-            << ledgerSeq << ";";
+    for (auto const& table : tableNames(session, type))
+        session << "DELETE FROM " << table << " WHERE LedgerSeq < "
+                << ledgerSeq << ";";
 }
 
 std::size_t
 getRows(soci::session& session, TableType type)
 {
-    std::size_t rows;
-    session << "SELECT COUNT(*) AS rows "
-               "FROM "
-            << to_string(type) << ";",
-        soci::into(rows);
+    std::size_t total = 0;
+    for (auto const& table : tableNames(session, type))
+    {
+        std::size_t rows;
+        session << "SELECT COUNT(*) AS rows "
+                   "FROM "
+                << table << ";",
+            soci::into(rows);
+        total += rows;
+    }
 
-    return rows;
+    return total;
 }
 
 RelationalDatabase::CountMinMax
@@ -185,13 +238,165 @@ getRowsMinMax(soci::session& session, TableType type)
     return res;
 }
 
+AccountTransactionWriter::AccountTransactionWriter(soci::session& session)
+    : legacy_(hasLegacyAccountTransactions(session))
+    , txID_(session)
+    , account_(session)
+    , insert_(
+          (session.prepare << "INSERT INTO AccountTransactionsV2 "
+                              "(TransID, Account, LedgerSeq, TxnSeq) "
+                              "VALUES (:txID, :account, :ledgerSeq, :txnSeq);",
+           soci::use(txID_),
+           soci::use(account_),
+           soci::use(ledgerSeq_),
+           soci::use(txnSeq_)))
+    , deleteTransaction_(
+          (session.prepare << "DELETE FROM AccountTransactionsV2 "
+                              "WHERE TransID = :txID;",
+           soci::use(txID_)))
+    , deleteLedger_(
+          (session.prepare << "DELETE FROM AccountTransactionsV2 "
+                              "WHERE LedgerSeq = :ledgerSeq;",
+           soci::use(ledgerSeq_)))
+{
+    if (legacy_)
+    {
+        legacyDeleteTransaction_.emplace(
+            (session.prepare << "DELETE FROM AccountTransactions "
+                                "WHERE TransID = :txID;",
+             soci::use(legacyTxID_)));
+        legacyDeleteLedger_.emplace(
+            (session.prepare << "DELETE FROM AccountTransactions "
+                                "WHERE LedgerSeq = :ledgerSeq;",
+             soci::use(ledgerSeq_)));
+    }
+}
+
+void
+AccountTransactionWriter::deleteLedger(LedgerIndex ledgerSeq)
+{
+    ledgerSeq_ = ledgerSeq;
+    deleteLedger_.execute(true);
+    if (legacyDeleteLedger_)
+        legacyDeleteLedger_->execute(true);
+}
+
+void
+AccountTransactionWriter::deleteTransaction(uint256 const& txID)
+{
+    txID_.write(0, reinterpret_cast<char const*>(txID.data()), txID.size());
+    deleteTransaction_.execute(true);
+    if (legacyDeleteTransaction_)
+    {
+        legacyTxID_ = to_string(txID);
+        legacyDeleteTransaction_->execute(true);
+    }
+}
+
+void
+AccountTransactionWriter::insert(
+    uint256 const& txID,
+    AccountID const& account,
+    LedgerIndex ledgerSeq,
+    std::uint32_t txnSeq)
+{
+    txID_.write(0, reinterpret_cast<char const*>(txID.data()), txID.size());
+    account_.write(
+        0, reinterpret_cast<char const*>(account.data()), account.size());
+    ledgerSeq_ = ledgerSeq;
+    txnSeq_ = txnSeq;
+    insert_.execute(true);
+}
+
+bool
+migrateAccountTransactions(
+    soci::session& session,
+    std::size_t batchSize,
+    beast::Journal j)
+{
+    if (!hasLegacyAccountTransactions(session))
+        return true;
+
+    soci::transaction tr(session);
+
+    std::size_t rows = 0;
+    {
+        AccountTransactionWriter writer(session);
+
+        std::int64_t rowID = 0;
+        std::string txIDText, accountText;
+        // SOCI requires boost::optional (not std::optional) as parameters.
+        boost::optional<std::uint64_t> ledgerSeq;
+        boost::optional<std::uint32_t> txnSeq;
+
+        soci::statement st =
+            (session.prepare
+                 << "SELECT rowid, TransID, Account, LedgerSeq, TxnSeq "
+                    "FROM AccountTransactions ORDER BY rowid LIMIT :limit;",
+             soci::into(rowID),
+             soci::into(txIDText),
+             soci::into(accountText),
+             soci::into(ledgerSeq),
+             soci::into(txnSeq),
+             soci::use(batchSize));
+
+        // Rows are buffered so the select is finished before the inserts.
+        std::vector<std::tuple<uint256, AccountID, LedgerIndex, std::uint32_t>>
+            batch;
+        batch.reserve(batchSize);
+
+        std::int64_t lastRowID = 0;
+        st.execute();
+        while (st.fetch())
+        {
+            ++rows;
+            lastRowID = rowID;
+
+            uint256 txID;
+            auto const account = parseBase58<AccountID>(accountText);
+            if (!txID.parseHex(txIDText) || !account)
+            {
+                JLOG(j.warn()) << "Dropping malformed AccountTransactions row "
+                               << rowID << ": " << txIDText << " "
+                               << accountText;
+                continue;
+            }
+
+            batch.emplace_back(
+                txID,
+                *account,
+                rangeCheckedCast<LedgerIndex>(ledgerSeq.value_or(0)),
+                txnSeq.value_or(0));
+        }
+
+        for (auto const& [txID, account, seq, txnSeq] : batch)
+            writer.insert(txID, account, seq, txnSeq);
+
+        if (rows)
+        {
+            session << "DELETE FROM AccountTransactions WHERE rowid <= :last;",
+                soci::use(lastRowID);
+        }
+    }
+
+    bool const done = rows < batchSize;
+    if (done)
+        session << "DROP TABLE AccountTransactions;";
+
+    tr.commit();
+
+    JLOG(j.debug()) << "Migrated " << rows << " AccountTransactions rows";
+    return done;
+}
+
 bool
 saveValidatedLedger(
     DatabaseCon& ldgDB,
     DatabaseCon& txnDB,
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current)
+    bool current,
+    AccountTxIndex* accountTxIndex)
 {
     auto j = app.journal("Ledger");
     auto seq = ledger->info().seq;
@@ -255,10 +460,6 @@ saveValidatedLedger(
             "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
         static boost::format deleteTrans1(
             "DELETE FROM Transactions WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans2(
-            "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-        static boost::format deleteAcctTrans(
-            "DELETE FROM AccountTransactions WHERE TransID = '%s';");
 
         {
             auto db = ldgDB.checkoutDb();
@@ -271,57 +472,37 @@ saveValidatedLedger(
 
             soci::transaction tr(*db);
 
-            *db << boost::str(deleteTrans1 % seq);
-            *db << boost::str(deleteTrans2 % seq);
+            // Prepared once here and re-executed for every row below.
+            AccountTransactionWriter accountTxs(*db);
+            std::vector<AccountTxIndex::Entry> entries;
 
-            std::string const ledgerSeq(std::to_string(seq));
+            *db << boost::str(deleteTrans1 % seq);
+            accountTxs.deleteLedger(seq);
 
             for (auto const& acceptedLedgerTx : *aLedger)
             {
                 uint256 transactionID = acceptedLedgerTx->getTransactionID();
 
-                std::string const txnId(to_string(transactionID));
-                std::string const txnSeq(
-                    std::to_string(acceptedLedgerTx->getTxnSeq()));
-
-                *db << boost::str(deleteAcctTrans % transactionID);
+                accountTxs.deleteTransaction(transactionID);
 
                 auto const& accts = acceptedLedgerTx->getAffected();
 
                 if (!accts.empty())
                 {
-                    std::string sql(
-                        "INSERT INTO AccountTransactions "
-                        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                    // Try to make an educated guess on how much space we'll
-                    // need for our arguments. In argument order we have: 64
-                    // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                    sql.reserve(sql.length() + (accts.size() * 128));
-
-                    bool first = true;
                     for (auto const& account : accts)
                     {
-                        if (!first)
-                            sql += ", ('";
-                        else
-                        {
-                            sql += "('";
-                            first = false;
-                        }
-
-                        sql += txnId;
-                        sql += "','";
-                        sql += toBase58(account);
-                        sql += "',";
-                        sql += ledgerSeq;
-                        sql += ",";
-                        sql += txnSeq;
-                        sql += ")";
+                        accountTxs.insert(
+                            transactionID,
+                            account,
+                            seq,
+                            acceptedLedgerTx->getTxnSeq());
+                        if (accountTxIndex)
+                            entries.push_back(
+                                {account,
+                                 seq,
+                                 acceptedLedgerTx->getTxnSeq(),
+                                 transactionID});
                     }
-                    sql += ";";
-                    JLOG(j.trace()) << "ActTx: " << sql;
-                    *db << sql;
                 }
                 else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
                          !isPseudoTx(*sleTxn))
@@ -347,6 +528,10 @@ saveValidatedLedger(
             }
 
             tr.commit();
+
+            // Indexed only once the transactions can be read back.
+            if (accountTxIndex)
+                accountTxIndex->saveLedger(seq, entries);
         }
 
         {
@@ -388,6 +573,80 @@ saveValidatedLedger(
     return true;
 }
 
+std::size_t
+indexAccountTransactions(
+    soci::session& session,
+    AccountTxIndex& index,
+    LedgerIndex after,
+    LedgerIndex last,
+    beast::Journal j)
+{
+    std::size_t ledgers = 0;
+    std::optional<LedgerIndex> current;
+    std::vector<AccountTxIndex::Entry> entries;
+
+    auto const save = [&]() {
+        if (!current)
+            return;
+
+        index.saveLedger(*current, entries);
+        entries.clear();
+        if (++ledgers % 10000 == 0)
+        {
+            JLOG(j.info()) << "Indexed account transactions through ledger "
+                           << *current;
+        }
+    };
+
+    // SOCI requires boost::optional (not std::optional) as parameters.
+    boost::optional<std::string> txID;
+    boost::optional<std::uint64_t> ledgerSeq;
+    soci::blob sociTxnMetaBlob(session);
+    soci::indicator tmi;
+    Blob txnMeta;
+
+    soci::statement st =
+        (session.prepare << "SELECT TransID, LedgerSeq, TxnMeta "
+                            "FROM Transactions WHERE LedgerSeq > :after "
+                            "AND LedgerSeq <= :last ORDER BY LedgerSeq;",
+         soci::use(after),
+         soci::use(last),
+         soci::into(txID),
+         soci::into(ledgerSeq),
+         soci::into(sociTxnMetaBlob, tmi));
+
+    st.execute();
+    while (st.fetch())
+    {
+        auto const seq = rangeCheckedCast<LedgerIndex>(ledgerSeq.value_or(0));
+        if (seq != current)
+        {
+            save();
+            current = seq;
+        }
+
+        uint256 id;
+        if (!txID || !id.parseHex(*txID) || tmi != soci::i_ok)
+            continue;
+
+        convert(sociTxnMetaBlob, txnMeta);
+        try
+        {
+            TxMeta const meta(id, seq, txnMeta);
+            for (auto const& account : meta.getAffectedAccounts())
+                entries.push_back({account, seq, meta.getIndex(), id});
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j.warn()) << "Unable to index transaction " << id << ": "
+                           << e.what();
+        }
+    }
+    save();
+
+    return ledgers;
+}
+
 /**
  * @brief getLedgerInfo Returns the info of the ledger retrieved from the
  *        database by using the provided SQL query suffix.
@@ -676,10 +935,92 @@ getTxHistory(
     return {txs, total};
 }
 
+/**
+ * @brief accountTransactionsSource Returns an SQL table expression, named
+ *        AccountTransactions, that yields the TransID, LedgerSeq and TxnSeq
+ *        of the rows for an account. TransID is produced as the hex text
+ *        used by the Transactions table so the two can be joined.
+ * @param session Session with the database.
+ * @param account The account.
+ * @param conditions Additional conditions on LedgerSeq and TxnSeq, each
+ *        starting with AND.
+ * @param order "ASC" or "DESC" if the caller sorts the rows by LedgerSeq
+ *        and TxnSeq and reads at most `rows` of them, otherwise nullptr.
+ *        While rows remain to be migrated, SQLite can't use the index to
+ *        sort the union, so each part is sorted and cut to `rows` rows on
+ *        its own and the caller sorts at most twice that many.
+ * @param rows The number of rows the caller reads, counting its offset.
+ * @return SQL table expression.
+ */
+static std::string
+accountTransactionsSource(
+    soci::session& session,
+    AccountID const& account,
+    std::string const& conditions,
+    char const* order = nullptr,
+    std::uint64_t rows = 0)
+{
+    std::string v2 =
+        "SELECT hex(TransID) AS TransID, LedgerSeq, TxnSeq "
+        "FROM AccountTransactionsV2 WHERE Account = X'" +
+        strHex(account) + "' " + conditions;
+
+    // Rows not yet migrated are still keyed by text.
+    if (!hasLegacyAccountTransactions(session))
+        return "(" + v2 + ") AS AccountTransactions";
+
+    std::string legacy =
+        "SELECT TransID, LedgerSeq, TxnSeq "
+        "FROM AccountTransactions WHERE Account = '" +
+        toBase58(account) + "' " + conditions;
+
+    if (order)
+    {
+        // SQLite only allows ORDER BY and LIMIT on a whole compound
+        // select, so each part is wrapped in a subquery.
+        auto const bounded = [&](std::string const& part) {
+            return boost::str(
+                boost::format("SELECT * FROM (%s ORDER BY LedgerSeq %s, "
+                              "TxnSeq %s LIMIT %u)") %
+                part % order % order % rows);
+        };
+        v2 = bounded(v2);
+        legacy = bounded(legacy);
+    }
+
+    return "(" + v2 + " UNION ALL " + legacy + ") AS AccountTransactions";
+}
+
+/**
+ * @brief accountTxsLimit Returns the number of transactions to return for
+ *        the given criteria.
+ * @param options Struct AccountTxOptions which contains the criteria.
+ * @param binary True for binary form, false for decoded.
+ * @return Number of transactions.
+ */
+static std::uint32_t
+accountTxsLimit(
+    RelationalDatabase::AccountTxOptions const& options,
+    bool binary)
+{
+    constexpr std::uint32_t NONBINARY_PAGE_LENGTH = 200;
+    constexpr std::uint32_t BINARY_PAGE_LENGTH = 500;
+
+    if (options.limit == UINT32_MAX)
+        return binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH;
+
+    if (!options.bUnlimited)
+        return std::min(
+            binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH, options.limit);
+
+    return options.limit;
+}
+
 /**
  * @brief transactionsSQL Returns a SQL query for selecting the oldest or newest
  *        transactions in decoded or binary form for the account that matches
  *        the given criteria starting from the provided offset.
+ * @param session Session with the database.
  * @param app Application object.
  * @param selection List of table fields to select from the database.
  * @param options Struct AccountTxOptions which contains the criteria to match:
@@ -695,6 +1036,7 @@ getTxHistory(
  */
 static std::string
 transactionsSQL(
+    soci::session& session,
     Application& app,
     std::string selection,
     RelationalDatabase::AccountTxOptions const& options,
@@ -703,28 +1045,9 @@ transactionsSQL(
     bool count,
     beast::Journal j)
 {
-    constexpr std::uint32_t NONBINARY_PAGE_LENGTH = 200;
-    constexpr std::uint32_t BINARY_PAGE_LENGTH = 500;
-
-    std::uint32_t numberOfResults;
-
-    if (count)
-    {
-        numberOfResults = std::numeric_limits<std::uint32_t>::max();
-    }
-    else if (options.limit == UINT32_MAX)
-    {
-        numberOfResults = binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH;
-    }
-    else if (!options.bUnlimited)
-    {
-        numberOfResults = std::min(
-            binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH, options.limit);
-    }
-    else
-    {
-        numberOfResults = options.limit;
-    }
+    std::uint32_t const numberOfResults = count
+        ? std::numeric_limits<std::uint32_t>::max()
+        : accountTxsLimit(options, binary);
 
     std::string maxClause = "";
     std::string minClause = "";
@@ -732,42 +1055,85 @@ transactionsSQL(
     if (options.maxLedger)
     {
         maxClause = boost::str(
-            boost::format("AND AccountTransactions.LedgerSeq <= '%u'") %
-            options.maxLedger);
+            boost::format("AND LedgerSeq <= %u") % options.maxLedger);
     }
 
     if (options.minLedger)
     {
         minClause = boost::str(
-            boost::format("AND AccountTransactions.LedgerSeq >= '%u'") %
-            options.minLedger);
+            boost::format("AND LedgerSeq >= %u") % options.minLedger);
     }
 
+    char const* const order = descending ? "DESC" : "ASC";
+    std::string const source = count
+        ? accountTransactionsSource(
+              session, options.account, maxClause + " " + minClause)
+        : accountTransactionsSource(
+              session,
+              options.account,
+              maxClause + " " + minClause,
+              order,
+              std::uint64_t{options.offset} + numberOfResults);
+
     std::string sql;
 
     if (count)
         sql = boost::str(
-            boost::format("SELECT %s FROM AccountTransactions "
-                          "WHERE Account = '%s' %s %s LIMIT %u, %u;") %
-            selection % toBase58(options.account) % maxClause % minClause %
-            options.offset % numberOfResults);
+            boost::format("SELECT %s FROM %s LIMIT %u, %u;") % selection %
+            source % options.offset % numberOfResults);
     else
         sql = boost::str(
             boost::format(
                 "SELECT %s FROM "
-                "AccountTransactions INNER JOIN Transactions "
+                "%s INNER JOIN Transactions "
                 "ON Transactions.TransID = AccountTransactions.TransID "
-                "WHERE Account = '%s' %s %s "
                 "ORDER BY AccountTransactions.LedgerSeq %s, "
                 "AccountTransactions.TxnSeq %s, AccountTransactions.TransID %s "
                 "LIMIT %u, %u;") %
-            selection % toBase58(options.account) % maxClause % minClause %
-            (descending ? "DESC" : "ASC") % (descending ? "DESC" : "ASC") %
-            (descending ? "DESC" : "ASC") % options.offset % numberOfResults);
+            selection % source % order % order % order % options.offset %
+            numberOfResults);
     JLOG(j.trace()) << "txSQL query: " << sql;
     return sql;
 }
 
+/**
+ * @brief addAccountTx Decodes a transaction and its metadata and appends
+ *        them to the result. Queues the ledger to be saved again if the
+ *        metadata is missing.
+ * @return True if the transaction was decoded.
+ */
+static bool
+addAccountTx(
+    RelationalDatabase::AccountTxs& ret,
+    Application& app,
+    LedgerMaster& ledgerMaster,
+    boost::optional<std::uint64_t> const& ledgerSeq,
+    boost::optional<std::string> const& status,
+    Blob const& rawTxn,
+    Blob const& txnMeta,
+    beast::Journal j)
+{
+    auto txn = Transaction::transactionFromSQL(ledgerSeq, status, rawTxn, app);
+
+    if (txnMeta.empty())
+    {  // Work around a bug that could leave the metadata missing
+        auto const seq = rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0));
+
+        JLOG(j.warn()) << "Recovering ledger " << seq << ", txn "
+                       << txn->getID();
+
+        if (auto l = ledgerMaster.getLedgerBySeq(seq))
+            pendSaveValidated(app, l, false, false);
+    }
+
+    if (!txn)
+        return false;
+
+    ret.emplace_back(
+        txn, std::make_shared<TxMeta>(txn->getID(), txn->getLedger(), txnMeta));
+    return true;
+}
+
 /**
  * @brief getAccountTxs Returns the oldest or newest transactions for the
  *        account that matches the given criteria starting from the provided
@@ -801,6 +1167,7 @@ getAccountTxs(
     RelationalDatabase::AccountTxs ret;
 
     std::string sql = transactionsSQL(
+        session,
         app,
         "AccountTransactions.LedgerSeq,Status,RawTxn,TxnMeta",
         options,
@@ -840,29 +1207,16 @@ getAccountTxs(
             else
                 txnMeta.clear();
 
-            auto txn =
-                Transaction::transactionFromSQL(ledgerSeq, status, rawTxn, app);
-
-            if (txnMeta.empty())
-            {  // Work around a bug that could leave the metadata missing
-                auto const seq =
-                    rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0));
-
-                JLOG(j.warn())
-                    << "Recovering ledger " << seq << ", txn " << txn->getID();
-
-                if (auto l = ledgerMaster.getLedgerBySeq(seq))
-                    pendSaveValidated(app, l, false, false);
-            }
-
-            if (txn)
-            {
-                ret.emplace_back(
-                    txn,
-                    std::make_shared<TxMeta>(
-                        txn->getID(), txn->getLedger(), txnMeta));
+            if (addAccountTx(
+                    ret,
+                    app,
+                    ledgerMaster,
+                    ledgerSeq,
+                    status,
+                    rawTxn,
+                    txnMeta,
+                    j))
                 total++;
-            }
         }
     }
 
@@ -922,6 +1276,7 @@ getAccountTxsB(
     std::vector<RelationalDatabase::txnMetaLedgerType> ret;
 
     std::string sql = transactionsSQL(
+        session,
         app,
         "AccountTransactions.LedgerSeq,Status,RawTxn,TxnMeta",
         options,
@@ -989,6 +1344,256 @@ getNewestAccountTxsB(
     return getAccountTxsB(session, app, options, true, j);
 }
 
+/**
+ * @brief forEachIndexedTransaction Reads from the Transactions table, in
+ *        order, the transactions the index holds for an account. Entries
+ *        for transactions that are missing, or that have since been saved
+ *        in another ledger, are skipped.
+ * @param session Session with the database.
+ * @param index The index.
+ * @param account The account.
+ * @param minLedger The first ledger to search.
+ * @param maxLedger The last ledger to search.
+ * @param start If set, the first position to read.
+ * @param forward True for ascending order, false for descending.
+ * @param skip The number of entries to pass over before reading any.
+ * @param f Called with the ledger sequence, transaction sequence, status,
+ *        raw transaction and metadata of each transaction. Returns false to
+ *        stop.
+ */
+static void
+forEachIndexedTransaction(
+    soci::session& session,
+    AccountTxIndex const& index,
+    AccountID const& account,
+    LedgerIndex minLedger,
+    LedgerIndex maxLedger,
+    std::optional<AccountTxIndex::Position> const& start,
+    bool forward,
+    std::uint32_t skip,
+    std::function<bool(
+        LedgerIndex,
+        std::uint32_t,
+        std::string const&,
+        Blob&&,
+        Blob&&)> const& f)
+{
+    // SOCI requires boost::optional (not std::optional) as parameters.
+    std::string txID;
+    boost::optional<std::uint64_t> ledgerSeq;
+    boost::optional<std::string> status;
+    soci::blob txnData(session);
+    soci::blob txnMeta(session);
+    soci::indicator dataPresent, metaPresent;
+    Blob rawData;
+    Blob rawMeta;
+
+    // Prepared once and re-executed for every entry.
+    soci::statement st =
+        (session.prepare << "SELECT LedgerSeq, Status, RawTxn, TxnMeta "
+                            "FROM Transactions WHERE TransID = :id;",
+         soci::use(txID),
+         soci::into(ledgerSeq),
+         soci::into(status),
+         soci::into(txnData, dataPresent),
+         soci::into(txnMeta, metaPresent));
+
+    index.forEach(
+        account,
+        minLedger,
+        maxLedger,
+        start,
+        forward,
+        [&](AccountTxIndex::Entry const& e) {
+            // An offset costs no database reads.
+            if (skip)
+            {
+                --skip;
+                return true;
+            }
+
+            txID = to_string(e.txID);
+            if (!st.execute(true) || ledgerSeq.value_or(0) != e.ledgerSeq)
+                return true;
+
+            if (dataPresent == soci::i_ok)
+                convert(txnData, rawData);
+            else
+                rawData.clear();
+
+            if (metaPresent == soci::i_ok)
+                convert(txnMeta, rawMeta);
+            else
+                rawMeta.clear();
+
+            return f(
+                e.ledgerSeq,
+                e.txnSeq,
+                status.value_or(""),
+                std::move(rawData),
+                std::move(rawMeta));
+        });
+}
+
+/**
+ * @brief forEachIndexedAccountTx Reads the oldest or newest transactions
+ *        for the account that match the given criteria starting from the
+ *        provided offset, as transactionsSQL selects them.
+ * @param session Session with the database.
+ * @param index The index.
+ * @param options Struct AccountTxOptions which contains the criteria.
+ * @param descending True for descending order, false for ascending.
+ * @param binary True for binary form, false for decoded.
+ * @param f Called with the ledger sequence, status, raw transaction and
+ *        metadata of each transaction.
+ */
+static void
+forEachIndexedAccountTx(
+    soci::session& session,
+    AccountTxIndex const& index,
+    RelationalDatabase::AccountTxOptions const& options,
+    bool descending,
+    bool binary,
+    std::function<void(LedgerIndex, std::string const&, Blob&&, Blob&&)> const&
+        f)
+{
+    auto remaining = accountTxsLimit(options, binary);
+    if (remaining == 0)
+        return;
+
+    forEachIndexedTransaction(
+        session,
+        index,
+        options.account,
+        options.minLedger,
+        options.maxLedger ? options.maxLedger
+                          : std::numeric_limits<LedgerIndex>::max(),
+        std::nullopt,
+        !descending,
+        options.offset,
+        [&](LedgerIndex ledgerSeq,
+            std::uint32_t,
+            std::string const& status,
+            Blob&& rawTxn,
+            Blob&& txnMeta) {
+            f(ledgerSeq, status, std::move(rawTxn), std::move(txnMeta));
+            return --remaining != 0;
+        });
+}
+
+std::pair<RelationalDatabase::AccountTxs, int>
+getOldestAccountTxs(
+    soci::session& session,
+    AccountTxIndex const& index,
+    Application& app,
+    LedgerMaster& ledgerMaster,
+    RelationalDatabase::AccountTxOptions const& options,
+    beast::Journal j)
+{
+    RelationalDatabase::AccountTxs ret;
+    int total = 0;
+    forEachIndexedAccountTx(
+        session,
+        index,
+        options,
+        false,
+        false,
+        [&](LedgerIndex seq,
+            std::string const& status,
+            Blob&& rawTxn,
+            Blob&& txnMeta) {
+            if (addAccountTx(
+                    ret, app, ledgerMaster, seq, status, rawTxn, txnMeta, j))
+                total++;
+        });
+    return {ret, total};
+}
+
+std::pair<RelationalDatabase::AccountTxs, int>
+getNewestAccountTxs(
+    soci::session& session,
+    AccountTxIndex const& index,
+    Application& app,
+    LedgerMaster& ledgerMaster,
+    RelationalDatabase::AccountTxOptions const& options,
+    beast::Journal j)
+{
+    RelationalDatabase::AccountTxs ret;
+    int total = 0;
+    forEachIndexedAccountTx(
+        session,
+        index,
+        options,
+        true,
+        false,
+        [&](LedgerIndex seq,
+            std::string const& status,
+            Blob&& rawTxn,
+            Blob&& txnMeta) {
+            if (addAccountTx(
+                    ret, app, ledgerMaster, seq, status, rawTxn, txnMeta, j))
+                total++;
+        });
+    return {ret, total};
+}
+
+std::pair<std::vector<RelationalDatabase::txnMetaLedgerType>, int>
+getOldestAccountTxsB(
+    soci::session& session,
+    AccountTxIndex const& index,
+    RelationalDatabase::AccountTxOptions const& options)
+{
+    std::vector<RelationalDatabase::txnMetaLedgerType> ret;
+    forEachIndexedAccountTx(
+        session,
+        index,
+        options,
+        false,
+        true,
+        [&ret](LedgerIndex seq, std::string const&, Blob&& raw, Blob&& meta) {
+            ret.emplace_back(std::move(raw), std::move(meta), seq);
+        });
+    return {ret, static_cast<int>(ret.size())};
+}
+
+std::pair<std::vector<RelationalDatabase::txnMetaLedgerType>, int>
+getNewestAccountTxsB(
+    soci::session& session,
+    AccountTxIndex const& index,
+    RelationalDatabase::AccountTxOptions const& options)
+{
+    std::vector<RelationalDatabase::txnMetaLedgerType> ret;
+    forEachIndexedAccountTx(
+        session,
+        index,
+        options,
+        true,
+        true,
+        [&ret](LedgerIndex seq, std::string const&, Blob&& raw, Blob&& meta) {
+            ret.emplace_back(std::move(raw), std::move(meta), seq);
+        });
+    return {ret, static_cast<int>(ret.size())};
+}
+
+/**
+ * @brief accountTxPageResults Returns the number of transactions to return
+ *        on a page.
+ * @param options Struct AccountTxPageOptions which contains the limit.
+ * @param page_length The most transactions a non-admin may request.
+ * @return Number of transactions.
+ */
+static std::uint32_t
+accountTxPageResults(
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length)
+{
+    if (options.limit == 0 || options.limit == UINT32_MAX ||
+        (options.limit > page_length && !options.bAdmin))
+        return page_length;
+
+    return options.limit;
+}
+
 /**
  * @brief accountTxPage Searches for the oldest or newest transactions for the
  *        account that matches the given criteria starting from the provided
@@ -1023,13 +1628,7 @@ accountTxPage(
 
     bool lookingForMarker = options.marker.has_value();
 
-    std::uint32_t numberOfResults;
-
-    if (options.limit == 0 || options.limit == UINT32_MAX ||
-        (options.limit > page_length && !options.bAdmin))
-        numberOfResults = page_length;
-    else
-        numberOfResults = options.limit;
+    std::uint32_t numberOfResults = accountTxPageResults(options, page_length);
 
     // As an account can have many thousands of transactions, there is a limit
     // placed on the amount of transactions returned. If the limit is reached
@@ -1047,30 +1646,18 @@ accountTxPage(
 
     std::optional<RelationalDatabase::AccountTxMarker> newmarker;
 
-    static std::string const prefix(
-        R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-          Status,RawTxn,TxnMeta
-          FROM AccountTransactions INNER JOIN Transactions
-          ON Transactions.TransID = AccountTransactions.TransID
-          AND AccountTransactions.Account = '%s' WHERE
-          )");
-
     std::string sql;
 
     // SQL's BETWEEN uses a closed interval ([a,b])
 
     char const* const order = forward ? "ASC" : "DESC";
 
+    std::string conditions;
     if (findLedger == 0)
     {
-        sql = boost::str(
-            boost::format(
-                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN %u AND %u
-             ORDER BY AccountTransactions.LedgerSeq %s,
-             AccountTransactions.TxnSeq %s
-             LIMIT %u;)")) %
-            toBase58(options.account) % options.minLedger % options.maxLedger %
-            order % order % queryLimit);
+        conditions = boost::str(
+            boost::format("AND LedgerSeq BETWEEN %u AND %u") %
+            options.minLedger % options.maxLedger);
     }
     else
     {
@@ -1080,29 +1667,24 @@ accountTxPage(
         std::uint32_t const maxLedger =
             forward ? options.maxLedger : findLedger - 1;
 
-        auto b58acct = toBase58(options.account);
-        sql = boost::str(
-            boost::format((
-                R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
+        conditions = boost::str(
+            boost::format("AND (LedgerSeq BETWEEN %u AND %u OR "
+                          "(LedgerSeq = %u AND TxnSeq %s %u))") %
+            minLedger % maxLedger % findLedger % compare % findSeq);
+    }
+
+    sql = boost::str(
+        boost::format(
+            R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
             Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN %u AND %u)
-            UNION
-            SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = %u AND
-            AccountTransactions.TxnSeq %s %u)
+            FROM %s INNER JOIN Transactions
+            ON Transactions.TransID = AccountTransactions.TransID
             ORDER BY AccountTransactions.LedgerSeq %s,
             AccountTransactions.TxnSeq %s
-            LIMIT %u;
-            )")) %
-            b58acct % minLedger % maxLedger % b58acct % findLedger % compare %
-            findSeq % order % order % queryLimit);
-    }
+            LIMIT %u;)") %
+        accountTransactionsSource(
+            session, options.account, conditions, order, queryLimit) %
+        order % order % queryLimit);
 
     {
         Blob rawData;
@@ -1211,6 +1793,138 @@ newestAccountTxPage(
         session, onUnsavedLedger, onTransaction, options, page_length, false);
 }
 
+/**
+ * @brief accountTxIndexPage Same as accountTxPage, but finds the account's
+ *        transactions in the index.
+ * @param session Session with the database.
+ * @param index The index.
+ * @param onUnsavedLedger Callback function to call on each found unsaved
+ *        ledger within the given range.
+ * @param onTransaction Callback function to call on each found transaction.
+ * @param options Struct AccountTxPageOptions which contains the criteria.
+ * @param page_length Total number of transactions to return.
+ * @param forward True for ascending order, false for descending.
+ * @return Marker for the next search if the search was not finished and
+ *         the number of transactions processed during this call.
+ */
+static std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+accountTxIndexPage(
+    soci::session& session,
+    AccountTxIndex const& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length,
+    bool forward)
+{
+    int total = 0;
+
+    std::uint32_t numberOfResults = accountTxPageResults(options, page_length);
+
+    std::optional<RelationalDatabase::AccountTxMarker> newmarker;
+
+    // As in accountTxPage, a marker replaces the bound of the range on its
+    // side and the page must begin with the marked transaction.
+    std::optional<AccountTxIndex::Position> start;
+    LedgerIndex minLedger = options.minLedger;
+    LedgerIndex maxLedger = options.maxLedger;
+    if (options.marker)
+    {
+        start = {options.marker->ledgerSeq, options.marker->txnSeq};
+        if (forward)
+            minLedger = options.marker->ledgerSeq;
+        else
+            maxLedger = options.marker->ledgerSeq;
+    }
+
+    bool lookingForMarker = options.marker.has_value();
+
+    forEachIndexedTransaction(
+        session,
+        index,
+        options.account,
+        minLedger,
+        maxLedger,
+        start,
+        forward,
+        0,
+        [&](LedgerIndex ledgerSeq,
+            std::uint32_t txnSeq,
+            std::string const& status,
+            Blob&& rawData,
+            Blob&& rawMeta) {
+            if (lookingForMarker)
+            {
+                if (ledgerSeq != options.marker->ledgerSeq ||
+                    txnSeq != options.marker->txnSeq)
+                    return false;
+                lookingForMarker = false;
+            }
+            else if (numberOfResults == 0)
+            {
+                newmarker = {ledgerSeq, txnSeq};
+                return false;
+            }
+
+            // Work around a bug that could leave the metadata missing
+            if (rawMeta.empty())
+                onUnsavedLedger(ledgerSeq);
+
+            onTransaction(
+                ledgerSeq, status, std::move(rawData), std::move(rawMeta));
+
+            --numberOfResults;
+            total++;
+            return true;
+        });
+
+    return {newmarker, total};
+}
+
+std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+oldestAccountTxPage(
+    soci::session& session,
+    AccountTxIndex const& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length)
+{
+    return accountTxIndexPage(
+        session,
+        index,
+        onUnsavedLedger,
+        onTransaction,
+        options,
+        page_length,
+        true);
+}
+
+std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+newestAccountTxPage(
+    soci::session& session,
+    AccountTxIndex const& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length)
+{
+    return accountTxIndexPage(
+        session,
+        index,
+        onUnsavedLedger,
+        onTransaction,
+        options,
+        page_length,
+        false);
+}
+
 std::variant<RelationalDatabase::AccountTx, TxSearched>
 getTransaction(
     soci::session& session,
@@ -22,7 +22,9 @@
 
 #include <xrpld/app/ledger/Ledger.h>
 #include <xrpld/app/rdb/RelationalDatabase.h>
+#include <xrpld/app/rdb/backend/detail/AccountTxIndex.h>
 #include <xrpld/core/Config.h>
+#include <xrpld/core/SociDB.h>
 
 namespace ripple {
 namespace detail {
@@ -125,6 +127,8 @@ getRowsMinMax(soci::session& session, TableType type);
  * @param app Application object.
  * @param ledger The ledger.
  * @param current True if ledger is current.
+ * @param accountTxIndex If not null, an index that also records the
+ *        accounts each transaction affected.
  * @return True is saving was successfull.
  */
 bool
@@ -133,7 +137,104 @@ saveValidatedLedger(
     DatabaseCon& txnDB,
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current);
+    bool current,
+    AccountTxIndex* accountTxIndex);
+
+/**
+ * @brief indexAccountTransactions Adds the transactions saved in a range of
+ *        ledgers to the index, one ledger at a time in ascending order. The
+ *        affected accounts are read from each transaction's metadata.
+ * @param session Session with the transaction database.
+ * @param index The index.
+ * @param after Ledgers up to and including this one are skipped.
+ * @param last The last ledger to index.
+ * @param j Journal.
+ * @return Number of ledgers indexed.
+ */
+std::size_t
+indexAccountTransactions(
+    soci::session& session,
+    AccountTxIndex& index,
+    LedgerIndex after,
+    LedgerIndex last,
+    beast::Journal j);
+
+/**
+ * @brief AccountTransactionWriter Writes rows of the AccountTransactions
+ *        index through statements prepared once and re-executed for every
+ *        row, with the transaction ID and account bound as raw bytes.
+ *
+ *        While a database still holds the legacy text table, rows removed
+ *        by deleteLedger and deleteTransaction are removed from it too.
+ *        The writer must not outlive the session.
+ */
+class AccountTransactionWriter
+{
+public:
+    explicit AccountTransactionWriter(soci::session& session);
+
+    AccountTransactionWriter(AccountTransactionWriter const&) = delete;
+    AccountTransactionWriter&
+    operator=(AccountTransactionWriter const&) = delete;
+
+    /** Delete every row for the ledger with the given sequence. */
+    void
+    deleteLedger(LedgerIndex ledgerSeq);
+
+    /** Delete every row for the given transaction. */
+    void
+    deleteTransaction(uint256 const& txID);
+
+    /** Record that the transaction affected the account. */
+    void
+    insert(
+        uint256 const& txID,
+        AccountID const& account,
+        LedgerIndex ledgerSeq,
+        std::uint32_t txnSeq);
+
+private:
+    bool const legacy_;
+
+    // Values bound to the statements below, set before each execution.
+    soci::blob txID_;
+    soci::blob account_;
+    LedgerIndex ledgerSeq_ = 0;
+    std::uint32_t txnSeq_ = 0;
+    std::string legacyTxID_;
+
+    soci::statement insert_;
+    soci::statement deleteTransaction_;
+    soci::statement deleteLedger_;
+    std::optional<soci::statement> legacyDeleteTransaction_;
+    std::optional<soci::statement> legacyDeleteLedger_;
+};
+
+/**
+ * @brief hasLegacyAccountTransactions Checks if the database still holds
+ *        the AccountTransactions table that stores transaction IDs and
+ *        accounts as text.
+ * @param session Session with database.
+ * @return True if the legacy table exists.
+ */
+bool
+hasLegacyAccountTransactions(soci::session& session);
+
+/**
+ * @brief migrateAccountTransactions Moves a batch of rows from the legacy
+ *        text AccountTransactions table into AccountTransactionsV2, and
+ *        drops the legacy table once it is empty. Each batch is its own
+ *        transaction, so readers and writers are only blocked briefly.
+ * @param session Session with database.
+ * @param batchSize Maximum number of rows to move.
+ * @param j Journal.
+ * @return True if no legacy rows remain.
+ */
+bool
+migrateAccountTransactions(
+    soci::session& session,
+    std::size_t batchSize,
+    beast::Journal j);
 
 /**
  * @brief getLedgerInfoByIndex Returns ledger by its sequence.
@@ -364,6 +465,45 @@ getNewestAccountTxsB(
     RelationalDatabase::AccountTxOptions const& options,
     beast::Journal j);
 
+/**
+ * @brief getOldestAccountTxs, getNewestAccountTxs, getOldestAccountTxsB,
+ *        getNewestAccountTxsB Same as the functions above, but find the
+ *        account's transactions in the index rather than in the
+ *        AccountTransactions table. Entries whose transaction has since
+ *        moved to another ledger are skipped.
+ * @param session Session with database.
+ * @param index The index.
+ */
+std::pair<RelationalDatabase::AccountTxs, int>
+getOldestAccountTxs(
+    soci::session& session,
+    AccountTxIndex const& index,
+    Application& app,
+    LedgerMaster& ledgerMaster,
+    RelationalDatabase::AccountTxOptions const& options,
+    beast::Journal j);
+
+std::pair<RelationalDatabase::AccountTxs, int>
+getNewestAccountTxs(
+    soci::session& session,
+    AccountTxIndex const& index,
+    Application& app,
+    LedgerMaster& ledgerMaster,
+    RelationalDatabase::AccountTxOptions const& options,
+    beast::Journal j);
+
+std::pair<std::vector<RelationalDatabase::txnMetaLedgerType>, int>
+getOldestAccountTxsB(
+    soci::session& session,
+    AccountTxIndex const& index,
+    RelationalDatabase::AccountTxOptions const& options);
+
+std::pair<std::vector<RelationalDatabase::txnMetaLedgerType>, int>
+getNewestAccountTxsB(
+    soci::session& session,
+    AccountTxIndex const& index,
+    RelationalDatabase::AccountTxOptions const& options);
+
 /**
  * @brief oldestAccountTxPage Searches oldest transactions for given
  *        account which match given criteria starting from given marker
@@ -420,6 +560,37 @@ newestAccountTxPage(
     RelationalDatabase::AccountTxPageOptions const& options,
     std::uint32_t page_length);
 
+/**
+ * @brief oldestAccountTxPage, newestAccountTxPage Same as the functions
+ *        above, but find the account's transactions in the index rather
+ *        than in the AccountTransactions table. Markers are interchangeable
+ *        with those of the table. Only the transactions on the page and the
+ *        one after it are read from the Transactions table.
+ * @param session Session with database.
+ * @param index The index.
+ */
+std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+oldestAccountTxPage(
+    soci::session& session,
+    AccountTxIndex const& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length);
+
+std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+newestAccountTxPage(
+    soci::session& session,
+    AccountTxIndex const& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length);
+
 /**
  * @brief getTransaction Returns transaction with given hash. If not found
  *        and range given then check if all ledgers from the range are
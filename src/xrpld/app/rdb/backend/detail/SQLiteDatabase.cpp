@@ -22,11 +22,18 @@
 #include <xrpld/app/misc/detail/AccountTxPaging.h>
 #include <xrpld/app/rdb/backend/SQLiteDatabase.h>
 #include <xrpld/app/rdb/backend/detail/Node.h>
+#include <xrpld/core/ConfigSections.h>
 #include <xrpld/core/DatabaseCon.h>
+#include <xrpld/core/JobQueue.h>
 #include <xrpld/core/SociDB.h>
 
 #include <xrpl/basics/StringUtilities.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <atomic>
+#include <mutex>
+
 namespace ripple {
 
 class SQLiteDatabaseImp final : public SQLiteDatabase
@@ -38,6 +45,7 @@ public:
         JobQueue& jobQueue)
         : app_(app)
         , useTxTables_(config.useTxTables())
+        , jobQueue_(jobQueue)
         , j_(app_.journal("SQLiteDatabaseImp"))
     {
         DatabaseCon::Setup const setup = setup_DatabaseCon(config, j_);
@@ -52,6 +60,16 @@ public:
             JLOG(j_.fatal()) << error;
             Throw<std::runtime_error>(error.data());
         }
+
+        openAccountTxIndex(config, setup);
+
+        if (existsTransaction() &&
+            detail::hasLegacyAccountTransactions(*txdb_->checkoutDb()))
+        {
+            JLOG(j_.warn()) << "Migrating AccountTransactions to the binary "
+                               "layout in the background";
+            migrateAccountTransactions();
+        }
     }
 
     std::optional<LedgerIndex>
@@ -173,9 +191,62 @@ public:
 private:
     Application& app_;
     bool const useTxTables_;
+    JobQueue& jobQueue_;
     beast::Journal j_;
     std::unique_ptr<DatabaseCon> lgrdb_, txdb_;
 
+    // Serves account_tx once built, if configured. The AccountTransactions
+    // table is maintained either way, and serves account_tx until then.
+    std::unique_ptr<detail::AccountTxIndex> accountTxIndex_;
+    std::atomic<bool> compacting_{false};
+
+    // Serializes ledger saves with the build. Until the index is built,
+    // ledgers after indexedThrough_ are left for the build to index.
+    std::mutex indexMutex_;
+    LedgerIndex indexedThrough_ = 0;
+
+    /**
+     * @brief openAccountTxIndex Opens the account transaction index if
+     *        `[relational_db] account_tx_index` selects one, and starts
+     *        building it if it does not hold every saved ledger.
+     * @param config Config object.
+     * @param setup Path to the databases and other opening parameters.
+     */
+    void
+    openAccountTxIndex(Config const& config, DatabaseCon::Setup const& setup);
+
+    /**
+     * @brief builtAccountTxIndex Returns the account transaction index if
+     *        it is configured and built.
+     * @return The index, or null if account_tx reads the table instead.
+     */
+    detail::AccountTxIndex const*
+    builtAccountTxIndex() const;
+
+    /**
+     * @brief buildAccountTxIndex Queues a low priority job that indexes one
+     *        batch of saved ledgers and queues the next until the index
+     *        holds every saved ledger.
+     */
+    void
+    buildAccountTxIndex();
+
+    /**
+     * @brief compactAccountTxIndex Queues a low priority job that merges
+     *        the segments of the account transaction index, unless one is
+     *        already queued.
+     */
+    void
+    compactAccountTxIndex();
+
+    /**
+     * @brief migrateAccountTransactions Queues a low priority job that moves
+     *        one batch of legacy account transaction rows and queues the
+     *        next until none remain.
+     */
+    void
+    migrateAccountTransactions();
+
     /**
      * @brief makeLedgerDBs Opens ledger and transaction databases for the node
      *        store, and stores their descriptors in private member variables.
@@ -247,6 +318,183 @@ SQLiteDatabaseImp::makeLedgerDBs(
     return res;
 }
 
+void
+SQLiteDatabaseImp::openAccountTxIndex(
+    Config const& config,
+    DatabaseCon::Setup const& setup)
+{
+    auto const engine = get(
+        config.section(SECTION_RELATIONAL_DB),
+        "account_tx_index",
+        std::string("sqlite"));
+    if (boost::iequals(engine, "sqlite"))
+        return;
+    if (!boost::iequals(engine, "segments"))
+        Throw<std::runtime_error>(
+            "Invalid [" SECTION_RELATIONAL_DB "] account_tx_index value: " +
+            engine);
+
+    if (!useTxTables_ || !existsTransaction())
+        return;
+
+    // Temporary databases get an index that is only kept in memory.
+    detail::AccountTxIndex::Setup indexSetup;
+    if (!setup.standAlone || setup.startUp == Config::LOAD ||
+        setup.startUp == Config::LOAD_FILE || setup.startUp == Config::REPLAY)
+        indexSetup.path = setup.dataDir / "account_tx_index";
+
+    accountTxIndex_ = std::make_unique<detail::AccountTxIndex>(indexSetup, j_);
+
+    std::optional<LedgerIndex> first, last;
+    {
+        auto db = checkoutTransaction();
+        first = detail::getMinLedgerSeq(*db, detail::TableType::Transactions);
+        last = detail::getMaxLedgerSeq(*db, detail::TableType::Transactions);
+    }
+    if (first)
+        accountTxIndex_->deleteBefore(*first);
+
+    // Ledgers saved while the index was not configured, or lost with the
+    // end of its log, are missing from it.
+    auto const indexed = accountTxIndex_->maxLedgerSeq();
+    if (accountTxIndex_->built() && last && indexed.value_or(0) < *last)
+    {
+        JLOG(j_.warn()) << "The account transaction index ends before ledger "
+                        << *last;
+        accountTxIndex_->setBuilt(false);
+    }
+
+    if (accountTxIndex_->built())
+        return;
+
+    // Ledgers are indexed in ascending order, so an interrupted build
+    // picks up after the last one it finished.
+    indexedThrough_ = std::max(indexed.value_or(0), first.value_or(1) - 1);
+    JLOG(j_.warn()) << "Building the account transaction index after ledger "
+                    << indexedThrough_ << " in the background";
+    buildAccountTxIndex();
+}
+
+detail::AccountTxIndex const*
+SQLiteDatabaseImp::builtAccountTxIndex() const
+{
+    if (accountTxIndex_ && accountTxIndex_->built())
+        return accountTxIndex_.get();
+    return nullptr;
+}
+
+void
+SQLiteDatabaseImp::buildAccountTxIndex()
+{
+    // Small batches keep the locks short, so ledger saves and queries
+    // interleave with the build.
+    static constexpr LedgerIndex batchLedgers = 256;
+
+    jobQueue_.addJob(jtMIGRATE, "buildAccountTxIndex", [this]() {
+        if (!existsTransaction())
+            return;
+
+        bool done = false;
+        try
+        {
+            std::lock_guard lock(indexMutex_);
+            {
+                auto db = checkoutTransaction();
+                auto const last =
+                    detail::getMaxLedgerSeq(
+                        *db, detail::TableType::Transactions)
+                        .value_or(0);
+                if (indexedThrough_ < last)
+                {
+                    auto const through = indexedThrough_ +
+                        std::min(batchLedgers, last - indexedThrough_);
+                    detail::indexAccountTransactions(
+                        *db, *accountTxIndex_, indexedThrough_, through, j_);
+                    indexedThrough_ = through;
+                }
+                done = indexedThrough_ >= last;
+            }
+
+            // Saves wait for the lock, so none is missed in between.
+            if (done)
+                accountTxIndex_->setBuilt(true);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.error())
+                << "Building the account transaction index failed: "
+                << e.what();
+            return;
+        }
+
+        if (!done)
+            return buildAccountTxIndex();
+
+        JLOG(j_.warn()) << "Account transaction index built through ledger "
+                        << indexedThrough_;
+    });
+}
+
+void
+SQLiteDatabaseImp::compactAccountTxIndex()
+{
+    if (compacting_.exchange(true))
+        return;
+
+    auto const queued =
+        jobQueue_.addJob(jtCOMPACT, "compactAccountTxIndex", [this]() {
+            bool more = false;
+            try
+            {
+                more = accountTxIndex_->compact();
+            }
+            catch (std::exception const& e)
+            {
+                JLOG(j_.error())
+                    << "Account transaction index compaction failed: "
+                    << e.what();
+            }
+
+            compacting_ = false;
+            if (more)
+                compactAccountTxIndex();
+        });
+
+    if (!queued)
+        compacting_ = false;
+}
+
+void
+SQLiteDatabaseImp::migrateAccountTransactions()
+{
+    // Small batches keep the transaction database lock short, so ledger
+    // saves and queries interleave with the migration.
+    static constexpr std::size_t batchSize = 4096;
+
+    jobQueue_.addJob(jtMIGRATE, "migrateAccountTransactions", [this]() {
+        if (!existsTransaction())
+            return;
+
+        bool done = false;
+        try
+        {
+            auto db = checkoutTransaction();
+            done = detail::migrateAccountTransactions(*db, batchSize, j_);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.error())
+                << "AccountTransactions migration failed: " << e.what();
+            return;
+        }
+
+        if (!done)
+            return migrateAccountTransactions();
+
+        JLOG(j_.info()) << "AccountTransactions migration complete";
+    });
+}
+
 std::optional<LedgerIndex>
 SQLiteDatabaseImp::getMinLedgerSeq()
 {
@@ -282,6 +530,9 @@ SQLiteDatabaseImp::getAccountTransactionsMinLedgerSeq()
     if (!useTxTables_)
         return {};
 
+    if (auto const index = builtAccountTxIndex())
+        return index->minLedgerSeq();
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -353,6 +604,9 @@ SQLiteDatabaseImp::deleteAccountTransactionsBeforeLedgerSeq(
     if (!useTxTables_)
         return;
 
+    if (accountTxIndex_)
+        accountTxIndex_->deleteBefore(ledgerSeq);
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -383,6 +637,9 @@ SQLiteDatabaseImp::getAccountTransactionCount()
     if (!useTxTables_)
         return 0;
 
+    if (auto const index = builtAccountTxIndex())
+        return index->size();
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -411,9 +668,26 @@ SQLiteDatabaseImp::saveValidatedLedger(
 {
     if (existsLedger())
     {
-        if (!detail::saveValidatedLedger(
-                *lgrdb_, *txdb_, app_, ledger, current))
-            return false;
+        {
+            // Until the index is built, a ledger the build has not reached
+            // yet is left for it.
+            std::unique_lock lock(indexMutex_, std::defer_lock);
+            detail::AccountTxIndex* index = nullptr;
+            if (accountTxIndex_)
+            {
+                lock.lock();
+                if (accountTxIndex_->built() ||
+                    ledger->info().seq <= indexedThrough_)
+                    index = accountTxIndex_.get();
+            }
+
+            if (!detail::saveValidatedLedger(
+                    *lgrdb_, *txdb_, app_, ledger, current, index))
+                return false;
+        }
+
+        if (accountTxIndex_ && accountTxIndex_->needsCompaction())
+            compactAccountTxIndex();
     }
 
     return true;
@@ -570,6 +844,10 @@ SQLiteDatabaseImp::getOldestAccountTxs(AccountTxOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
+        if (auto const index = builtAccountTxIndex())
+            return detail::getOldestAccountTxs(
+                       *db, *index, app_, ledgerMaster, options, j_)
+                .first;
         return detail::getOldestAccountTxs(*db, app_, ledgerMaster, options, j_)
             .first;
     }
@@ -588,6 +866,10 @@ SQLiteDatabaseImp::getNewestAccountTxs(AccountTxOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
+        if (auto const index = builtAccountTxIndex())
+            return detail::getNewestAccountTxs(
+                       *db, *index, app_, ledgerMaster, options, j_)
+                .first;
         return detail::getNewestAccountTxs(*db, app_, ledgerMaster, options, j_)
             .first;
     }
@@ -604,6 +886,8 @@ SQLiteDatabaseImp::getOldestAccountTxsB(AccountTxOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
+        if (auto const index = builtAccountTxIndex())
+            return detail::getOldestAccountTxsB(*db, *index, options).first;
         return detail::getOldestAccountTxsB(*db, app_, options, j_).first;
     }
 
@@ -619,6 +903,8 @@ SQLiteDatabaseImp::getNewestAccountTxsB(AccountTxOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
+        if (auto const index = builtAccountTxIndex())
+            return detail::getNewestAccountTxsB(*db, *index, options).first;
         return detail::getNewestAccountTxsB(*db, app_, options, j_).first;
     }
 
@@ -649,10 +935,19 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
-        auto newmarker =
-            detail::oldestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, page_length)
-                .first;
+        auto const index = builtAccountTxIndex();
+        auto newmarker = index
+            ? detail::oldestAccountTxPage(
+                  *db,
+                  *index,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length)
+                  .first
+            : detail::oldestAccountTxPage(
+                  *db, onUnsavedLedger, onTransaction, options, page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -683,10 +978,19 @@ SQLiteDatabaseImp::newestAccountTxPage(AccountTxPageOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
-        auto newmarker =
-            detail::newestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, page_length)
-                .first;
+        auto const index = builtAccountTxIndex();
+        auto newmarker = index
+            ? detail::newestAccountTxPage(
+                  *db,
+                  *index,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length)
+                  .first
+            : detail::newestAccountTxPage(
+                  *db, onUnsavedLedger, onTransaction, options, page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -716,10 +1020,19 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
-        auto newmarker =
-            detail::oldestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, page_length)
-                .first;
+        auto const index = builtAccountTxIndex();
+        auto newmarker = index
+            ? detail::oldestAccountTxPage(
+                  *db,
+                  *index,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length)
+                  .first
+            : detail::oldestAccountTxPage(
+                  *db, onUnsavedLedger, onTransaction, options, page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -749,10 +1062,19 @@ SQLiteDatabaseImp::newestAccountTxPageB(AccountTxPageOptions const& options)
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
-        auto newmarker =
-            detail::newestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, page_length)
-                .first;
+        auto const index = builtAccountTxIndex();
+        auto newmarker = index
+            ? detail::newestAccountTxPage(
+                  *db,
+                  *index,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length)
+                  .first
+            : detail::newestAccountTxPage(
+                  *db, onUnsavedLedger, onTransaction, options, page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -300,7 +300,8 @@ preflight(
         call to `preflight` for the transaction.
     @param app The current running `Application`.
     @param view The open ledger that the transaction
-        will attempt to be applied to.
+        will attempt to be applied to, or a read-only
+        view of it.
 
     @see PreclaimResult, preflight, doApply, apply
 
@@ -312,7 +313,7 @@ PreclaimResult
 preclaim(
     PreflightResult const& preflightResult,
     Application& app,
-    OpenView const& view);
+    ReadView const& view);
 
 /** Compute only the expected base fee for a transaction.
 
@@ -329,7 +329,7 @@ PreclaimResult
 preclaim(
     PreflightResult const& preflightResult,
     Application& app,
-    OpenView const& view)
+    ReadView const& view)
 {
     std::optional<PreclaimContext const> ctx;
     if (preflightResult.rules != view.rules())
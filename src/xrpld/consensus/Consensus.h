@@ -34,8 +34,10 @@
 #include <algorithm>
 #include <chrono>
 #include <deque>
+#include <map>
 #include <optional>
 #include <sstream>
+#include <utility>
 
 namespace ripple {
 
@@ -541,6 +543,11 @@ private:
     bool
     haveConsensus(std::unique_ptr<std::stringstream> const& clog);
 
+    // The transactions in one set but not the other, as TxSet::compare
+    // returns them. Each pair of sets is only compared once a round.
+    std::map<typename Tx_t::ID, bool>
+    compareSets(TxSet_t const& ours, TxSet_t const& other);
+
     // Create disputes between our position and the provided one.
     void
     createDisputes(
@@ -605,6 +612,13 @@ private:
     // Transaction Sets, indexed by hash of transaction tree
     hash_map<typename TxSet_t::ID, TxSet_t const> acquired_;
 
+    // The differences between pairs of acquired sets compared this round,
+    // keyed by the lower set ID first and as seen from that set
+    std::map<
+        std::pair<typename TxSet_t::ID, typename TxSet_t::ID>,
+        std::map<typename Tx_t::ID, bool>>
+        diffs_;
+
     std::optional<Result> result_;
     ConsensusCloseTimes rawCloseTimes_;
 
@@ -717,6 +731,7 @@ Consensus<Adaptor>::startRoundInternal(
     openTime_.reset(clock_.now());
     currPeerPositions_.clear();
     acquired_.clear();
+    diffs_.clear();
     rawCloseTimes_.peers.clear();
     rawCloseTimes_.self = {};
     deadNodes_.clear();
@@ -1816,6 +1831,37 @@ Consensus<Adaptor>::leaveConsensus(
     }
 }
 
+template <class Adaptor>
+std::map<typename Consensus<Adaptor>::Tx_t::ID, bool>
+Consensus<Adaptor>::compareSets(TxSet_t const& ours, TxSet_t const& other)
+{
+    bool const swapped = other.id() < ours.id();
+    auto const key = swapped ? std::make_pair(other.id(), ours.id())
+                             : std::make_pair(ours.id(), other.id());
+
+    auto it = diffs_.find(key);
+    if (it == diffs_.end())
+    {
+        it = diffs_
+                 .emplace(
+                     key, swapped ? other.compare(ours) : ours.compare(other))
+                 .first;
+    }
+    else
+    {
+        JLOG(j_.debug()) << "compareSets: reusing differences between "
+                         << ours.id() << " and " << other.id();
+    }
+
+    if (!swapped)
+        return it->second;
+
+    std::map<typename Tx_t::ID, bool> differences;
+    for (auto const& [txId, inLower] : it->second)
+        differences.emplace_hint(differences.end(), txId, !inLower);
+    return differences;
+}
+
 template <class Adaptor>
 void
 Consensus<Adaptor>::createDisputes(
@@ -1843,7 +1889,7 @@ Consensus<Adaptor>::createDisputes(
     JLOG(j_.debug()) << "createDisputes " << result_->txns.id() << " to "
                      << o.id();
 
-    auto differences = result_->txns.compare(o);
+    auto differences = compareSets(result_->txns, o);
 
     int dc = 0;
 
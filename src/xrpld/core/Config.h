@@ -218,6 +218,14 @@ public:
 
     // Compression
     bool COMPRESSION = false;
+    // Compress against the shared dictionary, experimental
+    bool COMPRESSION_DICTIONARY = false;
+
+    // Allocate SHAMap inner nodes from a slab rather than the heap
+    bool INNER_NODE_SLAB = false;
+
+    // Run RPC commands that never wait without a JobQueue::Coro stack
+    bool STACKLESS_RPC = false;
 
     // Enable the experimental Ledger Replay functionality
     bool LEDGER_REPLAY = false;
@@ -231,9 +239,10 @@ public:
     std::chrono::seconds AMENDMENT_MAJORITY_TIME = defaultAmendmentMajorityTime;
 
     // Thread pool configuration (0 = choose for me)
-    int WORKERS = 0;           // jobqueue thread count. default: upto 6
-    int IO_WORKERS = 0;        // io svc thread count. default: 2
-    int PREFETCH_WORKERS = 0;  // prefetch thread count. default: 4
+    int WORKERS = 0;             // jobqueue thread count. default: upto 6
+    int IO_WORKERS = 0;          // io svc thread count. default: 2
+    int PREFETCH_WORKERS = 0;    // prefetch thread count. default: 4
+    bool WORK_STEALING = false;  // jobqueue uses per-thread queues
 
     // Can only be set in code, specifically unit tests
     bool FORCE_MULTI_THREAD = false;
@@ -47,10 +47,12 @@ struct ConfigSection
 #define SECTION_BETA_RPC_API "beta_rpc_api"
 #define SECTION_CLUSTER_NODES "cluster_nodes"
 #define SECTION_COMPRESSION "compression"
+#define SECTION_COMPRESSION_DICTIONARY "compression_dictionary"
 #define SECTION_DEBUG_LOGFILE "debug_logfile"
 #define SECTION_ELB_SUPPORT "elb_support"
 #define SECTION_FEE_DEFAULT "fee_default"
 #define SECTION_FETCH_DEPTH "fetch_depth"
+#define SECTION_INNER_NODE_SLAB "inner_node_slab"
 #define SECTION_INSIGHT "insight"
 #define SECTION_IO_WORKERS "io_workers"
 #define SECTION_IPS "ips"
@@ -60,6 +62,7 @@ struct ConfigSection
 #define SECTION_MAX_TRANSACTIONS "max_transactions"
 #define SECTION_NETWORK_ID "network_id"
 #define SECTION_NETWORK_QUORUM "network_quorum"
+#define SECTION_NODE_CACHE_SNAPSHOT "node_cache_snapshot"
 #define SECTION_NODE_SEED "node_seed"
 #define SECTION_NODE_SIZE "node_size"
 #define SECTION_OVERLAY "overlay"
@@ -84,6 +87,7 @@ struct ConfigSection
 #define SECTION_SSL_VERIFY_FILE "ssl_verify_file"
 #define SECTION_SSL_VERIFY_DIR "ssl_verify_dir"
 #define SECTION_SERVER_DOMAIN "server_domain"
+#define SECTION_STACKLESS_RPC "stackless_rpc"
 #define SECTION_SWEEP_INTERVAL "sweep_interval"
 #define SECTION_VALIDATORS_FILE "validators_file"
 #define SECTION_VALIDATION_SEED "validation_seed"
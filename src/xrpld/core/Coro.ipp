@@ -60,10 +60,7 @@ inline JobQueue::Coro::~Coro()
 inline void
 JobQueue::Coro::yield() const
 {
-    {
-        std::lock_guard lock(jq_.m_mutex);
-        ++jq_.nSuspend_;
-    }
+    jq_.taskSuspended();
     (*yield_)();
 }
 
@@ -96,10 +93,7 @@ JobQueue::Coro::resume()
         std::lock_guard lk(mutex_run_);
         running_ = true;
     }
-    {
-        std::lock_guard lock(jq_.m_mutex);
-        --jq_.nSuspend_;
-    }
+    jq_.taskResumed();
     auto saved = detail::getLocalValues().release();
     detail::getLocalValues().reset(&lvs_);
     std::lock_guard lock(mutex_);
@@ -133,8 +127,7 @@ JobQueue::Coro::expectEarlyExit()
         //
         // That said, since we're outside the Coro's stack, we need to
         // decrement the nSuspend that the Coro's call to yield caused.
-        std::lock_guard lock(jq_.m_mutex);
-        --jq_.nSuspend_;
+        jq_.taskResumed();
 #ifndef NDEBUG
         finished_ = true;
 #endif
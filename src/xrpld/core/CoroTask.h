@@ -0,0 +1,309 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_COROTASK_H_INCLUDED
+#define RIPPLE_CORE_COROTASK_H_INCLUDED
+
+#include <xrpld/core/JobQueue.h>
+
+#include <xrpl/basics/contract.h>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace ripple {
+
+/** A stackless coroutine that produces a T.
+
+    Unlike JobQueue::Coro, a CoroTask has no stack of its own. Its frame
+    holds only the state that lives across a suspension, and it suspends
+    only where its body says co_await. A task is lazy: it does not start
+    until another task awaits it or it is passed to runCoroTask.
+
+    An exception that escapes the body is rethrown to the awaiter.
+*/
+template <class T>
+class [[nodiscard]] CoroTask
+{
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct promise_type
+    {
+        std::variant<std::monostate, T, std::exception_ptr> result;
+        std::coroutine_handle<> continuation;
+
+        CoroTask
+        get_return_object() noexcept
+        {
+            return CoroTask{handle_type::from_promise(*this)};
+        }
+
+        std::suspend_always
+        initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        auto
+        final_suspend() noexcept
+        {
+            // Hand the thread straight to whoever awaited us.
+            struct FinalAwaiter
+            {
+                bool
+                await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<>
+                await_suspend(handle_type h) noexcept
+                {
+                    return h.promise().continuation;
+                }
+
+                void
+                await_resume() noexcept
+                {
+                }
+            };
+            return FinalAwaiter{};
+        }
+
+        template <class U>
+        void
+        return_value(U&& value)
+        {
+            result.template emplace<1>(std::forward<U>(value));
+        }
+
+        void
+        unhandled_exception() noexcept
+        {
+            result.template emplace<2>(std::current_exception());
+        }
+    };
+
+    CoroTask(CoroTask&& other) noexcept
+        : handle_(std::exchange(other.handle_, {}))
+    {
+    }
+
+    CoroTask&
+    operator=(CoroTask&&) = delete;
+
+    ~CoroTask()
+    {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    auto
+    operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            handle_type h;
+
+            bool
+            await_ready() noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                h.promise().continuation = awaiting;
+                return h;
+            }
+
+            T
+            await_resume()
+            {
+                auto& result = h.promise().result;
+                if (auto e = std::get_if<std::exception_ptr>(&result))
+                    std::rethrow_exception(*e);
+                return std::move(std::get<T>(result));
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    explicit CoroTask(handle_type h) : handle_(h)
+    {
+    }
+
+    handle_type handle_;
+};
+
+namespace detail {
+
+// The frame that owns a task started by runCoroTask.
+struct DetachedCoroTask
+{
+    struct promise_type
+    {
+        DetachedCoroTask
+        get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void
+        return_void() noexcept
+        {
+        }
+
+        void
+        unhandled_exception() noexcept
+        {
+            LogicError("ripple::runCoroTask : unhandled exception");
+        }
+    };
+};
+
+}  // namespace detail
+
+/** Start a task and call done with its result when it finishes.
+
+    The task runs on the calling thread until it first suspends, and done
+    is called on whichever thread finishes it. Both the task and done must
+    handle their own exceptions.
+*/
+template <class T, class Done>
+void
+runCoroTask(CoroTask<T> task, Done done)
+{
+    [](CoroTask<T> task, Done done) -> detail::DetachedCoroTask {
+        done(co_await std::move(task));
+    }(std::move(task), std::move(done));
+}
+
+/** A one-shot event that a CoroTask can wait for.
+
+    notify() may be called from any thread, before or after the wait. A
+    waiting task is resumed by a job on the JobQueue. If the JobQueue is
+    stopping and refuses the job, the task is resumed on the notifying
+    thread instead, as JobQueue::Coro::post does, so it always runs to
+    completion. Like a suspended JobQueue::Coro, a waiting task is counted
+    by the JobQueue, and JobQueue::stop waits until it has been resumed.
+
+    The event is usually shared between the waiting task and the callback
+    that calls notify(), each holding a std::shared_ptr.
+*/
+class CoroEvent
+{
+public:
+    CoroEvent(JobQueue& jobQueue, JobType type, std::string name)
+        : jobQueue_(jobQueue), type_(type), name_(std::move(name))
+    {
+    }
+
+    CoroEvent(CoroEvent const&) = delete;
+    CoroEvent&
+    operator=(CoroEvent const&) = delete;
+
+    void
+    notify()
+    {
+        if (state_.exchange(notified, std::memory_order_acq_rel) != waiting)
+            return;
+
+        // The task may destroy this event, so take what is needed first.
+        auto& jobQueue = jobQueue_;
+        auto const resume = [&jobQueue, h = waiter_]() {
+            h.resume();
+            jobQueue.taskResumed();
+        };
+        if (!jobQueue.addJob(type_, name_, resume))
+            resume();
+    }
+
+    auto
+    operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            CoroEvent& event;
+
+            bool
+            await_ready() noexcept
+            {
+                return event.state_.load(std::memory_order_acquire) ==
+                    notified;
+            }
+
+            bool
+            await_suspend(std::coroutine_handle<> h) noexcept
+            {
+                event.waiter_ = h;
+                event.jobQueue_.taskSuspended();
+                int expected = idle;
+                if (event.state_.compare_exchange_strong(
+                        expected, waiting, std::memory_order_acq_rel))
+                    return true;
+
+                // notify() got in first, so carry on without suspending.
+                event.jobQueue_.taskResumed();
+                return false;
+            }
+
+            void
+            await_resume() noexcept
+            {
+            }
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    static constexpr int idle = 0;
+    static constexpr int waiting = 1;
+    static constexpr int notified = 2;
+
+    JobQueue& jobQueue_;
+    JobType const type_;
+    std::string const name_;
+    std::atomic<int> state_{idle};
+    std::coroutine_handle<> waiter_;
+};
+
+}  // namespace ripple
+
+#endif
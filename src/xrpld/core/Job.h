@@ -40,6 +40,9 @@ enum JobType {
     // earlier jobs having lower priority than later jobs. If you wish to
     // insert a job at a specific priority, simply add it at the right location.
 
+    jtMIGRATE,            // Migrate database rows to a new layout
+    jtCOMPACT,            // Merge the segments of an on-disk index
+    jtWARM,               // Load a snapshot of the node caches
     jtPACK,               // Make a fetch pack for a peer
     jtPUBOLDLEDGER,       // An old ledger has been accepted
     jtCLIENT,             // A placeholder for the priority of all jtCLIENT jobs
@@ -23,7 +23,9 @@
 #include <xrpld/core/ClosureCounter.h>
 #include <xrpld/core/JobTypeData.h>
 #include <xrpld/core/JobTypes.h>
+#include <xrpld/core/detail/WorkStealingScheduler.h>
 #include <xrpld/core/detail/Workers.h>
+#include <xrpld/perflog/TracedMutex.h>
 
 #include <xrpl/basics/LocalValue.h>
 #include <xrpl/json/json_value.h>
@@ -38,6 +40,7 @@ namespace perf {
 class PerfLog;
 }
 
+class CoroEvent;
 class Logs;
 struct Coro_create_t
 {
@@ -53,8 +56,14 @@ struct Coro_create_t
 
     When the JobQueue stops, it waits for all jobs
     and coroutines to finish.
+
+    Jobs are either kept in one job set shared by a pool of Workers, or,
+    if work stealing is selected, in the per-thread queues of a
+    WorkStealingScheduler. Both run jobs in JobType priority order and
+    honor the per-type limits in JobTypes.
 */
-class JobQueue : private Workers::Callback
+class JobQueue : private Workers::Callback,
+                 private WorkStealingScheduler::Callback
 {
 public:
     /** Coroutines must run to completion. */
@@ -147,7 +156,8 @@ public:
         beast::insight::Collector::ptr const& collector,
         beast::Journal journal,
         Logs& logs,
-        perf::PerfLog& perfLog);
+        perf::PerfLog& perfLog,
+        bool workStealing = false);
     ~JobQueue();
 
     /** Adds a job to the JobQueue.
@@ -188,6 +198,25 @@ public:
     std::shared_ptr<Coro>
     postCoro(JobType t, std::string const& name, F&& f);
 
+    /** Calls `f(i)` for every `i` in `[0, count)`, sharing the calls
+        between the calling thread and up to `helpers` jobs of type `t`.
+
+        The calling thread picks up any call that no helper has started,
+        so this returns even when no job of type `t` can run, for example
+        because of the type's limit or because the queue is stopping.
+        Helper jobs that start after the work is done return at once.
+
+        @return once every call has finished. The first exception thrown by
+                `f` is rethrown here.
+    */
+    void
+    parallelFor(
+        JobType t,
+        std::string const& name,
+        std::size_t count,
+        std::size_t helpers,
+        std::function<void(std::size_t)> const& f);
+
     /** Jobs waiting at this priority.
      */
     int
@@ -241,12 +270,13 @@ public:
 
 private:
     friend class Coro;
+    friend class CoroEvent;
 
     using JobDataMap = std::map<JobType, JobTypeData>;
 
     beast::Journal m_journal;
-    mutable std::mutex m_mutex;
-    std::uint64_t m_lastJob;
+    mutable perf::TracedMutex<std::mutex> m_mutex{"JobQueue"};
+    std::atomic<std::uint64_t> m_lastJob;
     std::set<Job> m_jobSet;
     JobCounter jobCounter_;
     std::atomic_bool stopping_{false};
@@ -257,18 +287,22 @@ private:
     // The number of jobs currently in processTask()
     int m_processCount;
 
-    // The number of suspended coroutines
+    // The number of suspended coroutines, stackful or CoroTask
     int nSuspend_ = 0;
 
     Workers m_workers;
 
+    // Jobs queued or running in the scheduler, when work stealing is used.
+    std::atomic<int> stealingPending_{0};
+    std::unique_ptr<WorkStealingScheduler> scheduler_;
+
     // Statistics tracking
     perf::PerfLog& perfLog_;
     beast::insight::Collector::ptr m_collector;
     beast::insight::Gauge job_count;
     beast::insight::Hook hook;
 
-    std::condition_variable cv_;
+    std::condition_variable_any cv_;
 
     void
     collect();
@@ -338,6 +372,42 @@ private:
     void
     processTask(int instance) override;
 
+    // Runs a Job taken from the work-stealing scheduler.
+    void
+    processJob(Job&& job, int instance) override;
+
+    // Runs a Job and records how long it waited and ran.
+    void
+    runJob(Job& job, Job::clock_type::time_point startTime, int instance);
+
+    // The number of threads running jobs.
+    int
+    getNumberOfThreads() const noexcept;
+
+    // The number of jobs of a type waiting and running.
+    //
+    // Invariants:
+    //  The calling thread owns the JobLock, unless work stealing is used
+    int
+    waitingCount(JobType type) const;
+    int
+    runningCount(JobType type) const;
+
+    // True if no jobs are queued or running.
+    //
+    // Invariants:
+    //  The calling thread owns the JobLock
+    bool
+    isIdle() const;
+
+    // Count a suspended coroutine, and uncount it once it has been resumed
+    // or will never run again. Uncounting the last one wakes stop().
+    void
+    taskSuspended();
+
+    void
+    taskResumed();
+
     // Returns the limit of running jobs for the given job type.
     // For jobs with no limit, we return the largest int. Hopefully that
     // will be enough.
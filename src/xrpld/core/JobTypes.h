@@ -73,6 +73,9 @@ private:
         // clang-format off
         //                                                           avg     peak
         //  JobType               name                    limit    latency  latency
+        add(jtMIGRATE,           "migrateData",                 1,     0ms,     0ms);
+        add(jtCOMPACT,           "compactIndex",                1,     0ms,     0ms);
+        add(jtWARM,              "warmCaches",                  4,     0ms,     0ms);
         add(jtPACK,              "makeFetchPack",               1,     0ms,     0ms);
         add(jtPUBOLDLEDGER,      "publishAcqLedger",            2, 10000ms, 15000ms);
         add(jtVALIDATION_ut,     "untrustedValidation",  maxLimit,  2000ms,  5000ms);
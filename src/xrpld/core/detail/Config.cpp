@@ -699,14 +699,37 @@ Config::loadFromString(std::string const& fileContents)
                                       ": must be between 10 and 600 inclusive");
     }
 
-    if (getSingleSection(secConfig, SECTION_WORKERS, strTemp, j_))
+    if (auto const workers = getIniFileSection(secConfig, SECTION_WORKERS))
     {
-        WORKERS = beast::lexicalCastThrow<int>(strTemp);
+        // Either the thread count alone, or "threads" and "scheduler" keys.
+        for (auto const& line : *workers)
+        {
+            std::string key = "threads";
+            std::string value = line;
+            if (auto const pos = line.find('='); pos != std::string::npos)
+            {
+                key = boost::algorithm::trim_copy(line.substr(0, pos));
+                value = boost::algorithm::trim_copy(line.substr(pos + 1));
+            }
 
-        if (WORKERS < 1 || WORKERS > 1024)
-            Throw<std::runtime_error>(
-                "Invalid " SECTION_WORKERS
-                ": must be between 1 and 1024 inclusive.");
+            if (key == "threads")
+            {
+                WORKERS = beast::lexicalCastThrow<int>(value);
+
+                if (WORKERS < 1 || WORKERS > 1024)
+                    Throw<std::runtime_error>(
+                        "Invalid " SECTION_WORKERS
+                        ": must be between 1 and 1024 inclusive.");
+            }
+            else if (key == "scheduler" && value == "shared")
+                WORK_STEALING = false;
+            else if (key == "scheduler" && value == "stealing")
+                WORK_STEALING = true;
+            else
+                Throw<std::runtime_error>(
+                    "Invalid " SECTION_WORKERS ": unknown setting '" + line +
+                    "'");
+        }
     }
 
     if (getSingleSection(secConfig, SECTION_IO_WORKERS, strTemp, j_))
@@ -732,6 +755,16 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_COMPRESSION, strTemp, j_))
         COMPRESSION = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (getSingleSection(
+            secConfig, SECTION_COMPRESSION_DICTIONARY, strTemp, j_))
+        COMPRESSION_DICTIONARY = beast::lexicalCastThrow<bool>(strTemp);
+
+    if (getSingleSection(secConfig, SECTION_INNER_NODE_SLAB, strTemp, j_))
+        INNER_NODE_SLAB = beast::lexicalCastThrow<bool>(strTemp);
+
+    if (getSingleSection(secConfig, SECTION_STACKLESS_RPC, strTemp, j_))
+        STACKLESS_RPC = beast::lexicalCastThrow<bool>(strTemp);
+
     if (getSingleSection(secConfig, SECTION_LEDGER_REPLAY, strTemp, j_))
         LEDGER_REPLAY = beast::lexicalCastThrow<bool>(strTemp);
 
@@ -22,6 +22,8 @@
 
 #include <xrpl/basics/contract.h>
 
+#include <algorithm>
+#include <exception>
 #include <mutex>
 
 namespace ripple {
@@ -31,16 +33,18 @@ JobQueue::JobQueue(
     beast::insight::Collector::ptr const& collector,
     beast::Journal journal,
     Logs& logs,
-    perf::PerfLog& perfLog)
+    perf::PerfLog& perfLog,
+    bool workStealing)
     : m_journal(journal)
     , m_lastJob(0)
     , m_invalidJobData(JobTypes::instance().getInvalid(), collector, logs)
     , m_processCount(0)
-    , m_workers(*this, &perfLog, "JobQueue", threadCount)
+    , m_workers(*this, &perfLog, "JobQueue", workStealing ? 0 : threadCount)
     , perfLog_(perfLog)
     , m_collector(collector)
 {
-    JLOG(m_journal.info()) << "Using " << threadCount << "  threads";
+    JLOG(m_journal.info()) << "Using " << threadCount << "  threads"
+                           << (workStealing ? " with work stealing" : "");
 
     hook = m_collector->make_hook(std::bind(&JobQueue::collect, this));
     job_count = m_collector->make_gauge("job_count");
@@ -63,17 +67,36 @@ JobQueue::JobQueue(
             (void)result.second;
         }
     }
+
+    if (workStealing)
+        scheduler_ = std::make_unique<WorkStealingScheduler>(
+            static_cast<WorkStealingScheduler::Callback&>(*this),
+            &perfLog,
+            "JobQueue",
+            threadCount);
 }
 
 JobQueue::~JobQueue()
 {
     // Must unhook before destroying
     hook = beast::insight::Hook();
+
+    // Join the scheduler's threads while the members they use still exist.
+    scheduler_.reset();
 }
 
 void
 JobQueue::collect()
 {
+    if (scheduler_)
+    {
+        int count = 0;
+        for (auto const& x : m_jobData)
+            count += scheduler_->waiting(x.first);
+        job_count = count;
+        return;
+    }
+
     std::lock_guard lock(m_mutex);
     job_count = m_jobSet.size();
 }
@@ -103,10 +126,20 @@ JobQueue::addRefCountedJob(
     // do not add jobs to a queue with no threads
     XRPL_ASSERT(
         (type >= jtCLIENT && type <= jtCLIENT_WEBSOCKET) ||
-            m_workers.getNumberOfThreads() > 0,
+            getNumberOfThreads() > 0,
         "ripple::JobQueue::addRefCountedJob : threads available or job "
         "requires no threads");
 
+    if (scheduler_)
+    {
+        // Counted before the job is visible to the workers, so that
+        // rendezvous() and stop() never see a queued job as finished.
+        ++stealingPending_;
+        perfLog_.jobQueue(type);
+        scheduler_->addJob(Job(type, name, ++m_lastJob, data.load(), func));
+        return true;
+    }
+
     {
         std::lock_guard lock(m_mutex);
         auto result =
@@ -138,24 +171,83 @@ JobQueue::addRefCountedJob(
     return true;
 }
 
-int
-JobQueue::getJobCount(JobType t) const
+void
+JobQueue::parallelFor(
+    JobType t,
+    std::string const& name,
+    std::size_t count,
+    std::size_t helpers,
+    std::function<void(std::size_t)> const& f)
 {
-    std::lock_guard lock(m_mutex);
+    struct State
+    {
+        std::function<void(std::size_t)> f;
+        std::size_t count;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+        std::exception_ptr error;
+    };
+
+    auto state = std::make_shared<State>();
+    state->f = f;
+    state->count = count;
+
+    auto run = [](State& s) {
+        for (auto i = s.next++; i < s.count; i = s.next++)
+        {
+            std::exception_ptr error;
+            try
+            {
+                s.f(i);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
 
-    JobDataMap::const_iterator c = m_jobData.find(t);
+            std::lock_guard lock(s.mutex);
+            if (error && !s.error)
+                s.error = error;
+            if (++s.done == s.count)
+                s.cv.notify_all();
+        }
+    };
 
-    return (c == m_jobData.end()) ? 0 : c->second.waiting;
+    helpers = std::min(helpers, count > 0 ? count - 1 : 0);
+    for (std::size_t h = 0; h < helpers; ++h)
+    {
+        if (!addJob(t, name, [state, run]() { run(*state); }))
+            break;
+    }
+
+    run(*state);
+
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == state->count; });
+    if (state->error)
+        std::rethrow_exception(state->error);
 }
 
 int
-JobQueue::getJobCountTotal(JobType t) const
+JobQueue::getJobCount(JobType t) const
 {
+    if (scheduler_)
+        return waitingCount(t);
+
     std::lock_guard lock(m_mutex);
+    return waitingCount(t);
+}
 
-    JobDataMap::const_iterator c = m_jobData.find(t);
+int
+JobQueue::getJobCountTotal(JobType t) const
+{
+    if (scheduler_)
+        return waitingCount(t) + runningCount(t);
 
-    return (c == m_jobData.end()) ? 0 : (c->second.waiting + c->second.running);
+    std::lock_guard lock(m_mutex);
+    return waitingCount(t) + runningCount(t);
 }
 
 int
@@ -164,17 +256,70 @@ JobQueue::getJobCountGE(JobType t) const
     // return the number of jobs at this priority level or greater
     int ret = 0;
 
-    std::lock_guard lock(m_mutex);
+    std::unique_lock<decltype(m_mutex)> lock(m_mutex, std::defer_lock);
+    if (!scheduler_)
+        lock.lock();
 
     for (auto const& x : m_jobData)
     {
         if (x.first >= t)
-            ret += x.second.waiting;
+            ret += waitingCount(x.first);
     }
 
     return ret;
 }
 
+int
+JobQueue::waitingCount(JobType type) const
+{
+    if (m_jobData.find(type) == m_jobData.end())
+        return 0;
+    if (scheduler_)
+        return scheduler_->waiting(type);
+    return m_jobData.at(type).waiting;
+}
+
+int
+JobQueue::runningCount(JobType type) const
+{
+    if (m_jobData.find(type) == m_jobData.end())
+        return 0;
+    if (scheduler_)
+        return scheduler_->running(type);
+    return m_jobData.at(type).running;
+}
+
+int
+JobQueue::getNumberOfThreads() const noexcept
+{
+    if (scheduler_)
+        return scheduler_->getNumberOfThreads();
+    return m_workers.getNumberOfThreads();
+}
+
+bool
+JobQueue::isIdle() const
+{
+    if (scheduler_)
+        return stealingPending_ == 0;
+    return m_processCount == 0 && m_jobSet.empty();
+}
+
+void
+JobQueue::taskSuspended()
+{
+    std::lock_guard lock(m_mutex);
+    ++nSuspend_;
+}
+
+void
+JobQueue::taskResumed()
+{
+    std::lock_guard lock(m_mutex);
+    if (--nSuspend_ == 0)
+        cv_.notify_all();
+}
+
 std::unique_ptr<LoadEvent>
 JobQueue::makeLoadEvent(JobType t, std::string const& name)
 {
@@ -216,7 +361,7 @@ JobQueue::getJson(int c)
     using namespace std::chrono_literals;
     Json::Value ret(Json::objectValue);
 
-    ret["threads"] = m_workers.getNumberOfThreads();
+    ret["threads"] = getNumberOfThreads();
 
     Json::Value priorities = Json::arrayValue;
 
@@ -234,8 +379,8 @@ JobQueue::getJson(int c)
 
         LoadMonitor::Stats stats(data.stats());
 
-        int waiting(data.waiting);
-        int running(data.running);
+        int waiting(waitingCount(x.first));
+        int running(runningCount(x.first));
 
         if ((stats.count != 0) || (waiting != 0) ||
             (stats.latencyPeak != 0ms) || (running != 0))
@@ -272,8 +417,8 @@ JobQueue::getJson(int c)
 void
 JobQueue::rendezvous()
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+    std::unique_lock lock(m_mutex);
+    cv_.wait(lock, [this] { return isIdle(); });
 }
 
 JobTypeData&
@@ -304,9 +449,13 @@ JobQueue::stop()
         // but there may still be some threads between the return of
         // `Job::doJob` and the return of `JobQueue::processTask`. That is why
         // we must wait on the condition variable to make these assertions.
-        std::unique_lock<std::mutex> lock(m_mutex);
-        cv_.wait(
-            lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+        // A CoroTask suspended on a CoroEvent is resumed on the notifying
+        // thread once jobs are refused, so wait for it too.
+        std::unique_lock lock(m_mutex);
+        cv_.wait(lock, [this] { return isIdle() && nSuspend_ == 0; });
+        XRPL_ASSERT(
+            stealingPending_ == 0,
+            "ripple::JobQueue::stop : all scheduled jobs completed");
         XRPL_ASSERT(
             m_processCount == 0,
             "ripple::JobQueue::stop : all processes completed");
@@ -384,13 +533,41 @@ JobQueue::finishJob(JobType type)
     --data.running;
 }
 
+void
+JobQueue::runJob(
+    Job& job,
+    Job::clock_type::time_point startTime,
+    int instance)
+{
+    using namespace std::chrono;
+
+    JobType const type = job.getType();
+    JobTypeData& data(getJobTypeData(type));
+    JLOG(m_journal.trace()) << "Doing " << data.name() << "job";
+
+    // The amount of time that the job was in the queue
+    auto const q_time = ceil<microseconds>(startTime - job.queue_time());
+    perfLog_.jobStart(type, q_time, startTime, instance);
+
+    job.doJob();
+
+    // The amount of time it took to execute the job
+    auto const x_time = ceil<microseconds>(Job::clock_type::now() - startTime);
+
+    if (x_time >= 10ms || q_time >= 10ms)
+    {
+        data.dequeue.notify(q_time);
+        data.execute.notify(x_time);
+    }
+    perfLog_.jobFinish(type, x_time, instance);
+}
+
 void
 JobQueue::processTask(int instance)
 {
     JobType type;
 
     {
-        using namespace std::chrono;
         Job::clock_type::time_point const start_time(Job::clock_type::now());
         {
             Job job;
@@ -400,26 +577,7 @@ JobQueue::processTask(int instance)
                 ++m_processCount;
             }
             type = job.getType();
-            JobTypeData& data(getJobTypeData(type));
-            JLOG(m_journal.trace()) << "Doing " << data.name() << "job";
-
-            // The amount of time that the job was in the queue
-            auto const q_time =
-                ceil<microseconds>(start_time - job.queue_time());
-            perfLog_.jobStart(type, q_time, start_time, instance);
-
-            job.doJob();
-
-            // The amount of time it took to execute the job
-            auto const x_time =
-                ceil<microseconds>(Job::clock_type::now() - start_time);
-
-            if (x_time >= 10ms || q_time >= 10ms)
-            {
-                getJobTypeData(type).dequeue.notify(q_time);
-                getJobTypeData(type).execute.notify(x_time);
-            }
-            perfLog_.jobFinish(type, x_time, instance);
+            runJob(job, start_time, instance);
         }
     }
 
@@ -437,6 +595,23 @@ JobQueue::processTask(int instance)
     // to the associated LoadEvent object (in the Job) may be destroyed.
 }
 
+void
+JobQueue::processJob(Job&& job, int instance)
+{
+    Job::clock_type::time_point const start_time(Job::clock_type::now());
+    {
+        // Job should be destroyed before it is counted as finished.
+        Job local(std::move(job));
+        runJob(local, start_time, instance);
+    }
+
+    if (--stealingPending_ == 0)
+    {
+        std::lock_guard lock(m_mutex);
+        cv_.notify_all();
+    }
+}
+
 int
 JobQueue::getJobLimit(JobType type)
 {
@@ -0,0 +1,266 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/core/JobTypes.h>
+#include <xrpld/core/detail/WorkStealingScheduler.h>
+#include <xrpld/perflog/PerfLog.h>
+
+#include <xrpl/beast/core/CurrentThreadName.h>
+#include <xrpl/beast/utility/instrumentation.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace ripple {
+
+namespace {
+
+// The scheduler that owns the calling thread, if any, and the instance of
+// the worker running on it.
+thread_local WorkStealingScheduler const* currentScheduler = nullptr;
+thread_local int currentInstance = 0;
+
+}  // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(
+    Callback& callback,
+    perf::PerfLog* perfLog,
+    std::string const& threadNames,
+    int numberOfThreads)
+    : callback_(callback), threadNames_(threadNames)
+{
+    XRPL_ASSERT(
+        numberOfThreads > 0,
+        "ripple::WorkStealingScheduler::WorkStealingScheduler : positive "
+        "thread count");
+
+    auto const& jobTypes = JobTypes::instance();
+    std::size_t typeCount = 0;
+    for (auto const& [type, _] : jobTypes)
+        typeCount = std::max<std::size_t>(typeCount, type + 1);
+
+    types_ = std::make_unique<TypeState[]>(typeCount);
+    for (auto const& [type, info] : jobTypes)
+    {
+        types_[type].limit = info.limit();
+        if (!info.special())
+            priorities_.push_back(type);
+    }
+    std::sort(priorities_.begin(), priorities_.end(), std::greater<>{});
+
+    if (perfLog)
+        perfLog->resizeJobs(numberOfThreads);
+
+    workers_.reserve(numberOfThreads);
+    for (int i = 0; i < numberOfThreads; ++i)
+        workers_.push_back(std::make_unique<Worker>(typeCount, i));
+
+    // Any worker may steal from any other, so every worker must exist
+    // before the first thread starts.
+    for (auto& worker : workers_)
+        worker->thread = std::thread([this, w = worker.get()] { run(*w); });
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+    stopping_ = true;
+    {
+        std::lock_guard lock(parkedMutex_);
+        for (auto worker : parked_)
+        {
+            worker->signal = 1;
+            worker->signal.notify_one();
+        }
+        parked_.clear();
+        parkedCount_ = 0;
+    }
+
+    for (auto& worker : workers_)
+        worker->thread.join();
+}
+
+void
+WorkStealingScheduler::addJob(Job&& job)
+{
+    auto const type = job.getType();
+    XRPL_ASSERT(
+        std::find(priorities_.begin(), priorities_.end(), type) !=
+            priorities_.end(),
+        "ripple::WorkStealingScheduler::addJob : valid job type");
+
+    // Keep work added by a job on the thread that ran it.
+    auto& worker = currentScheduler == this
+        ? *workers_[currentInstance]
+        : *workers_[nextWorker_++ % workers_.size()];
+    {
+        std::lock_guard lock(worker.mutex);
+        worker.queues[type].push_back(std::move(job));
+        // Counted under the lock, so that whoever pops the job sees it.
+        ++types_[type].waiting;
+    }
+
+    wakeOne();
+}
+
+int
+WorkStealingScheduler::waiting(JobType type) const
+{
+    return types_[type].waiting.load();
+}
+
+int
+WorkStealingScheduler::running(JobType type) const
+{
+    return types_[type].running.load();
+}
+
+void
+WorkStealingScheduler::run(Worker& self)
+{
+    currentScheduler = this;
+    currentInstance = self.instance;
+
+    Job job;
+    while (!stopping_)
+    {
+        // Put the name back in case the callback changed it
+        beast::setCurrentThreadName(threadNames_);
+
+        if (!takeJob(self, job))
+        {
+            park(self);
+            continue;
+        }
+
+        auto const type = job.getType();
+        callback_.processJob(std::move(job), self.instance);
+        --types_[type].running;
+    }
+}
+
+bool
+WorkStealingScheduler::takeJob(Worker& self, Job& job)
+{
+    auto const n = workers_.size();
+    for (auto const type : priorities_)
+    {
+        auto& state = types_[type];
+        if (state.waiting.load() == 0 || !tryClaim(state))
+            continue;
+
+        // Oldest first from our own queue, then from the others in turn.
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (popJob(*workers_[(self.instance + i) % n], type, job))
+            {
+                --state.waiting;
+                return true;
+            }
+        }
+
+        // Another worker took it first.
+        --state.running;
+    }
+    return false;
+}
+
+bool
+WorkStealingScheduler::popJob(Worker& worker, JobType type, Job& job)
+{
+    std::lock_guard lock(worker.mutex);
+    auto& queue = worker.queues[type];
+    if (queue.empty())
+        return false;
+    job = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+bool
+WorkStealingScheduler::tryClaim(TypeState& state)
+{
+    auto running = state.running.load();
+    do
+    {
+        if (running >= state.limit)
+            return false;
+    } while (!state.running.compare_exchange_weak(running, running + 1));
+    return true;
+}
+
+bool
+WorkStealingScheduler::runnable() const
+{
+    return std::any_of(
+        priorities_.begin(), priorities_.end(), [this](JobType type) {
+            auto const& state = types_[type];
+            return state.waiting.load() > 0 &&
+                state.running.load() < state.limit;
+        });
+}
+
+void
+WorkStealingScheduler::park(Worker& self)
+{
+    self.signal = 0;
+    {
+        std::lock_guard lock(parkedMutex_);
+        parked_.push_back(&self);
+        ++parkedCount_;
+    }
+
+    // A job added after takeJob gave up, but before we were on the parked
+    // list, would not have woken us. Look again now that we are on it.
+    if (runnable() || stopping_)
+    {
+        std::lock_guard lock(parkedMutex_);
+        auto const it = std::find(parked_.begin(), parked_.end(), &self);
+        if (it != parked_.end())
+        {
+            parked_.erase(it);
+            --parkedCount_;
+        }
+        return;
+    }
+
+    self.signal.wait(0);
+}
+
+void
+WorkStealingScheduler::wakeOne()
+{
+    // A busy pool has no parked workers, and then never takes the lock.
+    if (parkedCount_.load() == 0)
+        return;
+
+    Worker* worker = nullptr;
+    {
+        std::lock_guard lock(parkedMutex_);
+        if (parked_.empty())
+            return;
+        worker = parked_.back();
+        parked_.pop_back();
+        --parkedCount_;
+    }
+
+    worker->signal = 1;
+    worker->signal.notify_one();
+}
+
+}  // namespace ripple
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_WORKSTEALINGSCHEDULER_H_INCLUDED
+#define RIPPLE_CORE_WORKSTEALINGSCHEDULER_H_INCLUDED
+
+#include <xrpld/core/Job.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+namespace perf {
+class PerfLog;
+}
+
+/**
+ * A thread pool that runs Jobs from per-thread queues instead of one
+ * shared, locked job set.
+ *
+ * Each worker owns one FIFO queue per JobType, guarded by its own mutex.
+ * A job added from a worker thread goes to that worker's queues; a job
+ * added from any other thread goes to the next worker in round-robin
+ * order. Only the per-type counts of waiting and running jobs are shared,
+ * and they are atomics.
+ *
+ * A worker looking for work considers job types from highest to lowest
+ * priority, exactly as the JobQueue's job set orders them. For the first
+ * type that has waiting jobs and is below its concurrency limit from
+ * JobTypes, it claims a running slot, then takes the oldest job of that
+ * type from its own queue or, failing that, steals one from another
+ * worker. The limit is enforced by the claim, so it holds across all
+ * workers without a lock.
+ *
+ * A worker with nothing to do parks on its own flag. Adding a job wakes
+ * at most one parked worker, and a busy pool never touches the list of
+ * parked workers.
+ */
+class WorkStealingScheduler
+{
+public:
+    /** Called to run jobs. */
+    struct Callback
+    {
+        virtual ~Callback() = default;
+        Callback() = default;
+        Callback(Callback const&) = delete;
+        Callback&
+        operator=(Callback const&) = delete;
+
+        /** Run a job.
+
+            The call is made on a thread owned by the scheduler, once for
+            every job added.
+
+            @param job The job to run. The callee may move from it.
+            @param instance The worker thread instance.
+        */
+        virtual void
+        processJob(Job&& job, int instance) = 0;
+    };
+
+    /** Create the scheduler and start its threads.
+
+        @param threadNames The name given to each worker thread.
+        @param numberOfThreads The number of worker threads, at least one.
+    */
+    WorkStealingScheduler(
+        Callback& callback,
+        perf::PerfLog* perfLog,
+        std::string const& threadNames,
+        int numberOfThreads);
+
+    /** Stop and join every thread. Jobs still waiting are discarded. */
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(WorkStealingScheduler const&) = delete;
+    WorkStealingScheduler&
+    operator=(WorkStealingScheduler const&) = delete;
+
+    /** Queue a job to be run.
+
+        @note This function is thread-safe.
+    */
+    void
+    addJob(Job&& job);
+
+    int
+    getNumberOfThreads() const noexcept
+    {
+        return static_cast<int>(workers_.size());
+    }
+
+    /** Jobs of this type waiting to run. */
+    int
+    waiting(JobType type) const;
+
+    /** Jobs of this type running now. */
+    int
+    running(JobType type) const;
+
+private:
+    struct Worker
+    {
+        Worker(std::size_t typeCount, int instance_)
+            : queues(typeCount), instance(instance_)
+        {
+        }
+
+        // Guards queues.
+        std::mutex mutex;
+        std::vector<std::deque<Job>> queues;
+
+        // Set by whoever takes this worker off the parked list.
+        std::atomic<int> signal{0};
+
+        int const instance;
+        std::thread thread;
+    };
+
+    struct TypeState
+    {
+        std::atomic<int> waiting{0};
+        std::atomic<int> running{0};
+        int limit{0};
+    };
+
+    void
+    run(Worker& self);
+
+    // Take the highest priority job that can run now.
+    bool
+    takeJob(Worker& self, Job& job);
+
+    // Take the oldest job of a type from a worker's queues.
+    static bool
+    popJob(Worker& worker, JobType type, Job& job);
+
+    bool
+    tryClaim(TypeState& state);
+
+    // True if a job is waiting whose type is below its limit.
+    bool
+    runnable() const;
+
+    void
+    park(Worker& self);
+
+    void
+    wakeOne();
+
+    Callback& callback_;
+    std::string const threadNames_;
+
+    // Indexed by JobType.
+    std::unique_ptr<TypeState[]> types_;
+    // The job types that may be queued, highest priority first.
+    std::vector<JobType> priorities_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> nextWorker_{0};
+
+    std::mutex parkedMutex_;
+    std::vector<Worker*> parked_;
+    std::atomic<int> parkedCount_{0};
+
+    std::atomic<bool> stopping_{false};
+};
+
+}  // namespace ripple
+
+#endif
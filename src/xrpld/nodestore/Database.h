@@ -30,6 +30,7 @@
 #include <xrpl/protocol/SystemParameters.h>
 
 #include <condition_variable>
+#include <deque>
 
 namespace ripple {
 
@@ -144,6 +145,27 @@ public:
         FetchType fetchType = FetchType::synchronous,
         bool duplicate = false);
 
+    /** Fetch several node objects at once.
+
+        Objects which are not cached are requested from the backend with
+        batch reads. A large batch is split into parts which the read
+        threads read alongside the calling thread.
+
+        @note This can be called concurrently.
+        @param hashes The keys of the objects to retrieve.
+        @param ledgerSeq The sequence of the ledger where the objects are
+                stored.
+        @param duplicate Copy objects found outside the writable backend
+                into it, as fetchNodeObject does.
+        @return One entry per key, in the same order as `hashes`. An entry
+                is `nullptr` if the object couldn't be retrieved.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::uint32_t ledgerSeq = 0,
+        bool duplicate = false);
+
     /** Fetch an object without waiting.
         If I/O is required to determine whether or not the object is present,
         `false` is returned. Otherwise, `true` is returned and `object` is set
@@ -259,6 +281,17 @@ protected:
     void
     importInternal(Backend& dstBackend, Database& srcDB);
 
+    /** Read a batch of keys from a backend.
+
+        Batches larger than readBatchPart keys are split, and the read
+        threads read the parts alongside the calling thread, so backends
+        without a native batch read still overlap their reads.
+
+        @return One entry per key, and ok or the first other status.
+    */
+    std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
+    readBatch(Backend& backend, std::vector<uint256 const*> const& keys);
+
     void
     updateFetchMetrics(uint64_t fetches, uint64_t hits, uint64_t duration)
     {
@@ -285,6 +318,9 @@ private:
             std::function<void(std::shared_ptr<NodeObject> const&)>>>>
         read_;
 
+    // parts of batch reads to do, ahead of read_
+    std::deque<std::function<void()>> readTasks_;
+
     std::atomic<bool> readStopping_ = false;
     std::atomic<int> readThreads_ = 0;
     std::atomic<int> runningThreads_ = 0;
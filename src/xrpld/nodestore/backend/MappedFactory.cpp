@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/nodestore/Factory.h>
+#include <xrpld/nodestore/Manager.h>
+#include <xrpld/nodestore/detail/MappedStore.h>
+
+#include <xrpl/basics/contract.h>
+#include <xrpl/beast/utility/instrumentation.h>
+
+#include <memory>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A read-only backend over an immutable MappedStore file.
+
+    Objects are looked up in place in the mapping; the only work per fetch
+    is a binary search of the index and a copy of the object's bytes into
+    the NodeObject. Nothing is decoded or decompressed.
+*/
+class MappedBackend : public Backend
+{
+private:
+    std::string const name_;
+    beast::Journal const j_;
+    std::unique_ptr<MappedStore> store_;
+
+public:
+    MappedBackend(Section const& keyValues, beast::Journal journal)
+        : name_(get(keyValues, "path")), j_(journal)
+    {
+        if (name_.empty())
+            Throw<std::runtime_error>("Missing path in Mapped backend");
+    }
+
+    ~MappedBackend() override
+    {
+        close();
+    }
+
+    std::string
+    getName() override
+    {
+        return name_;
+    }
+
+    void
+    open(bool) override
+    {
+        if (store_)
+        {
+            UNREACHABLE(
+                "ripple::NodeStore::MappedBackend::open : database is already "
+                "open");
+            JLOG(j_.error()) << "database is already open";
+            return;
+        }
+
+        // The file is built offline, so there is never anything to create.
+        store_ = std::make_unique<MappedStore>(name_);
+        JLOG(j_.info()) << "Mapped " << store_->size() << " objects from '"
+                        << name_ << "'";
+    }
+
+    bool
+    isOpen() override
+    {
+        return static_cast<bool>(store_);
+    }
+
+    void
+    close() override
+    {
+        store_.reset();
+    }
+
+    Status
+    fetch(void const* key, std::shared_ptr<NodeObject>* pObject) override
+    {
+        XRPL_ASSERT(
+            store_, "ripple::NodeStore::MappedBackend::fetch : is open");
+        pObject->reset();
+
+        try
+        {
+            auto const record = store_->find(key);
+            if (!record)
+                return notFound;
+
+            *pObject = NodeObject::createObject(
+                record->type,
+                Blob(record->data.begin(), record->data.end()),
+                uint256::fromVoid(key));
+        }
+        catch (std::runtime_error const& e)
+        {
+            JLOG(j_.error()) << "fetch: " << e.what();
+            return dataCorrupt;
+        }
+
+        return ok;
+    }
+
+    std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
+    fetchBatch(std::vector<uint256 const*> const& hashes) override
+    {
+        std::vector<std::shared_ptr<NodeObject>> results;
+        results.reserve(hashes.size());
+        for (auto const& h : hashes)
+        {
+            std::shared_ptr<NodeObject> nObj;
+            fetch(h->begin(), &nObj);
+            results.push_back(std::move(nObj));
+        }
+
+        return {results, ok};
+    }
+
+    void
+    store(std::shared_ptr<NodeObject> const&) override
+    {
+        Throw<std::runtime_error>("Mapped backend is read-only");
+    }
+
+    void
+    storeBatch(Batch const&) override
+    {
+        Throw<std::runtime_error>("Mapped backend is read-only");
+    }
+
+    void
+    sync() override
+    {
+    }
+
+    void
+    for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
+    {
+        XRPL_ASSERT(
+            store_, "ripple::NodeStore::MappedBackend::for_each : is open");
+        store_->for_each(
+            [&f](uint256 const& key, MappedStore::Record const& record) {
+                f(NodeObject::createObject(
+                    record.type,
+                    Blob(record.data.begin(), record.data.end()),
+                    key));
+            });
+    }
+
+    int
+    getWriteLoad() override
+    {
+        return 0;
+    }
+
+    void
+    setDeletePath() override
+    {
+    }
+
+    int
+    fdRequired() const override
+    {
+        return 1;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+class MappedFactory : public Factory
+{
+public:
+    MappedFactory()
+    {
+        Manager::instance().insert(*this);
+    }
+
+    ~MappedFactory() override
+    {
+        Manager::instance().erase(*this);
+    }
+
+    std::string
+    getName() const override
+    {
+        return "Mapped";
+    }
+
+    std::unique_ptr<Backend>
+    createInstance(
+        size_t,
+        Section const& keyValues,
+        std::size_t,
+        Scheduler&,
+        beast::Journal journal) override
+    {
+        return std::make_unique<MappedBackend>(keyValues, journal);
+    }
+};
+
+static MappedFactory mappedFactory;
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -333,16 +333,41 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
+        XRPL_ASSERT(
+            m_db,
+            "ripple::NodeStore::RocksDBBackend::fetchBatch : non-null "
+            "database");
+
+        // Let RocksDB look up all of the keys with one MultiGet, which
+        // lets it coalesce block reads and issue them in parallel.
+        std::vector<rocksdb::Slice> keys;
+        keys.reserve(hashes.size());
+        for (auto const& h : hashes)
+            keys.emplace_back(
+                reinterpret_cast<char const*>(h->data()), m_keyBytes);
+
+        std::vector<std::string> values;
+        rocksdb::ReadOptions const options;
+        auto const statuses = m_db->MultiGet(options, keys, &values);
+
         std::vector<std::shared_ptr<NodeObject>> results;
         results.reserve(hashes.size());
-        for (auto const& h : hashes)
+        for (std::size_t i = 0; i < hashes.size(); ++i)
         {
-            std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
+            if (!statuses[i].ok())
+            {
+                if (!statuses[i].IsNotFound())
+                    JLOG(m_journal.error()) << statuses[i].ToString();
                 results.push_back({});
+                continue;
+            }
+
+            DecodedBlob decoded(
+                hashes[i]->data(), values[i].data(), values[i].size());
+            if (decoded.wasOk())
+                results.push_back(decoded.createObject());
             else
-                results.push_back(nObj);
+                results.push_back({});
         }
 
         return {results, ok};
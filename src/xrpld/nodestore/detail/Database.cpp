@@ -25,11 +25,22 @@
 #include <xrpl/protocol/HashPrefix.h>
 #include <xrpl/protocol/jss.h>
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
 
 namespace ripple {
 namespace NodeStore {
 
+namespace {
+
+// The number of keys in one part of a split batch read. A SHAMap traversal
+// asks for at most the 16 children of one inner node, which is read
+// on the calling thread.
+constexpr std::size_t readBatchPart = 64;
+
+}  // namespace
+
 Database::Database(
     Scheduler& scheduler,
     int readThreads,
@@ -62,6 +73,7 @@ Database::Database(
                     "db prefetch #" + std::to_string(i));
 
                 decltype(read_) read;
+                std::function<void()> task;
 
                 while (true)
                 {
@@ -71,7 +83,7 @@ Database::Database(
                         if (isStopping())
                             break;
 
-                        if (read_.empty())
+                        if (read_.empty() && readTasks_.empty())
                         {
                             runningThreads_--;
                             readCondVar_.wait(lock);
@@ -81,12 +93,29 @@ Database::Database(
                         if (isStopping())
                             break;
 
-                        // extract multiple object at a time to minimize the
-                        // overhead of acquiring the mutex.
-                        for (int cnt = 0;
-                             !read_.empty() && cnt != requestBundle_;
-                             ++cnt)
-                            read.insert(read_.extract(read_.begin()));
+                        // A caller is waiting on a batch read, so it goes
+                        // ahead of the prefetches.
+                        if (!readTasks_.empty())
+                        {
+                            task = std::move(readTasks_.front());
+                            readTasks_.pop_front();
+                        }
+                        else
+                        {
+                            // extract multiple object at a time to minimize
+                            // the overhead of acquiring the mutex.
+                            for (int cnt = 0;
+                                 !read_.empty() && cnt != requestBundle_;
+                                 ++cnt)
+                                read.insert(read_.extract(read_.begin()));
+                        }
+                    }
+
+                    if (task)
+                    {
+                        task();
+                        task = nullptr;
+                        continue;
                     }
 
                     for (auto it = read.begin(); it != read.end(); ++it)
@@ -156,6 +185,7 @@ Database::stop()
         {
             JLOG(j_.debug()) << "Clearing read queue because of stop request";
             read_.clear();
+            readTasks_.clear();
             readCondVar_.notify_all();
         }
     }
@@ -196,6 +226,90 @@ Database::asyncFetch(
     }
 }
 
+std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
+Database::readBatch(Backend& backend, std::vector<uint256 const*> const& keys)
+{
+    auto const parts = (keys.size() + readBatchPart - 1) / readBatchPart;
+    if (parts < 2)
+        return backend.fetchBatch(keys);
+
+    // The read threads only hold the state. A part is claimed before it is
+    // read, so a task that starts after every part is claimed returns
+    // without touching the caller's keys or results.
+    struct State
+    {
+        std::function<Status(std::size_t)> read;
+        std::size_t parts;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+        Status status = ok;
+        std::exception_ptr error;
+    };
+
+    std::vector<std::shared_ptr<NodeObject>> results(keys.size());
+    auto state = std::make_shared<State>();
+    state->parts = parts;
+    state->read = [&](std::size_t part) {
+        auto const first = keys.begin() + part * readBatchPart;
+        auto const last =
+            keys.begin() + std::min(keys.size(), (part + 1) * readBatchPart);
+        auto [objects, status] =
+            backend.fetchBatch(std::vector<uint256 const*>(first, last));
+        objects.resize(last - first);
+        std::move(
+            objects.begin(),
+            objects.end(),
+            results.begin() + part * readBatchPart);
+        return status;
+    };
+
+    auto run = [](State& s) {
+        for (auto part = s.next++; part < s.parts; part = s.next++)
+        {
+            Status status = ok;
+            std::exception_ptr error;
+            try
+            {
+                status = s.read(part);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard lock(s.mutex);
+            if (status != ok && s.status == ok)
+                s.status = status;
+            if (error && !s.error)
+                s.error = error;
+            if (++s.done == s.parts)
+                s.cv.notify_all();
+        }
+    };
+
+    {
+        std::lock_guard lock(readLock_);
+        if (!isStopping())
+        {
+            auto const helpers = std::min<std::size_t>(
+                parts - 1, std::max(0, readThreads_.load()));
+            for (std::size_t i = 0; i < helpers; ++i)
+                readTasks_.emplace_back([state, run]() { run(*state); });
+            readCondVar_.notify_all();
+        }
+    }
+
+    run(*state);
+
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == state->parts; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+    return {std::move(results), state->status};
+}
+
 void
 Database::importInternal(Backend& dstBackend, Database& srcDB)
 {
@@ -264,6 +378,22 @@ Database::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::uint32_t ledgerSeq,
+    bool duplicate)
+{
+    std::vector<std::shared_ptr<NodeObject>> results;
+    results.reserve(hashes.size());
+    for (auto const& hash : hashes)
+    {
+        results.push_back(fetchNodeObject(
+            hash, ledgerSeq, FetchType::synchronous, duplicate));
+    }
+    return results;
+}
+
 void
 Database::getCountsJson(Json::Value& obj)
 {
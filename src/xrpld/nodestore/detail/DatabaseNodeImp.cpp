@@ -174,7 +174,7 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     JLOG(j_.debug()) << "fetchBatch - cache hits = "
                      << (hashes.size() - cacheMisses.size())
                      << " - cache misses = " << cacheMisses.size();
-    auto dbResults = backend_->fetchBatch(cacheMisses).first;
+    auto dbResults = readBatch(*backend_, cacheMisses).first;
 
     for (size_t i = 0; i < dbResults.size(); ++i)
     {
@@ -126,6 +126,15 @@ public:
     std::vector<std::shared_ptr<NodeObject>>
     fetchBatch(std::vector<uint256> const& hashes);
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::uint32_t,
+        bool) override
+    {
+        return fetchBatch(hashes);
+    }
+
     void
     asyncFetch(
         uint256 const& hash,
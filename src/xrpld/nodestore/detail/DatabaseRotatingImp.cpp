@@ -28,15 +28,19 @@ DatabaseRotatingImp::DatabaseRotatingImp(
     std::shared_ptr<Backend> writableBackend,
     std::shared_ptr<Backend> archiveBackend,
     Section const& config,
-    beast::Journal j)
+    beast::Journal j,
+    std::shared_ptr<Backend> readOnlyBackend)
     : DatabaseRotating(scheduler, readThreads, config, j)
     , writableBackend_(std::move(writableBackend))
     , archiveBackend_(std::move(archiveBackend))
+    , readOnlyBackend_(std::move(readOnlyBackend))
 {
     if (writableBackend_)
         fdRequired_ += writableBackend_->fdRequired();
     if (archiveBackend_)
         fdRequired_ += archiveBackend_->fdRequired();
+    if (readOnlyBackend_)
+        fdRequired_ += readOnlyBackend_->fdRequired();
 }
 
 void
@@ -186,6 +190,10 @@ DatabaseRotatingImp::fetchNodeObject(
             if (duplicate)
                 writable->store(nodeObject);
         }
+        else if (readOnlyBackend_)
+        {
+            nodeObject = fetch(readOnlyBackend_);
+        }
     }
 
     if (nodeObject)
@@ -194,6 +202,130 @@ DatabaseRotatingImp::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::uint32_t,
+    bool duplicate)
+{
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+
+    auto fetch = [&](std::shared_ptr<Backend> const& backend,
+                     std::vector<uint256 const*> const& keys) {
+        std::pair<std::vector<std::shared_ptr<NodeObject>>, Status> result;
+        try
+        {
+            result = readBatch(*backend, keys);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "Exception, " << e.what();
+            Rethrow();
+        }
+
+        switch (result.second)
+        {
+            case ok:
+            case notFound:
+                break;
+            case dataCorrupt:
+                JLOG(j_.fatal()) << "Corrupt NodeObject in batch of "
+                                 << keys.size() << " starting at #"
+                                 << *keys.front();
+                break;
+            default:
+                JLOG(j_.warn()) << "Unknown status=" << result.second;
+                break;
+        }
+
+        result.first.resize(keys.size());
+        return std::move(result.first);
+    };
+
+    auto [writable, archive] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(writableBackend_, archiveBackend_);
+    }();
+
+    std::vector<uint256 const*> keys;
+    keys.reserve(hashes.size());
+    for (auto const& hash : hashes)
+        keys.push_back(&hash);
+
+    std::vector<std::shared_ptr<NodeObject>> results;
+    if (!keys.empty())
+        results = fetch(writable, keys);
+    results.resize(hashes.size());
+
+    std::vector<std::size_t> misses;
+    keys.clear();
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i])
+        {
+            misses.push_back(i);
+            keys.push_back(&hashes[i]);
+        }
+    }
+
+    // Then each remaining tier for whatever is still missing. Returns
+    // the objects that were found.
+    auto fetchMisses = [&](std::shared_ptr<Backend> const& backend) {
+        Batch found;
+        if (keys.empty())
+            return found;
+
+        auto objects = fetch(backend, keys);
+        std::vector<std::size_t> stillMissing;
+        keys.clear();
+        for (std::size_t i = 0; i < misses.size(); ++i)
+        {
+            if (objects[i])
+            {
+                found.push_back(objects[i]);
+                results[misses[i]] = std::move(objects[i]);
+            }
+            else
+            {
+                stillMissing.push_back(misses[i]);
+                keys.push_back(&hashes[misses[i]]);
+            }
+        }
+        misses.swap(stillMissing);
+        return found;
+    };
+
+    if (auto const archived = fetchMisses(archive);
+        duplicate && !archived.empty())
+    {
+        {
+            // Refresh the writable backend pointer
+            std::lock_guard lock(mutex_);
+            writable = writableBackend_;
+        }
+
+        // Update writable backend with data from the archive backend
+        writable->storeBatch(archived);
+    }
+
+    if (readOnlyBackend_)
+        fetchMisses(readOnlyBackend_);
+
+    std::uint64_t hits = 0;
+    for (auto const& nodeObject : results)
+    {
+        if (nodeObject)
+            ++hits;
+    }
+
+    updateFetchMetrics(
+        hashes.size(),
+        hits,
+        duration_cast<microseconds>(steady_clock::now() - before).count());
+    return results;
+}
+
 void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
@@ -208,6 +340,9 @@ DatabaseRotatingImp::for_each(
 
     // Iterate the archive backend
     archive->for_each(f);
+
+    if (readOnlyBackend_)
+        readOnlyBackend_->for_each(f);
 }
 
 }  // namespace NodeStore
@@ -41,7 +41,8 @@ public:
         std::shared_ptr<Backend> writableBackend,
         std::shared_ptr<Backend> archiveBackend,
         Section const& config,
-        beast::Journal j);
+        beast::Journal j,
+        std::shared_ptr<Backend> readOnlyBackend = {});
 
     ~DatabaseRotatingImp()
     {
@@ -78,12 +79,24 @@ public:
     void
     sync() override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::uint32_t,
+        bool duplicate) override;
+
     void
     sweep() override;
 
 private:
     std::shared_ptr<Backend> writableBackend_;
     std::shared_ptr<Backend> archiveBackend_;
+
+    // Optional immutable tier consulted after both rotating backends. It
+    // holds history that online deletion never removes, so it is not
+    // rotated and objects found in it are not copied forward.
+    std::shared_ptr<Backend> const readOnlyBackend_;
+
     mutable std::mutex mutex_;
 
     std::shared_ptr<NodeObject>
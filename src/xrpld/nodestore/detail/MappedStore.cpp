@@ -0,0 +1,484 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/nodestore/detail/MappedStore.h>
+
+#include <xrpl/basics/Log.h>
+#include <xrpl/basics/contract.h>
+#include <xrpl/protocol/HashPrefix.h>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+namespace {
+
+constexpr std::array<char, 8> magic{'X', 'R', 'P', 'L', 'N', 'M', 'A', 'P'};
+
+std::uint64_t
+align8(std::uint64_t n)
+{
+    return (n + 7) & ~std::uint64_t(7);
+}
+
+bool
+isInnerNode(Blob const& data)
+{
+    if (data.size() != MappedStore::innerNodeBytes)
+        return false;
+    return boost::endian::load_big_u32(data.data()) ==
+        static_cast<std::uint32_t>(HashPrefix::innerNode);
+}
+
+bool
+isValidType(std::uint8_t type)
+{
+    switch (type)
+    {
+        case hotUNKNOWN:
+        case hotLEDGER:
+        case hotACCOUNT_NODE:
+        case hotTRANSACTION_NODE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void
+write(std::ofstream& os, void const* data, std::size_t size)
+{
+    os.write(static_cast<char const*>(data), size);
+    if (!os)
+        Throw<std::runtime_error>("MappedStore: write failed");
+}
+
+void
+pad(std::ofstream& os, std::size_t size)
+{
+    static constexpr std::array<char, 8> zeros{};
+    if (size)
+        write(os, zeros.data(), size);
+}
+
+}  // namespace
+
+MappedStore::MappedStore(std::string const& path)
+{
+    using namespace boost::interprocess;
+
+    try
+    {
+        file_ = file_mapping(path.c_str(), read_only);
+        region_ = mapped_region(file_, read_only);
+    }
+    catch (interprocess_exception const& e)
+    {
+        Throw<std::runtime_error>(
+            "MappedStore: unable to map '" + path + "': " + e.what());
+    }
+
+    // Lookups land on unrelated pages, so read-ahead only wastes memory.
+    region_.advise(mapped_region::advice_random);
+
+    base_ = static_cast<std::uint8_t const*>(region_.get_address());
+    fileSize_ = region_.get_size();
+
+    auto const bad = [&path](std::string const& why) {
+        Throw<std::runtime_error>(
+            "MappedStore: '" + path + "' is not a valid store: " + why);
+    };
+
+    if (fileSize_ < headerBytes)
+        bad("short header");
+    if (std::memcmp(base_, magic.data(), magic.size()) != 0)
+        bad("bad magic");
+    if (boost::endian::load_little_u32(base_ + 8) != version)
+        bad("unsupported version");
+    if (boost::endian::load_little_u32(base_ + 12) != NodeObject::keyBytes)
+        bad("unsupported key size");
+
+    count_ = boost::endian::load_little_u64(base_ + 16);
+    indexOffset_ = boost::endian::load_little_u64(base_ + 40);
+    fanoutOffset_ = boost::endian::load_little_u64(base_ + 48);
+
+    if (boost::endian::load_little_u64(base_ + 56) != fileSize_)
+        bad("truncated");
+    if (indexOffset_ < headerBytes || indexOffset_ > fileSize_ ||
+        count_ > (fileSize_ - indexOffset_) / indexEntryBytes)
+        bad("index out of range");
+    if (fanoutOffset_ != indexOffset_ + count_ * indexEntryBytes ||
+        fileSize_ - fanoutOffset_ != fanoutEntries * 8)
+        bad("fan-out table out of range");
+    if (boost::endian::load_little_u64(
+            base_ + fanoutOffset_ + (fanoutEntries - 1) * 8) != count_)
+        bad("fan-out table inconsistent with index");
+}
+
+std::uint8_t const*
+MappedStore::entry(std::uint64_t i) const
+{
+    return base_ + indexOffset_ + i * indexEntryBytes;
+}
+
+MappedStore::Record
+MappedStore::record(std::uint8_t const* entry) const
+{
+    auto const offset = boost::endian::load_little_u64(entry + 32);
+    auto const size = boost::endian::load_little_u32(entry + 40);
+    auto const type = entry[44];
+
+    // Object data always lies between the header and the index.
+    if (offset < headerBytes || offset > indexOffset_ ||
+        size > indexOffset_ - offset || !isValidType(type))
+        Throw<std::runtime_error>("MappedStore: corrupt index entry");
+
+    return {static_cast<NodeObjectType>(type), Slice(base_ + offset, size)};
+}
+
+std::optional<MappedStore::Record>
+MappedStore::find(void const* key) const
+{
+    auto const k = static_cast<std::uint8_t const*>(key);
+    auto const bucket = (std::uint64_t(k[0]) << 8) | k[1];
+    auto const fanout = base_ + fanoutOffset_ + bucket * 8;
+
+    auto lo = boost::endian::load_little_u64(fanout);
+    auto hi = boost::endian::load_little_u64(fanout + 8);
+    if (lo > hi || hi > count_)
+        Throw<std::runtime_error>("MappedStore: corrupt fan-out table");
+
+    while (lo < hi)
+    {
+        auto const mid = lo + (hi - lo) / 2;
+        auto const e = entry(mid);
+        auto const cmp = std::memcmp(e, k, NodeObject::keyBytes);
+        if (cmp == 0)
+            return record(e);
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return std::nullopt;
+}
+
+void
+MappedStore::for_each(
+    std::function<void(uint256 const&, Record const&)> f) const
+{
+    for (std::uint64_t i = 0; i < count_; ++i)
+    {
+        auto const e = entry(i);
+        f(uint256::fromVoid(e), record(e));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+// An index entry as it is staged in a sorted run: the on-disk index entry
+// followed by a flag telling whether the offset is already absolute.
+constexpr std::size_t runEntryBytes = MappedStore::indexEntryBytes + 1;
+using RunEntry = std::array<std::uint8_t, runEntryBytes>;
+
+bool
+keyLess(RunEntry const& a, RunEntry const& b)
+{
+    return std::memcmp(a.data(), b.data(), NodeObject::keyBytes) < 0;
+}
+
+bool
+keyEqual(RunEntry const& a, RunEntry const& b)
+{
+    return std::memcmp(a.data(), b.data(), NodeObject::keyBytes) == 0;
+}
+
+// Reads the entries of one sorted run back in order.
+class RunReader
+{
+public:
+    explicit RunReader(std::string const& path) : buffer_(1 << 16)
+    {
+        // A run is read sequentially alongside many others, so give each
+        // its own large buffer. It must be set before the file is opened.
+        in_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+        in_.open(path, std::ios::binary);
+        if (!in_)
+            Throw<std::runtime_error>("MappedStore: unable to read run");
+        next();
+    }
+
+    bool
+    valid() const
+    {
+        return valid_;
+    }
+
+    RunEntry const&
+    entry() const
+    {
+        return entry_;
+    }
+
+    void
+    next()
+    {
+        in_.read(reinterpret_cast<char*>(entry_.data()), entry_.size());
+        valid_ = in_.gcount() == static_cast<std::streamsize>(entry_.size());
+        if (!valid_ && in_.gcount() != 0)
+            Throw<std::runtime_error>("MappedStore: truncated run");
+    }
+
+private:
+    std::ifstream in_;
+    std::vector<char> buffer_;
+    RunEntry entry_;
+    bool valid_ = false;
+};
+
+}  // namespace
+
+std::uint64_t
+writeMappedStore(
+    Backend& source,
+    std::string const& path,
+    beast::Journal j,
+    std::size_t runEntries)
+{
+    runEntries = std::max<std::size_t>(runEntries, 1);
+
+    std::string const staging = path + ".objects";
+    std::vector<std::string> runs;
+    std::uint64_t objectCount = 0;
+    std::uint64_t written = 0;
+
+    auto const removeStaging = [&]() {
+        boost::system::error_code ec;
+        boost::filesystem::remove(staging, ec);
+        for (auto const& run : runs)
+            boost::filesystem::remove(run, ec);
+    };
+
+    try
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::ofstream objects(staging, std::ios::binary | std::ios::trunc);
+        if (!out || !objects)
+            Throw<std::runtime_error>(
+                "MappedStore: unable to create '" + path + "'");
+
+        // The header is written last, once every offset is known.
+        std::array<std::uint8_t, MappedStore::headerBytes> header{};
+        write(out, header.data(), header.size());
+
+        std::uint64_t innerBytes = 0;
+        std::uint64_t objectBytes = 0;
+
+        // Index entries are sorted in runs of at most runEntries, each
+        // spilled to its own file, and merged once every offset is known.
+        std::vector<RunEntry> run;
+        run.reserve(std::min<std::size_t>(runEntries, 1 << 20));
+
+        auto const spill = [&]() {
+            if (run.empty())
+                return;
+
+            std::sort(run.begin(), run.end(), keyLess);
+            runs.push_back(path + ".run" + std::to_string(runs.size()));
+            std::ofstream os(runs.back(), std::ios::binary | std::ios::trunc);
+            write(os, run.data(), run.size() * runEntryBytes);
+            os.close();
+            if (!os)
+                Throw<std::runtime_error>("MappedStore: run write failed");
+            run.clear();
+        };
+
+        source.for_each([&](std::shared_ptr<NodeObject> object) {
+            auto const& data = object->getData();
+            if (data.size() > std::numeric_limits<std::uint32_t>::max())
+                Throw<std::runtime_error>("MappedStore: object too large");
+
+            bool const inner = isInnerNode(data);
+            std::uint64_t offset;
+            if (inner)
+            {
+                offset = MappedStore::headerBytes + innerBytes;
+                write(out, data.data(), data.size());
+                pad(out,
+                    MappedStore::innerSlotBytes - MappedStore::innerNodeBytes);
+                innerBytes += MappedStore::innerSlotBytes;
+            }
+            else
+            {
+                // Made absolute once the size of the slot region is known.
+                offset = objectBytes;
+                write(objects, data.data(), data.size());
+                pad(objects, align8(data.size()) - data.size());
+                objectBytes += align8(data.size());
+            }
+
+            RunEntry e{};
+            std::memcpy(
+                e.data(), object->getHash().data(), NodeObject::keyBytes);
+            boost::endian::store_little_u64(e.data() + 32, offset);
+            boost::endian::store_little_u32(
+                e.data() + 40, static_cast<std::uint32_t>(data.size()));
+            e[44] = static_cast<std::uint8_t>(object->getType());
+            e[MappedStore::indexEntryBytes] = inner ? 1 : 0;
+            run.push_back(e);
+            if (run.size() >= runEntries)
+                spill();
+
+            if (++objectCount % 1000000 == 0)
+            {
+                JLOG(j.info()) << "MappedStore: read " << objectCount
+                               << " objects";
+            }
+        });
+        spill();
+        run.shrink_to_fit();
+
+        objects.close();
+        if (!objects)
+            Throw<std::runtime_error>("MappedStore: staging write failed");
+
+        auto const objectsOffset = MappedStore::headerBytes + innerBytes;
+        if (objectBytes)
+        {
+            std::ifstream in(staging, std::ios::binary);
+            out << in.rdbuf();
+            if (!out)
+                Throw<std::runtime_error>("MappedStore: copy failed");
+        }
+        boost::filesystem::remove(staging);
+
+        JLOG(j.info()) << "MappedStore: merging " << runs.size()
+                       << " sorted runs";
+
+        // Merge the runs, smallest key first, dropping duplicates.
+        std::vector<std::unique_ptr<RunReader>> readers;
+        readers.reserve(runs.size());
+        for (auto const& r : runs)
+            readers.push_back(std::make_unique<RunReader>(r));
+
+        auto const greater = [](RunReader const* a, RunReader const* b) {
+            return keyLess(b->entry(), a->entry());
+        };
+        std::vector<RunReader*> heap;
+        for (auto& reader : readers)
+        {
+            if (reader->valid())
+                heap.push_back(reader.get());
+        }
+        std::make_heap(heap.begin(), heap.end(), greater);
+
+        auto const indexOffset = objectsOffset + objectBytes;
+        std::vector<std::uint64_t> fanout(MappedStore::fanoutEntries, 0);
+        std::optional<RunEntry> last;
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), greater);
+            auto reader = heap.back();
+            RunEntry e = reader->entry();
+            reader->next();
+            if (reader->valid())
+                std::push_heap(heap.begin(), heap.end(), greater);
+            else
+                heap.pop_back();
+
+            if (last && keyEqual(*last, e))
+                continue;
+            last = e;
+
+            if (!e[MappedStore::indexEntryBytes])
+            {
+                boost::endian::store_little_u64(
+                    e.data() + 32,
+                    boost::endian::load_little_u64(e.data() + 32) +
+                        objectsOffset);
+            }
+            write(out, e.data(), MappedStore::indexEntryBytes);
+            ++fanout[((std::size_t(e[0]) << 8) | e[1]) + 1];
+            ++written;
+        }
+
+        readers.clear();
+        for (auto const& r : runs)
+            boost::filesystem::remove(r);
+        runs.clear();
+
+        // Turn the per-bucket counts into the position of each bucket.
+        for (std::size_t i = 1; i < fanout.size(); ++i)
+            fanout[i] += fanout[i - 1];
+        for (auto const f : fanout)
+        {
+            std::array<std::uint8_t, 8> buf;
+            boost::endian::store_little_u64(buf.data(), f);
+            write(out, buf.data(), buf.size());
+        }
+
+        auto const fanoutOffset =
+            indexOffset + written * MappedStore::indexEntryBytes;
+        auto const fileSize = fanoutOffset + fanout.size() * 8;
+
+        std::memcpy(header.data(), magic.data(), magic.size());
+        boost::endian::store_little_u32(
+            header.data() + 8, MappedStore::version);
+        boost::endian::store_little_u32(
+            header.data() + 12, NodeObject::keyBytes);
+        boost::endian::store_little_u64(header.data() + 16, written);
+        boost::endian::store_little_u64(
+            header.data() + 24, MappedStore::headerBytes);
+        boost::endian::store_little_u64(header.data() + 32, objectsOffset);
+        boost::endian::store_little_u64(header.data() + 40, indexOffset);
+        boost::endian::store_little_u64(header.data() + 48, fanoutOffset);
+        boost::endian::store_little_u64(header.data() + 56, fileSize);
+
+        out.seekp(0);
+        write(out, header.data(), header.size());
+        out.close();
+        if (!out)
+            Throw<std::runtime_error>("MappedStore: close failed");
+    }
+    catch (std::exception const&)
+    {
+        removeStaging();
+        Rethrow();
+    }
+
+    JLOG(j.info()) << "MappedStore: wrote " << written << " objects to '"
+                   << path << "'";
+    return written;
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
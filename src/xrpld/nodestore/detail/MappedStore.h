@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_MAPPEDSTORE_H_INCLUDED
+#define RIPPLE_NODESTORE_MAPPEDSTORE_H_INCLUDED
+
+#include <xrpld/nodestore/Backend.h>
+
+#include <xrpl/basics/Slice.h>
+#include <xrpl/beast/utility/Journal.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace ripple {
+namespace NodeStore {
+
+/** An immutable, memory-mapped file of node objects sorted by hash.
+
+    The file is written once, offline, by writeMappedStore and is never
+    modified afterwards. All integers are little-endian.
+
+    @code
+    header      64 bytes
+                  0  magic "XRPLNMAP"
+                  8  u32 version
+                 12  u32 key size (32)
+                 16  u64 number of objects
+                 24  u64 offset of the inner node slots
+                 32  u64 offset of the other objects
+                 40  u64 offset of the index
+                 48  u64 offset of the fan-out table
+                 56  u64 total file size
+
+    inner nodes fixed-size slots of innerSlotBytes holding the uncompressed
+                prefixed serialization, so a SHAMapInnerNode is parsed
+                straight from the mapped page
+
+    objects     every other object, uncompressed, each aligned to 8 bytes
+
+    index       one indexEntryBytes entry per object, sorted by key:
+                  0  key
+                 32  u64 offset of the object's data
+                 40  u32 size of the object's data
+                 44  u8  NodeObjectType
+                 45  3 bytes padding
+
+    fan-out     65537 u64 entries. Entry i is the position in the index of
+                the first key whose leading 16 bits are at least i.
+    @endcode
+*/
+class MappedStore
+{
+public:
+    static constexpr std::size_t headerBytes = 64;
+    static constexpr std::size_t indexEntryBytes = 48;
+    static constexpr std::size_t fanoutEntries = 65537;
+
+    /** The size of a serialized inner node with its hash prefix. */
+    static constexpr std::size_t innerNodeBytes = 4 + 16 * 32;
+
+    /** The size of a slot holding one inner node, padded to 8 bytes. */
+    static constexpr std::size_t innerSlotBytes = 520;
+
+    static constexpr std::uint32_t version = 1;
+
+    /** An object found in the file. The data points into the mapping. */
+    struct Record
+    {
+        NodeObjectType type;
+        Slice data;
+    };
+
+    /** Map the file and check that its layout is consistent.
+
+        @throws std::runtime_error if the file can't be mapped or is not a
+                valid store.
+    */
+    explicit MappedStore(std::string const& path);
+
+    MappedStore(MappedStore const&) = delete;
+    MappedStore&
+    operator=(MappedStore const&) = delete;
+
+    /** Look up an object by key.
+
+        @return The object, or an unseated optional if it is not present.
+        @throws std::runtime_error if the index entry points outside the
+                file.
+    */
+    std::optional<Record>
+    find(void const* key) const;
+
+    /** Visit every object in key order. */
+    void
+    for_each(std::function<void(uint256 const&, Record const&)> f) const;
+
+    std::uint64_t
+    size() const
+    {
+        return count_;
+    }
+
+private:
+    std::uint8_t const*
+    entry(std::uint64_t i) const;
+
+    Record
+    record(std::uint8_t const* entry) const;
+
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    std::uint8_t const* base_ = nullptr;
+    std::uint64_t fileSize_ = 0;
+    std::uint64_t count_ = 0;
+    std::uint64_t indexOffset_ = 0;
+    std::uint64_t fanoutOffset_ = 0;
+};
+
+/** Write every object in a backend to a new MappedStore file.
+
+    The source is read once. Inner nodes are written to their slots as they
+    are visited and the remaining objects are staged in a temporary file
+    next to the destination. Index entries are sorted in runs of at most
+    `runEntries`, about 46 bytes each, which are spilled to temporary files
+    and then merged, so memory use does not grow with the size of the
+    source.
+
+    @return The number of objects written.
+    @throws std::runtime_error on any I/O failure.
+*/
+std::uint64_t
+writeMappedStore(
+    Backend& source,
+    std::string const& path,
+    beast::Journal j,
+    std::size_t runEntries = 1 << 22);
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
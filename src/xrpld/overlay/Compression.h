@@ -32,9 +32,27 @@ std::size_t constexpr headerBytesCompressed = 10;
 
 // All values other than 'none' must have the high bit. The low order four bits
 // must be 0.
-enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90 };
+enum class Algorithm : std::uint8_t {
+    None = 0x00,
+    LZ4 = 0x90,
+    LZ4Dictionary = 0xA0
+};
 
-enum class Compressed : std::uint8_t { On, Off };
+// What a peer accepts: nothing, LZ4, or LZ4 with or without the dictionary.
+enum class Compressed : std::uint8_t { On, Off, Dictionary };
+
+/** The version of the shared dictionary, negotiated as "lz4d<version>". */
+std::uint32_t constexpr dictionaryVersion = 1;
+
+/** The dictionary that Algorithm::LZ4Dictionary compresses against.
+
+    It holds the byte sequences that recur in the serialized ledger
+    objects, transactions and validations carried by protocol messages, so
+    that even small messages find matches. The content of a version never
+    changes; a new dictionary gets a new version.
+ */
+Slice
+dictionary();
 
 /** Decompress input stream.
  * @tparam InputStream ZeroCopyInputStream
@@ -58,6 +76,9 @@ decompress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Decompress(
                 in, inSize, decompressed, decompressedSize);
+        else if (algorithm == Algorithm::LZ4Dictionary)
+            return ripple::compression_algorithms::lz4Decompress(
+                in, inSize, decompressed, decompressedSize, dictionary());
         else
         {
             JLOG(debugLog().warn())
@@ -96,6 +117,9 @@ compress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Compress(
                 in, inSize, std::forward<BufferFactory>(bf));
+        else if (algorithm == Algorithm::LZ4Dictionary)
+            return ripple::compression_algorithms::lz4Compress(
+                in, inSize, std::forward<BufferFactory>(bf), dictionary());
         else
         {
             JLOG(debugLog().warn()) << "compress: invalid compression algorithm"
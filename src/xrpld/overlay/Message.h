@@ -76,7 +76,9 @@ public:
     /** Retrieve the packed message data. If compressed message is requested but
      * the message is not compressible then the uncompressed buffer is returned.
      * @param compressed Request compressed (Compress::On) or
-     *     uncompressed (Compress::Off) payload buffer
+     *     uncompressed (Compress::Off) payload buffer. Compress::Dictionary
+     *     also allows the shared dictionary, for message types that gain
+     *     from it.
      * @return Payload buffer
      */
     std::vector<uint8_t> const&
@@ -99,16 +101,18 @@ public:
 private:
     std::vector<uint8_t> buffer_;
     std::vector<uint8_t> bufferCompressed_;
+    std::vector<uint8_t> bufferDictionary_;
     std::size_t category_;
     std::once_flag once_flag_;
+    std::once_flag dictionaryOnce_;
     std::optional<PublicKey> validatorKey_;
 
     /** Set the payload header
      * @param in Pointer to the payload
      * @param payloadBytes Size of the payload excluding the header size
      * @param type Protocol message type
-     * @param compression Compression algorithm used in compression,
-     *   currently LZ4 only. If None then the message is uncompressed.
+     * @param compression Compression algorithm used in compression.
+     *   If None then the message is uncompressed.
      * @param uncompressedBytes Size of the uncompressed message
      */
     void
@@ -120,11 +124,15 @@ private:
         std::uint32_t uncompressedBytes);
 
     /** Try to compress the payload.
-     * Can be called concurrently by multiple peers but is compressed once.
-     * If the message is not compressible then the serialized buffer_ is used.
+     * Can be called concurrently by multiple peers but is compressed once
+     * per algorithm. If the message is not compressible then the
+     * serialized buffer_ is used.
+     * @param algorithm The compression algorithm
+     * @param compressed The buffer to hold the compressed message, left
+     *   empty if the message is not compressible
      */
     void
-    compress();
+    compress(Algorithm algorithm, std::vector<uint8_t>& compressed);
 
     /** Get the message type from the payload header.
      * First four bytes are the compression/algorithm flag and the payload size.
@@ -232,6 +232,12 @@ public:
      */
     virtual Json::Value
     txMetrics() const = 0;
+
+    /** Add overlay counters, such as signature verification, to a
+        get_counts response.
+     */
+    virtual void
+    getCountsJson(Json::Value& obj) const = 0;
 };
 
 }  // namespace ripple
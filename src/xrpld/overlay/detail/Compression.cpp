@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/overlay/Compression.h>
+
+namespace ripple {
+namespace compression {
+
+namespace {
+
+// Version 1: runs of bytes that recur in serialized objects, mostly field
+// headers together with the values that usually follow them. An LZ4 match
+// needs at least four bytes, so a header is only listed where it is next to
+// something predictable.
+constexpr char dictionaryV1[] =
+    // Object prefixes in TMGetObjectByHash replies
+    "MIN" "\x00" "MLN" "\x00" "SND" "\x00" "LWR" "\x00"
+    // Currency codes in issued amounts
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00" "EUR"
+    "\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00" "USD"
+    "\x00\x00\x00\x00\x00"
+    // Manifests: sequence and master key
+    "\x24\x00\x00\x00\x01\x71\x21\xED"
+    // Directories, offers and trust lines
+    "\x11\x00\x64\x22\x00\x00\x00\x00\x58"
+    "\x11\x00\x6F\x22\x00\x00\x00\x00\x24"
+    "\x11\x00\x72\x22\x00\x01\x00\x00\x25"
+    "\x11\x00\x72\x22\x00\x02\x00\x00\x25"
+    "\x12\x00\x07\x22\x80\x00\x00\x00\x24"
+    "\x12\x00\x14\x22\x80\x00\x00\x00\x24"
+    // Transaction metadata
+    "\xE1\xE1\xE5\x11\x00\x72"
+    "\xE1\xE1\xE5\x11\x00\x64"
+    "\xE1\xE1\xE5\x11\x00\x6F"
+    "\xE6\x22\x00\x00\x00\x00\x24"
+    "\xE7\x22\x00\x00\x00\x00\x24"
+    "\xE1\xE1\xF1\x03\x10\x00"
+    "\xF8\xE5\x11\x00\x61\x25"
+    "\x20\x1C\x00\x00\x00"
+    // Account roots
+    "\x11\x00\x61\x22\x00\x00\x00\x00\x24"
+    "\x62\x40\x00\x00\x00"
+    // Proposals: sequence and position, then the signature
+    "\x08\x00\x12\x20"
+    "\x2A\x46\x30\x44\x02\x20"
+    "\x2A\x47\x30\x45\x02\x21\x00"
+    // Validations: flags and ledger sequence, then the signature
+    "\x22\x80\x00\x00\x01\x26"
+    "\x76\x46\x30\x44\x02\x20"
+    "\x76\x47\x30\x45\x02\x21\x00"
+    // Payments: type, flags, sequence, amount, fee and signature
+    "\x12\x00\x00\x22\x00\x00\x00\x00\x24"
+    "\x12\x00\x00\x22\x80\x00\x00\x00\x24"
+    "\x61\x40\x00\x00\x00"
+    "\x68\x40\x00\x00\x00\x00\x00\x00\x0F\x73\x21"
+    "\x68\x40\x00\x00\x00\x00\x00\x00\x0A\x73\x21"
+    "\x68\x40\x00\x00\x00\x00\x00\x00\x0C\x73\x21"
+    "\x74\x46\x30\x44\x02\x20"
+    "\x74\x47\x30\x45\x02\x21\x00";
+
+}  // namespace
+
+Slice
+dictionary()
+{
+    static_assert(dictionaryVersion == 1);
+    // The array holds a terminating null that isn't part of the dictionary.
+    return {dictionaryV1, sizeof(dictionaryV1) - 1};
+}
+
+}  // namespace compression
+}  // namespace ripple
@@ -405,7 +405,8 @@ ConnectAttempt::onHandshake(error_code ec)
         app_.config().COMPRESSION,
         app_.config().LEDGER_REPLAY,
         app_.config().TX_REDUCE_RELAY_ENABLE,
-        app_.config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE);
+        app_.config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE,
+        app_.config().COMPRESSION_DICTIONARY);
 
     buildHandshake(
         req_,
@@ -76,11 +76,17 @@ makeFeaturesRequestHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled)
+    bool vpReduceRelayEnabled,
+    bool comprDictionaryEnabled)
 {
     std::stringstream str;
     if (comprEnabled)
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    {
+        str << FEATURE_COMPR << "=lz4";
+        if (comprDictionaryEnabled)
+            str << DELIM_VALUE << COMPR_LZ4_DICTIONARY;
+        str << DELIM_FEATURE;
+    }
     if (ledgerReplayEnabled)
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled)
@@ -96,11 +102,18 @@ makeFeaturesResponseHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled)
+    bool vpReduceRelayEnabled,
+    bool comprDictionaryEnabled)
 {
     std::stringstream str;
     if (comprEnabled && isFeatureValue(headers, FEATURE_COMPR, "lz4"))
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    {
+        str << FEATURE_COMPR << "=lz4";
+        if (comprDictionaryEnabled &&
+            isFeatureValue(headers, FEATURE_COMPR, COMPR_LZ4_DICTIONARY))
+            str << DELIM_VALUE << COMPR_LZ4_DICTIONARY;
+        str << DELIM_FEATURE;
+    }
     if (ledgerReplayEnabled && featureEnabled(headers, FEATURE_LEDGER_REPLAY))
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled && featureEnabled(headers, FEATURE_TXRR))
@@ -367,7 +380,8 @@ makeRequest(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled) -> request_type
+    bool vpReduceRelayEnabled,
+    bool comprDictionaryEnabled) -> request_type
 {
     request_type m;
     m.method(boost::beast::http::verb::get);
@@ -384,7 +398,8 @@ makeRequest(
             comprEnabled,
             ledgerReplayEnabled,
             txReduceRelayEnabled,
-            vpReduceRelayEnabled));
+            vpReduceRelayEnabled,
+            comprDictionaryEnabled));
     return m;
 }
 
@@ -414,7 +429,8 @@ makeResponse(
             app.config().COMPRESSION,
             app.config().LEDGER_REPLAY,
             app.config().TX_REDUCE_RELAY_ENABLE,
-            app.config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE));
+            app.config().VP_REDUCE_RELAY_BASE_SQUELCH_ENABLE,
+            app.config().COMPRESSION_DICTIONARY));
 
     buildHandshake(resp, sharedValue, networkID, public_ip, remote_ip, app);
 
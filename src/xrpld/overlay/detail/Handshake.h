@@ -21,6 +21,7 @@
 #define RIPPLE_OVERLAY_HANDSHAKE_H_INCLUDED
 
 #include <xrpld/app/main/Application.h>
+#include <xrpld/overlay/Compression.h>
 #include <xrpld/overlay/detail/ProtocolVersion.h>
 
 #include <xrpl/beast/utility/Journal.h>
@@ -99,6 +100,8 @@ verifyHandshake(
    enabled
    @param vpReduceRelayEnabled if true then validation/proposal reduce-relay
    feature is enabled
+   @param comprDictionaryEnabled if true then compression with the shared
+   dictionary is offered too
    @return http request with empty body
  */
 request_type
@@ -107,7 +110,8 @@ makeRequest(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled);
+    bool vpReduceRelayEnabled,
+    bool comprDictionaryEnabled = false);
 
 /** Make http response
 
@@ -139,6 +143,8 @@ makeResponse(
 
 // compression feature
 static constexpr char FEATURE_COMPR[] = "compr";
+// compression feature value for lz4 with version 1 of the shared dictionary
+static constexpr char COMPR_LZ4_DICTIONARY[] = "lz4d1";
 // validation/proposal reduce-relay base squelch feature
 static constexpr char FEATURE_VPRR[] = "vprr";
 // transaction reduce-relay feature
@@ -215,6 +221,31 @@ peerFeatureEnabled(
     return config && peerFeatureEnabled(request, feature, "1", config);
 }
 
+/** The compression to use with a peer. Compression is enabled as for
+    peerFeatureEnabled, and the shared dictionary is used if it is
+    configured and the headers also list it.
+   @tparam headers request (inbound) or response (outbound) header
+   @param request http headers
+   @param config compression's configuration value
+   @param dictionaryConfig the shared dictionary's configuration value
+   @return the compression to use with the peer
+ */
+template <typename headers>
+compression::Compressed
+peerCompression(
+    headers const& request,
+    bool config,
+    bool dictionaryConfig = false)
+{
+    using compression::Compressed;
+    if (!peerFeatureEnabled(request, FEATURE_COMPR, "lz4", config))
+        return Compressed::Off;
+    if (dictionaryConfig &&
+        isFeatureValue(request, FEATURE_COMPR, COMPR_LZ4_DICTIONARY))
+        return Compressed::Dictionary;
+    return Compressed::On;
+}
+
 /** Make request header X-Protocol-Ctl value with supported features
    @param comprEnabled if true then compression feature is enabled
    @param ledgerReplayEnabled if true then ledger-replay feature is enabled
@@ -222,6 +253,8 @@ peerFeatureEnabled(
    enabled
    @param vpReduceRelayEnabled if true then validation/proposal reduce-relay
    base squelch feature is enabled
+   @param comprDictionaryEnabled if true then compression with the shared
+   dictionary is offered too
    @return X-Protocol-Ctl header value
  */
 std::string
@@ -229,7 +262,8 @@ makeFeaturesRequestHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled);
+    bool vpReduceRelayEnabled,
+    bool comprDictionaryEnabled = false);
 
 /** Make response header X-Protocol-Ctl value with supported features.
     If the request has a feature that we support enabled
@@ -242,6 +276,8 @@ makeFeaturesRequestHeader(
    enabled
    @param vpReduceRelayEnabled if true then validation/proposal reduce-relay
    base squelch feature is enabled
+   @param comprDictionaryEnabled if true then compression with the shared
+   dictionary is accepted too
    @return X-Protocol-Ctl header value
  */
 std::string
@@ -250,7 +286,8 @@ makeFeaturesResponseHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled);
+    bool vpReduceRelayEnabled,
+    bool comprDictionaryEnabled = false);
 
 }  // namespace ripple
 
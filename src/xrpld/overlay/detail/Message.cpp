@@ -69,7 +69,7 @@ Message::totalSize(::google::protobuf::Message const& message)
 }
 
 void
-Message::compress()
+Message::compress(Algorithm algorithm, std::vector<uint8_t>& compressed)
 {
     using namespace ripple::compression;
     auto const messageBytes = buffer_.size() - headerBytes;
@@ -77,6 +77,26 @@ Message::compress()
     auto type = getType(buffer_.data());
 
     bool const compressible = [&] {
+        // The dictionary is for messages dominated by serialized objects.
+        // Without one, these only compress if they hold enough of them.
+        if (algorithm == Algorithm::LZ4Dictionary)
+        {
+            switch (type)
+            {
+                case protocol::mtMANIFESTS:
+                case protocol::mtTRANSACTION:
+                case protocol::mtLEDGER_DATA:
+                case protocol::mtGET_OBJECTS:
+                case protocol::mtPROPOSE_LEDGER:
+                case protocol::mtVALIDATION:
+                case protocol::mtREPLAY_DELTA_RESPONSE:
+                case protocol::mtTRANSACTIONS:
+                    return messageBytes > 32;
+                default:
+                    return false;
+            }
+        }
+
         if (messageBytes <= 70)
             return false;
         switch (type)
@@ -115,23 +135,24 @@ Message::compress()
             payload,
             messageBytes,
             [&](std::size_t inSize) {  // size of required compressed buffer
-                bufferCompressed_.resize(inSize + headerBytesCompressed);
-                return (bufferCompressed_.data() + headerBytesCompressed);
-            });
+                compressed.resize(inSize + headerBytesCompressed);
+                return (compressed.data() + headerBytesCompressed);
+            },
+            algorithm);
 
         if (compressedSize <
             (messageBytes - (headerBytesCompressed - headerBytes)))
         {
-            bufferCompressed_.resize(headerBytesCompressed + compressedSize);
+            compressed.resize(headerBytesCompressed + compressedSize);
             setHeader(
-                bufferCompressed_.data(),
+                compressed.data(),
                 compressedSize,
                 type,
-                Algorithm::LZ4,
+                algorithm,
                 messageBytes);
         }
         else
-            bufferCompressed_.resize(0);
+            compressed.resize(0);
     }
 }
 
@@ -212,7 +233,18 @@ Message::getBuffer(Compressed tryCompressed)
     if (tryCompressed == Compressed::Off)
         return buffer_;
 
-    std::call_once(once_flag_, &Message::compress, this);
+    if (tryCompressed == Compressed::Dictionary)
+    {
+        std::call_once(dictionaryOnce_, [this] {
+            compress(Algorithm::LZ4Dictionary, bufferDictionary_);
+        });
+
+        if (bufferDictionary_.size() > 0)
+            return bufferDictionary_;
+    }
+
+    std::call_once(
+        once_flag_, [this] { compress(Algorithm::LZ4, bufferCompressed_); });
 
     if (bufferCompressed_.size() > 0)
         return bufferCompressed_;
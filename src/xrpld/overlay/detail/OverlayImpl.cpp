@@ -145,6 +145,10 @@ OverlayImpl::OverlayImpl(
     , next_id_(1)
     , timer_count_(0)
     , slots_(app.logs(), *this, app.config())
+    , signatureBatcher_(
+          app.getJobQueue(),
+          collector,
+          app_.journal("SignatureBatcher"))
     , m_stats(
           std::bind(&OverlayImpl::collect_metrics, this),
           collector,
@@ -26,6 +26,7 @@
 #include <xrpld/overlay/Overlay.h>
 #include <xrpld/overlay/Slot.h>
 #include <xrpld/overlay/detail/Handshake.h>
+#include <xrpld/overlay/detail/SignatureBatcher.h>
 #include <xrpld/overlay/detail/TrafficCount.h>
 #include <xrpld/overlay/detail/TxMetrics.h>
 #include <xrpld/peerfinder/PeerfinderManager.h>
@@ -130,6 +131,9 @@ private:
     // Transaction reduce-relay metrics
     metrics::TxMetrics txMetrics_;
 
+    // Verifies signatures of messages received from peers
+    SignatureBatcher signatureBatcher_;
+
     // A message with the list of manifests we send to peers
     std::shared_ptr<Message> manifestMessage_;
     // Used to track whether we need to update the cached list of manifests
@@ -434,6 +438,18 @@ public:
         return txMetrics_.json();
     }
 
+    void
+    getCountsJson(Json::Value& obj) const override
+    {
+        signatureBatcher_.getCountsJson(obj);
+    }
+
+    SignatureBatcher&
+    signatureBatcher()
+    {
+        return signatureBatcher_;
+    }
+
     /** Add tx reduce-relay metrics. */
     template <typename... Args>
     void
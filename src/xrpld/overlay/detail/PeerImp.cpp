@@ -107,13 +107,10 @@ PeerImp::PeerImp(
     , request_(std::move(request))
     , headers_(request_)
     , compressionEnabled_(
-          peerFeatureEnabled(
+          peerCompression(
               headers_,
-              FEATURE_COMPR,
-              "lz4",
-              app_.config().COMPRESSION)
-              ? Compressed::On
-              : Compressed::Off)
+              app_.config().COMPRESSION,
+              app_.config().COMPRESSION_DICTIONARY))
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
@@ -125,7 +122,8 @@ PeerImp::PeerImp(
     , ledgerReplayMsgHandler_(app, app.getLedgerReplayer())
 {
     JLOG(journal_.info())
-        << "compression enabled " << (compressionEnabled_ == Compressed::On)
+        << "compression enabled " << (compressionEnabled_ != Compressed::Off)
+        << " dictionary " << (compressionEnabled_ == Compressed::Dictionary)
         << " vp reduce-relay base squelch enabled "
         << peerFeatureEnabled(
                headers_,
@@ -289,18 +287,10 @@ PeerImp::send(std::shared_ptr<Message> const& m)
     if (sendq_size != 0)
         return;
 
+    // Start writing once the handlers already queued on the strand have
+    // run, so the messages they send share the write.
     writePending_ = true;
-    boost::asio::async_write(
-        stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
-        bind_executor(
-            strand_,
-            std::bind(
-                &PeerImp::onWriteMessage,
-                shared_from_this(),
-                std::placeholders::_1,
-                std::placeholders::_2)));
+    post(strand_, std::bind(&PeerImp::writeQueued, shared_from_this()));
 }
 
 void
@@ -502,6 +492,11 @@ PeerImp::json()
         std::to_string(metrics_.recv.average_bytes());
     ret[jss::metrics][jss::avg_bps_sent] =
         std::to_string(metrics_.sent.average_bytes());
+    ret[jss::metrics][jss::avg_writes_sent] =
+        std::to_string(metrics_.sent.average_ops());
+    if (auto const writes = metrics_.sent.total_ops())
+        ret[jss::metrics][jss::avg_bytes_per_write] =
+            std::to_string(metrics_.sent.total_bytes() / writes);
 
     return ret;
 }
@@ -1041,6 +1036,41 @@ PeerImp::onReadMessage(error_code ec, std::size_t bytes_transferred)
                 std::placeholders::_2)));
 }
 
+void
+PeerImp::writeQueued()
+{
+    XRPL_ASSERT(
+        strand_.running_in_this_thread(),
+        "ripple::PeerImp::writeQueued : strand in this thread");
+    XRPL_ASSERT(
+        writePending_ && send_queue_.writing() == 0 && !send_queue_.empty(),
+        "ripple::PeerImp::writeQueued : nothing being written");
+
+    if (!socket_.is_open())
+    {
+        writePending_ = false;
+        return;
+    }
+
+    if (shutdown_)
+    {
+        writePending_ = false;
+        return tryAsyncShutdown();
+    }
+
+    // Timeout on writes only
+    boost::asio::async_write(
+        stream_,
+        send_queue_.startWrite(compressionEnabled_),
+        bind_executor(
+            strand_,
+            std::bind(
+                &PeerImp::onWriteMessage,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2)));
+}
+
 void
 PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 {
@@ -1070,11 +1100,10 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
     }
 
     metrics_.sent.add_message(bytes_transferred);
+    overlay_.reportOutboundTraffic(
+        TrafficCount::category::writes, static_cast<int>(bytes_transferred));
 
-    XRPL_ASSERT(
-        !send_queue_.empty(),
-        "ripple::PeerImp::onWriteMessage : non-empty send buffer");
-    send_queue_.pop();
+    send_queue_.finishWrite();
 
     if (shutdown_)
         return tryAsyncShutdown();
@@ -1085,19 +1114,7 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
         XRPL_ASSERT(
             !shutdownStarted_,
             "ripple::PeerImp::onWriteMessage : shutdown started");
-
-        // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
+        writeQueued();
     }
 }
 
@@ -1449,12 +1466,38 @@ PeerImp::handleTransaction(
                 << "No new transactions until synchronized";
         }
         else if (
-            app_.getJobQueue().getJobCount(jtTRANSACTION) >
+            app_.getJobQueue().getJobCount(jtTRANSACTION) +
+                overlay_.signatureBatcher().pending(jtTRANSACTION) >
             app_.config().MAX_TRANSACTIONS)
         {
             overlay_.incJqTransOverflow();
             JLOG(p_journal_.info()) << "Transaction queue is full";
         }
+        else if (checkSignature)
+        {
+            // The signature is verified along with other transactions
+            // received around the same time. The result is recorded in the
+            // HashRouter, where checkTransaction finds it.
+            overlay_.signatureBatcher().add(
+                jtTRANSACTION,
+                [&app = app_, stx]() {
+                    if (isPseudoTx(*stx))
+                        return true;
+                    return checkValidity(
+                               app.getHashRouter(),
+                               *stx,
+                               app.getLedgerMaster().getValidatedRules(),
+                               app.config())
+                               .first != Validity::SigBad;
+                },
+                [weak = std::weak_ptr<PeerImp>(shared_from_this()),
+                 flags,
+                 batch,
+                 stx](bool) {
+                    if (auto peer = weak.lock())
+                        peer->checkTransaction(flags, true, stx, batch);
+                });
+        }
         else
         {
             app_.getJobQueue().addJob(
@@ -1881,12 +1924,12 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
             calcNodeID(app_.validatorManifests().getMasterKey(publicKey))});
 
     std::weak_ptr<PeerImp> weak = shared_from_this();
-    app_.getJobQueue().addJob(
+    overlay_.signatureBatcher().add(
         isTrusted ? jtPROPOSAL_t : jtPROPOSAL_ut,
-        "recvPropose->checkPropose",
-        [weak, isTrusted, m, proposal]() {
+        [proposal, skip = cluster()]() { return skip || proposal.checkSign(); },
+        [weak, isTrusted, m, proposal](bool goodSignature) {
             if (auto peer = weak.lock())
-                peer->checkPropose(isTrusted, m, proposal);
+                peer->checkPropose(isTrusted, goodSignature, m, proposal);
         });
 }
 
@@ -2503,24 +2546,14 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
         }
         else if (isTrusted || !app_.getFeeTrack().isLoadedLocal())
         {
-            std::string const name = [isTrusted, val]() {
-                std::string ret =
-                    isTrusted ? "Trusted validation" : "Untrusted validation";
-
-#ifdef DEBUG
-                ret += " " +
-                    std::to_string(val->getFieldU32(sfLedgerSequence)) + ": " +
-                    to_string(val->getNodeID());
-#endif
-
-                return ret;
-            }();
-
+            // The signature is verified along with other validations
+            // received around the same time. STValidation remembers the
+            // result, so checkValidation does not verify it again.
             std::weak_ptr<PeerImp> weak = shared_from_this();
-            app_.getJobQueue().addJob(
+            overlay_.signatureBatcher().add(
                 isTrusted ? jtVALIDATION_t : jtVALIDATION_ut,
-                name,
-                [weak, val, m, key]() {
+                [val]() { return val->isValid(); },
+                [weak, val, m, key](bool) {
                     if (auto peer = weak.lock())
                         peer->checkValidation(val, key, m);
                 });
@@ -3081,6 +3114,7 @@ PeerImp::checkTransaction(
 void
 PeerImp::checkPropose(
     bool isTrusted,
+    bool goodSignature,
     std::shared_ptr<protocol::TMProposeSet> const& packet,
     RCLCxPeerPos peerPos)
 {
@@ -3089,7 +3123,7 @@ PeerImp::checkPropose(
 
     XRPL_ASSERT(packet, "ripple::PeerImp::checkPropose : non-null packet");
 
-    if (!cluster() && !peerPos.checkSign())
+    if (!goodSignature)
     {
         std::string desc{"Proposal fails sig check"};
         JLOG(p_journal_.warn()) << desc;
@@ -3621,6 +3655,8 @@ PeerImp::Metrics::add_message(std::uint64_t bytes)
 
     totalBytes_ += bytes;
     accumBytes_ += bytes;
+    ++totalOps_;
+    ++accumOps_;
     auto const timeElapsed = clock_type::now() - intervalStart_;
     auto const timeElapsedInSecs =
         std::chrono::duration_cast<std::chrono::seconds>(timeElapsed);
@@ -3634,8 +3670,14 @@ PeerImp::Metrics::add_message(std::uint64_t bytes)
             std::accumulate(rollingAvg_.begin(), rollingAvg_.end(), 0ull);
         rollingAvgBytes_ = totalBytes / rollingAvg_.size();
 
+        rollingOps_.push_back(accumOps_ / timeElapsedInSecs.count());
+        auto const totalOps =
+            std::accumulate(rollingOps_.begin(), rollingOps_.end(), 0ull);
+        rollingAvgOps_ = totalOps / rollingOps_.size();
+
         intervalStart_ = clock_type::now();
         accumBytes_ = 0;
+        accumOps_ = 0;
     }
 }
 
@@ -3653,4 +3695,18 @@ PeerImp::Metrics::total_bytes() const
     return totalBytes_;
 }
 
+std::uint64_t
+PeerImp::Metrics::average_ops() const
+{
+    std::shared_lock lock{mutex_};
+    return rollingAvgOps_;
+}
+
+std::uint64_t
+PeerImp::Metrics::total_ops() const
+{
+    std::shared_lock lock{mutex_};
+    return totalOps_;
+}
+
 }  // namespace ripple
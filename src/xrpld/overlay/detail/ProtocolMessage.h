@@ -133,8 +133,8 @@ struct MessageHeader
     std::uint16_t message_type = 0;
 
     /** Indicates which compression algorithm the payload is compressed with.
-     * Currenly only lz4 is supported. If None then the message is not
-     * compressed.
+     * Either lz4, or lz4 with the shared dictionary. If None then the
+     * message is not compressed.
      */
     compression::Algorithm algorithm = compression::Algorithm::None;
 };
@@ -203,7 +203,8 @@ parseMessageHeader(
 
         hdr.algorithm = static_cast<compression::Algorithm>(*iter & 0xF0);
 
-        if (hdr.algorithm != compression::Algorithm::LZ4)
+        if (hdr.algorithm != compression::Algorithm::LZ4 &&
+            hdr.algorithm != compression::Algorithm::LZ4Dictionary)
         {
             ec = make_error_code(boost::system::errc::protocol_error);
             return std::nullopt;
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/overlay/detail/SendQueue.h>
+#include <xrpld/overlay/detail/TrafficCount.h>
+#include <xrpld/overlay/detail/Tuning.h>
+
+#include <xrpl/basics/safe_cast.h>
+#include <xrpl/beast/utility/instrumentation.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+void
+SendQueue::push(std::shared_ptr<Message> const& m)
+{
+    auto const category = safe_cast<TrafficCount::category>(m->getCategory());
+    if (category == TrafficCount::category::proposal ||
+        category == TrafficCount::category::validation ||
+        category == TrafficCount::category::manifests)
+    {
+        queue_.insert(queue_.begin() + writing_ + priorityQueued_, m);
+        ++priorityQueued_;
+    }
+    else
+    {
+        queue_.push_back(m);
+    }
+}
+
+std::vector<boost::asio::const_buffer>
+SendQueue::startWrite(Compressed compressed)
+{
+    XRPL_ASSERT(
+        writing_ == 0 && !queue_.empty(),
+        "ripple::SendQueue::startWrite : nothing being written");
+
+    std::vector<boost::asio::const_buffer> buffers;
+    std::size_t bytes = 0;
+    for (auto const& m : queue_)
+    {
+        auto const& buffer = m->getBuffer(compressed);
+        if (!buffers.empty() &&
+            (buffers.size() == Tuning::maxWriteMessages ||
+             bytes + buffer.size() > Tuning::maxWriteBytes))
+            break;
+        buffers.push_back(boost::asio::buffer(buffer));
+        bytes += buffer.size();
+    }
+
+    writing_ = buffers.size();
+    priorityQueued_ -= std::min(priorityQueued_, writing_);
+    return buffers;
+}
+
+void
+SendQueue::finishWrite()
+{
+    XRPL_ASSERT(
+        writing_ != 0 && writing_ <= queue_.size(),
+        "ripple::SendQueue::finishWrite : write in progress");
+    queue_.erase(queue_.begin(), queue_.begin() + writing_);
+    writing_ = 0;
+}
+
+}  // namespace ripple
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+
+#include <xrpld/overlay/Message.h>
+
+#include <boost/asio/buffer.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+/** The messages waiting to be written to a peer.
+
+    The messages at the front are gathered into one write, up to
+    Tuning::maxWriteMessages and Tuning::maxWriteBytes. Proposals,
+    validations and manifests go ahead of the other messages that are not
+    being written yet, and keep their relative order. Manifests share that
+    lane so that a validation never arrives before the manifest of its
+    signing key.
+
+    @code
+    | being written | priority messages | other messages |
+    @endcode
+
+    Not thread safe. PeerImp uses it on its strand.
+*/
+class SendQueue
+{
+public:
+    using Compressed = compression::Compressed;
+
+    SendQueue() = default;
+
+    SendQueue(SendQueue const&) = delete;
+    SendQueue&
+    operator=(SendQueue const&) = delete;
+
+    /** Queue a message. */
+    void
+    push(std::shared_ptr<Message> const& m);
+
+    /** Select the messages at the front for the next write.
+
+        At least one message is selected, however large it is. The queue
+        must not be empty and no write may be in progress.
+
+        @param compressed The form of the messages to write.
+        @return The buffers of the selected messages, in order.
+    */
+    std::vector<boost::asio::const_buffer>
+    startWrite(Compressed compressed);
+
+    /** Remove the messages of the write in progress. */
+    void
+    finishWrite();
+
+    /** The number of messages queued, including those being written. */
+    std::size_t
+    size() const
+    {
+        return queue_.size();
+    }
+
+    bool
+    empty() const
+    {
+        return queue_.empty();
+    }
+
+    /** The number of messages in the write in progress. */
+    std::size_t
+    writing() const
+    {
+        return writing_;
+    }
+
+    /** The number of priority messages waiting behind the write. */
+    std::size_t
+    priorityQueued() const
+    {
+        return priorityQueued_;
+    }
+
+private:
+    std::deque<std::shared_ptr<Message>> queue_;
+    std::size_t writing_ = 0;
+    std::size_t priorityQueued_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/core/JobQueue.h>
+#include <xrpld/overlay/detail/SignatureBatcher.h>
+
+#include <xrpl/basics/Log.h>
+#include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace ripple {
+
+SignatureBatcher::SignatureBatcher(
+    JobQueue& jobQueue,
+    beast::insight::Collector::ptr const& collector,
+    beast::Journal journal)
+    : jobQueue_(jobQueue)
+    , j_(journal)
+    , rate_(clock_type::now())
+    , stats_(std::bind(&SignatureBatcher::collect_metrics, this), collector)
+{
+}
+
+void
+SignatureBatcher::add(JobType type, Verify verify, Continue then)
+{
+    std::lock_guard lock(mutex_);
+    auto& queue = queues_[type];
+    queue.checks.push_back({std::move(verify), std::move(then)});
+    if (!queue.scheduled)
+        schedule(type, queue, lock);
+}
+
+std::size_t
+SignatureBatcher::pending(JobType type) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = queues_.find(type); it != queues_.end())
+        return it->second.checks.size();
+    return 0;
+}
+
+void
+SignatureBatcher::schedule(
+    JobType type,
+    Queue& queue,
+    std::lock_guard<std::mutex> const&)
+{
+    queue.scheduled = jobQueue_.addJob(
+        type, "verifySignatures", [this, type]() { process(type); });
+
+    if (!queue.scheduled)
+    {
+        // The job queue is stopping, so nothing queued will ever run.
+        JLOG(j_.debug()) << "Dropping " << queue.checks.size()
+                         << " signature checks";
+        queue.checks.clear();
+    }
+}
+
+void
+SignatureBatcher::process(JobType type)
+{
+    std::vector<Check> batch;
+    {
+        std::lock_guard lock(mutex_);
+        auto& queue = queues_[type];
+        queue.scheduled = false;
+
+        if (queue.checks.size() <= maxBatchSize)
+        {
+            batch.swap(queue.checks);
+        }
+        else
+        {
+            auto const last = queue.checks.begin() +
+                static_cast<std::ptrdiff_t>(maxBatchSize);
+            batch.assign(
+                std::make_move_iterator(queue.checks.begin()),
+                std::make_move_iterator(last));
+            queue.checks.erase(queue.checks.begin(), last);
+        }
+
+        // Anything added from now on goes to the next job, which can run
+        // alongside this one.
+        if (!queue.checks.empty())
+            schedule(type, queue, lock);
+    }
+
+    if (batch.empty())
+        return;
+
+    std::vector<char> results(batch.size(), 0);
+    verify(type, batch, results);
+
+    auto const failed = static_cast<std::uint64_t>(
+        std::count(results.begin(), results.end(), 0));
+    verified_ += batch.size();
+    failed_ += failed;
+    ++batches_;
+    stats_.verified += batch.size();
+    stats_.failed += failed;
+    {
+        std::lock_guard lock(mutex_);
+        rate_.add(batch.size(), clock_type::now());
+    }
+
+    JLOG(j_.trace()) << "Verified " << batch.size() << " signatures, "
+                     << failed << " bad";
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        batch[i].then(results[i] != 0);
+}
+
+void
+SignatureBatcher::verify(
+    JobType type,
+    std::vector<Check> const& batch,
+    std::vector<char>& results)
+{
+    auto const chunkCount = std::max<std::size_t>(
+        1, std::min(maxHelpers + 1, batch.size() / minChecksPerThread));
+    auto const chunk = (batch.size() + chunkCount - 1) / chunkCount;
+
+    // The other chunks are checked by jobs of the batch's own type, so
+    // the work counts against its limit and is waited for at shutdown.
+    jobQueue_.parallelFor(
+        type, "verifySignatures", chunkCount, maxHelpers, [&](std::size_t c) {
+            auto const first = std::min(batch.size(), c * chunk);
+            auto const last = std::min(batch.size(), first + chunk);
+            for (auto i = first; i < last; ++i)
+            {
+                try
+                {
+                    results[i] = batch[i].verify() ? 1 : 0;
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j_.debug())
+                        << "Signature check failed: " << e.what();
+                    results[i] = 0;
+                }
+            }
+        });
+}
+
+double
+SignatureBatcher::rate() const
+{
+    std::lock_guard lock(mutex_);
+    return rate_.value(clock_type::now());
+}
+
+void
+SignatureBatcher::getCountsJson(Json::Value& obj) const
+{
+    XRPL_ASSERT(
+        obj.isObject(),
+        "ripple::SignatureBatcher::getCountsJson : valid input type");
+
+    obj[jss::sig_verified] = std::to_string(verified_);
+    obj[jss::sig_failed] = std::to_string(failed_);
+    obj[jss::sig_batches] = std::to_string(batches_);
+    obj[jss::sig_verify_per_second] = static_cast<Json::UInt>(rate());
+
+    std::size_t queued = 0;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto const& [type, queue] : queues_)
+            queued += queue.checks.size();
+    }
+    obj[jss::sig_verify_queue] = static_cast<Json::UInt>(queued);
+}
+
+void
+SignatureBatcher::collect_metrics()
+{
+    stats_.perSecond = static_cast<std::uint64_t>(rate());
+}
+
+}  // namespace ripple
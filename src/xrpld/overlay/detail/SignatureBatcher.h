@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SIGNATUREBATCHER_H_INCLUDED
+#define RIPPLE_OVERLAY_SIGNATUREBATCHER_H_INCLUDED
+
+#include <xrpld/core/Job.h>
+
+#include <xrpl/basics/DecayingSample.h>
+#include <xrpl/beast/insight/Collector.h>
+#include <xrpl/beast/utility/Journal.h>
+#include <xrpl/json/json_value.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+class JobQueue;
+
+/** Verifies the signatures of messages received from peers in batches.
+
+    Checks are queued by job type. One job of that type takes up to
+    maxBatchSize queued checks, verifies them, sharing a large batch with a
+    few more jobs of the same type, and then runs each check's continuation in the order
+    the checks were added. Checks that arrive while a batch job is waiting
+    to run join that batch, so a burst of messages is verified together
+    while a lone message is not delayed.
+*/
+class SignatureBatcher
+{
+public:
+    /** Returns `true` if the signature is good. May run on any thread. */
+    using Verify = std::function<bool()>;
+
+    /** Receives the result of Verify. Runs on the job queue. */
+    using Continue = std::function<void(bool)>;
+
+    /** The most checks verified by a single job. */
+    static constexpr std::size_t maxBatchSize = 128;
+
+    /** A batch is only split across jobs when each gets this many. */
+    static constexpr std::size_t minChecksPerThread = 32;
+
+    /** The most extra jobs that share the checks of one batch. */
+    static constexpr std::size_t maxHelpers = 3;
+
+    SignatureBatcher(
+        JobQueue& jobQueue,
+        beast::insight::Collector::ptr const& collector,
+        beast::Journal journal);
+
+    SignatureBatcher(SignatureBatcher const&) = delete;
+    SignatureBatcher&
+    operator=(SignatureBatcher const&) = delete;
+
+    /** Queue a signature check.
+
+        @param type The type of the job that verifies the batch and runs the
+                    continuation.
+        @param verify Checks the signature.
+        @param then Called with the result of `verify`.
+    */
+    void
+    add(JobType type, Verify verify, Continue then);
+
+    /** Returns the number of queued checks of the given type that have not
+        been picked up by a job yet.
+    */
+    std::size_t
+    pending(JobType type) const;
+
+    /** Add the verification counters to a get_counts response. */
+    void
+    getCountsJson(Json::Value& obj) const;
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    struct Check
+    {
+        Verify verify;
+        Continue then;
+    };
+
+    struct Queue
+    {
+        std::vector<Check> checks;
+        bool scheduled = false;
+    };
+
+    struct Stats
+    {
+        template <class Handler>
+        Stats(
+            Handler const& handler,
+            beast::insight::Collector::ptr const& collector)
+            : hook(collector->make_hook(handler))
+            , perSecond(collector->make_gauge(
+                  "SignatureBatcher",
+                  "Verify_Per_Second"))
+            , verified(collector->make_counter("SignatureBatcher", "Verified"))
+            , failed(collector->make_counter("SignatureBatcher", "Failed"))
+        {
+        }
+
+        beast::insight::Hook hook;
+        beast::insight::Gauge perSecond;
+        beast::insight::Counter verified;
+        beast::insight::Counter failed;
+    };
+
+    void
+    schedule(JobType type, Queue& queue, std::lock_guard<std::mutex> const&);
+
+    void
+    process(JobType type);
+
+    void
+    verify(
+        JobType type,
+        std::vector<Check> const& batch,
+        std::vector<char>& results);
+
+    double
+    rate() const;
+
+    void
+    collect_metrics();
+
+    JobQueue& jobQueue_;
+    beast::Journal const j_;
+
+    std::mutex mutable mutex_;
+    std::map<JobType, Queue> queues_;
+    DecayWindow<30, clock_type> mutable rate_;
+
+    std::atomic<std::uint64_t> verified_{0};
+    std::atomic<std::uint64_t> failed_{0};
+    std::atomic<std::uint64_t> batches_{0};
+
+    Stats stats_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -193,6 +193,9 @@ public:
         // TMTransactions
         requested_transactions,
 
+        // Writes to peer sockets, each carrying one or more messages
+        writes,
+
         // The total p2p bytes sent and received on the wire
         total,
 
@@ -304,6 +307,7 @@ public:
             {replay_delta_response, "replay_delta_response"},
             {have_transactions, "have_transactions"},
             {requested_transactions, "requested_transactions"},
+            {writes, "writes"},
             {total, "total"}};
 
         if (auto it = category_map.find(cat); it != category_map.end())
@@ -369,6 +373,7 @@ protected:
         {replay_delta_response, {replay_delta_response}},
         {have_transactions, {have_transactions}},
         {requested_transactions, {requested_transactions}},
+        {writes, {writes}},
         {total, {total}},
         {unknown, {unknown}},
     };
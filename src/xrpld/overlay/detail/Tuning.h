@@ -59,8 +59,15 @@ enum {
 
     /** The maximum number of levels to search */
     maxQueryDepth = 3,
+
+    /** The most queued messages gathered into one write to a peer */
+    maxWriteMessages = 64,
 };
 
+/** The most bytes gathered into one write to a peer. Larger messages are
+    written on their own. */
+std::size_t constexpr maxWriteBytes = 65536;
+
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
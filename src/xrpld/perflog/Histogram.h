@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PERFLOG_HISTOGRAM_H_INCLUDED
+#define RIPPLE_PERFLOG_HISTOGRAM_H_INCLUDED
+
+#include <xrpl/json/json_value.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ripple {
+namespace perf {
+
+/**
+ * A fixed-size, log-linear histogram of non-negative integer samples,
+ * typically durations in microseconds.
+ *
+ * Each power of two is split into 2^subBucketBits equal buckets, so any
+ * recorded value is reported to within 1/16th of its magnitude. Values of
+ * 2^maxBits or more are counted in the last bucket. Recording is a few
+ * relaxed atomic increments and never blocks; a snapshot taken while
+ * samples are being recorded may be very slightly inconsistent.
+ */
+class Histogram
+{
+public:
+    static constexpr std::size_t subBucketBits = 4;
+    static constexpr std::size_t subBuckets = 1 << subBucketBits;
+    static constexpr std::size_t maxBits = 36;
+    static constexpr std::size_t bucketCount =
+        subBuckets * (maxBits - subBucketBits + 1);
+
+    /** A consistent copy of the histogram's state. */
+    struct Snapshot
+    {
+        std::array<std::uint64_t, bucketCount> buckets{};
+        std::uint64_t count = 0;
+        std::uint64_t sum = 0;
+        std::uint64_t max = 0;
+
+        /** The value that the given fraction of samples do not exceed.
+
+            The result is rounded up to the end of its bucket, but is never
+            more than the largest value recorded.
+
+            @param fraction A value in [0, 1], e.g. 0.99 for the p99.
+        */
+        std::uint64_t
+        percentile(double fraction) const;
+
+        Snapshot&
+        operator+=(Snapshot const& other);
+
+        /** Render the count, sum, max, p50, p90, p99 and p999, treating
+            the samples as microseconds. */
+        Json::Value
+        json() const;
+    };
+
+    Histogram() = default;
+    Histogram(Histogram const&) = delete;
+    Histogram&
+    operator=(Histogram const&) = delete;
+
+    void
+    record(std::uint64_t value) noexcept;
+
+    Snapshot
+    snapshot() const;
+
+    /** The bucket a value is counted in. */
+    static std::size_t
+    bucket(std::uint64_t value) noexcept;
+
+    /** The largest value that is counted in a bucket. */
+    static std::uint64_t
+    bucketMax(std::size_t bucket) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+}  // namespace perf
+}  // namespace ripple
+
+#endif
@@ -23,6 +23,7 @@
 #include <xrpld/core/Config.h>
 #include <xrpld/core/JobTypes.h>
 
+#include <xrpl/beast/insight/Collector.h>
 #include <xrpl/json/json_value.h>
 
 #include <boost/filesystem.hpp>
@@ -67,6 +68,8 @@ public:
         boost::filesystem::path perfLog;
         // log_interval is in milliseconds to support faster testing.
         milliseconds logInterval{seconds(1)};
+        // Number of most contended locks to report. 0 disables tracing.
+        std::size_t traceLocks{0};
     };
 
     virtual ~PerfLog() = default;
@@ -157,6 +160,16 @@ public:
     virtual Json::Value
     currentJson() const = 0;
 
+    /**
+     * Render latency distributions in Json: queued and running time for
+     * each job type and, if lock tracing is enabled, the wait times of the
+     * most contended locks.
+     *
+     * @return Latency histograms Json object
+     */
+    virtual Json::Value
+    latencyJson() const = 0;
+
     /**
      * Ensure enough room to store each currently executing job
      *
@@ -180,7 +193,8 @@ make_PerfLog(
     PerfLog::Setup const& setup,
     Application& app,
     beast::Journal journal,
-    std::function<void()>&& signalStop);
+    std::function<void()>&& signalStop,
+    beast::insight::Collector::ptr const& collector);
 
 template <typename Func, class Rep, class Period>
 auto
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PERFLOG_TRACEDMUTEX_H_INCLUDED
+#define RIPPLE_PERFLOG_TRACEDMUTEX_H_INCLUDED
+
+#include <xrpld/perflog/Histogram.h>
+
+#include <xrpl/json/json_value.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+namespace perf {
+
+/** Contention statistics shared by every traced mutex with one name. */
+struct LockSite
+{
+    explicit LockSite(std::string name_) : name(std::move(name_))
+    {
+    }
+
+    std::string const name;
+    // Acquisitions while tracing was enabled, and how many of those had
+    // to wait because the mutex was held.
+    std::atomic<std::uint64_t> acquired{0};
+    std::atomic<std::uint64_t> contended{0};
+    // Time spent waiting by contended acquisitions, in microseconds.
+    Histogram wait;
+};
+
+/**
+ * The set of lock sites. Sites are never removed, so references to them
+ * remain valid for the life of the process.
+ */
+class LockSites
+{
+public:
+    static LockSites&
+    instance();
+
+    /** Return the site with the given name, creating it if needed. */
+    LockSite&
+    get(std::string const& name);
+
+    /** Turn recording on or off for every traced mutex. Off by default. */
+    static void
+    enable(bool on)
+    {
+        enabled_.store(on, std::memory_order_relaxed);
+    }
+
+    static bool
+    enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /** Render the sites that have spent the most time waiting.
+
+        @param top The maximum number of sites to include.
+    */
+    Json::Value
+    json(std::size_t top) const;
+
+private:
+    LockSites() = default;
+
+    static std::atomic<bool> enabled_;
+    mutable std::mutex mutex_;
+    std::deque<LockSite> sites_;
+};
+
+/**
+ * A mutex that, while lock tracing is enabled, records how long callers
+ * wait to acquire it.
+ *
+ * An uncontended acquisition costs a relaxed atomic increment and uses
+ * try_lock in place of lock. When tracing is disabled it costs a single
+ * relaxed load. TracedMutex meets the same named requirements as Mutex, so it
+ * works with the standard lock types and std::condition_variable_any.
+ */
+template <class Mutex>
+class TracedMutex
+{
+public:
+    explicit TracedMutex(std::string const& name)
+        : site_(LockSites::instance().get(name))
+    {
+    }
+
+    TracedMutex(TracedMutex const&) = delete;
+    TracedMutex&
+    operator=(TracedMutex const&) = delete;
+
+    void
+    lock()
+    {
+        if (!LockSites::enabled())
+        {
+            mutex_.lock();
+            return;
+        }
+
+        site_.acquired.fetch_add(1, std::memory_order_relaxed);
+        if (mutex_.try_lock())
+            return;
+
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
+        mutex_.lock();
+        site_.contended.fetch_add(1, std::memory_order_relaxed);
+        site_.wait.record(
+            duration_cast<microseconds>(steady_clock::now() - start).count());
+    }
+
+    bool
+    try_lock()
+    {
+        return mutex_.try_lock();
+    }
+
+    void
+    unlock()
+    {
+        mutex_.unlock();
+    }
+
+private:
+    Mutex mutex_;
+    LockSite& site_;
+};
+
+}  // namespace perf
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/perflog/Histogram.h>
+
+#include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <string>
+
+namespace ripple {
+namespace perf {
+
+std::size_t
+Histogram::bucket(std::uint64_t value) noexcept
+{
+    if (value < subBuckets)
+        return value;
+
+    // Values at or above 2^maxBits all land in the last bucket.
+    auto const msb = std::min<std::size_t>(
+        std::bit_width(value) - 1, maxBits - 1);
+    auto const shift = msb - subBucketBits;
+    auto const sub = std::min<std::uint64_t>(
+        value >> shift, (std::uint64_t(1) << (subBucketBits + 1)) - 1);
+    return subBuckets * shift + sub;
+}
+
+std::uint64_t
+Histogram::bucketMax(std::size_t bucket) noexcept
+{
+    if (bucket < subBuckets)
+        return bucket;
+
+    auto const shift = bucket / subBuckets - 1;
+    auto const sub = bucket % subBuckets + subBuckets;
+    return ((std::uint64_t(sub) + 1) << shift) - 1;
+}
+
+void
+Histogram::record(std::uint64_t value) noexcept
+{
+    buckets_[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max &&
+           !max_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+Histogram::Snapshot
+Histogram::snapshot() const
+{
+    Snapshot result;
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+        result.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        result.count += result.buckets[i];
+    }
+    // Summing the buckets keeps the count consistent with them even if
+    // samples arrive while they are being read.
+    result.sum = sum_.load(std::memory_order_relaxed);
+    result.max = max_.load(std::memory_order_relaxed);
+    return result;
+}
+
+std::uint64_t
+Histogram::Snapshot::percentile(double fraction) const
+{
+    if (count == 0)
+        return 0;
+
+    XRPL_ASSERT(
+        fraction >= 0 && fraction <= 1,
+        "ripple::perf::Histogram::Snapshot::percentile : valid fraction");
+    auto const target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(fraction * count)));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+            return std::min(bucketMax(i), max);
+    }
+    return max;
+}
+
+Histogram::Snapshot&
+Histogram::Snapshot::operator+=(Snapshot const& other)
+{
+    for (std::size_t i = 0; i < bucketCount; ++i)
+        buckets[i] += other.buckets[i];
+    count += other.count;
+    sum += other.sum;
+    max = std::max(max, other.max);
+    return *this;
+}
+
+Json::Value
+Histogram::Snapshot::json() const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::count] = std::to_string(count);
+    ret[jss::sum_us] = std::to_string(sum);
+    ret[jss::max_us] = std::to_string(max);
+    ret[jss::p50_us] = std::to_string(percentile(0.5));
+    ret[jss::p90_us] = std::to_string(percentile(0.9));
+    ret[jss::p99_us] = std::to_string(percentile(0.99));
+    ret[jss::p999_us] = std::to_string(percentile(0.999));
+    return ret;
+}
+
+}  // namespace perf
+}  // namespace ripple
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <xrpld/core/JobTypes.h>
+#include <xrpld/perflog/TracedMutex.h>
 #include <xrpld/perflog/detail/PerfLogImp.h>
 
 #include <xrpl/basics/BasicConfig.h>
@@ -62,9 +63,16 @@ PerfLogImp::Counters::Counters(
     {
         // populateJq
         jq_.reserve(jobTypes.size());
+        jqLatency_.reserve(jobTypes.size());
         for (auto const& [jobType, _] : jobTypes)
         {
-            auto const inserted = jq_.emplace(jobType, Jq()).second;
+            auto const inserted = jq_.emplace(jobType, Jq()).second &&
+                jqLatency_
+                    .emplace(
+                        std::piecewise_construct,
+                        std::forward_as_tuple(jobType),
+                        std::forward_as_tuple())
+                    .second;
             if (!inserted)
             {
                 // Ensure that no other function populates this entry.
@@ -218,6 +226,43 @@ PerfLogImp::Counters::currentJson() const
     return current;
 }
 
+Json::Value
+PerfLogImp::Counters::latencyJson(std::size_t traceLocks) const
+{
+    Json::Value jqobj(Json::objectValue);
+    // The distributions of all jobs together.
+    Histogram::Snapshot totalQueued;
+    Histogram::Snapshot totalRunning;
+    for (auto const& [type, latency] : jqLatency_)
+    {
+        auto const queued = latency.queued.snapshot();
+        auto const running = latency.running.snapshot();
+        if (!queued.count && !running.count)
+            continue;
+
+        Json::Value j(Json::objectValue);
+        j[jss::queued_us] = queued.json();
+        j[jss::running_us] = running.json();
+        jqobj[JobTypes::name(type)] = j;
+        totalQueued += queued;
+        totalRunning += running;
+    }
+
+    if (totalQueued.count || totalRunning.count)
+    {
+        Json::Value totalJqJson(Json::objectValue);
+        totalJqJson[jss::queued_us] = totalQueued.json();
+        totalJqJson[jss::running_us] = totalRunning.json();
+        jqobj[jss::total] = totalJqJson;
+    }
+
+    Json::Value latency(Json::objectValue);
+    latency[jss::job_queue] = jqobj;
+    if (traceLocks)
+        latency[jss::locks] = LockSites::instance().json(traceLocks);
+    return latency;
+}
+
 //-----------------------------------------------------------------------------
 
 void
@@ -300,6 +345,7 @@ PerfLogImp::report()
     }
     report[jss::hostid] = hostname_;
     report[jss::counters] = counters_.countersJson();
+    report[jss::latency] = counters_.latencyJson(setup_.traceLocks);
     report[jss::nodestore] = Json::objectValue;
     app_.getNodeStore().getCountsJson(report[jss::nodestore]);
     report[jss::current_activities] = counters_.currentJson();
@@ -312,9 +358,15 @@ PerfLogImp::PerfLogImp(
     Setup const& setup,
     Application& app,
     beast::Journal journal,
-    std::function<void()>&& signalStop)
-    : setup_(setup), app_(app), j_(journal), signalStop_(std::move(signalStop))
+    std::function<void()>&& signalStop,
+    beast::insight::Collector::ptr const& collector)
+    : setup_(setup)
+    , app_(app)
+    , j_(journal)
+    , signalStop_(std::move(signalStop))
+    , collector_(collector)
 {
+    LockSites::enable(setup_.traceLocks > 0);
     openLog();
 }
 
@@ -411,6 +463,7 @@ PerfLogImp::jobStart(
         ++counter->second.value.started;
         counter->second.value.queuedDuration += dur;
     }
+    counters_.jqLatency_.at(type).queued.record(dur.count());
     std::lock_guard lock(counters_.jobsMutex_);
     if (instance >= 0 && instance < counters_.jobs_.size())
         counters_.jobs_[instance] = {type, startTime};
@@ -431,6 +484,7 @@ PerfLogImp::jobFinish(JobType const type, microseconds dur, int instance)
         ++counter->second.value.finished;
         counter->second.value.runningDuration += dur;
     }
+    counters_.jqLatency_.at(type).running.record(dur.count());
     std::lock_guard lock(counters_.jobsMutex_);
     if (instance >= 0 && instance < counters_.jobs_.size())
         counters_.jobs_[instance] = {jtINVALID, steady_time_point()};
@@ -455,9 +509,43 @@ PerfLogImp::rotate()
     cond_.notify_one();
 }
 
+void
+PerfLogImp::collect()
+{
+    for (auto const& job : stats_->jobs)
+    {
+        auto const& latency = counters_.jqLatency_.at(job.type);
+        auto const queued = latency.queued.snapshot();
+        auto const running = latency.running.snapshot();
+        job.queuedP99 = queued.percentile(0.99);
+        job.queuedP999 = queued.percentile(0.999);
+        job.runningP99 = running.percentile(0.99);
+        job.runningP999 = running.percentile(0.999);
+    }
+}
+
 void
 PerfLogImp::start()
 {
+    if (!stats_)
+    {
+        stats_.emplace();
+        for (auto const& [type, info] : JobTypes::instance())
+        {
+            if (info.special())
+                continue;
+            auto const& name = info.name();
+            stats_->jobs.push_back(
+                {type,
+                 collector_->make_gauge(name + "_q_p99"),
+                 collector_->make_gauge(name + "_q_p999"),
+                 collector_->make_gauge(name + "_p99"),
+                 collector_->make_gauge(name + "_p999")});
+        }
+        // Hook up last, once everything it reads exists.
+        stats_->hook = collector_->make_hook([this] { collect(); });
+    }
+
     if (setup_.perfLog.size())
         thread_ = std::thread(&PerfLogImp::run, this);
 }
@@ -465,6 +553,9 @@ PerfLogImp::start()
 void
 PerfLogImp::stop()
 {
+    // Must unhook before destroying
+    stats_.reset();
+
     if (thread_.joinable())
     {
         {
@@ -497,6 +588,8 @@ setup_PerfLog(Section const& section, boost::filesystem::path const& configDir)
     std::uint64_t logInterval;
     if (get_if_exists(section, "log_interval", logInterval))
         setup.logInterval = std::chrono::seconds(logInterval);
+
+    set(setup.traceLocks, "trace_locks", section);
     return setup;
 }
 
@@ -505,10 +598,11 @@ make_PerfLog(
     PerfLog::Setup const& setup,
     Application& app,
     beast::Journal journal,
-    std::function<void()>&& signalStop)
+    std::function<void()>&& signalStop,
+    beast::insight::Collector::ptr const& collector)
 {
     return std::make_unique<PerfLogImp>(
-        setup, app, journal, std::move(signalStop));
+        setup, app, journal, std::move(signalStop), collector);
 }
 
 }  // namespace perf
@@ -20,9 +20,11 @@
 #ifndef RIPPLE_BASICS_PERFLOGIMP_H
 #define RIPPLE_BASICS_PERFLOGIMP_H
 
+#include <xrpld/perflog/Histogram.h>
 #include <xrpld/perflog/PerfLog.h>
 #include <xrpld/rpc/detail/Handler.h>
 
+#include <xrpl/beast/insight/Insight.h>
 #include <xrpl/beast/utility/Journal.h>
 
 #include <boost/asio/ip/host_name.hpp>
@@ -31,6 +33,7 @@
 #include <cstdint>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -102,10 +105,20 @@ class PerfLogImp : public PerfLog
             microseconds runningDuration{0};
         };
 
-        // rpc_ and jq_ do not need mutex protection because all
+        /**
+         * Job Queue task latency distributions. Recorded without locking.
+         */
+        struct JqLatency
+        {
+            Histogram queued;
+            Histogram running;
+        };
+
+        // rpc_, jq_ and jqLatency_ do not need mutex protection because all
         // keys and values are created before more threads are started.
         std::unordered_map<std::string, Locked<Rpc>> rpc_;
         std::unordered_map<JobType, Locked<Jq>> jq_;
+        std::unordered_map<JobType, JqLatency> jqLatency_;
         std::vector<std::pair<JobType, steady_time_point>> jobs_;
         mutable std::mutex jobsMutex_;
         std::unordered_map<std::uint64_t, MethodStart> methods_;
@@ -116,12 +129,33 @@ class PerfLogImp : public PerfLog
         countersJson() const;
         Json::Value
         currentJson() const;
+        Json::Value
+        latencyJson(std::size_t traceLocks) const;
+    };
+
+    /**
+     * Tail latencies published through insight.
+     */
+    struct Stats
+    {
+        struct Job
+        {
+            JobType type;
+            beast::insight::Gauge queuedP99;
+            beast::insight::Gauge queuedP999;
+            beast::insight::Gauge runningP99;
+            beast::insight::Gauge runningP999;
+        };
+
+        std::vector<Job> jobs;
+        beast::insight::Hook hook;
     };
 
     Setup const setup_;
     Application& app_;
     beast::Journal const j_;
     std::function<void()> const signalStop_;
+    beast::insight::Collector::ptr const collector_;
     Counters counters_{ripple::RPC::getHandlerNames(), JobTypes::instance()};
     std::ofstream logFile_;
     std::thread thread_;
@@ -131,10 +165,13 @@ class PerfLogImp : public PerfLog
     std::string const hostname_{boost::asio::ip::host_name()};
     bool stop_{false};
     bool rotate_{false};
+    std::optional<Stats> stats_;
 
     void
     openLog();
     void
+    collect();
+    void
     run();
     void
     report();
@@ -149,7 +186,8 @@ public:
         Setup const& setup,
         Application& app,
         beast::Journal journal,
-        std::function<void()>&& signalStop);
+        std::function<void()>&& signalStop,
+        beast::insight::Collector::ptr const& collector);
 
     ~PerfLogImp() override;
 
@@ -191,6 +229,12 @@ public:
         return counters_.currentJson();
     }
 
+    Json::Value
+    latencyJson() const override
+    {
+        return counters_.latencyJson(setup_.traceLocks);
+    }
+
     void
     resizeJobs(int const resize) override;
     void
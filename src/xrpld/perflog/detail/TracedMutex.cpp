@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/perflog/TracedMutex.h>
+
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace ripple {
+namespace perf {
+
+std::atomic<bool> LockSites::enabled_{false};
+
+LockSites&
+LockSites::instance()
+{
+    static LockSites sites;
+    return sites;
+}
+
+LockSite&
+LockSites::get(std::string const& name)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = std::find_if(
+        sites_.begin(), sites_.end(), [&name](LockSite const& site) {
+            return site.name == name;
+        });
+    if (it != sites_.end())
+        return *it;
+    return sites_.emplace_back(name);
+}
+
+Json::Value
+LockSites::json(std::size_t top) const
+{
+    std::vector<std::pair<LockSite const*, Histogram::Snapshot>> waits;
+    {
+        std::lock_guard lock(mutex_);
+        waits.reserve(sites_.size());
+        for (auto const& site : sites_)
+            waits.emplace_back(&site, site.wait.snapshot());
+    }
+
+    top = std::min(top, waits.size());
+    std::partial_sort(
+        waits.begin(),
+        waits.begin() + top,
+        waits.end(),
+        [](auto const& a, auto const& b) {
+            return a.second.sum > b.second.sum;
+        });
+
+    Json::Value ret(Json::objectValue);
+    for (std::size_t i = 0; i < top; ++i)
+    {
+        auto const& [site, wait] = waits[i];
+        Json::Value& s = ret[site->name];
+        s[jss::acquired] = std::to_string(site->acquired);
+        s[jss::contended] = std::to_string(site->contended);
+        s[jss::wait_us] = wait.json();
+    }
+    return ret;
+}
+
+}  // namespace perf
+}  // namespace ripple
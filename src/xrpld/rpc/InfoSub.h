@@ -21,6 +21,7 @@
 #define RIPPLE_NET_INFOSUB_H_INCLUDED
 
 #include <xrpld/app/misc/Manifest.h>
+#include <xrpld/rpc/PublishedJson.h>
 
 #include <xrpl/basics/CountedObject.h>
 #include <xrpl/json/json_value.h>
@@ -201,6 +202,18 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message that is being published to many subscribers.
+
+        Subscribers that can share the message's serialized form with the
+        other subscribers should override this. By default, the message's
+        JSON is sent.
+    */
+    virtual void
+    publish(std::shared_ptr<PublishedJson const> const& msg, bool broadcast)
+    {
+        send(msg->json(), broadcast);
+    }
+
     std::uint64_t
     getSeq();
 
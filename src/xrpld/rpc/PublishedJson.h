@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_PUBLISHEDJSON_H_INCLUDED
+#define RIPPLE_RPC_PUBLISHEDJSON_H_INCLUDED
+
+#include <xrpl/json/json_value.h>
+#include <xrpl/protocol/MultiApiJson.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+/** A stream message published, unchanged, to many subscribers.
+
+    The message is immutable once made. Its serialized form is produced
+    the first time a subscriber asks for it and then shared by every
+    subscriber, so publishing to N subscribers serializes the message
+    once rather than N times.
+*/
+class PublishedJson
+{
+    Json::Value const jv_;
+    mutable std::once_flag once_;
+    mutable std::shared_ptr<std::string const> text_;
+
+public:
+    explicit PublishedJson(Json::Value jv) : jv_(std::move(jv))
+    {
+    }
+
+    PublishedJson(PublishedJson const&) = delete;
+    PublishedJson&
+    operator=(PublishedJson const&) = delete;
+
+    Json::Value const&
+    json() const
+    {
+        return jv_;
+    }
+
+    /** The message as written by Json::stream.
+
+        @note This function is thread-safe.
+    */
+    std::shared_ptr<std::string const> const&
+    text() const;
+};
+
+/** The PublishedJson for each API version of a MultiApiJson.
+
+    Each version's message is made on first use, so versions that no
+    subscriber uses cost nothing.
+*/
+class PublishedMultiApiJson
+{
+    MultiApiJson const& json_;
+    std::array<std::shared_ptr<PublishedJson const>, MultiApiJson::size>
+        published_;
+
+public:
+    explicit PublishedMultiApiJson(MultiApiJson const& json) : json_(json)
+    {
+    }
+
+    std::shared_ptr<PublishedJson const> const&
+    operator()(unsigned int apiVersion);
+};
+
+}  // namespace ripple
+
+#endif
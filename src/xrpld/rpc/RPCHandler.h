@@ -20,6 +20,7 @@
 #ifndef RIPPLE_RPC_RPCHANDLER_H_INCLUDED
 #define RIPPLE_RPC_RPCHANDLER_H_INCLUDED
 
+#include <xrpld/core/CoroTask.h>
 #include <xrpld/rpc/Context.h>
 #include <xrpld/rpc/Status.h>
 
@@ -32,6 +33,22 @@ struct JsonContext;
 Status
 doCommand(RPC::JsonContext&, Json::Value&);
 
+/** Execute an RPC command without a JobQueue::Coro.
+
+    Commands with a stackless handler run as part of the returned task and
+    may suspend it. Every other command runs to completion before the task
+    first suspends, exactly as doCommand would run it.
+*/
+CoroTask<Status>
+doCommandAsync(RPC::JsonContext&, Json::Value&);
+
+/** Whether a command has a stackless handler that may suspend. */
+bool
+hasAsyncHandler(
+    unsigned int version,
+    bool betaEnabled,
+    std::string const& method);
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method);
 
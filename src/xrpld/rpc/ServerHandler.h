@@ -22,10 +22,15 @@
 
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/main/CollectorManager.h>
+#include <xrpld/core/CoroTask.h>
 #include <xrpld/core/JobQueue.h>
+#include <xrpld/rpc/Context.h>
+#include <xrpld/rpc/Role.h>
 #include <xrpld/rpc/detail/WSInfoSub.h>
 
 #include <xrpl/json/Output.h>
+#include <xrpl/resource/Charge.h>
+#include <xrpl/resource/Fees.h>
 #include <xrpl/server/Server.h>
 #include <xrpl/server/Session.h>
 #include <xrpl/server/WSSession.h>
@@ -37,6 +42,7 @@
 #include <condition_variable>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace ripple {
@@ -198,17 +204,67 @@ private:
         std::shared_ptr<JobQueue::Coro> const& coro,
         Json::Value const& jv);
 
+    // Like processSession, for a command with a stackless handler.
+    CoroTask<Json::Value>
+    processSessionAsync(std::shared_ptr<WSSession> session, Json::Value jv);
+
+    // A websocket command that has passed its checks. The context refers
+    // to loadType, so a WSCommand is never copied.
+    struct WSCommand
+    {
+        std::shared_ptr<WSInfoSub> is;
+        Json::Value jr{Json::objectValue};
+        Resource::Charge loadType = Resource::feeReferenceRPC;
+        // Empty if the command is not to be run.
+        std::optional<RPC::JsonContext> context;
+
+        WSCommand() = default;
+        WSCommand(WSCommand const&) = delete;
+        WSCommand&
+        operator=(WSCommand const&) = delete;
+    };
+
+    // The checks shared by both ways of running a websocket command.
+    // Returns the response if the request gets no further, and otherwise
+    // fills in command.
+    std::optional<Json::Value>
+    beginWSCommand(
+        std::shared_ptr<WSSession> const& session,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        Json::Value const& jv,
+        WSCommand& command);
+
+    // The response to a websocket request that is not a well formed
+    // command, if it is not.
+    std::optional<Json::Value>
+    checkWSRequest(WSInfoSub& is, Json::Value const& jv, unsigned apiVersion);
+
+    void
+    failWSCommand(
+        Json::Value const& jv,
+        WSCommand& command,
+        std::exception const& ex);
+
+    Json::Value
+    finishWSResponse(Json::Value const& jv, WSCommand& command);
+
+    // Whether an HTTP request names a command that may suspend, and so
+    // must run in a JobQueue::Coro.
+    bool
+    needsCoro(Json::Value const& request) const;
+
     void
     processSession(
         std::shared_ptr<Session> const&,
-        std::shared_ptr<JobQueue::Coro> coro);
+        std::shared_ptr<JobQueue::Coro> coro,
+        Json::Value const& jsonOrig);
 
     void
     processRequest(
         Port const& port,
-        std::string const& request,
+        Json::Value const& jsonOrig,
         beast::IP::Endpoint const& remoteIPAddress,
-        Output&&,
+        Session& session,
         std::shared_ptr<JobQueue::Coro> coro,
         std::string_view forwardedFor,
         std::string_view user);
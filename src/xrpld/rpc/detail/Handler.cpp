@@ -47,6 +47,30 @@ byRef(Function const& f)
     };
 }
 
+template <typename Function>
+CoroTask<Status>
+callByRef(Function f, JsonContext& context, Json::Value& result)
+{
+    result = co_await f(context);
+    if (result.type() != Json::objectValue)
+    {
+        UNREACHABLE("ripple::RPC::callByRef : result is object");
+        result = RPC::makeObjectValue(result);
+    }
+
+    co_return Status();
+}
+
+/** Adjust an old-style stackless handler to be call-by-reference. */
+template <typename Function>
+Handler::AsyncMethod<Json::Value>
+byRefAsync(Function const& f)
+{
+    return [f](JsonContext& context, Json::Value& result) {
+        return callByRef(f, context, result);
+    };
+}
+
 template <class Object, class HandlerImpl>
 Status
 handle(JsonContext& context, Object& object)
@@ -157,7 +181,13 @@ Handler const handlerArray[]{
      byRef(&doPeerReservationsList),
      Role::ADMIN,
      NO_CONDITION},
-    {"ripple_path_find", byRef(&doRipplePathFind), Role::USER, NO_CONDITION},
+    {"ripple_path_find",
+     byRef(&doRipplePathFind),
+     Role::USER,
+     NO_CONDITION,
+     apiMinimumSupportedVersion,
+     apiMaximumValidVersion,
+     byRefAsync(&doRipplePathFindAsync)},
     {"server_definitions",
      byRef(&doServerDefinitions),
      Role::USER,
@@ -22,6 +22,7 @@
 
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/misc/NetworkOPs.h>
+#include <xrpld/core/CoroTask.h>
 #include <xrpld/rpc/RPCHandler.h>
 #include <xrpld/rpc/Status.h>
 #include <xrpld/rpc/detail/RPCHelpers.h>
@@ -47,6 +48,10 @@ struct Handler
     template <class JsonValue>
     using Method = std::function<Status(JsonContext&, JsonValue&)>;
 
+    template <class JsonValue>
+    using AsyncMethod =
+        std::function<CoroTask<Status>(JsonContext&, JsonValue&)>;
+
     char const* name_;
     Method<Json::Value> valueMethod_;
     Role role_;
@@ -54,6 +59,10 @@ struct Handler
 
     unsigned minApiVer_ = apiMinimumSupportedVersion;
     unsigned maxApiVer_ = apiMaximumValidVersion;
+
+    // For commands that may wait for other work, such as path finding, a
+    // stackless version that can run without a JobQueue::Coro.
+    AsyncMethod<Json::Value> asyncMethod_ = {};
 };
 
 Handler const*
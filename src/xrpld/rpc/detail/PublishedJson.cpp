@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/rpc/PublishedJson.h>
+
+#include <xrpl/beast/utility/instrumentation.h>
+#include <xrpl/json/json_writer.h>
+
+namespace ripple {
+
+std::shared_ptr<std::string const> const&
+PublishedJson::text() const
+{
+    std::call_once(once_, [this]() {
+        std::string s;
+        Json::stream(jv_, [&s](void const* data, std::size_t n) {
+            s.append(static_cast<char const*>(data), n);
+        });
+        text_ = std::make_shared<std::string const>(std::move(s));
+    });
+    return text_;
+}
+
+std::shared_ptr<PublishedJson const> const&
+PublishedMultiApiJson::operator()(unsigned int apiVersion)
+{
+    XRPL_ASSERT(
+        MultiApiJson::valid(apiVersion),
+        "ripple::PublishedMultiApiJson::operator() : valid API version");
+    auto& published = published_[MultiApiJson::index(apiVersion)];
+    if (!published)
+    {
+        json_.visit(apiVersion, [&published](Json::Value const& jv) {
+            published = std::make_shared<PublishedJson const>(jv);
+        });
+    }
+    return published;
+}
+
+}  // namespace ripple
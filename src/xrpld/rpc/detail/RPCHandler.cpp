@@ -176,6 +176,9 @@ fillHandler(JsonContext& context, Handler const*& result)
     return rpcSUCCESS;
 }
 
+// Identifies each command to the PerfLog.
+std::atomic<std::uint64_t> requestId{0};
+
 template <class Object, class Method>
 Status
 callMethod(
@@ -184,7 +187,6 @@ callMethod(
     std::string const& name,
     Object& result)
 {
-    static std::atomic<std::uint64_t> requestId{0};
     auto& perfLog = context.app.getPerfLog();
     std::uint64_t const curId = ++requestId;
     try
@@ -216,6 +218,44 @@ callMethod(
     }
 }
 
+template <class Object, class Method>
+CoroTask<Status>
+callMethodAsync(
+    JsonContext& context,
+    Method method,
+    std::string const& name,
+    Object& result)
+{
+    auto& perfLog = context.app.getPerfLog();
+    std::uint64_t const curId = ++requestId;
+    try
+    {
+        // There is no LoadEvent here, since time spent suspended is not
+        // load on the server.
+        perfLog.rpcStart(name, curId);
+        auto start = std::chrono::system_clock::now();
+        auto ret = co_await method(context, result);
+        auto end = std::chrono::system_clock::now();
+
+        JLOG(context.j.debug())
+            << "RPC call " << name << " completed in "
+            << ((end - start).count() / 1000000000.0) << "seconds";
+        perfLog.rpcFinish(name, curId);
+        co_return ret;
+    }
+    catch (std::exception& e)
+    {
+        perfLog.rpcError(name, curId);
+        JLOG(context.j.info()) << "Caught throw: " << e.what();
+
+        if (context.loadType == Resource::feeReferenceRPC)
+            context.loadType = Resource::feeExceptionRPC;
+
+        inject_error(rpcINTERNAL, result);
+        co_return rpcINTERNAL;
+    }
+}
+
 }  // namespace
 
 Status
@@ -257,6 +297,43 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
     return rpcUNKNOWN_COMMAND;
 }
 
+CoroTask<Status>
+doCommandAsync(RPC::JsonContext& context, Json::Value& result)
+{
+    Handler const* handler = nullptr;
+    if (auto error = fillHandler(context, handler))
+    {
+        inject_error(error, result);
+        co_return error;
+    }
+
+    if (auto method = handler->asyncMethod_)
+    {
+        JLOG(context.j.debug())
+            << "start stackless command: " << handler->name_
+            << ", user: " << context.headers.user
+            << ", forwarded for: " << context.headers.forwardedFor;
+
+        co_return co_await callMethodAsync(
+            context, method, handler->name_, result);
+    }
+
+    if (auto method = handler->valueMethod_)
+        co_return callMethod(context, method, handler->name_, result);
+
+    co_return rpcUNKNOWN_COMMAND;
+}
+
+bool
+hasAsyncHandler(
+    unsigned int version,
+    bool betaEnabled,
+    std::string const& method)
+{
+    auto handler = RPC::getHandler(version, betaEnabled, method);
+    return handler && handler->asyncMethod_;
+}
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method)
 {
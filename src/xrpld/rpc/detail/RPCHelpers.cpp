@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <xrpld/app/ledger/Ledger.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/ledger/LedgerToJson.h>
 #include <xrpld/app/ledger/OpenLedger.h>
@@ -268,6 +269,15 @@ getAccountObjects(
         return true;
     }
 
+    // The entries of a directory page are scattered across the state map.
+    // Load them, and the next page, in a few batch reads rather than one
+    // read per entry.
+    auto const stateMap = [&ledger]() -> SHAMap const* {
+        if (auto const l = dynamic_cast<Ledger const*>(&ledger))
+            return &l->stateMap();
+        return nullptr;
+    }();
+
     std::uint32_t i = 0;
     for (;;)
     {
@@ -283,6 +293,16 @@ getAccountObjects(
             found = true;
         }
 
+        if (stateMap && i < mlimit)
+        {
+            auto const count = std::min<std::size_t>(
+                std::distance(iter, entries.end()), mlimit - i);
+            std::vector<uint256> keys(iter, iter + count);
+            if (auto const next = dir->getFieldU64(sfIndexNext))
+                keys.push_back(keylet::page(root, next).key);
+            stateMap->prefetch(std::move(keys));
+        }
+
         // it's possible that the returned NFTPages exactly filled the
         // response.  Check for that condition.
         if (i == mlimit && mlimit < limit)
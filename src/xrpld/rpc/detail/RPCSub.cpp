@@ -77,13 +77,22 @@ public:
 
     void
     send(Json::Value const& jvObj, bool broadcast) override
+    {
+        publish(std::make_shared<PublishedJson const>(jvObj), broadcast);
+    }
+
+    void
+    publish(std::shared_ptr<PublishedJson const> const& msg, bool broadcast)
+        override
     {
         std::lock_guard sl(mLock);
 
         auto jm = broadcast ? j_.debug() : j_.info();
-        JLOG(jm) << "RPCCall::fromNetwork push: " << jvObj;
+        JLOG(jm) << "RPCCall::fromNetwork push: " << msg->json();
 
-        mDeque.push_back(std::make_pair(mSeq++, jvObj));
+        // The message is shared with the other subscribers, and copied only
+        // when it is sent, away from the publisher.
+        mDeque.push_back(std::make_pair(mSeq++, msg));
 
         if (!mSending)
         {
@@ -139,7 +148,7 @@ private:
 
                     mDeque.pop_front();
 
-                    jvEvent = env;
+                    jvEvent = env->json();
                     jvEvent["seq"] = seq;
 
                     bSend = true;
@@ -192,7 +201,7 @@ private:
 
     bool mSending;  // Sending threead is active.
 
-    std::deque<std::pair<int, Json::Value>> mDeque;
+    std::deque<std::pair<int, std::shared_ptr<PublishedJson const>>> mDeque;
 
     beast::Journal const j_;
     Logs& logs_;
@@ -292,6 +292,42 @@ buffers_to_string(ConstBufferSequence const& bs)
     return s;
 }
 
+bool
+ServerHandler::needsCoro(Json::Value const& request) const
+{
+    auto const suspends = [this](Json::Value const& jsonRPC) {
+        if (!jsonRPC.isObject() || !jsonRPC.isMember(jss::method) ||
+            !jsonRPC[jss::method].isString())
+            return false;
+
+        // The version is looked for where processRequest looks for it. A
+        // command that might be given a coroutine is assumed to need one.
+        auto const& params = jsonRPC[jss::params];
+        auto const apiVersion = params.isArray() && params.size() > 0 &&
+                params[0u].isObject()
+            ? RPC::getAPIVersionNumber(params[0u], app_.config().BETA_RPC_API)
+            : RPC::getAPIVersionNumber(jsonRPC, app_.config().BETA_RPC_API);
+        return RPC::hasAsyncHandler(
+            apiVersion,
+            app_.config().BETA_RPC_API,
+            jsonRPC[jss::method].asString());
+    };
+
+    if (request.isMember(jss::method) && request[jss::method] == "batch")
+    {
+        auto const& params = request[jss::params];
+        if (!params.isArray())
+            return false;
+        for (auto const& jsonRPC : params)
+        {
+            if (suspends(jsonRPC))
+                return true;
+        }
+        return false;
+    }
+    return suspends(request);
+}
+
 void
 ServerHandler::onRequest(Session& session)
 {
@@ -312,26 +348,86 @@ ServerHandler::onRequest(Session& session)
         return;
     }
 
+    // Parse the body here, as for a websocket message, so the request can
+    // be routed by its command.
+    Json::Value jv;
+    {
+        auto const request = buffers_to_string(session.request().body().data());
+        Json::Reader reader;
+        if ((request.size() > RPC::Tuning::maxRequestSize) ||
+            !reader.parse(request, jv) || !jv || !jv.isObject())
+        {
+            HTTPReply(
+                400,
+                "Unable to parse request: " + reader.getFormatedErrorMessages(),
+                makeOutput(session),
+                app_.journal("RPC"));
+            if (beast::rfc2616::is_keep_alive(session.request()))
+                session.complete();
+            else
+                session.close(true);
+            return;
+        }
+    }
+
     std::shared_ptr<Session> detachedSession = session.detach();
-    auto const postResult = m_jobQueue.postCoro(
-        jtCLIENT_RPC,
-        "RPC-Client",
-        [this, detachedSession](std::shared_ptr<JobQueue::Coro> coro) {
-            processSession(detachedSession, coro);
-        });
-    if (postResult == nullptr)
+    bool posted = false;
+    if (app_.config().STACKLESS_RPC && !needsCoro(jv))
     {
-        // The coroutine was rejected, probably because we're shutting down.
+        // No command in the request suspends, so it runs straight through
+        // on a job without a coroutine stack.
+        posted = m_jobQueue.addJob(
+            jtCLIENT_RPC,
+            "RPC-Client",
+            [this, detachedSession, jv = std::move(jv)]() {
+                processSession(detachedSession, {}, jv);
+            });
+    }
+    else
+    {
+        posted = m_jobQueue.postCoro(
+                     jtCLIENT_RPC,
+                     "RPC-Client",
+                     [this, detachedSession, jv = std::move(jv)](
+                         std::shared_ptr<JobQueue::Coro> coro) {
+                         processSession(detachedSession, coro, jv);
+                     }) != nullptr;
+    }
+    if (!posted)
+    {
+        // The job was rejected, probably because we're shutting down.
         HTTPReply(
             503,
             "Service Unavailable",
             makeOutput(*detachedSession),
             app_.journal("RPC"));
         detachedSession->close(true);
-        return;
     }
 }
 
+// Serialize a reply, followed by a newline, in a single pass.
+static std::string
+serializeReply(Json::Value const& jr)
+{
+    std::string s;
+    Json::stream(jr, [&s](void const* data, std::size_t n) {
+        s.append(static_cast<char const*>(data), n);
+    });
+    return s;
+}
+
+static void
+sendResponse(WSSession& session, Json::Value const& jr)
+{
+    auto s = serializeReply(jr);
+    s.pop_back();
+
+    // The message owns the serialized reply, so it is not copied again.
+    session.send(std::make_shared<SharedBufferWSMsg>(
+        std::make_shared<std::string const>(std::move(s))));
+    session.complete();
+}
+
 void
 ServerHandler::onWSMessage(
     std::shared_ptr<WSSession> session,
@@ -360,20 +456,51 @@ ServerHandler::onWSMessage(
 
     JLOG(m_journal.trace()) << "Websocket received '" << jv << "'";
 
+    if (app_.config().STACKLESS_RPC)
+    {
+        // Only commands that may suspend need a coroutine frame. The rest
+        // run straight through on a job.
+        auto const postResult = m_jobQueue.addJob(
+            jtCLIENT_WEBSOCKET,
+            "WS-Client",
+            [this, session, jv = std::move(jv)]() {
+                auto const apiVersion = RPC::getAPIVersionNumber(
+                    jv, app_.config().BETA_RPC_API);
+                auto const& method = jv.isMember(jss::command)
+                    ? jv[jss::command]
+                    : jv[jss::method];
+                if (method.isString() &&
+                    RPC::hasAsyncHandler(
+                        apiVersion,
+                        app_.config().BETA_RPC_API,
+                        method.asString()))
+                {
+                    runCoroTask(
+                        processSessionAsync(session, jv),
+                        [session](Json::Value const& jr) {
+                            sendResponse(*session, jr);
+                        });
+                }
+                else
+                {
+                    sendResponse(*session, processSession(session, {}, jv));
+                }
+            });
+        if (!postResult)
+        {
+            // The job was rejected, probably because we're shutting down.
+            session->close(
+                {boost::beast::websocket::going_away, "Shutting Down"});
+        }
+        return;
+    }
+
     auto const postResult = m_jobQueue.postCoro(
         jtCLIENT_WEBSOCKET,
         "WS-Client",
         [this, session, jv = std::move(jv)](
             std::shared_ptr<JobQueue::Coro> const& coro) {
-            auto const jr = this->processSession(session, coro, jv);
-            auto const s = to_string(jr);
-            auto const n = s.length();
-            boost::beast::multi_buffer sb(n);
-            sb.commit(boost::asio::buffer_copy(
-                sb.prepare(n), boost::asio::buffer(s.c_str(), n)));
-            session->send(
-                std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb)));
-            session->complete();
+            sendResponse(*session, this->processSession(session, coro, jv));
         });
     if (postResult == nullptr)
     {
@@ -418,14 +545,52 @@ logDuration(
                 << " microseconds. request = " << request;
 }
 
-Json::Value
-ServerHandler::processSession(
+std::optional<Json::Value>
+ServerHandler::checkWSRequest(
+    WSInfoSub& is,
+    Json::Value const& jv,
+    unsigned apiVersion)
+{
+    // Requests without "command" are invalid.
+    bool const malformed = apiVersion == RPC::apiInvalidVersion ||
+        (!jv.isMember(jss::command) && !jv.isMember(jss::method)) ||
+        (jv.isMember(jss::command) && !jv[jss::command].isString()) ||
+        (jv.isMember(jss::method) && !jv[jss::method].isString()) ||
+        (jv.isMember(jss::command) && jv.isMember(jss::method) &&
+         jv[jss::command].asString() != jv[jss::method].asString());
+    if (!malformed)
+        return std::nullopt;
+
+    Json::Value jr(Json::objectValue);
+    jr[jss::type] = jss::response;
+    jr[jss::status] = jss::error;
+    jr[jss::error] = apiVersion == RPC::apiInvalidVersion
+        ? jss::invalid_API_version
+        : jss::missingCommand;
+    jr[jss::request] = jv;
+    if (jv.isMember(jss::id))
+        jr[jss::id] = jv[jss::id];
+    if (jv.isMember(jss::jsonrpc))
+        jr[jss::jsonrpc] = jv[jss::jsonrpc];
+    if (jv.isMember(jss::ripplerpc))
+        jr[jss::ripplerpc] = jv[jss::ripplerpc];
+    if (jv.isMember(jss::api_version))
+        jr[jss::api_version] = jv[jss::api_version];
+
+    is.getConsumer().charge(Resource::feeMalformedRPC);
+    return jr;
+}
+
+std::optional<Json::Value>
+ServerHandler::beginWSCommand(
     std::shared_ptr<WSSession> const& session,
     std::shared_ptr<JobQueue::Coro> const& coro,
-    Json::Value const& jv)
+    Json::Value const& jv,
+    WSCommand& command)
 {
-    auto is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
-    if (is->getConsumer().disconnect(m_journal))
+    command.is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
+    auto& is = *command.is;
+    if (is.getConsumer().disconnect(m_journal))
     {
         session->close(
             {boost::beast::websocket::policy_error, "threshold exceeded"});
@@ -434,38 +599,12 @@ ServerHandler::processSession(
         return rpcError(rpcSLOW_DOWN);
     }
 
-    // Requests without "command" are invalid.
-    Json::Value jr(Json::objectValue);
-    Resource::Charge loadType = Resource::feeReferenceRPC;
     try
     {
         auto apiVersion =
             RPC::getAPIVersionNumber(jv, app_.config().BETA_RPC_API);
-        if (apiVersion == RPC::apiInvalidVersion ||
-            (!jv.isMember(jss::command) && !jv.isMember(jss::method)) ||
-            (jv.isMember(jss::command) && !jv[jss::command].isString()) ||
-            (jv.isMember(jss::method) && !jv[jss::method].isString()) ||
-            (jv.isMember(jss::command) && jv.isMember(jss::method) &&
-             jv[jss::command].asString() != jv[jss::method].asString()))
-        {
-            jr[jss::type] = jss::response;
-            jr[jss::status] = jss::error;
-            jr[jss::error] = apiVersion == RPC::apiInvalidVersion
-                ? jss::invalid_API_version
-                : jss::missingCommand;
-            jr[jss::request] = jv;
-            if (jv.isMember(jss::id))
-                jr[jss::id] = jv[jss::id];
-            if (jv.isMember(jss::jsonrpc))
-                jr[jss::jsonrpc] = jv[jss::jsonrpc];
-            if (jv.isMember(jss::ripplerpc))
-                jr[jss::ripplerpc] = jv[jss::ripplerpc];
-            if (jv.isMember(jss::api_version))
-                jr[jss::api_version] = jv[jss::api_version];
-
-            is->getConsumer().charge(Resource::feeMalformedRPC);
-            return jr;
-        }
+        if (auto malformed = checkWSRequest(is, jv, apiVersion))
+            return malformed;
 
         auto required = RPC::roleRequired(
             apiVersion,
@@ -477,44 +616,55 @@ ServerHandler::processSession(
             session->port(),
             jv,
             beast::IP::from_asio(session->remote_endpoint().address()),
-            is->user());
+            is.user());
         if (Role::FORBID == role)
         {
-            loadType = Resource::feeMalformedRPC;
-            jr[jss::result] = rpcError(rpcFORBIDDEN);
+            command.loadType = Resource::feeMalformedRPC;
+            command.jr[jss::result] = rpcError(rpcFORBIDDEN);
         }
         else
         {
-            RPC::JsonContext context{
+            command.context.emplace(RPC::JsonContext{
                 {app_.journal("RPCHandler"),
                  app_,
-                 loadType,
+                 command.loadType,
                  app_.getOPs(),
                  app_.getLedgerMaster(),
-                 is->getConsumer(),
+                 is.getConsumer(),
                  role,
                  coro,
-                 is,
+                 command.is,
                  apiVersion},
                 jv,
-                {is->user(), is->forwarded_for()}};
-
-            auto start = std::chrono::system_clock::now();
-            RPC::doCommand(context, jr[jss::result]);
-            auto end = std::chrono::system_clock::now();
-            logDuration(jv, end - start, m_journal);
+                {is.user(), is.forwarded_for()}});
         }
     }
     catch (std::exception const& ex)
     {
-        jr[jss::result] = RPC::make_error(rpcINTERNAL);
-        JLOG(m_journal.error())
-            << "Exception while processing WS: " << ex.what() << "\n"
-            << "Input JSON: " << Json::Compact{Json::Value{jv}};
+        failWSCommand(jv, command, ex);
     }
+    return std::nullopt;
+}
+
+void
+ServerHandler::failWSCommand(
+    Json::Value const& jv,
+    WSCommand& command,
+    std::exception const& ex)
+{
+    command.jr[jss::result] = RPC::make_error(rpcINTERNAL);
+    JLOG(m_journal.error())
+        << "Exception while processing WS: " << ex.what() << "\n"
+        << "Input JSON: " << Json::Compact{Json::Value{jv}};
+}
 
-    is->getConsumer().charge(loadType);
-    if (is->getConsumer().warn())
+Json::Value
+ServerHandler::finishWSResponse(Json::Value const& jv, WSCommand& command)
+{
+    auto& is = *command.is;
+    auto& jr = command.jr;
+    is.getConsumer().charge(command.loadType);
+    if (is.getConsumer().warn())
         jr[jss::warning] = jss::load;
 
     // Currently we will simply unwrap errors returned by the RPC
@@ -564,17 +714,75 @@ ServerHandler::processSession(
     return jr;
 }
 
-// Run as a coroutine.
+Json::Value
+ServerHandler::processSession(
+    std::shared_ptr<WSSession> const& session,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    Json::Value const& jv)
+{
+    WSCommand command;
+    if (auto response = beginWSCommand(session, coro, jv, command))
+        return std::move(*response);
+
+    if (command.context)
+    {
+        try
+        {
+            auto start = std::chrono::system_clock::now();
+            RPC::doCommand(*command.context, command.jr[jss::result]);
+            auto end = std::chrono::system_clock::now();
+            logDuration(jv, end - start, m_journal);
+        }
+        catch (std::exception const& ex)
+        {
+            failWSCommand(jv, command, ex);
+        }
+    }
+    return finishWSResponse(jv, command);
+}
+
+// The frame of this task holds the request and the context while the
+// command is suspended, in place of a JobQueue::Coro's stack.
+CoroTask<Json::Value>
+ServerHandler::processSessionAsync(
+    std::shared_ptr<WSSession> session,
+    Json::Value jv)
+{
+    WSCommand command;
+    if (auto response = beginWSCommand(session, {}, jv, command))
+        co_return std::move(*response);
+
+    if (command.context)
+    {
+        try
+        {
+            auto start = std::chrono::system_clock::now();
+            co_await RPC::doCommandAsync(
+                *command.context, command.jr[jss::result]);
+            auto end = std::chrono::system_clock::now();
+            logDuration(jv, end - start, m_journal);
+        }
+        catch (std::exception const& ex)
+        {
+            failWSCommand(jv, command, ex);
+        }
+    }
+    co_return finishWSResponse(jv, command);
+}
+
+// Run as a coroutine, or as a plain job when no command in the request
+// can suspend.
 void
 ServerHandler::processSession(
     std::shared_ptr<Session> const& session,
-    std::shared_ptr<JobQueue::Coro> coro)
+    std::shared_ptr<JobQueue::Coro> coro,
+    Json::Value const& jsonOrig)
 {
     processRequest(
         session->port(),
-        buffers_to_string(session->request().body().data()),
+        jsonOrig,
         session->remoteAddress().at_port(0),
-        makeOutput(*session),
+        *session,
         coro,
         forwardedFor(session->request()),
         [&] {
@@ -609,30 +817,15 @@ Json::Int constexpr wrong_version = -32606;
 void
 ServerHandler::processRequest(
     Port const& port,
-    std::string const& request,
+    Json::Value const& jsonOrig,
     beast::IP::Endpoint const& remoteIPAddress,
-    Output&& output,
+    Session& session,
     std::shared_ptr<JobQueue::Coro> coro,
     std::string_view forwardedFor,
     std::string_view user)
 {
     auto rpcJ = app_.journal("RPC");
-
-    Json::Value jsonOrig;
-    {
-        Json::Reader reader;
-        if ((request.size() > RPC::Tuning::maxRequestSize) ||
-            !reader.parse(request, jsonOrig) || !jsonOrig ||
-            !jsonOrig.isObject())
-        {
-            HTTPReply(
-                400,
-                "Unable to parse request: " + reader.getFormatedErrorMessages(),
-                output,
-                rpcJ);
-            return;
-        }
-    }
+    auto const output = makeOutput(session);
 
     bool batch = false;
     unsigned size = 1;
@@ -1015,14 +1208,13 @@ ServerHandler::processRequest(
         return 200;
     }();
 
-    auto response = to_string(reply);
+    // The session takes the reply rather than copying it.
+    auto response = serializeReply(reply);
 
     rpc_time_.notify(std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::high_resolution_clock::now() - start));
     ++rpc_requests_;
-    rpc_size_.notify(beast::insight::Event::value_type{response.size()});
-
-    response += '\n';
+    rpc_size_.notify(beast::insight::Event::value_type{response.size() - 1});
 
     if (auto stream = m_journal.debug())
     {
@@ -1033,7 +1225,9 @@ ServerHandler::processRequest(
             stream << "Reply: " << response.substr(0, maxSize);
     }
 
-    HTTPReply(httpStatus, response, output, rpcJ);
+    response += "\r\n";
+    HTTPReplyHeaders(httpStatus, response.size(), output);
+    session.write(std::move(response));
 }
 
 //------------------------------------------------------------------------------
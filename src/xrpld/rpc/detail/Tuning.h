@@ -77,6 +77,9 @@ inline int constexpr pageLength(bool isBinary)
     return isBinary ? binaryPageLength : jsonPageLength;
 }
 
+/** Number of state entries a LedgerData walk loads ahead of itself. */
+static int constexpr ledgerDataReadAhead = 512;
+
 /** Maximum number of source currencies allowed in a path find request. */
 static int constexpr max_src_cur = 18;
 
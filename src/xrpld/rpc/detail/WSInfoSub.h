@@ -82,6 +82,15 @@ public:
         auto m = std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb));
         sp->send(m);
     }
+
+    void
+    publish(std::shared_ptr<PublishedJson const> const& msg, bool) override
+    {
+        auto sp = ws_.lock();
+        if (!sp)
+            return;
+        sp->send(std::make_shared<SharedBufferWSMsg>(msg->text()));
+    }
 };
 
 }  // namespace ripple
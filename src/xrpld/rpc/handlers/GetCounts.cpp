@@ -24,7 +24,10 @@
 #include <xrpld/app/misc/NetworkOPs.h>
 #include <xrpld/app/rdb/backend/SQLiteDatabase.h>
 #include <xrpld/nodestore/Database.h>
+#include <xrpld/overlay/Overlay.h>
+#include <xrpld/perflog/PerfLog.h>
 #include <xrpld/rpc/Context.h>
+#include <xrpld/shamap/SHAMapInnerNode.h>
 
 #include <xrpl/basics/UptimeClock.h>
 #include <xrpl/json/json_value.h>
@@ -116,6 +119,12 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::treenode_track_size] =
         app.getNodeFamily().getTreeNodeCache()->getTrackSize();
 
+    if (auto const slab = SHAMapInnerNode::slabStats(); slab.bytes != 0)
+    {
+        ret[jss::inner_node_slab_size] = Json::UInt(slab.nodes);
+        ret[jss::inner_node_slab_KB] = Json::UInt(slab.bytes / 1024);
+    }
+
     std::string uptime;
     auto s = UptimeClock::now();
     using namespace std::chrono_literals;
@@ -127,6 +136,9 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::uptime] = uptime;
 
     app.getNodeStore().getCountsJson(ret);
+    app.overlay().getCountsJson(ret);
+    app.getOPs().getCountsJson(ret);
+    ret[jss::latency] = app.getPerfLog().latencyJson();
 
     return ret;
 }
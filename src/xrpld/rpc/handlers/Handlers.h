@@ -124,6 +124,12 @@ Json::Value
 doPeerReservationsList(RPC::JsonContext&);
 Json::Value
 doRipplePathFind(RPC::JsonContext&);
+CoroTask<Json::Value>
+doRipplePathFindAsync(RPC::JsonContext&);
+// The part of doRipplePathFindAsync that waits for the path-finding engine,
+// which is used when the server is not standalone.
+CoroTask<Json::Value>
+doRipplePathRequestAsync(RPC::JsonContext&);
 Json::Value
 doServerDefinitions(RPC::JsonContext&);
 Json::Value
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <xrpld/app/ledger/Ledger.h>
 #include <xrpld/app/ledger/LedgerToJson.h>
 #include <xrpld/rpc/Context.h>
 #include <xrpld/rpc/GRPCHandlers.h>
@@ -31,10 +32,26 @@
 
 namespace ripple {
 
+// Load the state map nodes that a walk from `key` will visit for its next
+// `remaining` entries, and the one after them that sets the marker, in a
+// few batch reads rather than one read per node.
+static void
+readAhead(ReadView const& view, uint256 const& key, int remaining)
+{
+    if (auto const ledger = dynamic_cast<Ledger const*>(&view))
+        ledger->stateMap().prefetch(
+            key,
+            std::min(remaining, RPC::Tuning::ledgerDataReadAhead - 1) + 1);
+}
+
 // Get state nodes from a ledger
 //   Inputs:
 //     limit:        integer, maximum number of entries
 //     marker:       opaque, resume point
+//     end_marker:   opaque, optional last key to return. Clients scanning
+//                   the whole state can split it into key ranges, such as
+//                   one per leading nibble, and page through them in
+//                   parallel.
 //     binary:       boolean, format
 //     type:         string // optional, defaults to all ledger node types
 //   Outputs:
@@ -61,6 +78,17 @@ doLedgerData(RPC::JsonContext& context)
             return RPC::expected_field_error(jss::marker, "valid");
     }
 
+    std::optional<ReadView::key_type> endKey;
+    if (params.isMember(jss::end_marker))
+    {
+        Json::Value const& jEndMarker = params[jss::end_marker];
+        endKey.emplace();
+        if (!(jEndMarker.isString() &&
+              endKey->parseHex(jEndMarker.asString())) ||
+            *endKey < key)
+            return RPC::expected_field_error(jss::end_marker, "valid");
+    }
+
     bool const isBinary = params[jss::binary].asBool();
 
     int limit = -1;
@@ -101,9 +129,15 @@ doLedgerData(RPC::JsonContext& context)
     }
 
     auto e = lpLedger->sles.end();
+    if (endKey)
+        e = lpLedger->sles.upper_bound(*endKey);
+
+    readAhead(*lpLedger, key, limit);
+    int ahead = RPC::Tuning::ledgerDataReadAhead;
+
     for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
     {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
+        auto const& sle = *i;
         if (limit-- <= 0)
         {
             // Stop processing before the current key.
@@ -112,6 +146,12 @@ doLedgerData(RPC::JsonContext& context)
             break;
         }
 
+        if (--ahead == 0)
+        {
+            readAhead(*lpLedger, sle->key(), limit);
+            ahead = RPC::Tuning::ledgerDataReadAhead;
+        }
+
         if (type == ltANY || sle->getType() == type)
         {
             if (isBinary)
@@ -190,9 +230,12 @@ doLedgerDataGrpc(
 
     int maxLimit = RPC::Tuning::pageLength(true);
 
+    readAhead(*ledger, startKey, maxLimit);
+    int ahead = RPC::Tuning::ledgerDataReadAhead;
+
     for (auto i = ledger->sles.upper_bound(startKey); i != e; ++i)
     {
-        auto sle = ledger->read(keylet::unchecked((*i)->key()));
+        auto const& sle = *i;
         if (maxLimit-- <= 0)
         {
             // Stop processing before the current key.
@@ -201,6 +244,13 @@ doLedgerDataGrpc(
             response.set_marker(k.data(), k.size());
             break;
         }
+
+        if (--ahead == 0)
+        {
+            readAhead(*ledger, sle->key(), maxLimit);
+            ahead = RPC::Tuning::ledgerDataReadAhead;
+        }
+
         auto stateObject = response.mutable_ledger_objects()->add_objects();
         Serializer s;
         sle->add(s);
@@ -19,6 +19,7 @@
 
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/paths/PathRequests.h>
+#include <xrpld/core/CoroTask.h>
 #include <xrpld/rpc/Context.h>
 #include <xrpld/rpc/detail/LegacyPathFind.h>
 #include <xrpld/rpc/detail/RPCHelpers.h>
@@ -28,6 +29,17 @@
 
 namespace ripple {
 
+// Whether the request is handed to the path-finding engine and has to wait
+// for it, rather than being answered directly against a given ledger.
+static bool
+usesPathRequest(RPC::JsonContext const& context)
+{
+    return !context.app.config().standalone() &&
+        !context.params.isMember(jss::ledger) &&
+        !context.params.isMember(jss::ledger_index) &&
+        !context.params.isMember(jss::ledger_hash);
+}
+
 // This interface is deprecated.
 Json::Value
 doRipplePathFind(RPC::JsonContext& context)
@@ -40,10 +52,7 @@ doRipplePathFind(RPC::JsonContext& context)
     std::shared_ptr<ReadView const> lpLedger;
     Json::Value jvResult;
 
-    if (!context.app.config().standalone() &&
-        !context.params.isMember(jss::ledger) &&
-        !context.params.isMember(jss::ledger_index) &&
-        !context.params.isMember(jss::ledger_hash))
+    if (usesPathRequest(context))
     {
         // No ledger specified, use pathfinding defaults
         // and dispatch to pathfinding engine
@@ -174,4 +183,51 @@ doRipplePathFind(RPC::JsonContext& context)
     return result;
 }
 
+// Waits for the path-finding engine without a JobQueue::Coro. Rather than
+// yielding a stack, the task suspends on a CoroEvent that the path-finding
+// continuation notifies. If the JobQueue refuses to resume the task because
+// we're shutting down, the event resumes it on the path-finding thread, for
+// the reasons given above.
+CoroTask<Json::Value>
+doRipplePathRequestAsync(RPC::JsonContext& context)
+{
+    context.loadType = Resource::feeHeavyBurdenRPC;
+
+    if (context.app.getLedgerMaster().getValidatedLedgerAge() >
+        RPC::Tuning::maxValidatedLedgerAge)
+    {
+        if (context.apiVersion == 1)
+            co_return rpcError(rpcNO_NETWORK);
+        co_return rpcError(rpcNOT_SYNCED);
+    }
+
+    PathRequest::pointer request;
+    auto const event = std::make_shared<CoroEvent>(
+        context.app.getJobQueue(), jtCLIENT, "RPC-PathFind");
+    auto jvResult = context.app.getPathRequests().makeLegacyPathRequest(
+        request,
+        [event]() { event->notify(); },
+        context.consumer,
+        context.ledgerMaster.getClosedLedger(),
+        context.params);
+    if (request)
+    {
+        co_await *event;
+        jvResult = request->doStatus(context.params);
+    }
+
+    co_return jvResult;
+}
+
+// Used in place of doRipplePathFind when the request is not running in a
+// JobQueue::Coro.
+CoroTask<Json::Value>
+doRipplePathFindAsync(RPC::JsonContext& context)
+{
+    if (context.app.config().PATH_SEARCH_MAX == 0 || !usesPathRequest(context))
+        co_return doRipplePathFind(context);
+
+    co_return co_await doRipplePathRequestAsync(context);
+}
+
 }  // namespace ripple
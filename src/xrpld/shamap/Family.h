@@ -27,6 +27,7 @@
 #include <xrpl/beast/utility/Journal.h>
 
 #include <cstdint>
+#include <functional>
 
 namespace ripple {
 
@@ -83,6 +84,16 @@ public:
 
     virtual void
     reset() = 0;
+
+    /** Call `f(i)` for every `i` in `[0, count)`, possibly concurrently.
+
+        Returns once every call has finished, rethrowing the first
+        exception thrown by `f`.
+    */
+    virtual void
+    parallelFor(
+        std::size_t count,
+        std::function<void(std::size_t)> const& f) = 0;
 };
 
 }  // namespace ripple
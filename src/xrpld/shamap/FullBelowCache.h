@@ -28,6 +28,7 @@
 
 #include <atomic>
 #include <string>
+#include <vector>
 
 namespace ripple {
 
@@ -118,6 +119,16 @@ public:
         m_cache.insert(key);
     }
 
+    /** Return the keys in the cache.
+        Thread safety:
+            Safe to call from any thread.
+    */
+    std::vector<key_type>
+    getKeys() const
+    {
+        return m_cache.getKeys();
+    }
+
     /** generation determines whether cached entry is valid */
     std::uint32_t
     getGeneration(void) const
@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_SHAMAP_NODECACHESNAPSHOT_H_INCLUDED
+#define RIPPLE_SHAMAP_NODECACHESNAPSHOT_H_INCLUDED
+
+#include <xrpld/shamap/Family.h>
+#include <xrpld/shamap/SHAMap.h>
+
+#include <xrpl/basics/BasicConfig.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/** The hot part of a Family's caches, saved so a restart starts warm.
+
+    A snapshot holds the hashes of the inner nodes nearest the root of
+    recent state maps, which every lookup walks through, and the keys of
+    the FullBelowCache, which let acquiring a ledger skip subtrees that are
+    already complete. Only hashes are saved: the nodes themselves are read
+    back from the node store with batch reads.
+
+    A FullBelow key is only a promise that a subtree is complete in the
+    node store, so the keys are restored only if online deletion has not
+    rotated the node store since the snapshot was taken, and only for
+    nodes the node store still holds.
+
+    The file is a 40 byte header followed by the hashes:
+
+    @code
+    magic           "XRPLWARM"
+    version         4 bytes, big endian
+    ledger          4 bytes, the sequence of the newest map walked
+    last rotated    4 bytes, SHAMapStore::getLastRotated when written
+    reserved        4 bytes
+    inner nodes     8 bytes, the number of inner node hashes
+    full below      8 bytes, the number of FullBelow keys
+    @endcode
+*/
+struct NodeCacheSnapshot
+{
+    struct Setup
+    {
+        explicit Setup() = default;
+
+        /** The snapshot file, or empty if snapshots are disabled. */
+        boost::filesystem::path path;
+
+        /** How often to write the snapshot. Zero writes it at shutdown only.
+         */
+        std::chrono::minutes interval{10};
+
+        /** The most inner node hashes, and FullBelow keys, to save. */
+        std::size_t maxNodes = 65536;
+
+        /** The number of jobs reading nodes while loading. */
+        std::size_t threads = 4;
+    };
+
+    std::uint32_t ledgerSeq = 0;
+    std::uint32_t lastRotated = 0;
+    std::vector<uint256> innerNodes;
+    std::vector<uint256> fullBelow;
+};
+
+/** The nodes a snapshot put in the caches. */
+struct WarmedNodes
+{
+    std::size_t innerNodes = 0;
+    std::size_t fullBelow = 0;
+
+    /** The nodes put in the TreeNodeCache.
+
+        Nothing else refers to them yet, so a sweep would drop them from
+        the cache. The caller holds them until the maps that use them are
+        loaded.
+    */
+    std::vector<intr_ptr::SharedPtr<SHAMapTreeNode>> nodes;
+};
+
+/** Read the [node_cache_snapshot] section.
+
+    @param section The configuration section.
+    @param databasePath The directory relative paths are resolved against.
+    @throws std::runtime_error if a value is out of range.
+*/
+NodeCacheSnapshot::Setup
+setup_NodeCacheSnapshot(
+    Section const& section,
+    std::string const& databasePath);
+
+/** Gather the hashes of the resident inner nodes of some maps and the
+    keys of the FullBelowCache.
+
+    The maps are walked in order, breadth first, so the first map and the
+    nodes nearest each root are kept if there are more than `maxNodes`.
+    The caller fills in the ledger sequence and the last rotation.
+*/
+NodeCacheSnapshot
+makeNodeCacheSnapshot(
+    Family& family,
+    std::vector<SHAMap const*> const& maps,
+    std::size_t maxNodes);
+
+/** Write a snapshot, replacing any existing file at once.
+
+    @throws std::runtime_error if the file can't be written.
+*/
+void
+writeNodeCacheSnapshot(
+    NodeCacheSnapshot const& snapshot,
+    boost::filesystem::path const& path);
+
+/** Read a snapshot.
+
+    @throws std::runtime_error if the file is missing or corrupt.
+*/
+NodeCacheSnapshot
+readNodeCacheSnapshot(boost::filesystem::path const& path);
+
+/** Read the nodes of a snapshot into a Family's caches.
+
+    The hashes are split into batches which are fetched from the node
+    store. Nodes that are no longer stored are skipped.
+
+    @param lastRotated SHAMapStore::getLastRotated now. FullBelow keys are
+           restored only if it matches the snapshot.
+    @param parallelFor Called once with the number of batches and a
+           function that fetches one batch. Returns once every batch has
+           been fetched, and may fetch them in parallel.
+    @param stopping Checked before each batch. Returns true to give up.
+*/
+WarmedNodes
+warmNodeCaches(
+    Family& family,
+    NodeCacheSnapshot const& snapshot,
+    std::uint32_t lastRotated,
+    std::function<void(
+        std::size_t count,
+        std::function<void(std::size_t)> const& f)> const& parallelFor,
+    std::function<bool()> const& stopping);
+
+}  // namespace ripple
+
+#endif
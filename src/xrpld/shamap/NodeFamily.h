@@ -87,6 +87,11 @@ public:
         acquire(hash, seq);
     }
 
+    void
+    parallelFor(
+        std::size_t count,
+        std::function<void(std::size_t)> const& f) override;
+
 private:
     Application& app_;
     NodeStore::Database& db_;
@@ -36,6 +36,9 @@
 #include <xrpl/beast/utility/Journal.h>
 #include <xrpl/beast/utility/instrumentation.h>
 
+#include <array>
+#include <atomic>
+#include <functional>
 #include <set>
 #include <stack>
 #include <vector>
@@ -239,6 +242,27 @@ public:
     const_iterator
     lower_bound(uint256 const& id) const;
 
+    /** Load the nodes an in-order walk from the given item will visit.
+
+        Reads the nodes holding the `count` items following `id` one level
+        at a time, with a single batch read per level, and hooks them into
+        the tree so the walk that follows finds them in memory. Nodes that
+        can't be read are skipped; the walk reports them as usual.
+
+        @param id the identifier of the item. It does not need to exist.
+        @param count the number of items the walk will visit.
+     */
+    void
+    prefetch(uint256 const& id, std::size_t count) const;
+
+    /** Load the nodes on the paths to the given items.
+
+        Like the walk version, but for lookups of unrelated items. The
+        items do not need to exist.
+     */
+    void
+    prefetch(std::vector<uint256> keys) const;
+
     /**  Visit every node in this SHAMap
 
          @param function called with every node visited.
@@ -267,6 +291,18 @@ public:
         std::function<
             void(boost::intrusive_ptr<SHAMapItem const> const&)> const&) const;
 
+    /**  Visit the inner nodes of this SHAMap that are in memory
+
+         Nodes are visited breadth first, so the nodes nearest the root
+         come first. Nothing is read from the database.
+
+         @param function called with every node visited.
+         If function returns false, visitResident exits.
+    */
+    void
+    visitResident(
+        std::function<bool(SHAMapInnerNode const&)> const& function) const;
+
     // comparison/sync functions
 
     /** Check for nodes in the SHAMap not available
@@ -326,6 +362,17 @@ public:
         Slice const& rawNode,
         SHAMapSyncFilter* filter);
 
+    /** Add a node that was already deserialized from the wire.
+
+        This lets the caller hash the nodes of a reply without holding
+        whatever lock guards the map.
+    */
+    SHAMapAddNode
+    addKnownNode(
+        SHAMapNodeID const& nodeID,
+        intr_ptr::SharedPtr<SHAMapTreeNode> node,
+        SHAMapSyncFilter* filter);
+
     // status functions
     void
     setImmutable();
@@ -343,6 +390,18 @@ public:
     bool
     compare(SHAMap const& otherMap, Delta& differences, int maxCount) const;
 
+    /** Like compare, but the differing branches below the root are
+        compared concurrently, using the Family's parallelFor.
+
+        The differences found by all the workers count against maxCount.
+        Maps too small to gain from it are compared on the calling thread.
+    */
+    bool
+    compareParallel(
+        SHAMap const& otherMap,
+        Delta& differences,
+        int maxCount) const;
+
     /** Convert any modified nodes to shared. */
     int
     unshare();
@@ -486,6 +545,23 @@ private:
     intr_ptr::SharedPtr<SHAMapTreeNode>
     descendNoStore(SHAMapInnerNode&, int branch) const;
 
+    using ChildArray =
+        std::array<intr_ptr::SharedPtr<SHAMapTreeNode>, branchFactor>;
+
+    // Non-storing, batched
+    // Gets every non-empty child of an inner node. Children that are neither
+    // in memory nor in the cache are read from the database with a single
+    // batch request. Throws if a child of a backed map is missing.
+    ChildArray
+    descendNoStore(SHAMapInnerNode&) const;
+
+    // Storing, batched
+    // Gets the child on each of the given branches. Children that are
+    // neither in memory nor in the cache are read from the database with a
+    // single batch request. A child that can't be read is null.
+    std::vector<intr_ptr::SharedPtr<SHAMapTreeNode>>
+    descend(std::vector<std::pair<SHAMapInnerNode*, int>> const&) const;
+
     /** If there is only one leaf below this node, get its contents */
     boost::intrusive_ptr<SHAMapItem const> const&
     onlyBelow(SHAMapTreeNode*) const;
@@ -499,13 +575,22 @@ private:
     peekFirstItem(SharedPtrNodeStack& stack) const;
     SHAMapLeafNode const*
     peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const;
+    // compare helper: the differences below a pair of nodes
+    bool
+    compareNodes(
+        SHAMapTreeNode* ourTop,
+        SHAMap const& otherMap,
+        SHAMapTreeNode* otherTop,
+        Delta& differences,
+        std::atomic<int>& maxCount) const;
+
     bool
     walkBranch(
         SHAMapTreeNode* node,
         boost::intrusive_ptr<SHAMapItem const> const& otherMapItem,
         bool isFirstMap,
         Delta& differences,
-        int& maxCount) const;
+        std::atomic<int>& maxCount) const;
     int
     walkSubTree(bool doWrite, NodeObjectType t);
 
@@ -575,6 +660,13 @@ private:
         }
     };
 
+    // addKnownNode helper, which only calls makeNode if the node is needed
+    SHAMapAddNode
+    hookKnownNode(
+        SHAMapNodeID const& node,
+        std::function<intr_ptr::SharedPtr<SHAMapTreeNode>()> const& makeNode,
+        SHAMapSyncFilter* filter);
+
     // getMissingNodes helper functions
     void
     gmn_ProcessNodes(MissingNodes&, MissingNodes::StackEntry& node);
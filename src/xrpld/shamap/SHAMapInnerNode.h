@@ -107,6 +107,31 @@ public:
     operator=(SHAMapInnerNode const&) = delete;
     ~SHAMapInnerNode();
 
+    /** Inner nodes are allocated from a slab when slab allocation is
+        enabled, and from the heap otherwise. A node is always returned to
+        wherever it came from, so the mode can change at any time.
+     */
+    static void*
+    operator new(std::size_t size);
+
+    static void
+    operator delete(void* p) noexcept;
+
+    /** Choose where inner nodes created from now on are allocated. */
+    static void
+    setSlabAllocation(bool enable) noexcept;
+
+    struct SlabStats
+    {
+        // Inner nodes currently allocated from the slab
+        std::size_t nodes;
+        // Memory reserved by the slab, whether in use or not
+        std::size_t bytes;
+    };
+
+    static SlabStats
+    slabStats() noexcept;
+
     // Needed to support intrusive weak pointers
     void
     partialDestructor() override;
@@ -0,0 +1,264 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2025 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/shamap/NodeCacheSnapshot.h>
+
+#include <xrpl/basics/TaggedCache.ipp>
+#include <xrpl/basics/contract.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+namespace ripple {
+
+namespace {
+
+constexpr char magic[] = "XRPLWARM";
+constexpr std::size_t magicBytes = sizeof(magic) - 1;
+constexpr std::uint32_t version = 1;
+constexpr std::size_t headerBytes = magicBytes + 4 * 4 + 2 * 8;
+
+// The number of hashes fetched from the node store at once.
+constexpr std::size_t batchSize = 256;
+
+}  // namespace
+
+NodeCacheSnapshot::Setup
+setup_NodeCacheSnapshot(
+    Section const& section,
+    std::string const& databasePath)
+{
+    NodeCacheSnapshot::Setup setup;
+
+    boost::filesystem::path path = get(section, "path", "node_cache.snapshot");
+    if (path.is_relative() && !databasePath.empty())
+        path = boost::filesystem::path(databasePath) / path;
+    setup.path = path;
+
+    std::uint32_t minutes;
+    if (set(minutes, "interval", section))
+        setup.interval = std::chrono::minutes(minutes);
+
+    std::size_t nodes;
+    if (set(nodes, "nodes", section))
+    {
+        if (nodes == 0)
+            Throw<std::runtime_error>(
+                "[node_cache_snapshot] nodes must be greater than zero");
+        setup.maxNodes = nodes;
+    }
+
+    return setup;
+}
+
+NodeCacheSnapshot
+makeNodeCacheSnapshot(
+    Family& family,
+    std::vector<SHAMap const*> const& maps,
+    std::size_t maxNodes)
+{
+    NodeCacheSnapshot snapshot;
+
+    // Recent maps share most of their nodes near the root
+    std::unordered_set<uint256, hardened_hash<>> seen;
+    for (auto const map : maps)
+    {
+        if (!map)
+            continue;
+
+        map->visitResident([&](SHAMapInnerNode const& node) {
+            if (snapshot.innerNodes.size() >= maxNodes)
+                return false;
+            auto const& hash = node.getHash().as_uint256();
+            if (seen.insert(hash).second)
+                snapshot.innerNodes.push_back(hash);
+            return true;
+        });
+    }
+
+    snapshot.fullBelow = family.getFullBelowCache()->getKeys();
+    if (snapshot.fullBelow.size() > maxNodes)
+        snapshot.fullBelow.resize(maxNodes);
+
+    return snapshot;
+}
+
+void
+writeNodeCacheSnapshot(
+    NodeCacheSnapshot const& snapshot,
+    boost::filesystem::path const& path)
+{
+    // Write a new file and rename it over the old one, so a crash while
+    // writing leaves the previous snapshot intact.
+    auto const temp = path.string() + ".tmp";
+    {
+        std::ofstream os(temp, std::ios::binary | std::ios::trunc);
+        if (!os)
+            Throw<std::runtime_error>("Unable to create " + temp);
+
+        std::array<std::uint8_t, headerBytes> header{};
+        std::memcpy(header.data(), magic, magicBytes);
+        auto p = header.data() + magicBytes;
+        boost::endian::store_big_u32(p, version);
+        boost::endian::store_big_u32(p + 4, snapshot.ledgerSeq);
+        boost::endian::store_big_u32(p + 8, snapshot.lastRotated);
+        boost::endian::store_big_u64(p + 16, snapshot.innerNodes.size());
+        boost::endian::store_big_u64(p + 24, snapshot.fullBelow.size());
+        os.write(reinterpret_cast<char const*>(header.data()), header.size());
+
+        for (auto const* hashes : {&snapshot.innerNodes, &snapshot.fullBelow})
+        {
+            for (auto const& hash : *hashes)
+                os.write(
+                    reinterpret_cast<char const*>(hash.data()), hash.size());
+        }
+
+        os.flush();
+        if (!os)
+            Throw<std::runtime_error>("Unable to write " + temp);
+    }
+
+    boost::filesystem::rename(temp, path);
+}
+
+NodeCacheSnapshot
+readNodeCacheSnapshot(boost::filesystem::path const& path)
+{
+    std::ifstream is(path.string(), std::ios::binary);
+    if (!is)
+        Throw<std::runtime_error>("Unable to open " + path.string());
+
+    std::vector<std::uint8_t> const data{
+        std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+
+    if (data.size() < headerBytes ||
+        std::memcmp(data.data(), magic, magicBytes) != 0)
+        Throw<std::runtime_error>(path.string() + " is not a node snapshot");
+
+    auto const p = data.data() + magicBytes;
+    if (boost::endian::load_big_u32(p) != version)
+        Throw<std::runtime_error>(
+            path.string() + " has an unsupported snapshot version");
+
+    NodeCacheSnapshot snapshot;
+    snapshot.ledgerSeq = boost::endian::load_big_u32(p + 4);
+    snapshot.lastRotated = boost::endian::load_big_u32(p + 8);
+    auto const innerNodes = boost::endian::load_big_u64(p + 16);
+    auto const fullBelow = boost::endian::load_big_u64(p + 24);
+
+    auto const hashes = (data.size() - headerBytes) / uint256::bytes;
+    if ((data.size() - headerBytes) % uint256::bytes != 0 ||
+        innerNodes > hashes || fullBelow != hashes - innerNodes)
+        Throw<std::runtime_error>(path.string() + " is truncated");
+
+    auto hash = data.data() + headerBytes;
+    auto const readHashes = [&hash](std::vector<uint256>& v, std::size_t n) {
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i, hash += uint256::bytes)
+            v.push_back(uint256::fromVoid(hash));
+    };
+    readHashes(snapshot.innerNodes, innerNodes);
+    readHashes(snapshot.fullBelow, fullBelow);
+
+    return snapshot;
+}
+
+WarmedNodes
+warmNodeCaches(
+    Family& family,
+    NodeCacheSnapshot const& snapshot,
+    std::uint32_t lastRotated,
+    std::function<void(
+        std::size_t count,
+        std::function<void(std::size_t)> const& f)> const& parallelFor,
+    std::function<bool()> const& stopping)
+{
+    // FullBelow keys follow the inner nodes, so one pass reads both and
+    // only keys whose node is still stored are restored.
+    std::vector<uint256> hashes = snapshot.innerNodes;
+    if (snapshot.lastRotated == lastRotated)
+        hashes.insert(
+            hashes.end(), snapshot.fullBelow.begin(), snapshot.fullBelow.end());
+
+    auto const batches = (hashes.size() + batchSize - 1) / batchSize;
+    auto const treeNodeCache = family.getTreeNodeCache();
+    auto const fullBelowCache = family.getFullBelowCache();
+    // Online deletion clears the cache when it rotates
+    auto const generation = fullBelowCache->getGeneration();
+    std::atomic<std::size_t> innerNodes{0};
+    std::atomic<std::size_t> fullBelow{0};
+    std::vector<std::vector<intr_ptr::SharedPtr<SHAMapTreeNode>>> held(
+        batches);
+
+    parallelFor(batches, [&](std::size_t b) {
+        if (stopping && stopping())
+            return;
+
+        auto const first = b * batchSize;
+        auto const last = std::min(hashes.size(), first + batchSize);
+        std::vector<uint256> const batch(
+            hashes.begin() + first, hashes.begin() + last);
+
+        auto const objects =
+            family.db().fetchNodeObjects(batch, snapshot.ledgerSeq);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            if (!objects[i])
+                continue;
+
+            SHAMapHash const hash{batch[i]};
+            auto node = SHAMapTreeNode::makeFromPrefix(
+                makeSlice(objects[i]->getData()), hash);
+            if (!node || !node->isInner())
+                continue;
+
+            treeNodeCache->canonicalize_replace_client(batch[i], node);
+            held[b].push_back(std::move(node));
+            if (first + i < snapshot.innerNodes.size())
+                ++innerNodes;
+            else if (fullBelowCache->getGeneration() == generation)
+            {
+                fullBelowCache->insert(batch[i]);
+                ++fullBelow;
+            }
+        }
+    });
+
+    WarmedNodes warmed;
+    warmed.innerNodes = innerNodes;
+    warmed.fullBelow = fullBelow;
+    for (auto& nodes : held)
+    {
+        warmed.nodes.insert(
+            warmed.nodes.end(),
+            std::make_move_iterator(nodes.begin()),
+            std::make_move_iterator(nodes.end()));
+    }
+    return warmed;
+}
+
+}  // namespace ripple
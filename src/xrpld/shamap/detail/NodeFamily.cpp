@@ -20,6 +20,7 @@
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/main/Application.h>
 #include <xrpld/app/main/Tuning.h>
+#include <xrpld/core/JobQueue.h>
 #include <xrpld/shamap/NodeFamily.h>
 
 #include <xrpl/basics/TaggedCache.ipp>
@@ -95,6 +96,17 @@ NodeFamily::missingNodeAcquireBySeq(std::uint32_t seq, uint256 const& nodeHash)
     }
 }
 
+void
+NodeFamily::parallelFor(
+    std::size_t count,
+    std::function<void(std::size_t)> const& f)
+{
+    // Comparing transaction sets holds up consensus, so the helpers run at
+    // the priority of advancing the ledger.
+    app_.getJobQueue().parallelFor(
+        jtADVANCE, "SHAMap::parallelFor", count, count - 1, f);
+}
+
 void
 NodeFamily::acquire(uint256 const& hash, std::uint32_t seq)
 {
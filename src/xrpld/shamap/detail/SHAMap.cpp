@@ -27,6 +27,9 @@
 #include <xrpl/basics/TaggedCache.ipp>
 #include <xrpl/basics/contract.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace ripple {
 
 [[nodiscard]] intr_ptr::SharedPtr<SHAMapLeafNode>
@@ -356,6 +359,96 @@ SHAMap::descendNoStore(SHAMapInnerNode& parent, int branch) const
     return ret;
 }
 
+SHAMap::ChildArray
+SHAMap::descendNoStore(SHAMapInnerNode& parent) const
+{
+    ChildArray children;
+    std::array<int, branchFactor> branches;
+    std::vector<uint256> hashes;
+    int wanted = 0;
+
+    for (int branch = 0; branch < branchFactor; ++branch)
+    {
+        if (parent.isEmptyBranch(branch))
+            continue;
+
+        children[branch] = parent.getChild(branch);
+        if (children[branch] || !backed_)
+            continue;
+
+        children[branch] = cacheLookup(parent.getChildHash(branch));
+        if (!children[branch])
+        {
+            branches[wanted++] = branch;
+            hashes.push_back(parent.getChildHash(branch).as_uint256());
+        }
+    }
+
+    if (hashes.empty())
+        return children;
+
+    auto const objects = f_.db().fetchNodeObjects(hashes, ledgerSeq_);
+    XRPL_ASSERT(
+        objects.size() == hashes.size(),
+        "ripple::SHAMap::descendNoStore : batch result size");
+
+    for (int i = 0; i < wanted; ++i)
+    {
+        SHAMapHash const hash{hashes[i]};
+        auto& child = children[branches[i]];
+        child = finishFetch(hash, objects[i]);
+        if (!child)
+            Throw<SHAMapMissingNode>(type_, hash);
+    }
+
+    return children;
+}
+
+std::vector<intr_ptr::SharedPtr<SHAMapTreeNode>>
+SHAMap::descend(
+    std::vector<std::pair<SHAMapInnerNode*, int>> const& branches) const
+{
+    std::vector<intr_ptr::SharedPtr<SHAMapTreeNode>> children(
+        branches.size());
+    std::vector<std::size_t> wanted;
+    std::vector<uint256> hashes;
+
+    for (std::size_t i = 0; i < branches.size(); ++i)
+    {
+        auto const [parent, branch] = branches[i];
+        children[i] = parent->getChild(branch);
+        if (children[i] || !backed_)
+            continue;
+
+        if (auto node = cacheLookup(parent->getChildHash(branch)))
+        {
+            children[i] = parent->canonicalizeChild(branch, std::move(node));
+            continue;
+        }
+
+        wanted.push_back(i);
+        hashes.push_back(parent->getChildHash(branch).as_uint256());
+    }
+
+    if (hashes.empty())
+        return children;
+
+    auto const objects = f_.db().fetchNodeObjects(hashes, ledgerSeq_);
+    XRPL_ASSERT(
+        objects.size() == hashes.size(),
+        "ripple::SHAMap::descend : batch result size");
+
+    for (std::size_t i = 0; i < wanted.size(); ++i)
+    {
+        auto const [parent, branch] = branches[wanted[i]];
+        if (auto node = finishFetch(SHAMapHash{hashes[i]}, objects[i]))
+            children[wanted[i]] =
+                parent->canonicalizeChild(branch, std::move(node));
+    }
+
+    return children;
+}
+
 std::pair<SHAMapTreeNode*, SHAMapNodeID>
 SHAMap::descend(
     SHAMapInnerNode* parent,
@@ -710,6 +803,129 @@ SHAMap::lower_bound(uint256 const& id) const
     return end();
 }
 
+void
+SHAMap::prefetch(uint256 const& id, std::size_t count) const
+{
+    if (!backed_ || count == 0 || !root_->isInner())
+        return;
+
+    struct Pending
+    {
+        SHAMapTreeNode* node;
+        SHAMapNodeID nodeID;
+        // Only the nodes on the path to id hold items before it
+        bool onPath;
+    };
+
+    // The nodes the walk reaches, in the order it reaches them. Each holds
+    // at least one item, so the first `count` hold every item it visits.
+    std::vector<Pending> level{{root_.get(), SHAMapNodeID{}, true}};
+
+    for (;;)
+    {
+        if (level.size() > count)
+            level.resize(count);
+
+        // Replace each inner node by its children, keeping the order
+        std::vector<std::pair<SHAMapInnerNode*, int>> branches;
+        std::vector<std::size_t> slots;
+        std::vector<Pending> next;
+        for (auto const& p : level)
+        {
+            if (p.node->isLeaf())
+            {
+                next.push_back(p);
+                continue;
+            }
+
+            auto const inner = static_cast<SHAMapInnerNode*>(p.node);
+            int const first = p.onPath ? selectBranch(p.nodeID, id) : 0;
+            for (int branch = first; branch < branchFactor; ++branch)
+            {
+                if (inner->isEmptyBranch(branch))
+                    continue;
+                branches.emplace_back(inner, branch);
+                slots.push_back(next.size());
+                next.push_back(
+                    {nullptr,
+                     p.nodeID.getChildNodeID(branch),
+                     p.onPath && branch == first});
+            }
+        }
+
+        if (branches.empty())
+            return;
+
+        // Parents hold their children, so the pointers stay valid.
+        auto const children = descend(branches);
+        for (std::size_t i = 0; i < children.size(); ++i)
+            next[slots[i]].node = children[i].get();
+
+        std::erase_if(next, [](Pending const& p) { return !p.node; });
+        level = std::move(next);
+    }
+}
+
+void
+SHAMap::prefetch(std::vector<uint256> keys) const
+{
+    if (!backed_ || keys.empty() || !root_->isInner())
+        return;
+
+    std::sort(keys.begin(), keys.end());
+
+    // Keys in one subtree are adjacent once sorted
+    struct Pending
+    {
+        SHAMapInnerNode* node;
+        SHAMapNodeID nodeID;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::vector<Pending> level{
+        {static_cast<SHAMapInnerNode*>(root_.get()),
+         SHAMapNodeID{},
+         0,
+         keys.size()}};
+
+    while (!level.empty())
+    {
+        std::vector<std::pair<SHAMapInnerNode*, int>> branches;
+        std::vector<Pending> next;
+        for (auto const& p : level)
+        {
+            for (auto i = p.first; i < p.last;)
+            {
+                auto const branch = selectBranch(p.nodeID, keys[i]);
+                auto j = i + 1;
+                while (j < p.last && selectBranch(p.nodeID, keys[j]) == branch)
+                    ++j;
+
+                if (!p.node->isEmptyBranch(branch))
+                {
+                    branches.emplace_back(p.node, branch);
+                    next.push_back(
+                        {nullptr, p.nodeID.getChildNodeID(branch), i, j});
+                }
+                i = j;
+            }
+        }
+
+        auto const children = descend(branches);
+
+        level.clear();
+        for (std::size_t i = 0; i < children.size(); ++i)
+        {
+            if (children[i] && children[i]->isInner())
+            {
+                next[i].node = static_cast<SHAMapInnerNode*>(children[i].get());
+                level.push_back(next[i]);
+            }
+        }
+    }
+}
+
 bool
 SHAMap::hasItem(uint256 const& id) const
 {
@@ -1040,6 +1256,52 @@ SHAMap::flushDirty(NodeObjectType t)
     return walkSubTree(backed_, t);
 }
 
+namespace {
+
+// Levels with fewer dirty nodes than this are hashed on the calling thread;
+// the cost of handing out the work outweighs the hashing itself.
+constexpr std::size_t minParallelHashBatch = 512;
+
+// Recompute the hashes of a batch of dirty nodes which all sit at the same
+// depth of the tree. The children of every node in the batch must already
+// have been hashed and hooked into their parents.
+template <class Entry>
+void
+hashLevel(Family& f, std::vector<Entry>& level)
+{
+    auto const hashRange = [&level](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            auto& node = level[i].node;
+            if (node->isInner())
+                static_cast<SHAMapInnerNode&>(*node).updateHashDeep();
+            else
+                node->updateHash();
+            node->unshare();
+        }
+    };
+
+    auto const workerCount = std::min<std::size_t>(
+        std::thread::hardware_concurrency(),
+        level.size() / minParallelHashBatch);
+
+    if (workerCount < 2)
+    {
+        hashRange(0, level.size());
+        return;
+    }
+
+    // Nodes at the same depth never share a hash dependency, so each
+    // worker can take a contiguous slice of the level.
+    auto const chunk = (level.size() + workerCount - 1) / workerCount;
+    f.parallelFor(workerCount, [&](std::size_t w) {
+        auto const first = std::min(level.size(), w * chunk);
+        hashRange(first, std::min(level.size(), first + chunk));
+    });
+}
+
+}  // namespace
+
 int
 SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
 {
@@ -1071,102 +1333,78 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
-    // Stack of {parent,index,child} pointers representing
-    // inner nodes we are in the process of flushing
-    using StackEntry = std::pair<intr_ptr::SharedPtr<SHAMapInnerNode>, int>;
-    std::stack<StackEntry, std::vector<StackEntry>> stack;
-
-    node = preFlushNode(std::move(node));
-
-    int pos = 0;
-
-    // We can't flush an inner node until we flush its children
-    while (1)
+    // A dirty node together with the inner node, and the branch of that
+    // inner node, it must be hooked into once it has been flushed.
+    struct DirtyNode
+    {
+        intr_ptr::SharedPtr<SHAMapInnerNode> parent;
+        int branch;
+        intr_ptr::SharedPtr<SHAMapTreeNode> node;
+    };
+
+    // First pass: collect every dirty node, grouped by its depth in the
+    // tree. No hashing is done here; it is all deferred to the second pass
+    // so that nodes at the same depth can be hashed as one batch.
+    std::vector<std::vector<DirtyNode>> levels(1);
+    levels[0].push_back({{}, 0, preFlushNode(std::move(node))});
+
+    for (std::size_t depth = 0; depth < levels.size(); ++depth)
     {
-        while (pos < branchFactor)
+        for (std::size_t i = 0; i < levels[depth].size(); ++i)
         {
-            if (node->isEmptyBranch(pos))
-            {
-                ++pos;
-            }
-            else
-            {
-                // No need to do I/O. If the node isn't linked,
-                // it can't need to be flushed
-                int branch = pos;
-                auto child = node->getChild(pos++);
+            if (levels[depth][i].node->isLeaf())
+                continue;
 
-                if (child && (child->cowid() != 0))
-                {
-                    // This is a node that needs to be flushed
+            auto inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(
+                levels[depth][i].node);
 
-                    child = preFlushNode(std::move(child));
+            for (int branch = 0; branch < branchFactor; ++branch)
+            {
+                if (inner->isEmptyBranch(branch))
+                    continue;
 
-                    if (child->isInner())
-                    {
-                        // save our place and work on this node
-
-                        stack.emplace(std::move(node), branch);
-                        // The semantics of this changes when we move to c++-20
-                        // Right now no move will occur; With c++-20 child will
-                        // be moved from.
-                        node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(
-                            std::move(child));
-                        pos = 0;
-                    }
-                    else
-                    {
-                        // flush this leaf
-                        ++flushed;
+                // No need to do I/O. If the node isn't linked,
+                // it can't need to be flushed
+                auto child = inner->getChild(branch);
 
-                        XRPL_ASSERT(
-                            node->cowid() == cowid_,
-                            "ripple::SHAMap::walkSubTree : node cowid do "
-                            "match");
-                        child->updateHash();
-                        child->unshare();
+                if (!child || (child->cowid() == 0))
+                    continue;
 
-                        if (doWrite)
-                            child = writeNode(t, std::move(child));
+                if (levels.size() == depth + 1)
+                    levels.emplace_back();
 
-                        node->shareChild(branch, child);
-                    }
-                }
+                levels[depth + 1].push_back(
+                    {inner, branch, preFlushNode(std::move(child))});
             }
         }
+    }
 
-        // update the hash of this inner node
-        node->updateHashDeep();
-
-        // This inner node can now be shared
-        node->unshare();
-
-        if (doWrite)
-            node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(
-                writeNode(t, std::move(node)));
-
-        ++flushed;
+    // Second pass: working up from the deepest level, hash each level as a
+    // batch, then write its nodes and hook them into their parents so the
+    // next level up sees the final child hashes.
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level)
+    {
+        hashLevel(f_, *level);
 
-        if (stack.empty())
-            break;
+        for (auto& entry : *level)
+        {
+            if (doWrite)
+                entry.node = writeNode(t, std::move(entry.node));
 
-        auto parent = std::move(stack.top().first);
-        pos = stack.top().second;
-        stack.pop();
+            ++flushed;
 
-        // Hook this inner node to its parent
-        XRPL_ASSERT(
-            parent->cowid() == cowid_,
-            "ripple::SHAMap::walkSubTree : parent cowid do match");
-        parent->shareChild(pos, node);
+            if (!entry.parent)
+                continue;
 
-        // Continue with parent's next child, if any
-        node = std::move(parent);
-        ++pos;
+            XRPL_ASSERT(
+                entry.parent->cowid() == cowid_,
+                "ripple::SHAMap::walkSubTree : parent cowid do match");
+            entry.parent->shareChild(entry.branch, entry.node);
+        }
     }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
+    // The only node at depth zero is the new root_
+    root_ = std::move(levels[0][0].node);
 
     return flushed;
 }
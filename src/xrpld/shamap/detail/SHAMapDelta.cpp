@@ -22,8 +22,11 @@
 #include <xrpl/basics/IntrusivePointer.ipp>
 #include <xrpl/basics/contract.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <stack>
+#include <thread>
 #include <vector>
 
 namespace ripple {
@@ -42,7 +45,7 @@ SHAMap::walkBranch(
     boost::intrusive_ptr<SHAMapItem const> const& otherMapItem,
     bool isFirstMap,
     Delta& differences,
-    int& maxCount) const
+    std::atomic<int>& maxCount) const
 {
     // Walk a branch of a SHAMap that's matched by an empty branch or single
     // item in the other map
@@ -137,11 +140,136 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
     if (getHash() == otherMap.getHash())
         return true;
 
+    std::atomic<int> remaining{maxCount};
+    return compareNodes(
+        root_.get(), otherMap, otherMap.root_.get(), differences, remaining);
+}
+
+bool
+SHAMap::compareParallel(
+    SHAMap const& otherMap,
+    Delta& differences,
+    int maxCount) const
+{
+    XRPL_ASSERT(
+        isValid() && otherMap.isValid(),
+        "ripple::SHAMap::compareParallel : valid state and valid input");
+
+    if (getHash() == otherMap.getHash())
+        return true;
+
+    if (!root_->isInner() || !otherMap.root_->isInner())
+        return compare(otherMap, differences, maxCount);
+
+    auto ours = static_cast<SHAMapInnerNode*>(root_.get());
+    auto other = static_cast<SHAMapInnerNode*>(otherMap.root_.get());
+
+    // Only branches both maps have are worth splitting. The size of the
+    // nodes below them shows how much work the comparison is.
+    using Branch = std::pair<SHAMapTreeNode*, SHAMapTreeNode*>;
+    std::vector<Branch> branches;
+    std::size_t children = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (ours->getChildHash(i) == other->getChildHash(i) ||
+            ours->isEmptyBranch(i) || other->isEmptyBranch(i))
+            continue;
+
+        Branch const branch{
+            descendThrow(ours, i), otherMap.descendThrow(other, i)};
+        for (auto const node : {branch.first, branch.second})
+        {
+            children += node->isInner()
+                ? static_cast<SHAMapInnerNode*>(node)->getBranchCount()
+                : 1;
+        }
+        branches.push_back(branch);
+    }
+
+    // Below this, handing out the work costs more than it saves.
+    static constexpr std::size_t minParallelChildren = 256;
+    if (branches.size() < 2 || children < minParallelChildren)
+        return compare(otherMap, differences, maxCount);
+
+    // Every worker counts its differences against the same budget.
+    std::atomic<int> remaining{maxCount};
+    for (int i = 0; i < 16; ++i)
+    {
+        if (ours->getChildHash(i) == other->getChildHash(i))
+            continue;
+
+        if (other->isEmptyBranch(i))
+        {
+            if (!walkBranch(
+                    descendThrow(ours, i),
+                    nullptr,
+                    true,
+                    differences,
+                    remaining))
+                return false;
+        }
+        else if (ours->isEmptyBranch(i))
+        {
+            if (!otherMap.walkBranch(
+                    otherMap.descendThrow(other, i),
+                    nullptr,
+                    false,
+                    differences,
+                    remaining))
+                return false;
+        }
+    }
+
+    auto const workerCount = std::min<std::size_t>(
+        branches.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<Delta> deltas(workerCount);
+    std::vector<char> complete(workerCount, true);
+    int budget = remaining;
+
+    f_.parallelFor(workerCount, [&](std::size_t w) {
+        for (auto b = w; b < branches.size() && complete[w] && remaining > 0;
+             b += workerCount)
+        {
+            complete[w] = compareNodes(
+                branches[b].first,
+                otherMap,
+                branches[b].second,
+                deltas[w],
+                remaining);
+        }
+    });
+
+    // Workers stopping at the same time may each have found one more
+    // difference than the budget allows.
+    for (std::size_t w = 0; w < workerCount; ++w)
+    {
+        for (auto& difference : deltas[w])
+        {
+            differences.insert(std::move(difference));
+            if (--budget <= 0)
+                return false;
+        }
+
+        if (!complete[w])
+            return false;
+    }
+
+    return true;
+}
+
+bool
+SHAMap::compareNodes(
+    SHAMapTreeNode* ourTop,
+    SHAMap const& otherMap,
+    SHAMapTreeNode* otherTop,
+    Delta& differences,
+    std::atomic<int>& maxCount) const
+{
     using StackEntry = std::pair<SHAMapTreeNode*, SHAMapTreeNode*>;
     std::stack<StackEntry, std::vector<StackEntry>>
         nodeStack;  // track nodes we've pushed
 
-    nodeStack.push({root_.get(), otherMap.root_.get()});
+    nodeStack.push({ourTop, otherTop});
     while (!nodeStack.empty())
     {
         auto [ourNode, otherNode] = nodeStack.top();
@@ -149,7 +277,7 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
 
         if (!ourNode || !otherNode)
         {
-            UNREACHABLE("ripple::SHAMap::compare : missing a node");
+            UNREACHABLE("ripple::SHAMap::compareNodes : missing a node");
             Throw<SHAMapMissingNode>(type_, uint256());
         }
 
@@ -230,7 +358,7 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
                 }
         }
         else
-            UNREACHABLE("ripple::SHAMap::compare : invalid node");
+            UNREACHABLE("ripple::SHAMap::compareNodes : invalid node");
     }
 
     return true;
@@ -253,12 +381,13 @@ SHAMap::walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing)
         intr_ptr::SharedPtr<SHAMapInnerNode> node = std::move(nodeStack.top());
         nodeStack.pop();
 
+        auto const children = descendNoStore(*node);
         for (int i = 0; i < 16; ++i)
         {
             if (!node->isEmptyBranch(i))
             {
-                intr_ptr::SharedPtr<SHAMapTreeNode> nextNode =
-                    descendNoStore(*node, i);
+                intr_ptr::SharedPtr<SHAMapTreeNode> const& nextNode =
+                    children[i];
 
                 if (nextNode)
                 {
@@ -287,16 +416,8 @@ SHAMap::walkMapParallel(
         return false;
 
     using StackEntry = intr_ptr::SharedPtr<SHAMapInnerNode>;
-    std::array<intr_ptr::SharedPtr<SHAMapTreeNode>, 16> topChildren;
-    {
-        auto const& innerRoot =
-            intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_);
-        for (int i = 0; i < 16; ++i)
-        {
-            if (!innerRoot->isEmptyBranch(i))
-                topChildren[i] = descendNoStore(*innerRoot, i);
-        }
-    }
+    auto const topChildren = descendNoStore(
+        *intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_));
     std::vector<std::thread> workers;
     workers.reserve(16);
     std::vector<SHAMapMissingNode> exceptions;
@@ -332,12 +453,13 @@ SHAMap::walkMapParallel(
                             "ripple::SHAMap::walkMapParallel : non-null node");
                         nodeStack.pop();
 
+                        auto const children = descendNoStore(*node);
                         for (int i = 0; i < 16; ++i)
                         {
                             if (node->isEmptyBranch(i))
                                 continue;
-                            intr_ptr::SharedPtr<SHAMapTreeNode> nextNode =
-                                descendNoStore(*node, i);
+                            intr_ptr::SharedPtr<SHAMapTreeNode> const&
+                                nextNode = children[i];
 
                             if (nextNode)
                             {
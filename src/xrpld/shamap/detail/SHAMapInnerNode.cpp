@@ -22,6 +22,7 @@
 #include <xrpld/shamap/detail/TaggedPointer.ipp>
 
 #include <xrpl/basics/IntrusivePointer.ipp>
+#include <xrpl/basics/SlabAllocator.h>
 #include <xrpl/basics/Slice.h>
 #include <xrpl/basics/contract.h>
 #include <xrpl/basics/spinlock.h>
@@ -30,6 +31,61 @@
 
 namespace ripple {
 
+namespace {
+
+// Building or acquiring a ledger creates inner nodes by the tens of
+// thousands. Carving them out of large slabs replaces a heap allocation
+// per node with one per slab, and keeps them densely packed.
+SlabAllocator<SHAMapInnerNode> innerNodeSlab(0, megabytes(std::size_t(32)));
+
+std::atomic<bool> useInnerNodeSlab{false};
+
+// Stays set once the slab has been enabled, since nodes carved from it
+// may outlive a later disable.
+std::atomic<bool> innerNodeSlabUsed{false};
+
+}  // namespace
+
+void*
+SHAMapInnerNode::operator new(std::size_t size)
+{
+    XRPL_ASSERT(
+        size == sizeof(SHAMapInnerNode),
+        "ripple::SHAMapInnerNode::operator new : valid size");
+
+    if (useInnerNodeSlab.load(std::memory_order_acquire))
+    {
+        if (auto p = innerNodeSlab.allocate())
+            return p;
+    }
+
+    return ::operator new(size);
+}
+
+void
+SHAMapInnerNode::operator delete(void* p) noexcept
+{
+    if (innerNodeSlabUsed.load(std::memory_order_acquire) &&
+        innerNodeSlab.deallocate(static_cast<std::uint8_t*>(p)))
+        return;
+
+    ::operator delete(p);
+}
+
+void
+SHAMapInnerNode::setSlabAllocation(bool enable) noexcept
+{
+    if (enable)
+        innerNodeSlabUsed.store(true, std::memory_order_release);
+    useInnerNodeSlab.store(enable, std::memory_order_release);
+}
+
+SHAMapInnerNode::SlabStats
+SHAMapInnerNode::slabStats() noexcept
+{
+    return {innerNodeSlab.inUse(), innerNodeSlab.reserved()};
+}
+
 SHAMapInnerNode::SHAMapInnerNode(
     std::uint32_t cowid,
     std::uint8_t numAllocatedChildren)
@@ -22,6 +22,8 @@
 
 #include <xrpl/basics/random.h>
 
+#include <deque>
+
 namespace ripple {
 
 void
@@ -47,10 +49,18 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
     if (!root_->isInner())
         return;
 
-    using StackEntry = std::pair<int, intr_ptr::SharedPtr<SHAMapInnerNode>>;
+    // Each level keeps the children it fetched as one batch, so resuming
+    // a level never goes back to the database.
+    struct StackEntry
+    {
+        int pos;
+        intr_ptr::SharedPtr<SHAMapInnerNode> node;
+        ChildArray children;
+    };
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
     auto node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_);
+    auto children = descendNoStore(*node);
     int pos = 0;
 
     while (true)
@@ -60,7 +70,7 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
             if (!node->isEmptyBranch(pos))
             {
                 intr_ptr::SharedPtr<SHAMapTreeNode> child =
-                    descendNoStore(*node, pos);
+                    std::move(children[pos]);
                 if (!function(*child))
                     return;
 
@@ -75,12 +85,14 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
                     if (pos != 15)
                     {
                         // save next position to resume at
-                        stack.push(std::make_pair(pos + 1, std::move(node)));
+                        stack.push(
+                            {pos + 1, std::move(node), std::move(children)});
                     }
 
                     // descend to the child's first position
                     node =
                         intr_ptr::static_pointer_cast<SHAMapInnerNode>(child);
+                    children = descendNoStore(*node);
                     pos = 0;
                 }
             }
@@ -93,7 +105,10 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
         if (stack.empty())
             break;
 
-        std::tie(pos, node) = stack.top();
+        auto& top = stack.top();
+        pos = top.pos;
+        node = std::move(top.node);
+        children = std::move(top.children);
         stack.pop();
     }
 }
@@ -166,6 +181,38 @@ SHAMap::visitDifferences(
     }
 }
 
+void
+SHAMap::visitResident(
+    std::function<bool(SHAMapInnerNode const&)> const& function) const
+{
+    if (!root_ || !root_->isInner())
+        return;
+
+    std::deque<intr_ptr::SharedPtr<SHAMapInnerNode>> queue;
+    queue.push_back(intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_));
+
+    while (!queue.empty())
+    {
+        auto const node = std::move(queue.front());
+        queue.pop_front();
+
+        if (!function(*node))
+            return;
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if (node->isEmptyBranch(i))
+                continue;
+
+            // Children that were never loaded stay unloaded
+            auto child = node->getChild(i);
+            if (child && child->isInner())
+                queue.push_back(
+                    intr_ptr::static_pointer_cast<SHAMapInnerNode>(child));
+        }
+    }
+}
+
 // Starting at the position referred to by the specfied
 // StackEntry, process that node and its first resident
 // children, descending the SHAMap until we complete the
@@ -580,9 +627,31 @@ SHAMap::addKnownNode(
     SHAMapNodeID const& node,
     Slice const& rawNode,
     SHAMapSyncFilter* filter)
+{
+    return hookKnownNode(
+        node,
+        [&rawNode]() { return SHAMapTreeNode::makeFromWire(rawNode); },
+        filter);
+}
+
+SHAMapAddNode
+SHAMap::addKnownNode(
+    SHAMapNodeID const& node,
+    intr_ptr::SharedPtr<SHAMapTreeNode> newNode,
+    SHAMapSyncFilter* filter)
+{
+    return hookKnownNode(
+        node, [&newNode]() { return std::move(newNode); }, filter);
+}
+
+SHAMapAddNode
+SHAMap::hookKnownNode(
+    SHAMapNodeID const& node,
+    std::function<intr_ptr::SharedPtr<SHAMapTreeNode>()> const& makeNode,
+    SHAMapSyncFilter* filter)
 {
     XRPL_ASSERT(
-        !node.isRoot(), "ripple::SHAMap::addKnownNode : valid node input");
+        !node.isRoot(), "ripple::SHAMap::hookKnownNode : valid node input");
 
     if (!isSynching())
     {
@@ -599,7 +668,8 @@ SHAMap::addKnownNode(
            (iNodeID.getDepth() < node.getDepth()))
     {
         int branch = selectBranch(iNodeID, node.getNodeID());
-        XRPL_ASSERT(branch >= 0, "ripple::SHAMap::addKnownNode : valid branch");
+        XRPL_ASSERT(
+            branch >= 0, "ripple::SHAMap::hookKnownNode : valid branch");
         auto inner = static_cast<SHAMapInnerNode*>(iNode);
         if (inner->isEmptyBranch(branch))
         {
@@ -618,7 +688,7 @@ SHAMap::addKnownNode(
 
         if (iNode == nullptr)
         {
-            auto newNode = SHAMapTreeNode::makeFromWire(rawNode);
+            auto newNode = makeNode();
 
             if (!newNode || childHash != newNode->getHash())
             {